@@ -10,6 +10,7 @@
 
 #include <bitset>
 #include <cstdint>
+#include <memory>
 #include <type_traits>
 #include <vector>
 
@@ -61,6 +62,18 @@ struct GrowableColumns {
   /// Read-only access to a column w/o checking its existence first.
   auto col(size_t index) const { return data.col(index); }
 
+  /// Make sure storage for at least @p n columns is allocated. The size of
+  /// the container is not changed.
+  /// @param n Number of columns to allocate storage for
+  void reserve(size_t n) {
+    if (capacity() < n) {
+      data.conservativeResize(Eigen::NoChange, n);
+    }
+  }
+
+  /// Remove all columns but keep the allocated storage.
+  void clear() { m_size = 0; }
+
   /// Return the current allocated storage capacity
   size_t capacity() const { return static_cast<size_t>(data.cols()); }
 
@@ -94,9 +107,9 @@ struct Types {
 };
 
 struct IndexData {
-  using IndexType = uint16_t;
+  using IndexType = uint32_t;
 
-  static constexpr IndexType kInvalid = UINT16_MAX;
+  static constexpr IndexType kInvalid = UINT32_MAX;
 
   IndexType irefsurface = kInvalid;
   IndexType iprevious = kInvalid;
@@ -172,9 +185,20 @@ class TrackStateProxy {
   /// Set the reference surface to a given value
   /// @param srf Shared pointer to the surface to set
   /// @note This overload is only present in case @c ReadOnly is false.
+  /// @note Ownership is only kept if the trajectory shares surface ownership.
   template <bool RO = ReadOnly, typename = std::enable_if_t<!RO>>
   void setReferenceSurface(std::shared_ptr<const Surface> srf) {
-    m_traj->m_referenceSurfaces[data().irefsurface] = std::move(srf);
+    m_traj->setReferenceSurface(data().irefsurface, std::move(srf));
+  }
+
+  /// Set the reference surface without sharing its ownership
+  /// @param srf Pointer to the surface to set
+  /// @note This overload is only present in case @c ReadOnly is false.
+  /// @note The caller must ensure that the surface outlives the trajectory,
+  ///       e.g. by using surfaces from the tracking geometry.
+  template <bool RO = ReadOnly, typename = std::enable_if_t<!RO>>
+  void setReferenceSurface(const Surface* srf) {
+    m_traj->setReferenceSurface(data().irefsurface, srf);
   }
 
   /// Track parameters vector. This tries to be somewhat smart and return the
@@ -396,13 +420,18 @@ class TrackStateProxy {
 
     // this shouldn't change
     assert(data().irefsurface != IndexData::kInvalid);
-    std::shared_ptr<const Surface>& refSrf =
-        m_traj->m_referenceSurfaces[dataref.irefsurface];
+    const Surface* refSrf = m_traj->m_referenceSurfaces[dataref.irefsurface];
     // either unset, or the same, otherwise this is inconsistent assignment
-    assert(!refSrf || refSrf.get() == &meas.referenceSurface());
+    assert(!refSrf || refSrf == &meas.referenceSurface());
     if (!refSrf) {
       // ref surface is not set, set it now
-      refSrf = meas.referenceSurface().getSharedPtr();
+      if (m_traj->m_shareSurfaceOwnership) {
+        m_traj->setReferenceSurface(dataref.irefsurface,
+                                    meas.referenceSurface().getSharedPtr());
+      } else {
+        m_traj->setReferenceSurface(dataref.irefsurface,
+                                    &meas.referenceSurface());
+      }
     }
 
     assert(dataref.icalibratedsourcelink != IndexData::kInvalid);
@@ -552,6 +581,24 @@ class MultiTrajectory {
   /// Create an empty trajectory.
   MultiTrajectory() = default;
 
+  /// Create an empty trajectory with restricted storage.
+  ///
+  /// Components that are not part of the allocation mask are never allocated
+  /// when adding track states, regardless of the mask or track state given
+  /// there, and are invalid on all track states. Explicitly resetting the
+  /// calibrated measurement still allocates it.
+  ///
+  /// Without shared surface ownership, the trajectory only stores pointers to
+  /// the reference surfaces; the caller must ensure that they outlive the
+  /// trajectory, e.g. by using surfaces from the tracking geometry.
+  ///
+  /// @param allocationMask The components that can be allocated
+  /// @param shareSurfaceOwnership Whether to keep the reference surfaces alive
+  MultiTrajectory(const TrackStatePropMask::Type& allocationMask,
+                  bool shareSurfaceOwnership = true)
+      : m_allocationMask(allocationMask),
+        m_shareSurfaceOwnership(shareSurfaceOwnership) {}
+
   /// Add a track state using information from a separate track state object.
   ///
   /// @tparam parameters_t The parameter type used for the trackstate
@@ -574,6 +621,34 @@ class MultiTrajectory {
       const TrackStatePropMask::Type& mask = TrackStatePropMask::All,
       size_t iprevious = SIZE_MAX);
 
+  /// Allocate storage for a number of track states upfront.
+  ///
+  /// Growing the trajectory state by state reallocates and copies the whole
+  /// column storage every few states. If the (approximate) number of track
+  /// states is known beforehand, e.g. from the number of measurements, this
+  /// can be avoided. Only components within the allocation mask are reserved.
+  ///
+  /// @param nStates The number of track states to allocate storage for
+  void reserve(size_t nStates);
+
+  /// Remove all track states but keep the allocated storage, such that the
+  /// trajectory can be refilled without reallocation.
+  ///
+  /// A single trajectory can hold the track states of all tracks in an event,
+  /// each identified by its tip index, and be cleared between events.
+  void clear();
+
+  /// Number of stored track states.
+  size_t size() const { return m_index.size(); }
+
+  /// The components that can be allocated.
+  const TrackStatePropMask::Type& allocationMask() const {
+    return m_allocationMask;
+  }
+
+  /// Whether the trajectory keeps its reference surfaces alive.
+  bool sharesSurfaceOwnership() const { return m_shareSurfaceOwnership; }
+
   /// Access a read-only point on the trajectory by index.
   /// @param istate The index to access
   /// @return Read only proxy to the stored track state
@@ -614,11 +689,26 @@ class MultiTrajectory {
   std::vector<SourceLink> m_sourceLinks;
   std::vector<ProjectorBitset> m_projectors;
 
-  // owning vector of shared pointers to surfaces
-  // @TODO: This might be problematic when appending a large number of surfaces
-  // trackstates, because vector has to reallocated and thus copy. This might
-  // be handled in a smart way by moving but not sure.
-  std::vector<std::shared_ptr<const Surface>> m_referenceSurfaces;
+  // reference surfaces and, only with shared surface ownership, their owners
+  std::vector<const Surface*> m_referenceSurfaces;
+  std::vector<std::shared_ptr<const Surface>> m_referenceSurfaceOwners;
+
+  TrackStatePropMask::Type m_allocationMask = TrackStatePropMask::All;
+  bool m_shareSurfaceOwnership = true;
+
+  /// Add an unset reference surface and return its index.
+  detail_lt::IndexData::IndexType addReferenceSurface();
+  /// Set the reference surface and keep it alive if ownership is shared.
+  void setReferenceSurface(size_t isurface,
+                           std::shared_ptr<const Surface> srf);
+  /// Set the reference surface without keeping it alive.
+  void setReferenceSurface(size_t isurface, const Surface* srf);
+  /// Shared pointer to the reference surface, e.g. for bound parameters.
+  ///
+  /// The pointer only owns the surface if the trajectory keeps it alive;
+  /// otherwise it wraps the stored pointer without touching any reference
+  /// count.
+  std::shared_ptr<const Surface> referenceSurfacePtr(size_t isurface) const;
 
   friend class detail_lt::TrackStateProxy<SourceLink, ParametersSize,
                                           MeasurementSizeMax, true>;
@@ -8,6 +8,7 @@
 
 #include <bitset>
 #include <cstdint>
+#include <memory>
 #include <type_traits>
 #include <vector>
 
@@ -70,7 +71,7 @@ template <typename SL, size_t N, size_t M, bool ReadOnly>
 inline BoundParameters TrackStateProxy<SL, N, M, ReadOnly>::predictedParameters(
     const Acts::GeometryContext& gctx) const {
   return {gctx, predictedCovariance(), predicted(),
-          m_traj->m_referenceSurfaces[data().irefsurface]};
+          m_traj->referenceSurfacePtr(data().irefsurface)};
 }
 
 template <typename SL, size_t N, size_t M, bool ReadOnly>
@@ -91,7 +92,7 @@ template <typename SL, size_t N, size_t M, bool ReadOnly>
 inline BoundParameters TrackStateProxy<SL, N, M, ReadOnly>::filteredParameters(
     const Acts::GeometryContext& gctx) const {
   return {gctx, filteredCovariance(), filtered(),
-          m_traj->m_referenceSurfaces[data().irefsurface]};
+          m_traj->referenceSurfacePtr(data().irefsurface)};
 }
 
 template <typename SL, size_t N, size_t M, bool ReadOnly>
@@ -112,7 +113,7 @@ template <typename SL, size_t N, size_t M, bool ReadOnly>
 inline BoundParameters TrackStateProxy<SL, N, M, ReadOnly>::smoothedParameters(
     const Acts::GeometryContext& gctx) const {
   return {gctx, smoothedCovariance(), smoothed(),
-          m_traj->m_referenceSurfaces[data().irefsurface]};
+          m_traj->referenceSurfacePtr(data().irefsurface)};
 }
 
 template <typename SL, size_t N, size_t M, bool ReadOnly>
@@ -164,6 +165,7 @@ template <typename SL>
 template <typename parameters_t>
 inline size_t MultiTrajectory<SL>::addTrackState(
     const TrackState<SL, parameters_t>& ts, size_t iprevious) {
+  namespace PropMask = TrackStatePropMask;
   using CovMap =
       typename detail_lt::Types<ParametersSize, false>::CovarianceMap;
 
@@ -174,29 +176,35 @@ inline size_t MultiTrajectory<SL>::addTrackState(
 
   TrackStateProxy nts = getTrackState(index);
 
-  // make shared ownership held by this multi trajectory
-  m_referenceSurfaces.push_back(ts.referenceSurface().getSharedPtr());
-  p.irefsurface = m_referenceSurfaces.size() - 1;
+  p.irefsurface = addReferenceSurface();
+  if (m_shareSurfaceOwnership) {
+    setReferenceSurface(p.irefsurface, ts.referenceSurface().getSharedPtr());
+  } else {
+    setReferenceSurface(p.irefsurface, &ts.referenceSurface());
+  }
 
   if (iprevious != SIZE_MAX) {
-    p.iprevious = static_cast<uint16_t>(iprevious);
+    p.iprevious = static_cast<detail_lt::IndexData::IndexType>(iprevious);
   }
 
-  if (ts.parameter.predicted) {
+  if (ts.parameter.predicted and
+      ACTS_CHECK_BIT(m_allocationMask, PropMask::Predicted)) {
     const auto& predicted = *ts.parameter.predicted;
     m_params.addCol() = predicted.parameters();
     CovMap(m_cov.addCol().data()) = *predicted.covariance();
     p.ipredicted = m_params.size() - 1;
   }
 
-  if (ts.parameter.filtered) {
+  if (ts.parameter.filtered and
+      ACTS_CHECK_BIT(m_allocationMask, PropMask::Filtered)) {
     const auto& filtered = *ts.parameter.filtered;
     m_params.addCol() = filtered.parameters();
     CovMap(m_cov.addCol().data()) = *filtered.covariance();
     p.ifiltered = m_params.size() - 1;
   }
 
-  if (ts.parameter.smoothed) {
+  if (ts.parameter.smoothed and
+      ACTS_CHECK_BIT(m_allocationMask, PropMask::Smoothed)) {
     const auto& smoothed = *ts.parameter.smoothed;
     m_params.addCol() = smoothed.parameters();
     CovMap(m_cov.addCol().data()) = *smoothed.covariance();
@@ -204,18 +212,21 @@ inline size_t MultiTrajectory<SL>::addTrackState(
   }
 
   // store jacobian
-  if (ts.parameter.jacobian) {
+  if (ts.parameter.jacobian and
+      ACTS_CHECK_BIT(m_allocationMask, PropMask::Jacobian)) {
     CovMap(m_jac.addCol().data()) = *ts.parameter.jacobian;
     p.ijacobian = m_jac.size() - 1;
   }
 
   // handle measurements
-  if (ts.measurement.uncalibrated) {
+  if (ts.measurement.uncalibrated and
+      ACTS_CHECK_BIT(m_allocationMask, PropMask::Uncalibrated)) {
     m_sourceLinks.push_back(*ts.measurement.uncalibrated);
     p.iuncalibrated = m_sourceLinks.size() - 1;
   }
 
-  if (ts.measurement.calibrated) {
+  if (ts.measurement.calibrated and
+      ACTS_CHECK_BIT(m_allocationMask, PropMask::Calibrated)) {
     std::visit([&](const auto& m) { nts.resetCalibrated(m); },
                *ts.measurement.calibrated);
   }
@@ -237,42 +248,44 @@ inline size_t MultiTrajectory<SL>::addTrackState(
   size_t index = m_index.size() - 1;
 
   if (iprevious != SIZE_MAX) {
-    p.iprevious = static_cast<uint16_t>(iprevious);
+    p.iprevious = static_cast<detail_lt::IndexData::IndexType>(iprevious);
   }
 
   // always set, but can be null
-  m_referenceSurfaces.emplace_back(nullptr);
-  p.irefsurface = m_referenceSurfaces.size() - 1;
+  p.irefsurface = addReferenceSurface();
+
+  // components outside of the allocation mask are never allocated
+  const PropMask::Type allocate = mask & m_allocationMask;
 
-  if (ACTS_CHECK_BIT(mask, PropMask::Predicted)) {
+  if (ACTS_CHECK_BIT(allocate, PropMask::Predicted)) {
     m_params.addCol();
     m_cov.addCol();
     p.ipredicted = m_params.size() - 1;
   }
 
-  if (ACTS_CHECK_BIT(mask, PropMask::Filtered)) {
+  if (ACTS_CHECK_BIT(allocate, PropMask::Filtered)) {
     m_params.addCol();
     m_cov.addCol();
     p.ifiltered = m_params.size() - 1;
   }
 
-  if (ACTS_CHECK_BIT(mask, PropMask::Smoothed)) {
+  if (ACTS_CHECK_BIT(allocate, PropMask::Smoothed)) {
     m_params.addCol();
     m_cov.addCol();
     p.ismoothed = m_params.size() - 1;
   }
 
-  if (ACTS_CHECK_BIT(mask, PropMask::Jacobian)) {
+  if (ACTS_CHECK_BIT(allocate, PropMask::Jacobian)) {
     m_jac.addCol();
     p.ijacobian = m_jac.size() - 1;
   }
 
-  if (ACTS_CHECK_BIT(mask, PropMask::Uncalibrated)) {
+  if (ACTS_CHECK_BIT(allocate, PropMask::Uncalibrated)) {
     m_sourceLinks.emplace_back();
     p.iuncalibrated = m_sourceLinks.size() - 1;
   }
 
-  if (ACTS_CHECK_BIT(mask, PropMask::Calibrated)) {
+  if (ACTS_CHECK_BIT(allocate, PropMask::Calibrated)) {
     m_meas.addCol();
     m_measCov.addCol();
     p.icalibrated = m_meas.size() - 1;
@@ -287,6 +300,88 @@ inline size_t MultiTrajectory<SL>::addTrackState(
   return index;
 }
 
+template <typename SL>
+inline void MultiTrajectory<SL>::reserve(size_t nStates) {
+  namespace PropMask = TrackStatePropMask;
+
+  const auto& mask = m_allocationMask;
+  // number of components per track state stored in the same columns
+  const size_t nParams = ACTS_CHECK_BIT(mask, PropMask::Predicted) +
+                         ACTS_CHECK_BIT(mask, PropMask::Filtered) +
+                         ACTS_CHECK_BIT(mask, PropMask::Smoothed);
+  const size_t nMeas = ACTS_CHECK_BIT(mask, PropMask::Calibrated);
+  const size_t nJac = ACTS_CHECK_BIT(mask, PropMask::Jacobian);
+  const size_t nSourceLinks =
+      ACTS_CHECK_BIT(mask, PropMask::Uncalibrated) + nMeas;
+
+  m_index.reserve(nStates);
+  m_params.reserve(nParams * nStates);
+  m_cov.reserve(nParams * nStates);
+  m_meas.reserve(nMeas * nStates);
+  m_measCov.reserve(nMeas * nStates);
+  m_jac.reserve(nJac * nStates);
+  m_sourceLinks.reserve(nSourceLinks * nStates);
+  m_projectors.reserve(nMeas * nStates);
+  m_referenceSurfaces.reserve(nStates);
+  if (m_shareSurfaceOwnership) {
+    m_referenceSurfaceOwners.reserve(nStates);
+  }
+}
+
+template <typename SL>
+inline void MultiTrajectory<SL>::clear() {
+  m_index.clear();
+  m_params.clear();
+  m_cov.clear();
+  m_meas.clear();
+  m_measCov.clear();
+  m_jac.clear();
+  m_sourceLinks.clear();
+  m_projectors.clear();
+  m_referenceSurfaces.clear();
+  m_referenceSurfaceOwners.clear();
+}
+
+template <typename SL>
+inline detail_lt::IndexData::IndexType
+MultiTrajectory<SL>::addReferenceSurface() {
+  m_referenceSurfaces.push_back(nullptr);
+  if (m_shareSurfaceOwnership) {
+    m_referenceSurfaceOwners.emplace_back(nullptr);
+  }
+  return m_referenceSurfaces.size() - 1;
+}
+
+template <typename SL>
+inline void MultiTrajectory<SL>::setReferenceSurface(
+    size_t isurface, std::shared_ptr<const Surface> srf) {
+  m_referenceSurfaces[isurface] = srf.get();
+  if (m_shareSurfaceOwnership) {
+    m_referenceSurfaceOwners[isurface] = std::move(srf);
+  }
+}
+
+template <typename SL>
+inline void MultiTrajectory<SL>::setReferenceSurface(size_t isurface,
+                                                     const Surface* srf) {
+  m_referenceSurfaces[isurface] = srf;
+  if (m_shareSurfaceOwnership) {
+    m_referenceSurfaceOwners[isurface] = nullptr;
+  }
+}
+
+template <typename SL>
+inline std::shared_ptr<const Surface> MultiTrajectory<SL>::referenceSurfacePtr(
+    size_t isurface) const {
+  if (m_shareSurfaceOwnership and m_referenceSurfaceOwners[isurface]) {
+    return m_referenceSurfaceOwners[isurface];
+  }
+  // the surface is not owned by the trajectory; the aliasing constructor
+  // wraps the pointer without a control block, i.e. without owning it
+  return std::shared_ptr<const Surface>(std::shared_ptr<const Surface>(),
+                                        m_referenceSurfaces[isurface]);
+}
+
 template <typename SL>
 template <typename F>
 void MultiTrajectory<SL>::visitBackwards(size_t iendpoint, F&& callable) const {
@@ -0,0 +1,793 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/EventData/Measurement.hpp"
+#include "Acts/EventData/MeasurementHelpers.hpp"
+#include "Acts/EventData/MultiTrajectory.hpp"
+#include "Acts/EventData/TrackParameters.hpp"
+#include "Acts/EventData/TrackState.hpp"
+#include "Acts/Fitter/KalmanFitterError.hpp"
+#include "Acts/Fitter/detail/VoidKalmanComponents.hpp"
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/MagneticField/MagneticFieldContext.hpp"
+#include "Acts/Propagator/AbortList.hpp"
+#include "Acts/Propagator/ActionList.hpp"
+#include "Acts/Propagator/ConstrainedStep.hpp"
+#include "Acts/Propagator/Propagator.hpp"
+#include "Acts/Propagator/detail/PointwiseMaterialInteraction.hpp"
+#include "Acts/Utilities/CalibrationContext.hpp"
+#include "Acts/Utilities/Definitions.hpp"
+#include "Acts/Utilities/Logger.hpp"
+#include "Acts/Utilities/Result.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace Acts {
+
+/// @brief Options struct how the CombinatorialKalmanFitter is called
+///
+/// It contains the context of the track finding call, the chi2 cut for the
+/// measurement compatibility, the branching budgets and configurations for
+/// material effects.
+///
+/// @note the context objects must be provided
+struct CombinatorialKalmanFitterOptions {
+  /// Deleted default constructor
+  CombinatorialKalmanFitterOptions() = delete;
+
+  /// PropagatorOptions with context
+  ///
+  /// @param gctx The goemetry context for this track finding
+  /// @param mctx The magnetic context for this track finding
+  /// @param cctx The calibration context for this track finding
+  /// @param chi2Cut The maximum chi2 of a compatible measurement
+  /// @param branchesPerSurface The maximum number of branches per surface
+  /// @param candidates The maximum number of track candidates
+  /// @param mScattering Whether to include multiple scattering
+  /// @param eLoss Whether to include energy loss
+  CombinatorialKalmanFitterOptions(
+      std::reference_wrapper<const GeometryContext> gctx,
+      std::reference_wrapper<const MagneticFieldContext> mctx,
+      std::reference_wrapper<const CalibrationContext> cctx,
+      double chi2Cut = 15., size_t branchesPerSurface = 10,
+      size_t candidates = 100, bool mScattering = true, bool eLoss = true)
+      : geoContext(gctx),
+        magFieldContext(mctx),
+        calibrationContext(cctx),
+        maxChi2(chi2Cut),
+        maxBranchesPerSurface(branchesPerSurface),
+        maxCandidates(candidates),
+        multipleScattering(mScattering),
+        energyLoss(eLoss) {}
+
+  /// Context object for the geometry
+  std::reference_wrapper<const GeometryContext> geoContext;
+  /// Context object for the magnetic field
+  std::reference_wrapper<const MagneticFieldContext> magFieldContext;
+  /// context object for the calibration
+  std::reference_wrapper<const CalibrationContext> calibrationContext;
+
+  /// The maximum (predicted) chi2 of a measurement to be compatible
+  double maxChi2 = 15.;
+
+  /// The maximum number of measurements a branch is split into on a single
+  /// surface, the ones with the smallest chi2 are kept
+  size_t maxBranchesPerSurface = 10;
+
+  /// The maximum number of track candidates, i.e. branches being propagated
+  /// or already finished, for a single seed
+  size_t maxCandidates = 100;
+
+  /// Whether to consider multiple scattering
+  bool multipleScattering = true;
+
+  /// Whether to consider energy loss
+  bool energyLoss = true;
+};
+
+/// @brief Bookkeeping of a single branch of the combinatorial Kalman filter
+struct CombinatorialKalmanFitterTipState {
+  // The index of the last track state of the branch
+  size_t trackTip = SIZE_MAX;
+
+  // Counter for states with measurements
+  size_t measurementStates = 0;
+
+  // Counter for sensitive surfaces without compatible measurement
+  size_t holeStates = 0;
+
+  // The volume the navigation was in when the branch was created, used to
+  // resume it on surfaces without associated layer
+  const TrackingVolume* volume = nullptr;
+};
+
+/// @brief A measurement compatible with the predicted parameters on a surface
+template <typename source_link_t>
+struct CombinatorialKalmanFitterCandidate {
+  // The chi2 of the measurement with respect to the predicted parameters
+  double chi2 = 0.;
+
+  // The measurement, a copy of the source link
+  source_link_t sourceLink;
+
+  // The measurement calibrated with the predicted parameters
+  FittableMeasurement<source_link_t> calibrated;
+};
+
+template <typename source_link_t>
+struct CombinatorialKalmanFitterResult {
+  // Track states of all branches. Branches created on the same surface
+  // share their common prefix, i.e. all track states up to the surface,
+  // and the predicted parameters on the surface.
+  MultiTrajectory<source_link_t> fittedStates;
+
+  // The finished track candidates, one entry per trajectory in the
+  // multitrajectory, in the order they have been finished
+  std::vector<CombinatorialKalmanFitterTipState> tracks;
+
+  // The branch that is currently propagated
+  CombinatorialKalmanFitterTipState activeBranch;
+
+  // Branches that still need to be propagated, starting from the filtered
+  // parameters of their last track state
+  std::vector<CombinatorialKalmanFitterTipState> pendingBranches;
+
+  // The surface the active branch has been resumed on, only set until the
+  // branch has moved on
+  const Surface* resumeSurface = nullptr;
+
+  // Scratch buffer of the compatible measurements on the current surface
+  std::vector<CombinatorialKalmanFitterCandidate<source_link_t>>
+      compatibleMeasurements;
+
+  // Counter for handled states
+  size_t processedStates = 0;
+
+  // Indicator if initialization has been performed.
+  bool initialized = false;
+
+  // Indicator if all branches have been propagated
+  bool finished = false;
+
+  Result<void> result{Result<void>::success()};
+};
+
+/// @brief Combinatorial Kalman filter track finding as a plugin to the
+/// Propagator
+///
+/// @tparam propagator_t Type of the propagation class
+/// @tparam updater_t Type of the kalman updater class
+/// @tparam calibrator_t Type of the calibrator class
+///
+/// The CombinatorialKalmanFitter finds and fits tracks in a single
+/// propagation call starting from a seed. Its Actor evaluates all
+/// measurements on every surface reached by the navigator against the
+/// predicted parameters. Each measurement passing the chi2 cut creates a
+/// branch of the trajectory in the MultiTrajectory sharing the previous
+/// track states with its siblings. The most compatible branch is propagated
+/// further immediately, the others are resumed from their filtered
+/// parameters once the current branch left the detector. The number of
+/// branches is limited per surface and in total.
+///
+/// The trajectories contain filtered parameters only. As the track states
+/// of the common prefixes are shared, smoothing has to be done per
+/// candidate after the track finding, e.g. by refitting the found
+/// measurements with the KalmanFitter.
+template <typename propagator_t, typename updater_t = VoidKalmanUpdater,
+          typename calibrator_t = VoidMeasurementCalibrator>
+class CombinatorialKalmanFitter {
+ public:
+  /// Default constructor is deleted
+  CombinatorialKalmanFitter() = delete;
+
+  /// Constructor from arguments
+  CombinatorialKalmanFitter(propagator_t pPropagator,
+                            std::unique_ptr<const Logger> logger =
+                                getDefaultLogger("CombinatorialKalmanFilter",
+                                                 Logging::INFO))
+      : m_propagator(std::move(pPropagator)), m_logger(logger.release()) {}
+
+ private:
+  /// The propgator for the transport and material update
+  propagator_t m_propagator;
+
+  /// Logger getter to support macros
+  const Logger& logger() const { return *m_logger; }
+
+  /// Owned logging instance
+  std::shared_ptr<const Logger> m_logger;
+
+  /// @brief Propagator Actor plugin for the CombinatorialKalmanFilter
+  ///
+  /// @tparam source_link_t is an type fulfilling the @c SourceLinkConcept
+  /// @tparam parameters_t The type of parameters used for "local" paremeters.
+  template <typename source_link_t, typename parameters_t>
+  class Actor {
+   public:
+    /// Explicit constructor with updater and calibrator
+    Actor(updater_t pUpdater = updater_t(),
+          calibrator_t pCalibrator = calibrator_t())
+        : m_updater(std::move(pUpdater)),
+          m_calibrator(std::move(pCalibrator)) {}
+
+    /// Broadcast the result_type
+    using result_type = CombinatorialKalmanFitterResult<source_link_t>;
+
+    /// Allows retrieving measurements for a surface
+    std::map<const Surface*, std::vector<source_link_t>> inputMeasurements;
+
+    /// The maximum chi2 of a compatible measurement
+    double maxChi2 = 15.;
+
+    /// The maximum number of branches per surface
+    size_t maxBranchesPerSurface = 10;
+
+    /// The maximum number of track candidates
+    size_t maxCandidates = 100;
+
+    /// Whether to consider multiple scattering.
+    bool multipleScattering = true;
+
+    /// Whether to consider energy loss.
+    bool energyLoss = true;
+
+    /// @brief Combinatorial Kalman actor operation
+    ///
+    /// @tparam propagator_state_t is the type of Propagagor state
+    /// @tparam stepper_t Type of the stepper
+    ///
+    /// @param state is the mutable propagator state object
+    /// @param stepper The stepper in use
+    /// @param result is the mutable result state object
+    template <typename propagator_state_t, typename stepper_t>
+    void operator()(propagator_state_t& state, const stepper_t& stepper,
+                    result_type& result) const {
+      if (result.finished or not result.result.ok()) {
+        return;
+      }
+      ACTS_VERBOSE("CombinatorialKalmanFitter step");
+
+      if (!result.initialized) {
+        ACTS_VERBOSE("Initializing");
+        result.initialized = true;
+      }
+
+      // Update:
+      // - Waiting for a current surface, the surface a branch has been
+      //   resumed on has already been handled
+      auto surface = state.navigation.currentSurface;
+      if (surface != nullptr and surface != result.resumeSurface) {
+        auto res = filter(surface, state, stepper, result);
+        if (!res.ok()) {
+          ACTS_ERROR("Error in filter: " << res.error());
+          result.result = res.error();
+          return;
+        }
+      }
+      // The resume surface is only skipped until the branch has moved on,
+      // reaching it again later is a regular surface encounter
+      if (surface != result.resumeSurface) {
+        result.resumeSurface = nullptr;
+      }
+
+      // Finalization of the branch:
+      // when the navigation is breaked, store the branch as a track
+      // candidate and continue with the next pending branch
+      if (state.navigation.navigationBreak) {
+        finishBranch(result);
+        bool resumed = false;
+        while (not resumed and not result.pendingBranches.empty()) {
+          resumed = resume(state, stepper, result);
+          if (not resumed) {
+            finishBranch(result);
+          }
+        }
+        if (not resumed) {
+          ACTS_VERBOSE("All branches done, found " << result.tracks.size()
+                                                   << " track candidates");
+          result.finished = true;
+        }
+      }
+    }
+
+    /// @brief Combinatorial Kalman actor operation : finish the active branch
+    ///
+    /// @param result is the mutable result state object
+    void finishBranch(result_type& result) const {
+      // Branches without any measurement are no track candidates
+      if (result.activeBranch.measurementStates > 0) {
+        result.tracks.push_back(result.activeBranch);
+      }
+      result.activeBranch = CombinatorialKalmanFitterTipState();
+    }
+
+    /// @brief Combinatorial Kalman actor operation : resume a pending branch
+    ///
+    /// Resets the navigation and stepping state to the filtered parameters
+    /// of the last track state of the branch. On a surface with associated
+    /// layer, the navigation starts from this layer. Otherwise, e.g. on a
+    /// boundary surface, it starts from the layer at the branch position in
+    /// the volume the branch was created in, like a regular propagation.
+    ///
+    /// @tparam propagator_state_t is the type of Propagagor state
+    /// @tparam stepper_t Type of the stepper
+    ///
+    /// @param state is the mutable propagator state object
+    /// @param stepper The stepper in use
+    /// @param result is the mutable result state object
+    ///
+    /// @return false if the branch is now active but can not be propagated
+    template <typename propagator_state_t, typename stepper_t>
+    bool resume(propagator_state_t& state, const stepper_t& stepper,
+                result_type& result) const {
+      result.activeBranch = result.pendingBranches.back();
+      result.pendingBranches.pop_back();
+
+      auto st = result.fittedStates.getTrackState(
+          result.activeBranch.trackTip);
+      const Surface* surface = &st.referenceSurface();
+      auto filteredPars = st.filteredParameters(state.options.geoContext);
+      ACTS_VERBOSE("Resume branch on surface " << surface->geoID());
+
+      const Layer* layer = surface->associatedLayer();
+      const TrackingVolume* volume = (layer != nullptr)
+                                         ? layer->trackingVolume()
+                                         : result.activeBranch.volume;
+      if (volume == nullptr) {
+        ACTS_WARNING("No tracking volume to resume the branch on surface "
+                     << surface->geoID() << ", it is not propagated further");
+        return false;
+      }
+      // The navigator needs a start layer to resolve the layers ahead
+      if (layer == nullptr) {
+        layer = volume->associatedLayer(state.options.geoContext,
+                                        filteredPars.position());
+      }
+
+      // Set the navigation state
+      state.navigation = typename propagator_t::NavigatorState();
+      state.navigation.startSurface = surface;
+      state.navigation.startLayer = layer;
+      state.navigation.startVolume = volume;
+      state.navigation.currentSurface = surface;
+      state.navigation.currentVolume = volume;
+
+      // Update the stepping state
+      stepper.update(state.stepping, filteredPars);
+      state.stepping.stepSize = ConstrainedStep(state.options.maxStepSize);
+      state.stepping.pathAccumulated = 0.;
+      // Reinitialize the stepping jacobian
+      surface->initJacobianToGlobal(
+          state.options.geoContext, state.stepping.jacToGlobal,
+          state.stepping.pos, state.stepping.dir, filteredPars.parameters());
+      state.stepping.jacobian = BoundMatrix::Identity();
+      state.stepping.jacTransport = FreeMatrix::Identity();
+      state.stepping.derivative = FreeVector::Zero();
+
+      // The material after the update has not been applied to this branch
+      materialInteractor(surface, state, stepper, postUpdate);
+      result.resumeSurface = surface;
+      return true;
+    }
+
+    /// @brief Combinatorial Kalman actor operation : update
+    ///
+    /// @tparam propagator_state_t is the type of Propagagor state
+    /// @tparam stepper_t Type of the stepper
+    ///
+    /// @param surface The surface where the update happens
+    /// @param state The mutable propagator state object
+    /// @param stepper The stepper in use
+    /// @param result The mutable result state object
+    template <typename propagator_state_t, typename stepper_t>
+    Result<void> filter(const Surface* surface, propagator_state_t& state,
+                        const stepper_t& stepper, result_type& result) const {
+      // Try to find the surface in the measurement surfaces
+      auto sourcelinks_it = inputMeasurements.find(surface);
+      if (sourcelinks_it != inputMeasurements.end()) {
+        // Screen output message
+        ACTS_VERBOSE("Measurement surface " << surface->geoID()
+                                            << " detected.");
+
+        // Update state and stepper with pre material effects
+        materialInteractor(surface, state, stepper, preUpdate);
+
+        // Transport & bind the state to the current surface
+        auto [boundParams, jacobian, pathLength] =
+            stepper.boundState(state.stepping, *surface, true);
+
+        // Collect the compatible measurements
+        selectMeasurements(boundParams, sourcelinks_it->second, result);
+        auto& compatible = result.compatibleMeasurements;
+
+        if (compatible.empty()) {
+          ACTS_VERBOSE("No compatible measurement on " << surface->geoID());
+          addHoleOrMaterialState(surface, state, stepper, result);
+          materialInteractor(surface, state, stepper, postUpdate);
+          return Result<void>::success();
+        }
+
+        // Apply the branch budgets. The active branch is counted as well.
+        size_t nCandidates = result.tracks.size() +
+                             result.pendingBranches.size() + 1;
+        size_t nBranches = std::min(compatible.size(), maxBranchesPerSurface);
+        if (nCandidates < maxCandidates) {
+          nBranches = std::min(nBranches, 1 + maxCandidates - nCandidates);
+        } else {
+          nBranches = std::min<size_t>(nBranches, 1);
+        }
+        ACTS_VERBOSE("Found " << compatible.size()
+                              << " compatible measurements, creating "
+                              << nBranches << " branches");
+
+        // All branches share the track states up to here
+        const CombinatorialKalmanFitterTipState parent = result.activeBranch;
+        size_t ipredicted = detail_lt::IndexData::kInvalid;
+        size_t ijacobian = detail_lt::IndexData::kInvalid;
+        for (size_t ib = 0; ib < nBranches; ++ib) {
+          // The predicted parameters and the jacobian are shared as well
+          auto mask = TrackStatePropMask::All;
+          if (ib > 0) {
+            mask &= ~(TrackStatePropMask::Predicted |
+                      TrackStatePropMask::Jacobian);
+          }
+          size_t tip =
+              result.fittedStates.addTrackState(mask, parent.trackTip);
+          auto trackStateProxy = result.fittedStates.getTrackState(tip);
+
+          if (ib == 0) {
+            trackStateProxy.predicted() = boundParams.parameters();
+            trackStateProxy.predictedCovariance() = *boundParams.covariance();
+            trackStateProxy.jacobian() = jacobian;
+            ipredicted = trackStateProxy.data().ipredicted;
+            ijacobian = trackStateProxy.data().ijacobian;
+          } else {
+            trackStateProxy.data().ipredicted = ipredicted;
+            trackStateProxy.data().ijacobian = ijacobian;
+          }
+          trackStateProxy.pathLength() = pathLength;
+
+          // assign the source link and the measurement calibrated during
+          // the selection to the track state
+          trackStateProxy.uncalibrated() = compatible[ib].sourceLink;
+          std::visit(
+              [&](const auto& calibrated) {
+                trackStateProxy.setCalibrated(calibrated);
+              },
+              compatible[ib].calibrated);
+
+          // Get and set the type flags
+          auto& typeFlags = trackStateProxy.typeFlags();
+          typeFlags.set(TrackStateFlag::MaterialFlag);
+          typeFlags.set(TrackStateFlag::ParameterFlag);
+          typeFlags.set(TrackStateFlag::MeasurementFlag);
+
+          auto updateRes =
+              m_updater(state.geoContext, trackStateProxy, forward);
+          if (!updateRes.ok()) {
+            ACTS_ERROR("Update step failed: " << updateRes.error());
+            return updateRes.error();
+          }
+
+          CombinatorialKalmanFitterTipState branch = parent;
+          branch.trackTip = tip;
+          branch.volume = state.navigation.currentVolume;
+          ++branch.measurementStates;
+          if (ib == 0) {
+            result.activeBranch = branch;
+          } else {
+            result.pendingBranches.push_back(branch);
+          }
+          ++result.processedStates;
+        }
+
+        // Continue with the most compatible branch
+        auto activeState =
+            result.fittedStates.getTrackState(result.activeBranch.trackTip);
+        ACTS_VERBOSE("Filtering step successful, updated parameters are : \n"
+                     << activeState.filtered().transpose());
+        stepper.update(state.stepping, activeState.filteredParameters(
+                                           state.options.geoContext));
+
+        // Update state and stepper with post material effects
+        materialInteractor(surface, state, stepper, postUpdate);
+      } else if (surface->surfaceMaterial() != nullptr) {
+        addHoleOrMaterialState(surface, state, stepper, result);
+        // Update state and stepper with material effects
+        materialInteractor(surface, state, stepper, fullUpdate);
+      }
+      return Result<void>::success();
+    }
+
+    /// @brief Combinatorial Kalman actor operation : measurement selection
+    ///
+    /// Evaluates the chi2 of all measurements on a surface with respect to
+    /// the predicted parameters and keeps the compatible ones, sorted by
+    /// increasing chi2, together with their calibration.
+    ///
+    /// @param boundParams The predicted parameters on the surface
+    /// @param sourcelinks The measurements on the surface
+    /// @param result The mutable result state object
+    void selectMeasurements(const BoundParameters& boundParams,
+                            const std::vector<source_link_t>& sourcelinks,
+                            result_type& result) const {
+      const auto& predicted = boundParams.parameters();
+      const auto& predictedCovariance = *boundParams.covariance();
+
+      auto& compatible = result.compatibleMeasurements;
+      compatible.clear();
+      for (const auto& sl : sourcelinks) {
+        auto calibrated = m_calibrator(sl, predicted);
+        double chi2 = std::visit(
+            [&](const auto& calibrated) {
+              constexpr size_t measdim =
+                  std::decay_t<decltype(calibrated)>::size();
+              const ActsMatrixD<measdim, eBoundParametersSize> H =
+                  calibrated.projector();
+              const ActsVectorD<measdim> residual =
+                  calibrated.parameters() - H * predicted;
+              const ActsSymMatrixD<measdim> residualCovariance =
+                  H * predictedCovariance * H.transpose() +
+                  calibrated.covariance();
+              return (residual.transpose() * residualCovariance.inverse() *
+                      residual)
+                  .value();
+            },
+            calibrated);
+        ACTS_VERBOSE("Measurement chi2: " << chi2);
+        // negated comparison, a NaN is never compatible
+        if (chi2 <= maxChi2) {
+          compatible.push_back({chi2, sl, std::move(calibrated)});
+        }
+      }
+      // the stable sort keeps the input order for equal chi2
+      std::stable_sort(
+          compatible.begin(), compatible.end(),
+          [](const auto& a, const auto& b) { return a.chi2 < b.chi2; });
+    }
+
+    /// @brief Combinatorial Kalman actor operation : hole or material state
+    ///
+    /// Adds a track state without measurement to the active branch, if the
+    /// branch has already a measurement.
+    ///
+    /// @tparam propagator_state_t is the type of Propagagor state
+    /// @tparam stepper_t Type of the stepper
+    ///
+    /// @param surface The surface of the track state
+    /// @param state The mutable propagator state object
+    /// @param stepper The stepper in use
+    /// @param result The mutable result state object
+    template <typename propagator_state_t, typename stepper_t>
+    void addHoleOrMaterialState(const Surface* surface,
+                                propagator_state_t& state,
+                                const stepper_t& stepper,
+                                result_type& result) const {
+      auto& branch = result.activeBranch;
+      if (branch.measurementStates == 0) {
+        return;
+      }
+      // No storage allocation for uncalibrated/calibrated measurement and
+      // filtered parameter
+      branch.trackTip = result.fittedStates.addTrackState(
+          ~(TrackStatePropMask::Uncalibrated | TrackStatePropMask::Calibrated |
+            TrackStatePropMask::Filtered),
+          branch.trackTip);
+
+      auto trackStateProxy = result.fittedStates.getTrackState(branch.trackTip);
+      trackStateProxy.setReferenceSurface(surface->getSharedPtr());
+
+      // Set the track state flags
+      auto& typeFlags = trackStateProxy.typeFlags();
+      typeFlags.set(TrackStateFlag::MaterialFlag);
+      typeFlags.set(TrackStateFlag::ParameterFlag);
+
+      if (surface->associatedDetectorElement() != nullptr) {
+        ACTS_VERBOSE("Detected hole on " << surface->geoID());
+        typeFlags.set(TrackStateFlag::HoleFlag);
+        ++branch.holeStates;
+
+        // Transport & bind the state to the current surface
+        auto [boundParams, jacobian, pathLength] =
+            stepper.boundState(state.stepping, *surface, true);
+        trackStateProxy.predicted() = boundParams.parameters();
+        trackStateProxy.predictedCovariance() = *boundParams.covariance();
+        trackStateProxy.jacobian() = jacobian;
+        trackStateProxy.pathLength() = pathLength;
+      } else {
+        ACTS_VERBOSE("Detected in-sensitive surface " << surface->geoID());
+
+        // Transport & get curvilinear state instead of bound state
+        auto [curvilinearParams, jacobian, pathLength] =
+            stepper.curvilinearState(state.stepping, true);
+        trackStateProxy.predicted() = curvilinearParams.parameters();
+        trackStateProxy.predictedCovariance() =
+            *curvilinearParams.covariance();
+        trackStateProxy.jacobian() = jacobian;
+        trackStateProxy.pathLength() = pathLength;
+      }
+
+      // Set the filtered parameter index to be the same with predicted
+      // parameter
+      trackStateProxy.data().ifiltered = trackStateProxy.data().ipredicted;
+
+      ++result.processedStates;
+    }
+
+    /// @brief Combinatorial Kalman actor operation : material interaction
+    ///
+    /// @tparam propagator_state_t is the type of Propagagor state
+    /// @tparam stepper_t Type of the stepper
+    ///
+    /// @param surface The surface where the material interaction happens
+    /// @param state The mutable propagator state object
+    /// @param stepper The stepper in use
+    /// @param updateStage The materal update stage
+    template <typename propagator_state_t, typename stepper_t>
+    void materialInteractor(
+        const Surface* surface, propagator_state_t& state,
+        const stepper_t& stepper,
+        const MaterialUpdateStage& updateStage = fullUpdate) const {
+      if (surface and surface->surfaceMaterial()) {
+        // Prepare relevant input particle properties
+        detail::PointwiseMaterialInteraction interaction(surface, state,
+                                                         stepper);
+        // Evaluate the material properties
+        if (interaction.evaluateMaterialProperties(state, updateStage)) {
+          // Evaluate the material effects
+          interaction.evaluatePointwiseMaterialInteraction(multipleScattering,
+                                                           energyLoss);
+          // Update the state and stepper with material effects
+          interaction.updateState(state, stepper);
+        }
+      }
+    }
+
+    /// Pointer to a logger that is owned by the parent,
+    /// CombinatorialKalmanFilter
+    const Logger* m_logger;
+
+    /// Getter for the logger, to support logging macros
+    const Logger& logger() const { return *m_logger; }
+
+    /// The Kalman updater
+    updater_t m_updater;
+
+    /// The Measuremetn calibrator
+    calibrator_t m_calibrator;
+  };
+
+  template <typename source_link_t, typename parameters_t>
+  class Aborter {
+   public:
+    /// Broadcast the result_type
+    using action_type = Actor<source_link_t, parameters_t>;
+
+    template <typename propagator_state_t, typename stepper_t,
+              typename result_t>
+    bool operator()(propagator_state_t& /*state*/, const stepper_t& /*stepper*/,
+                    const result_t& result) const {
+      if (!result.result.ok() or result.finished) {
+        return true;
+      }
+      return false;
+    }
+  };
+
+ public:
+  /// Track finding implementation, finds and filters all track candidates
+  /// compatible with the start parameters in a single propagation
+  ///
+  /// @tparam source_link_t Source link type identifying uncalibrated input
+  /// measurements.
+  /// @tparam start_parameters_t Type of the initial parameters
+  /// @tparam parameters_t Type of parameters used for local parameters
+  ///
+  /// @param sourcelinks The uncalibrated measurements to search in
+  /// @param sParameters The initial track parameters, e.g. from a seed
+  /// @param ckfOptions CombinatorialKalmanFitterOptions steering the search
+  /// @note The input measurements are given in the form of @c SourceLinks. It's
+  /// @c calibrator_t's job to turn them into calibrated measurements used in
+  /// the fit.
+  ///
+  /// @return the track candidates sharing one MultiTrajectory
+  template <typename source_link_t, typename start_parameters_t,
+            typename parameters_t = BoundParameters>
+  Result<CombinatorialKalmanFitterResult<source_link_t>> findTracks(
+      const std::vector<source_link_t>& sourcelinks,
+      const start_parameters_t& sParameters,
+      const CombinatorialKalmanFitterOptions& ckfOptions) const {
+    static_assert(SourceLinkConcept<source_link_t>,
+                  "Source link does not fulfill SourceLinkConcept");
+
+    // To be able to find measurements later, we put them into a map
+    ACTS_VERBOSE("Preparing " << sourcelinks.size() << " input measurements");
+    std::map<const Surface*, std::vector<source_link_t>> inputMeasurements;
+    for (const auto& sl : sourcelinks) {
+      const Surface* srf = &sl.referenceSurface();
+      inputMeasurements[srf].push_back(sl);
+    }
+
+    // Create the ActionList and AbortList
+    using CombinatorialKalmanAborter = Aborter<source_link_t, parameters_t>;
+    using CombinatorialKalmanActor = Actor<source_link_t, parameters_t>;
+    using CombinatorialKalmanResult =
+        typename CombinatorialKalmanActor::result_type;
+    using Actors = ActionList<CombinatorialKalmanActor>;
+    using Aborters = AbortList<CombinatorialKalmanAborter>;
+
+    // Create relevant options for the propagation options
+    PropagatorOptions<Actors, Aborters> propOptions(ckfOptions.geoContext,
+                                                    ckfOptions.magFieldContext);
+    // The step budget is shared by all branches
+    propOptions.maxSteps *= std::max<size_t>(1, ckfOptions.maxCandidates);
+
+    // Catch the actor and set the measurements
+    auto& ckfActor =
+        propOptions.actionList.template get<CombinatorialKalmanActor>();
+    ckfActor.m_logger = m_logger.get();
+    ckfActor.inputMeasurements = std::move(inputMeasurements);
+    ckfActor.maxChi2 = ckfOptions.maxChi2;
+    ckfActor.maxBranchesPerSurface =
+        std::max<size_t>(1, ckfOptions.maxBranchesPerSurface);
+    ckfActor.maxCandidates = ckfOptions.maxCandidates;
+    ckfActor.multipleScattering = ckfOptions.multipleScattering;
+    ckfActor.energyLoss = ckfOptions.energyLoss;
+
+    // also set logger on updater
+    ckfActor.m_updater.m_logger = m_logger;
+
+    // Run the track finding
+    auto result = m_propagator.template propagate(sParameters, propOptions);
+
+    if (!result.ok()) {
+      return result.error();
+    }
+
+    const auto& propRes = *result;
+
+    /// Get the result of the track finding
+    auto ckfResult = propRes.template get<CombinatorialKalmanResult>();
+
+    if (!ckfResult.result.ok()) {
+      return ckfResult.result.error();
+    }
+
+    /// If the propagation was stopped before all branches were done, keep
+    /// the unfinished branches as (shorter) track candidates
+    if (not ckfResult.finished) {
+      ACTS_DEBUG("Propagation stopped with "
+                 << ckfResult.pendingBranches.size() + 1
+                 << " unfinished branches");
+      ckfActor.finishBranch(ckfResult);
+      for (const auto& branch : ckfResult.pendingBranches) {
+        ckfResult.tracks.push_back(branch);
+      }
+      ckfResult.pendingBranches.clear();
+    }
+
+    /// It could happen that no compatible measurement was found.
+    /// The result gets meaningless so such case is regarded as failure.
+    if (ckfResult.tracks.empty()) {
+      return KalmanFitterError::PropagationInVain;
+    }
+
+    return std::move(ckfResult);
+  }
+};
+
+}  // namespace Acts
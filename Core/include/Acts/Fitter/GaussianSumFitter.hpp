@@ -0,0 +1,754 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/EventData/Measurement.hpp"
+#include "Acts/EventData/MeasurementHelpers.hpp"
+#include "Acts/EventData/MultiTrajectory.hpp"
+#include "Acts/EventData/TrackParameters.hpp"
+#include "Acts/EventData/TrackState.hpp"
+#include "Acts/Fitter/KalmanFitterError.hpp"
+#include "Acts/Fitter/detail/GaussianMixture.hpp"
+#include "Acts/Fitter/detail/VoidKalmanComponents.hpp"
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/MagneticField/MagneticFieldContext.hpp"
+#include "Acts/Material/BetheHeitlerApprox.hpp"
+#include "Acts/Material/Interactions.hpp"
+#include "Acts/Propagator/AbortList.hpp"
+#include "Acts/Propagator/ActionList.hpp"
+#include "Acts/Propagator/Propagator.hpp"
+#include "Acts/Propagator/detail/PointwiseMaterialInteraction.hpp"
+#include "Acts/Utilities/CalibrationContext.hpp"
+#include "Acts/Utilities/Definitions.hpp"
+#include "Acts/Utilities/Logger.hpp"
+#include "Acts/Utilities/Result.hpp"
+#include "Acts/Utilities/Units.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace Acts {
+
+/// @brief Options struct how the GaussianSumFitter is called
+///
+/// It contains the context of the fitter call, the limits of the mixture
+/// and configurations for material effects.
+///
+/// @note the context objects must be provided
+struct GaussianSumFitterOptions {
+  /// Deleted default constructor
+  GaussianSumFitterOptions() = delete;
+
+  /// PropagatorOptions with context
+  ///
+  /// @param gctx The goemetry context for this fit
+  /// @param mctx The magnetic context for this fit
+  /// @param cctx The calibration context for this fit
+  /// @param nComponents The maximum number of components of the mixture
+  /// @param mScattering Whether to include multiple scattering
+  /// @param eLoss Whether to include energy loss
+  GaussianSumFitterOptions(
+      std::reference_wrapper<const GeometryContext> gctx,
+      std::reference_wrapper<const MagneticFieldContext> mctx,
+      std::reference_wrapper<const CalibrationContext> cctx,
+      size_t nComponents = 12, bool mScattering = true, bool eLoss = true)
+      : geoContext(gctx),
+        magFieldContext(mctx),
+        calibrationContext(cctx),
+        maxComponents(nComponents),
+        multipleScattering(mScattering),
+        energyLoss(eLoss) {}
+
+  /// Context object for the geometry
+  std::reference_wrapper<const GeometryContext> geoContext;
+  /// Context object for the magnetic field
+  std::reference_wrapper<const MagneticFieldContext> magFieldContext;
+  /// context object for the calibration
+  std::reference_wrapper<const CalibrationContext> calibrationContext;
+
+  /// The maximum number of components kept after each surface
+  size_t maxComponents = 12;
+
+  /// Components with a smaller weight after a measurement update are dropped
+  double minComponentWeight = 1e-4;
+
+  /// Whether to consider multiple scattering
+  bool multipleScattering = true;
+
+  /// Whether to consider energy loss, i.e. ionisation and, for electrons,
+  /// bremsstrahlung
+  bool energyLoss = true;
+
+  /// The particle mass and PDG code, the mixture approximation of the
+  /// bremsstrahlung is only applied to electrons
+  double mass = 0.51099891 * UnitConstants::MeV;
+  int absPdgCode = 11;
+};
+
+template <typename source_link_t>
+struct GaussianSumFitterResult {
+  // Fitted states that the actor has handled. The parameters of every
+  // track state are the mean and covariance of the mixture.
+  MultiTrajectory<source_link_t> fittedStates;
+
+  // This is the index of the 'tip' of the track stored in multitrajectory.
+  size_t trackTip = SIZE_MAX;
+
+  // The combined filtered parameters on the last measurement surface
+  std::optional<BoundParameters> fittedParameters;
+
+  // The mixture of the filtered parameters on the last measurement surface
+  std::vector<detail::GaussianComponent> fittedComponents;
+
+  // Counter for states with measurements
+  size_t measurementStates = 0;
+
+  // Counter for handled states
+  size_t processedStates = 0;
+
+  // Indicator if initialization has been performed.
+  bool initialized = false;
+
+  // Indicator if all measurements have been handled
+  bool finished = false;
+
+  // Measurement surfaces without hits
+  std::vector<const Surface*> missedActiveSurfaces;
+
+  // The mixture on the last handled surface
+  std::vector<detail::GaussianComponent> components;
+
+  // Scratch buffers for the material effects, the component reduction and
+  // the update of the stepper
+  std::vector<detail::GaussianComponent> componentsBuffer;
+  std::vector<BetheHeitlerApprox::Component> betheHeitlerBuffer;
+  std::vector<std::pair<size_t, double>> neighboursBuffer;
+  std::vector<BoundParameters> parametersBuffer;
+  std::vector<double> weightsBuffer;
+
+  Result<void> result{Result<void>::success()};
+};
+
+/// @brief Gaussian sum filter implementation of Acts as a plugin to the
+/// Propagator
+///
+/// @tparam propagator_t Type of the propagation class, its stepper has to
+///         propagate a bundle of tracks (see MultiEigenStepper)
+/// @tparam calibrator_t Type of the calibrator class
+///
+/// The Gaussian sum filter (GSF) describes the track parameters by a
+/// weighted mixture of Gaussian components instead of a single one. For
+/// electrons the energy loss by bremsstrahlung on every material surface is
+/// approximated by a mixture (see BetheHeitlerApprox), i.e. each component
+/// is split into several components. A measurement updates every component
+/// with the Kalman formalism and reweights it with its compatibility. After
+/// each surface the mixture is reduced to a bounded number of components by
+/// merging the closest pairs, such that the runtime stays predictable.
+///
+/// Every component is a track of the bundle stepper, i.e. the components are
+/// propagated individually with their own transport jacobians. On each
+/// surface the components are taken from the stepper and handed back to it
+/// after the material effects, the update and the reduction.
+///
+/// The GSF runs the forward filter only, there is no smoother. The fitted
+/// parameters are those on the last measurement surface.
+template <typename propagator_t,
+          typename calibrator_t = VoidMeasurementCalibrator>
+class GaussianSumFitter {
+ public:
+  /// Default constructor is deleted
+  GaussianSumFitter() = delete;
+
+  /// Constructor from arguments
+  ///
+  /// @param pPropagator The propagator
+  /// @param betheHeitler The mixture approximation of the bremsstrahlung
+  /// @param logger The logging instance
+  GaussianSumFitter(propagator_t pPropagator,
+                    BetheHeitlerApprox betheHeitler = BetheHeitlerApprox(),
+                    std::unique_ptr<const Logger> logger =
+                        getDefaultLogger("GaussianSumFilter", Logging::INFO))
+      : m_propagator(std::move(pPropagator)),
+        m_betheHeitler(std::move(betheHeitler)),
+        m_logger(logger.release()) {}
+
+ private:
+  /// The propgator for the transport and material update
+  propagator_t m_propagator;
+
+  /// The bremsstrahlung approximation
+  BetheHeitlerApprox m_betheHeitler;
+
+  /// Logger getter to support macros
+  const Logger& logger() const { return *m_logger; }
+
+  /// Owned logging instance
+  std::shared_ptr<const Logger> m_logger;
+
+  /// @brief Propagator Actor plugin for the GaussianSumFilter
+  ///
+  /// @tparam source_link_t is an type fulfilling the @c SourceLinkConcept
+  template <typename source_link_t>
+  class Actor {
+   public:
+    /// Explicit constructor with calibrator
+    Actor(calibrator_t pCalibrator = calibrator_t())
+        : m_calibrator(std::move(pCalibrator)) {}
+
+    /// Broadcast the result_type
+    using result_type = GaussianSumFitterResult<source_link_t>;
+
+    /// Allows retrieving measurements for a surface
+    std::map<const Surface*, source_link_t> inputMeasurements;
+
+    /// The maximum number of components
+    size_t maxComponents = 12;
+
+    /// The minimum weight of a component after a measurement update
+    double minComponentWeight = 1e-4;
+
+    /// Whether to consider multiple scattering.
+    bool multipleScattering = true;
+
+    /// Whether to consider energy loss.
+    bool energyLoss = true;
+
+    /// @brief Gaussian sum actor operation
+    ///
+    /// @tparam propagator_state_t is the type of Propagagor state
+    /// @tparam stepper_t Type of the stepper
+    ///
+    /// @param state is the mutable propagator state object
+    /// @param stepper The stepper in use
+    /// @param result is the mutable result state object
+    template <typename propagator_state_t, typename stepper_t>
+    void operator()(propagator_state_t& state, const stepper_t& stepper,
+                    result_type& result) const {
+      if (result.finished or not result.result.ok()) {
+        return;
+      }
+      ACTS_VERBOSE("GaussianSumFitter step");
+
+      // Initialization:
+      // - The mixture starts with a single component
+      if (!result.initialized) {
+        ACTS_VERBOSE("Initializing");
+        auto res = initialize(state, stepper, result);
+        if (!res.ok()) {
+          result.result = res.error();
+          return;
+        }
+        result.initialized = true;
+      }
+
+      // Update:
+      // - Waiting for a current surface with a measurement or material
+      auto surface = state.navigation.currentSurface;
+      if (surface != nullptr and state.stepping.navDir == forward) {
+        auto res = filter(surface, state, stepper, result);
+        if (!res.ok()) {
+          ACTS_ERROR("Error in filter: " << res.error());
+          result.result = res.error();
+          return;
+        }
+      }
+
+      // Finalization:
+      // when all measurements have been handled or the navigation is breaked
+      if (result.measurementStates == inputMeasurements.size() or
+          state.navigation.navigationBreak) {
+        finalize(state, result);
+      }
+    }
+
+    /// @brief Gaussian sum actor operation : initialize
+    ///
+    /// @tparam propagator_state_t is the type of Propagagor state
+    /// @tparam stepper_t Type of the stepper
+    ///
+    /// @param state is the mutable propagator state object
+    /// @param stepper The stepper in use
+    /// @param result is the mutable result state object
+    template <typename propagator_state_t, typename stepper_t>
+    Result<void> initialize(propagator_state_t& state, const stepper_t& stepper,
+                            result_type& result) const {
+      if (not state.stepping.covTransport) {
+        ACTS_ERROR("Start parameters without covariance");
+        return KalmanFitterError::ForwardUpdateFailed;
+      }
+      result.fittedStates.reserve(inputMeasurements.size());
+      // The mixture starts with the tracks of the stepper
+      result.components.clear();
+      for (size_t i = 0; i < stepper.size(state.stepping); ++i) {
+        auto [curvilinearParams, jacobian, pathLength] =
+            stepper.curvilinearState(state.stepping, i, true);
+        detail::GaussianComponent cmp;
+        cmp.weight = stepper.weight(state.stepping, i);
+        cmp.parameters = curvilinearParams.parameters();
+        cmp.covariance = *curvilinearParams.covariance();
+        result.components.push_back(std::move(cmp));
+      }
+      return Result<void>::success();
+    }
+
+    /// @brief Gaussian sum actor operation : update
+    ///
+    /// @tparam propagator_state_t is the type of Propagagor state
+    /// @tparam stepper_t Type of the stepper
+    ///
+    /// @param surface The surface where the update happens
+    /// @param state The mutable propagator state object
+    /// @param stepper The stepper in use
+    /// @param result The mutable result state object
+    template <typename propagator_state_t, typename stepper_t>
+    Result<void> filter(const Surface* surface, propagator_state_t& state,
+                        const stepper_t& stepper, result_type& result) const {
+      auto sourcelink_it = inputMeasurements.find(surface);
+      const bool hasMeasurement = (sourcelink_it != inputMeasurements.end());
+      const bool hasMaterial = (surface->surfaceMaterial() != nullptr);
+      if (not hasMeasurement and not hasMaterial) {
+        return Result<void>::success();
+      }
+      const bool isSensitive =
+          hasMeasurement or (surface->associatedDetectorElement() != nullptr);
+
+      // The components are the tracks of the stepper bound to the surface,
+      // the jacobian and the path length are the weighted means of theirs
+      result.components.clear();
+      BoundMatrix jacobian = BoundMatrix::Zero();
+      double pathLength = 0.;
+      for (size_t i = 0; i < stepper.size(state.stepping); ++i) {
+        auto [boundParams, jac, path] =
+            stepper.boundState(state.stepping, i, *surface, true);
+        detail::GaussianComponent cmp;
+        cmp.weight = stepper.weight(state.stepping, i);
+        cmp.parameters = boundParams.parameters();
+        cmp.covariance = *boundParams.covariance();
+        jacobian += cmp.weight * jac;
+        pathLength += cmp.weight * path;
+        result.components.push_back(std::move(cmp));
+      }
+      BoundVector mean;
+      BoundSymMatrix covariance;
+      detail::combineComponents(result.components, mean, covariance);
+
+      if (hasMeasurement) {
+        ACTS_VERBOSE("Measurement surface " << surface->geoID()
+                                            << " detected.");
+        // add a full TrackState entry multi trajectory
+        result.trackTip = result.fittedStates.addTrackState(
+            TrackStatePropMask::All, result.trackTip);
+        auto trackStateProxy =
+            result.fittedStates.getTrackState(result.trackTip);
+
+        // assign the source link and the predicted mixture to the track state
+        trackStateProxy.uncalibrated() = sourcelink_it->second;
+        trackStateProxy.predicted() = mean;
+        trackStateProxy.predictedCovariance() = covariance;
+        trackStateProxy.jacobian() = jacobian;
+        trackStateProxy.pathLength() = pathLength;
+
+        // Calibrate with the mean, update all components and store the
+        // combined filtered parameters
+        auto updateRes = std::visit(
+            [&](const auto& calibrated) -> Result<void> {
+              trackStateProxy.setCalibrated(calibrated);
+              auto res = update(calibrated, result);
+              if (res.ok()) {
+                detail::combineComponents(result.components, mean,
+                                          covariance);
+                trackStateProxy.chi2() =
+                    filteredChi2(calibrated, mean, covariance);
+              }
+              return res;
+            },
+            m_calibrator(trackStateProxy.uncalibrated(), mean));
+        if (!updateRes.ok()) {
+          return updateRes.error();
+        }
+        trackStateProxy.filtered() = mean;
+        trackStateProxy.filteredCovariance() = covariance;
+
+        auto& typeFlags = trackStateProxy.typeFlags();
+        typeFlags.set(TrackStateFlag::MaterialFlag);
+        typeFlags.set(TrackStateFlag::ParameterFlag);
+        typeFlags.set(TrackStateFlag::MeasurementFlag);
+        ACTS_VERBOSE("Filtering step successful with "
+                     << result.components.size()
+                     << " components, updated parameters are : \n"
+                     << mean.transpose());
+
+        ++result.measurementStates;
+        ++result.processedStates;
+
+        // Keep the mixture on the last measurement surface
+        if (result.measurementStates == inputMeasurements.size()) {
+          result.fittedParameters = BoundParameters(
+              state.options.geoContext, covariance, mean,
+              surface->getSharedPtr());
+          result.fittedComponents = result.components;
+          return Result<void>::success();
+        }
+      } else if (result.measurementStates > 0) {
+        // No source link on surface, add either hole or passive material
+        // TrackState entry multi trajectory
+        result.trackTip = result.fittedStates.addTrackState(
+            ~(TrackStatePropMask::Uncalibrated |
+              TrackStatePropMask::Calibrated | TrackStatePropMask::Filtered),
+            result.trackTip);
+        auto trackStateProxy =
+            result.fittedStates.getTrackState(result.trackTip);
+        trackStateProxy.setReferenceSurface(surface->getSharedPtr());
+        trackStateProxy.predicted() = mean;
+        trackStateProxy.predictedCovariance() = covariance;
+        trackStateProxy.jacobian() = jacobian;
+        trackStateProxy.pathLength() = pathLength;
+        trackStateProxy.data().ifiltered = trackStateProxy.data().ipredicted;
+
+        auto& typeFlags = trackStateProxy.typeFlags();
+        typeFlags.set(TrackStateFlag::MaterialFlag);
+        typeFlags.set(TrackStateFlag::ParameterFlag);
+        if (isSensitive) {
+          ACTS_VERBOSE("Detected hole on " << surface->geoID());
+          typeFlags.set(TrackStateFlag::HoleFlag);
+          result.missedActiveSurfaces.push_back(surface);
+        } else {
+          ACTS_VERBOSE("Detected in-sensitive surface " << surface->geoID());
+        }
+        ++result.processedStates;
+      }
+
+      // Apply the material effects to the components and reduce the mixture
+      if (hasMaterial) {
+        materialInteractor(surface, state, stepper, result);
+      }
+      detail::reduceMixture(result.components, maxComponents,
+                            result.neighboursBuffer);
+      detail::normalizeWeights(result.components);
+
+      // Continue the propagation with the components of the mixture
+      auto& parameters = result.parametersBuffer;
+      auto& weights = result.weightsBuffer;
+      parameters.clear();
+      weights.clear();
+      for (const auto& cmp : result.components) {
+        parameters.emplace_back(state.options.geoContext, cmp.covariance,
+                                cmp.parameters, surface->getSharedPtr());
+        weights.push_back(cmp.weight);
+      }
+      stepper.update(state.stepping, parameters, weights);
+      return Result<void>::success();
+    }
+
+    /// @brief Gaussian sum actor operation : component update
+    ///
+    /// Updates every component with the Kalman formalism and reweights it
+    /// with the likelihood of the measurement given the component.
+    ///
+    /// @tparam measurement_t Type of the calibrated measurement
+    ///
+    /// @param calibrated The calibrated measurement
+    /// @param result The mutable result state object
+    template <typename measurement_t>
+    Result<void> update(const measurement_t& calibrated,
+                        result_type& result) const {
+      constexpr size_t measdim = measurement_t::size();
+      using CovMatrix = ActsSymMatrixD<measdim>;
+      using ParVector = ActsVectorD<measdim>;
+
+      const ActsMatrixD<measdim, eBoundParametersSize> H =
+          calibrated.projector();
+      const ParVector measured = calibrated.parameters();
+      const CovMatrix measuredCovariance = calibrated.covariance();
+
+      // The likelihoods are accumulated as logarithms to avoid underflows
+      double maxLogWeight = -std::numeric_limits<double>::infinity();
+      for (auto& cmp : result.components) {
+        const CovMatrix S =
+            H * cmp.covariance * H.transpose() + measuredCovariance;
+        const CovMatrix SInv = S.inverse();
+        const ActsMatrixD<eBoundParametersSize, measdim> K =
+            cmp.covariance * H.transpose() * SInv;
+        const ParVector residual = measured - H * cmp.parameters;
+
+        cmp.parameters += K * residual;
+        cmp.covariance =
+            (BoundSymMatrix::Identity() - K * H) * cmp.covariance;
+
+        const double chi2 = (residual.transpose() * SInv * residual).value();
+        cmp.weight = std::log(cmp.weight) - 0.5 * chi2 -
+                     0.5 * std::log(S.determinant());
+        maxLogWeight = std::max(maxLogWeight, cmp.weight);
+      }
+      if (not std::isfinite(maxLogWeight)) {
+        ACTS_ERROR("Component update failed");
+        return KalmanFitterError::ForwardUpdateFailed;
+      }
+      for (auto& cmp : result.components) {
+        cmp.weight = std::exp(cmp.weight - maxLogWeight);
+      }
+      detail::normalizeWeights(result.components);
+
+      // Drop the components incompatible with the measurement
+      result.components.erase(
+          std::remove_if(result.components.begin(), result.components.end(),
+                         [&](const auto& cmp) {
+                           return cmp.weight < minComponentWeight;
+                         }),
+          result.components.end());
+      detail::normalizeWeights(result.components);
+      return Result<void>::success();
+    }
+
+    /// @brief Gaussian sum actor operation : chi2 of the combined state
+    ///
+    /// @tparam measurement_t Type of the calibrated measurement
+    ///
+    /// @param calibrated The calibrated measurement
+    /// @param filtered The combined filtered parameters
+    /// @param filteredCovariance The combined filtered covariance
+    template <typename measurement_t>
+    double filteredChi2(const measurement_t& calibrated,
+                        const BoundVector& filtered,
+                        const BoundSymMatrix& filteredCovariance) const {
+      constexpr size_t measdim = measurement_t::size();
+      const ActsMatrixD<measdim, eBoundParametersSize> H =
+          calibrated.projector();
+      const ActsVectorD<measdim> residual =
+          calibrated.parameters() - H * filtered;
+      const ActsSymMatrixD<measdim> R =
+          calibrated.covariance() - H * filteredCovariance * H.transpose();
+      return (residual.transpose() * R.inverse() * residual).value();
+    }
+
+    /// @brief Gaussian sum actor operation : material interaction
+    ///
+    /// Multiple scattering and ionisation are applied to each component.
+    /// For electrons every component is split according to the mixture
+    /// approximation of the bremsstrahlung.
+    ///
+    /// @tparam propagator_state_t is the type of Propagagor state
+    /// @tparam stepper_t Type of the stepper
+    ///
+    /// @param surface The surface where the material interaction happens
+    /// @param state The mutable propagator state object
+    /// @param stepper The stepper in use
+    /// @param result The mutable result state object
+    template <typename propagator_state_t, typename stepper_t>
+    void materialInteractor(const Surface* surface, propagator_state_t& state,
+                            const stepper_t& stepper,
+                            result_type& result) const {
+      detail::PointwiseMaterialInteraction interaction(surface, state,
+                                                       stepper);
+      if (not interaction.evaluateMaterialProperties(state, fullUpdate)) {
+        return;
+      }
+      const auto& slab = interaction.slab;
+      const double m = interaction.mass;
+      const int pdg = interaction.pdg;
+      const double q = interaction.q;
+
+      for (auto& cmp : result.components) {
+        const double qOverP = cmp.parameters[eQOP];
+        if (multipleScattering) {
+          const double theta0 =
+              computeMultipleScatteringTheta0(slab, pdg, m, qOverP, q);
+          const double sinTheta = std::sin(cmp.parameters[eTHETA]);
+          cmp.covariance(ePHI, ePHI) += theta0 * theta0 / (sinTheta * sinTheta);
+          cmp.covariance(eTHETA, eTHETA) += theta0 * theta0;
+        }
+        if (energyLoss) {
+          const double p = std::abs(q / qOverP);
+          const double energy = std::sqrt(m * m + p * p) -
+                                computeEnergyLossBethe(slab, pdg, m, qOverP, q);
+          // put particle almost at rest if energy loss is too large
+          const double nextP = (m < energy)
+                                   ? std::sqrt(energy * energy - m * m)
+                                   : 1e-3 * p;
+          cmp.parameters[eQOP] = std::copysign(std::abs(q) / nextP, qOverP);
+          const double sigmaQOverP =
+              computeEnergyLossLandauSigmaQOverP(slab, pdg, m, qOverP, q);
+          cmp.covariance(eQOP, eQOP) += sigmaQOverP * sigmaQOverP;
+        }
+      }
+      if (not energyLoss or pdg != 11 or not betheHeitler) {
+        return;
+      }
+
+      // Split the components according to the bremsstrahlung mixture, the
+      // energy fraction z scales q/p by 1/z
+      auto& bhMixture = result.betheHeitlerBuffer;
+      betheHeitler->mixture(slab.thicknessInX0(), bhMixture);
+      auto& split = result.componentsBuffer;
+      split.clear();
+      for (const auto& cmp : result.components) {
+        const double qOverP = cmp.parameters[eQOP];
+        for (const auto& bh : bhMixture) {
+          if (bh.mean <= 0.f) {
+            continue;
+          }
+          split.push_back(cmp);
+          auto& splitCmp = split.back();
+          splitCmp.weight *= bh.weight;
+          splitCmp.parameters[eQOP] = qOverP / bh.mean;
+          splitCmp.covariance(eQOP, eQOP) += qOverP * qOverP * bh.variance /
+                                             std::pow(bh.mean, 4);
+        }
+      }
+      std::swap(result.components, split);
+    }
+
+    /// @brief Gaussian sum actor operation : finalize
+    ///
+    /// @tparam propagator_state_t is the type of Propagagor state
+    ///
+    /// @param state The mutable propagator state object
+    /// @param result The mutable result state object
+    template <typename propagator_state_t>
+    void finalize(propagator_state_t& state, result_type& result) const {
+      ACTS_VERBOSE("Finalize after " << result.measurementStates
+                                     << " measurements");
+      result.finished = true;
+      // Fall back to the last measurement if not all have been found
+      if (not result.fittedParameters and result.measurementStates > 0) {
+        size_t lastMeasurement = SIZE_MAX;
+        result.fittedStates.visitBackwards(
+            result.trackTip, [&](const auto& trackState) {
+              if (trackState.typeFlags().test(
+                      TrackStateFlag::MeasurementFlag)) {
+                lastMeasurement = trackState.index();
+                return false;
+              }
+              return true;
+            });
+        auto trackState = result.fittedStates.getTrackState(lastMeasurement);
+        result.fittedParameters =
+            trackState.filteredParameters(state.options.geoContext);
+      }
+    }
+
+    /// Pointer to a logger that is owned by the parent, GaussianSumFilter
+    const Logger* m_logger;
+
+    /// Getter for the logger, to support logging macros
+    const Logger& logger() const { return *m_logger; }
+
+    /// Pointer to the bremsstrahlung approximation owned by the parent
+    const BetheHeitlerApprox* betheHeitler = nullptr;
+
+    /// The Measurement calibrator
+    calibrator_t m_calibrator;
+  };
+
+  template <typename source_link_t>
+  class Aborter {
+   public:
+    /// Broadcast the result_type
+    using action_type = Actor<source_link_t>;
+
+    template <typename propagator_state_t, typename stepper_t,
+              typename result_t>
+    bool operator()(propagator_state_t& /*state*/, const stepper_t& /*stepper*/,
+                    const result_t& result) const {
+      if (!result.result.ok() or result.finished) {
+        return true;
+      }
+      return false;
+    }
+  };
+
+ public:
+  /// Fit implementation of the Gaussian sum filter
+  ///
+  /// @tparam source_link_t Source link type identifying uncalibrated input
+  /// measurements.
+  /// @tparam start_parameters_t Type of the initial parameters
+  ///
+  /// @param sourcelinks The fittable uncalibrated measurements
+  /// @param sParameters The initial track parameters, with covariance
+  /// @param gsfOptions GaussianSumFitterOptions steering the fit
+  /// @note The input measurements are given in the form of @c SourceLinks. It's
+  /// @c calibrator_t's job to turn them into calibrated measurements used in
+  /// the fit.
+  ///
+  /// @return the fitted track states and the final mixture
+  template <typename source_link_t, typename start_parameters_t>
+  Result<GaussianSumFitterResult<source_link_t>> fit(
+      const std::vector<source_link_t>& sourcelinks,
+      const start_parameters_t& sParameters,
+      const GaussianSumFitterOptions& gsfOptions) const {
+    static_assert(SourceLinkConcept<source_link_t>,
+                  "Source link does not fulfill SourceLinkConcept");
+
+    // To be able to find measurements later, we put them into a map
+    ACTS_VERBOSE("Preparing " << sourcelinks.size() << " input measurements");
+    std::map<const Surface*, source_link_t> inputMeasurements;
+    for (const auto& sl : sourcelinks) {
+      const Surface* srf = &sl.referenceSurface();
+      inputMeasurements.emplace(srf, sl);
+    }
+
+    // Create the ActionList and AbortList
+    using GsfAborter = Aborter<source_link_t>;
+    using GsfActor = Actor<source_link_t>;
+    using GsfResult = typename GsfActor::result_type;
+    using Actors = ActionList<GsfActor>;
+    using Aborters = AbortList<GsfAborter>;
+
+    // Create relevant options for the propagation options
+    PropagatorOptions<Actors, Aborters> gsfPropOptions(
+        gsfOptions.geoContext, gsfOptions.magFieldContext);
+    gsfPropOptions.mass = gsfOptions.mass;
+    gsfPropOptions.absPdgCode = gsfOptions.absPdgCode;
+
+    // Catch the actor and set the measurements
+    auto& gsfActor = gsfPropOptions.actionList.template get<GsfActor>();
+    gsfActor.m_logger = m_logger.get();
+    gsfActor.betheHeitler = &m_betheHeitler;
+    gsfActor.inputMeasurements = std::move(inputMeasurements);
+    gsfActor.maxComponents = std::max<size_t>(1, gsfOptions.maxComponents);
+    gsfActor.minComponentWeight = gsfOptions.minComponentWeight;
+    gsfActor.multipleScattering = gsfOptions.multipleScattering;
+    gsfActor.energyLoss = gsfOptions.energyLoss;
+
+    // Run the fitter
+    auto result = m_propagator.template propagate(sParameters, gsfPropOptions);
+
+    if (!result.ok()) {
+      return result.error();
+    }
+
+    const auto& propRes = *result;
+
+    /// Get the result of the fit
+    auto gsfResult = propRes.template get<GsfResult>();
+
+    /// It could happen that the fit ends in zero measurement states.
+    /// The result gets meaningless so such case is regarded as fit failure.
+    if (gsfResult.result.ok() and not gsfResult.measurementStates) {
+      gsfResult.result = Result<void>(KalmanFitterError::PropagationInVain);
+    }
+
+    if (!gsfResult.result.ok()) {
+      return gsfResult.result.error();
+    }
+
+    return std::move(gsfResult);
+  }
+};
+
+}  // namespace Acts
@@ -30,11 +30,16 @@
 #include "Acts/Utilities/CalibrationContext.hpp"
 #include "Acts/Utilities/Definitions.hpp"
 #include "Acts/Utilities/Logger.hpp"
+#include "Acts/Utilities/ParallelFor.hpp"
 #include "Acts/Utilities/Result.hpp"
 
+#include <algorithm>
 #include <functional>
+#include <iterator>
 #include <map>
 #include <memory>
+#include <tuple>
+#include <vector>
 
 namespace Acts {
 
@@ -137,9 +142,46 @@ struct KalmanFitterResult {
   // Measurement surfaces handled in both forward and backward filtering
   std::vector<const Surface*> passedAgainSurfaces;
 
+  // Material surfaces passed before the first measurement, no track states
+  // are created for them
+  std::vector<const Surface*> leadingMaterialSurfaces;
+
   Result<void> result{Result<void>::success()};
 };
 
+/// @brief Navigation sequence of a fitted track
+///
+/// @tparam source_link_t Source link type of the fit
+///
+/// @param result The result of the Kalman fit
+///
+/// Collects the surfaces handled by the forward filter in propagation order:
+/// the material surfaces before the first measurement followed by the
+/// reference surfaces of all track states, i.e. measurements, outliers,
+/// holes, and material. The sequence can be replayed with the
+/// DirectNavigator, e.g. to refit the track without searching the geometry.
+///
+/// @return The ordered surfaces
+template <typename source_link_t>
+DirectNavigator::SurfaceSequence navigationSequence(
+    const KalmanFitterResult<source_link_t>& result) {
+  DirectNavigator::SurfaceSequence trackStateSurfaces;
+  if (result.trackTip != SIZE_MAX) {
+    result.fittedStates.visitBackwards(result.trackTip, [&](const auto& st) {
+      trackStateSurfaces.push_back(&st.referenceSurface());
+    });
+  }
+
+  DirectNavigator::SurfaceSequence sequence;
+  sequence.reserve(result.leadingMaterialSurfaces.size() +
+                   trackStateSurfaces.size());
+  sequence.insert(sequence.end(), result.leadingMaterialSurfaces.begin(),
+                  result.leadingMaterialSurfaces.end());
+  sequence.insert(sequence.end(), trackStateSurfaces.rbegin(),
+                  trackStateSurfaces.rend());
+  return sequence;
+}
+
 /// @brief Kalman fitter implementation of Acts as a plugin
 ///
 /// to the Propgator
@@ -254,8 +296,47 @@ class KalmanFitter {
     /// The target surface
     const Surface* targetSurface = nullptr;
 
-    /// Allows retrieving measurements for a surface
-    std::map<const Surface*, source_link_t> inputMeasurements;
+    /// Allows retrieving measurements for a surface, sorted by surface
+    std::vector<std::pair<const Surface*, source_link_t>> inputMeasurements;
+
+    /// Set the input measurements, the storage of previous ones is reused
+    ///
+    /// Only the first measurement on each surface is used.
+    ///
+    /// @param sourcelinks The fittable uncalibrated measurements
+    void setInputMeasurements(const std::vector<source_link_t>& sourcelinks) {
+      inputMeasurements.clear();
+      for (const auto& sl : sourcelinks) {
+        inputMeasurements.emplace_back(&sl.referenceSurface(), sl);
+      }
+      auto bySurface = [](const auto& lhs, const auto& rhs) {
+        return std::less<const Surface*>()(lhs.first, rhs.first);
+      };
+      std::stable_sort(inputMeasurements.begin(), inputMeasurements.end(),
+                       bySurface);
+      inputMeasurements.erase(
+          std::unique(inputMeasurements.begin(), inputMeasurements.end(),
+                      [](const auto& lhs, const auto& rhs) {
+                        return lhs.first == rhs.first;
+                      }),
+          inputMeasurements.end());
+    }
+
+    /// Find the input measurement on a surface
+    ///
+    /// @param surface The surface to look up
+    ///
+    /// @return Iterator to the measurement, or the end of the measurements
+    auto findMeasurement(const Surface* surface) const {
+      auto it = std::lower_bound(
+          inputMeasurements.begin(), inputMeasurements.end(), surface,
+          [](const auto& measurement, const Surface* srf) {
+            return std::less<const Surface*>()(measurement.first, srf);
+          });
+      return (it != inputMeasurements.end() and it->first == surface)
+                 ? it
+                 : inputMeasurements.end();
+    }
 
     /// Whether to consider multiple scattering.
     bool multipleScattering = true;
@@ -266,6 +347,9 @@ class KalmanFitter {
     /// Whether run smoothing as backward filtering
     bool backwardFiltering = false;
 
+    /// The number of track states to allocate storage for upfront
+    size_t trackStatesReserve = 0;
+
     /// @brief Kalman actor operation
     ///
     /// @tparam propagator_state_t is the type of Propagagor state
@@ -389,7 +473,9 @@ class KalmanFitter {
     /// @param result is the mutable result state object
     template <typename propagator_state_t, typename stepper_t>
     void initialize(propagator_state_t& /*state*/, const stepper_t& /*stepper*/,
-                    result_type& /*result*/) const {}
+                    result_type& result) const {
+      result.fittedStates.reserve(trackStatesReserve);
+    }
 
     /// @brief Kalman actor operation : reverse direction
     ///
@@ -410,18 +496,30 @@ class KalmanFitter {
 
       // Reset stepping&navigation state using last measurement track state on
       // sensitive surface
+      auto navigation = std::move(state.navigation);
       state.navigation = typename propagator_t::NavigatorState();
       result.fittedStates.applyBackwards(result.trackTip, [&](auto st) {
         if (st.hasUncalibrated()) {
           // Set the navigation state
           state.navigation.startSurface = &st.referenceSurface();
-          state.navigation.startLayer =
-              state.navigation.startSurface->associatedLayer();
-          state.navigation.startVolume =
-              state.navigation.startLayer->trackingVolume();
+          if constexpr (isDirectNavigator) {
+            // Replay the surfaces before the start surface in reverse order
+            const auto& sequence = navigation.surfaceSequence;
+            auto startIt = std::find(sequence.begin(), sequence.end(),
+                                     state.navigation.startSurface);
+            state.navigation.surfaceSequence.assign(
+                std::make_reverse_iterator(startIt), sequence.rend());
+            state.navigation.nextSurfaceIter =
+                state.navigation.surfaceSequence.begin();
+          } else {
+            state.navigation.startLayer =
+                state.navigation.startSurface->associatedLayer();
+            state.navigation.startVolume =
+                state.navigation.startLayer->trackingVolume();
+            state.navigation.currentVolume = state.navigation.startVolume;
+          }
           state.navigation.targetSurface = targetSurface;
           state.navigation.currentSurface = state.navigation.startSurface;
-          state.navigation.currentVolume = state.navigation.startVolume;
 
           // Update the stepping state
           stepper.update(state.stepping,
@@ -467,7 +565,7 @@ class KalmanFitter {
     Result<void> filter(const Surface* surface, propagator_state_t& state,
                         const stepper_t& stepper, result_type& result) const {
       // Try to find the surface in the measurement surfaces
-      auto sourcelink_it = inputMeasurements.find(surface);
+      auto sourcelink_it = findMeasurement(surface);
       if (sourcelink_it != inputMeasurements.end()) {
         // Screen output message
         ACTS_VERBOSE("Measurement surface " << surface->geoID()
@@ -607,6 +705,9 @@ class KalmanFitter {
 
           // We count the processed state
           ++result.processedStates;
+        } else {
+          // Remember the surface for the navigation sequence
+          result.leadingMaterialSurfaces.push_back(surface);
         }
 
         // Update state and stepper with material effects
@@ -630,7 +731,7 @@ class KalmanFitter {
                                 const stepper_t& stepper,
                                 result_type& result) const {
       // Try to find the surface in the measurement surfaces
-      auto sourcelink_it = inputMeasurements.find(surface);
+      auto sourcelink_it = findMeasurement(surface);
       if (sourcelink_it != inputMeasurements.end()) {
         // Screen output message
         ACTS_VERBOSE("Measurement surface "
@@ -908,54 +1009,21 @@ class KalmanFitter {
     }
   };
 
- public:
-  /// Fit implementation of the foward filter, calls the
-  /// the forward filter and backward smoother
+  /// Create the propagator options for the fit, with the actor configured
+  /// according to the kalman fitter options
   ///
   /// @tparam source_link_t Source link type identifying uncalibrated input
   /// measurements.
-  /// @tparam start_parameters_t Type of the initial parameters
-  /// @tparam kalman_fitter_options_t Type of the kalman fitter options
   /// @tparam parameters_t Type of parameters used for local parameters
+  /// @tparam kalman_fitter_options_t Type of the kalman fitter options
   ///
-  /// @param sourcelinks The fittable uncalibrated measurements
-  /// @param sParameters The initial track parameters
   /// @param kfOptions KalmanOptions steering the fit
-  /// @note The input measurements are given in the form of @c SourceLinks. It's
-  /// @c calibrator_t's job to turn them into calibrated measurements used in
-  /// the fit.
-  ///
-  /// @return the output as an output track
-  template <typename source_link_t, typename start_parameters_t,
-            typename kalman_fitter_options_t,
-            typename parameters_t = BoundParameters,
-            typename result_t = Result<KalmanFitterResult<source_link_t>>>
-  auto fit(const std::vector<source_link_t>& sourcelinks,
-           const start_parameters_t& sParameters,
-           const kalman_fitter_options_t& kfOptions) const
-      -> std::enable_if_t<!isDirectNavigator, result_t> {
-    static_assert(SourceLinkConcept<source_link_t>,
-                  "Source link does not fulfill SourceLinkConcept");
-
-    static_assert(
-        std::is_same<outlier_finder_t,
-                     typename kalman_fitter_options_t::OutlierFinder>::value,
-        "Inconsistent type of outlier finder between kalman fitter and "
-        "kalman fitter options");
-
-    // To be able to find measurements later, we put them into a map
-    // We need to copy input SourceLinks anyways, so the map can own them.
-    ACTS_VERBOSE("Preparing " << sourcelinks.size() << " input measurements");
-    std::map<const Surface*, source_link_t> inputMeasurements;
-    for (const auto& sl : sourcelinks) {
-      const Surface* srf = &sl.referenceSurface();
-      inputMeasurements.emplace(srf, sl);
-    }
-
+  template <typename source_link_t, typename parameters_t,
+            typename kalman_fitter_options_t>
+  auto makePropagatorOptions(const kalman_fitter_options_t& kfOptions) const {
     // Create the ActionList and AbortList
     using KalmanAborter = Aborter<source_link_t, parameters_t>;
     using KalmanActor = Actor<source_link_t, parameters_t>;
-    using KalmanResult = typename KalmanActor::result_type;
     using Actors = ActionList<KalmanActor>;
     using Aborters = AbortList<KalmanAborter>;
 
@@ -963,10 +1031,9 @@ class KalmanFitter {
     PropagatorOptions<Actors, Aborters> kalmanOptions(
         kfOptions.geoContext, kfOptions.magFieldContext);
 
-    // Catch the actor and set the measurements
+    // Catch the actor and configure it
     auto& kalmanActor = kalmanOptions.actionList.template get<KalmanActor>();
     kalmanActor.m_logger = m_logger.get();
-    kalmanActor.inputMeasurements = std::move(inputMeasurements);
     kalmanActor.targetSurface = kfOptions.referenceSurface;
     kalmanActor.multipleScattering = kfOptions.multipleScattering;
     kalmanActor.energyLoss = kfOptions.energyLoss;
@@ -979,17 +1046,117 @@ class KalmanFitter {
     kalmanActor.m_updater.m_logger = m_logger;
     kalmanActor.m_smoother.m_logger = m_logger;
 
-    // Run the fitter
-    auto result = m_propagator.template propagate(sParameters, kalmanOptions);
+    return kalmanOptions;
+  }
 
-    if (!result.ok()) {
-      return result.error();
-    }
+ public:
+  /// Propagator state and propagation result that are reused to fit several
+  /// tracks, e.g. by one thread of a batch fit
+  ///
+  /// @tparam propagator_state_t Type of the propagator state
+  /// @tparam propagation_result_t Type of the propagation result
+  template <typename propagator_state_t, typename propagation_result_t>
+  struct FitState {
+    /// The propagator state including the configured actor and aborter
+    propagator_state_t propagation;
+    /// The propagation result holding the track state storage
+    propagation_result_t result;
+  };
 
-    const auto& propRes = *result;
+  /// Create a fit state to be reused by fitWithState()
+  ///
+  /// @tparam source_link_t Source link type identifying uncalibrated input
+  /// measurements.
+  /// @tparam parameters_t Type of parameters used for local parameters
+  /// @tparam start_parameters_t Type of the initial parameters
+  /// @tparam kalman_fitter_options_t Type of the kalman fitter options
+  ///
+  /// @param sParameters Initial track parameters to set up the state, they
+  ///        are replaced by the ones of every fitted track
+  /// @param kfOptions KalmanOptions steering the fit
+  template <typename source_link_t, typename parameters_t = BoundParameters,
+            typename start_parameters_t, typename kalman_fitter_options_t>
+  auto makeFitState(const start_parameters_t& sParameters,
+                    const kalman_fitter_options_t& kfOptions) const {
+    static_assert(
+        std::is_same<outlier_finder_t,
+                     typename kalman_fitter_options_t::OutlierFinder>::value,
+        "Inconsistent type of outlier finder between kalman fitter and "
+        "kalman fitter options");
+
+    auto kalmanOptions =
+        makePropagatorOptions<source_link_t, parameters_t>(kfOptions);
+    using PropagationResult =
+        typename propagator_t::template result_type<decltype(kalmanOptions)>;
+    auto propState = m_propagator.makeState(sParameters, kalmanOptions);
+    return FitState<decltype(propState), PropagationResult>{
+        std::move(propState), PropagationResult()};
+  }
+
+  /// Fit implementation of the foward filter reusing a fit state, calls the
+  /// the forward filter and backward smoother
+  ///
+  /// The propagator state is reset to the initial track parameters and the
+  /// storage of the input measurements is kept between fits. The fitted
+  /// states are moved into the returned result; the track state storage is
+  /// only kept for the next fit if this fit failed.
+  ///
+  /// @tparam source_link_t Source link type identifying uncalibrated input
+  /// measurements.
+  /// @tparam start_parameters_t Type of the initial parameters
+  /// @tparam fit_state_t Type of the fit state from makeFitState()
+  /// @tparam parameters_t Type of parameters used for local parameters
+  ///
+  /// @param sourcelinks The fittable uncalibrated measurements
+  /// @param sParameters The initial track parameters
+  /// @param fitState The fit state from makeFitState()
+  ///
+  /// @return the output as an output track
+  template <typename source_link_t, typename start_parameters_t,
+            typename fit_state_t, typename parameters_t = BoundParameters,
+            typename result_t = Result<KalmanFitterResult<source_link_t>>>
+  auto fitWithState(const std::vector<source_link_t>& sourcelinks,
+                    const start_parameters_t& sParameters,
+                    fit_state_t& fitState) const
+      -> std::enable_if_t<!isDirectNavigator, result_t> {
+    static_assert(SourceLinkConcept<source_link_t>,
+                  "Source link does not fulfill SourceLinkConcept");
+
+    using KalmanActor = Actor<source_link_t, parameters_t>;
+    using KalmanResult = typename KalmanActor::result_type;
+    using PropagationResult = decltype(fitState.result);
+
+    auto& propState = fitState.propagation;
+    auto& kalmanActor =
+        propState.options.actionList.template get<KalmanActor>();
+
+    // To be able to find measurements later, we sort them by surface
+    // We need to copy input SourceLinks anyways, so the actor can own them.
+    ACTS_VERBOSE("Preparing " << sourcelinks.size() << " input measurements");
+    kalmanActor.setInputMeasurements(sourcelinks);
+    // Every measurement results in a track state
+    kalmanActor.trackStatesReserve = sourcelinks.size();
+
+    // Reset the result of the previous fit, but keep the track state storage
+    auto fittedStates =
+        std::move(fitState.result.template get<KalmanResult>().fittedStates);
+    fittedStates.clear();
+    fitState.result = PropagationResult();
+    fitState.result.template get<KalmanResult>().fittedStates =
+        std::move(fittedStates);
+
+    // Run the fitter, the direction reversed for the smoothing of the
+    // previous fit is restored
+    propState.options.direction = forward;
+    m_propagator.resetState(propState, sParameters);
+    auto status = m_propagator.propagateState(propState, fitState.result);
+
+    if (!status.ok()) {
+      return status.error();
+    }
 
     /// Get the result of the fit
-    auto kalmanResult = propRes.template get<KalmanResult>();
+    KalmanResult& kalmanResult = fitState.result.template get<KalmanResult>();
 
     /// It could happen that the fit ends in zero processed states.
     /// The result gets meaningless so such case is regarded as fit failure.
@@ -1001,10 +1168,126 @@ class KalmanFitter {
       return kalmanResult.result.error();
     }
 
-    // Return the converted Track
+    // Return the converted Track, the fitted states are moved into it
     return m_outputConverter(std::move(kalmanResult));
   }
 
+  /// Fit implementation of the foward filter, calls the
+  /// the forward filter and backward smoother
+  ///
+  /// @tparam source_link_t Source link type identifying uncalibrated input
+  /// measurements.
+  /// @tparam start_parameters_t Type of the initial parameters
+  /// @tparam kalman_fitter_options_t Type of the kalman fitter options
+  /// @tparam parameters_t Type of parameters used for local parameters
+  ///
+  /// @param sourcelinks The fittable uncalibrated measurements
+  /// @param sParameters The initial track parameters
+  /// @param kfOptions KalmanOptions steering the fit
+  /// @note The input measurements are given in the form of @c SourceLinks. It's
+  /// @c calibrator_t's job to turn them into calibrated measurements used in
+  /// the fit.
+  ///
+  /// @return the output as an output track
+  template <typename source_link_t, typename start_parameters_t,
+            typename kalman_fitter_options_t,
+            typename parameters_t = BoundParameters,
+            typename result_t = Result<KalmanFitterResult<source_link_t>>>
+  auto fit(const std::vector<source_link_t>& sourcelinks,
+           const start_parameters_t& sParameters,
+           const kalman_fitter_options_t& kfOptions) const
+      -> std::enable_if_t<!isDirectNavigator, result_t> {
+    static_assert(SourceLinkConcept<source_link_t>,
+                  "Source link does not fulfill SourceLinkConcept");
+
+    static_assert(
+        std::is_same<outlier_finder_t,
+                     typename kalman_fitter_options_t::OutlierFinder>::value,
+        "Inconsistent type of outlier finder between kalman fitter and "
+        "kalman fitter options");
+
+    // Create the propagator state and run the fitter
+    auto fitState =
+        makeFitState<source_link_t, parameters_t>(sParameters, kfOptions);
+    return fitWithState<source_link_t, start_parameters_t,
+                        decltype(fitState), parameters_t, result_t>(
+        sourcelinks, sParameters, fitState);
+  }
+
+  /// Fit implementation for a batch of tracks, calls the forward filter
+  /// and backward smoother for every track
+  ///
+  /// The propagator state, including the configured actor and aborter lists,
+  /// is set up once per thread and reset between the tracks fitted by that
+  /// thread, see fitWithState().
+  ///
+  /// @tparam input_range_t Random-access range of pair- or tuple-like
+  /// elements, the source links (std::vector<source_link_t>) being the first
+  /// and the initial track parameters the second element
+  /// @tparam kalman_fitter_options_t Type of the kalman fitter options
+  /// @tparam parameters_t Type of parameters used for local parameters
+  ///
+  /// @param inputs The source links and initial parameters of all tracks
+  /// @param kfOptions KalmanOptions steering the fit, shared by all tracks
+  /// @param nThreads The number of threads, 0 means all hardware threads
+  ///
+  /// @return the outputs in the order of the inputs
+  template <typename input_range_t, typename kalman_fitter_options_t,
+            typename parameters_t = BoundParameters,
+            typename source_link_t = typename std::decay_t<std::tuple_element_t<
+                0, typename input_range_t::value_type>>::value_type,
+            typename result_t = Result<KalmanFitterResult<source_link_t>>>
+  auto fitBatch(const input_range_t& inputs,
+                const kalman_fitter_options_t& kfOptions,
+                size_t nThreads = 1) const
+      -> std::enable_if_t<!isDirectNavigator, std::vector<result_t>> {
+    static_assert(SourceLinkConcept<source_link_t>,
+                  "Source link does not fulfill SourceLinkConcept");
+
+    static_assert(
+        std::is_same<outlier_finder_t,
+                     typename kalman_fitter_options_t::OutlierFinder>::value,
+        "Inconsistent type of outlier finder between kalman fitter and "
+        "kalman fitter options");
+
+    const size_t nTracks = std::size(inputs);
+    nThreads = resolveNumberOfThreads(nThreads, nTracks);
+    ACTS_VERBOSE("Fitting " << nTracks << " tracks with " << nThreads
+                            << " threads");
+
+    // The result type is not default constructible, all entries are
+    // overwritten by the fit
+    std::vector<result_t> results;
+    results.reserve(nTracks);
+    for (size_t itrack = 0; itrack < nTracks; ++itrack) {
+      results.emplace_back(KalmanFitterError::PropagationInVain);
+    }
+    if (nTracks == 0) {
+      return results;
+    }
+
+    // One fit state per thread, set up with the first track
+    const auto& sParameters = std::get<1>(*std::begin(inputs));
+    using FitStateType = decltype(
+        makeFitState<source_link_t, parameters_t>(sParameters, kfOptions));
+    std::vector<FitStateType> fitStates;
+    fitStates.reserve(nThreads);
+    for (size_t ithread = 0; ithread < nThreads; ++ithread) {
+      fitStates.push_back(
+          makeFitState<source_link_t, parameters_t>(sParameters, kfOptions));
+    }
+
+    parallelFor(nTracks, nThreads, [&](size_t itrack, size_t ithread) {
+      const auto& input = *std::next(std::begin(inputs), itrack);
+      const auto& trackParameters = std::get<1>(input);
+      results[itrack] =
+          fitWithState<source_link_t, std::decay_t<decltype(trackParameters)>,
+                       FitStateType, parameters_t, result_t>(
+              std::get<0>(input), trackParameters, fitStates[ithread]);
+    });
+    return results;
+  }
+
   /// Fit implementation of the foward filter, calls the
   /// the forward filter and backward smoother
   ///
@@ -1041,14 +1324,7 @@ class KalmanFitter {
         "Inconsistent type of outlier finder between kalman fitter and "
         "kalman fitter options");
 
-    // To be able to find measurements later, we put them into a map
-    // We need to copy input SourceLinks anyways, so the map can own them.
     ACTS_VERBOSE("Preparing " << sourcelinks.size() << " input measurements");
-    std::map<const Surface*, source_link_t> inputMeasurements;
-    for (const auto& sl : sourcelinks) {
-      const Surface* srf = &sl.referenceSurface();
-      inputMeasurements.emplace(srf, sl);
-    }
 
     // Create the ActionList and AbortList
     using KalmanAborter = Aborter<source_link_t, parameters_t>;
@@ -1064,14 +1340,15 @@ class KalmanFitter {
     // Catch the actor and set the measurements
     auto& kalmanActor = kalmanOptions.actionList.template get<KalmanActor>();
     kalmanActor.m_logger = m_logger.get();
-    kalmanActor.inputMeasurements = std::move(inputMeasurements);
+    // To be able to find measurements later, we sort them by surface
+    kalmanActor.setInputMeasurements(sourcelinks);
     kalmanActor.targetSurface = kfOptions.referenceSurface;
     kalmanActor.multipleScattering = kfOptions.multipleScattering;
     kalmanActor.energyLoss = kfOptions.energyLoss;
     kalmanActor.backwardFiltering = kfOptions.backwardFiltering;
 
     // Set config for outlier finder
-    kalmanActor.m_outlierFinder.m_config = kfOptions.outlierFinderConfig;
+    kalmanActor.m_outlierFinder = kfOptions.outlierFinder;
 
     // also set logger on updater and smoother
     kalmanActor.m_updater.m_logger = m_logger;
@@ -0,0 +1,176 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Utilities/Definitions.hpp"
+#include "Acts/Utilities/ParameterDefinitions.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace Acts {
+namespace detail {
+
+/// A weighted component of a Gaussian mixture of bound track parameters
+struct GaussianComponent {
+  /// The weight of the component
+  double weight = 0.;
+  /// The bound parameters
+  BoundVector parameters = BoundVector::Zero();
+  /// The covariance of the bound parameters
+  BoundSymMatrix covariance = BoundSymMatrix::Zero();
+};
+
+/// Normalize the weights of a mixture to one
+///
+/// @param components The mixture
+inline void normalizeWeights(std::vector<GaussianComponent>& components) {
+  double sum = 0.;
+  for (const auto& cmp : components) {
+    sum += cmp.weight;
+  }
+  for (auto& cmp : components) {
+    cmp.weight /= sum;
+  }
+}
+
+/// Combine a mixture into a single Gaussian with the same mean and
+/// covariance
+///
+/// @param components The mixture, the weights have to be normalized
+/// @param [out] mean The mean of the mixture
+/// @param [out] covariance The covariance of the mixture
+inline void combineComponents(const std::vector<GaussianComponent>& components,
+                              BoundVector& mean, BoundSymMatrix& covariance) {
+  mean.setZero();
+  for (const auto& cmp : components) {
+    mean += cmp.weight * cmp.parameters;
+  }
+  covariance.setZero();
+  for (const auto& cmp : components) {
+    const BoundVector diff = cmp.parameters - mean;
+    covariance += cmp.weight * (cmp.covariance + diff * diff.transpose());
+  }
+}
+
+/// Merge a component into another one, preserving the weight, the mean and
+/// the covariance of the pair
+///
+/// @param [in,out] a The component to merge into
+/// @param b The component to be merged
+inline void mergeComponents(GaussianComponent& a, const GaussianComponent& b) {
+  const double weight = a.weight + b.weight;
+  const double wa = a.weight / weight;
+  const double wb = b.weight / weight;
+  const BoundVector diff = a.parameters - b.parameters;
+  a.parameters = wa * a.parameters + wb * b.parameters;
+  a.covariance = wa * a.covariance + wb * b.covariance +
+                 wa * wb * diff * diff.transpose();
+  a.weight = weight;
+}
+
+/// Symmetric Kullback-Leibler distance of two components in q/p
+///
+/// Restricting the distance to q/p, which is affected by the
+/// bremsstrahlung, avoids inverting the full covariance matrices.
+///
+/// @param a The first component
+/// @param b The second component
+inline double qOverPDistance(const GaussianComponent& a,
+                             const GaussianComponent& b) {
+  constexpr double minVariance = std::numeric_limits<double>::min();
+  const double va = std::max(a.covariance(eQOP, eQOP), minVariance);
+  const double vb = std::max(b.covariance(eQOP, eQOP), minVariance);
+  const double diff = a.parameters[eQOP] - b.parameters[eQOP];
+  return 0.5 * (va / vb + vb / va - 2. + diff * diff * (1. / va + 1. / vb));
+}
+
+/// Reduce a mixture to a maximum number of components
+///
+/// The closest pair of components according to the q/p distance is merged
+/// until the number of components is small enough. The nearest neighbour of
+/// every component is cached, after a merge only the components whose
+/// neighbour was merged are searched again, i.e. a merge costs O(n) instead
+/// of a rescan of all O(n^2) pairs.
+///
+/// @param [in,out] components The mixture
+/// @param maxComponents The maximum number of components, at least one
+/// @param neighbours Scratch buffer for the nearest neighbours
+inline void reduceMixture(std::vector<GaussianComponent>& components,
+                          size_t maxComponents,
+                          std::vector<std::pair<size_t, double>>& neighbours) {
+  const size_t n = components.size();
+  maxComponents = std::max<size_t>(maxComponents, 1);
+  if (n <= maxComponents) {
+    return;
+  }
+  constexpr double infinity = std::numeric_limits<double>::infinity();
+  // A merged component has the neighbour n, a component without neighbour
+  // has itself as neighbour
+  auto merged = [&](size_t k) { return neighbours[k].first == n; };
+  auto nearest = [&](size_t i) {
+    std::pair<size_t, double> neighbour{i, infinity};
+    for (size_t k = 0; k < n; ++k) {
+      if (k == i or merged(k)) {
+        continue;
+      }
+      const double d = qOverPDistance(components[i], components[k]);
+      if (d < neighbour.second) {
+        neighbour = {k, d};
+      }
+    }
+    return neighbour;
+  };
+  neighbours.assign(n, {0, infinity});
+  for (size_t i = 0; i < n; ++i) {
+    neighbours[i] = nearest(i);
+  }
+
+  for (size_t nActive = n; maxComponents < nActive; --nActive) {
+    auto closest = std::min_element(
+        neighbours.begin(), neighbours.end(),
+        [](const auto& a, const auto& b) { return a.second < b.second; });
+    const size_t i = closest - neighbours.begin();
+    const size_t j = closest->first;
+    mergeComponents(components[i], components[j]);
+    neighbours[j] = {n, infinity};
+    neighbours[i] = nearest(i);
+    // The distances to i changed, the neighbours i and j are searched again
+    for (size_t k = 0; k < n; ++k) {
+      if (k == i or merged(k)) {
+        continue;
+      }
+      if (neighbours[k].first == i or neighbours[k].first == j) {
+        neighbours[k] = nearest(k);
+        continue;
+      }
+      const double d = qOverPDistance(components[k], components[i]);
+      if (d < neighbours[k].second) {
+        neighbours[k] = {i, d};
+      }
+    }
+  }
+
+  size_t nKept = 0;
+  for (size_t k = 0; k < n; ++k) {
+    if (not merged(k)) {
+      if (k != nKept) {
+        components[nKept] = std::move(components[k]);
+      }
+      ++nKept;
+    }
+  }
+  components.resize(nKept);
+}
+
+}  // namespace detail
+}  // namespace Acts
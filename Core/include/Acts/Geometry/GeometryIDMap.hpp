@@ -0,0 +1,131 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Acts/Geometry/GeometryID.hpp"
+
+namespace Acts {
+
+/// @brief Immutable flat lookup table keyed by GeometryID
+///
+/// The identifiers are stored as a sorted array of encoded values, separate
+/// from the values, such that a lookup only touches a few contiguous cache
+/// lines. The volume occupies the most significant bits of the identifier,
+/// a dense table of offsets per volume restricts the binary search to the
+/// entries of a single volume.
+///
+/// @tparam value_t the type of the stored values
+template <typename value_t>
+class GeometryIDMap {
+ public:
+  using Value = value_t;
+
+  /// Construct an empty map
+  GeometryIDMap() { m_volumeOffsets.fill(0); }
+
+  /// Construct from unsorted pairs of identifier and value
+  ///
+  /// @param elements are the identifier-value pairs (moved)
+  ///
+  /// @throw std::invalid_argument if an identifier appears twice
+  GeometryIDMap(std::vector<std::pair<GeometryID, value_t>> elements) {
+    std::vector<size_t> order(elements.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+      return elements[lhs].first.value() < elements[rhs].first.value();
+    });
+    m_ids.reserve(elements.size());
+    m_values.reserve(elements.size());
+    for (size_t i : order) {
+      const GeometryID::Value id = elements[i].first.value();
+      if (not m_ids.empty() and m_ids.back() == id) {
+        throw std::invalid_argument("GeometryIDMap: duplicate identifier");
+      }
+      m_ids.push_back(id);
+      m_values.push_back(std::move(elements[i].second));
+    }
+    fillVolumeOffsets();
+  }
+
+  /// Construct from a map sorted by identifier
+  ///
+  /// @param elements are the identifier-value pairs (copied)
+  GeometryIDMap(const std::map<GeometryID, value_t>& elements) {
+    m_ids.reserve(elements.size());
+    m_values.reserve(elements.size());
+    for (const auto& [id, value] : elements) {
+      m_ids.push_back(id.value());
+      m_values.push_back(value);
+    }
+    // the GeometryID ordering is the ordering of the encoded values
+    fillVolumeOffsets();
+  }
+
+  /// Number of stored elements
+  size_t size() const { return m_ids.size(); }
+
+  /// Whether the map is empty
+  bool empty() const { return m_ids.empty(); }
+
+  /// Find the value for an identifier
+  ///
+  /// @param id is the identifier to be looked up
+  ///
+  /// @return pointer to the value, nullptr if the identifier is not stored
+  const value_t* find(GeometryID id) const {
+    const GeometryID::Value encoded = id.value();
+    const size_t volume = id.volume();
+    const auto begin = m_ids.begin() + m_volumeOffsets[volume];
+    const auto end = m_ids.begin() + m_volumeOffsets[volume + 1];
+    const auto it = std::lower_bound(begin, end, encoded);
+    if (it == end or *it != encoded) {
+      return nullptr;
+    }
+    return &m_values[it - m_ids.begin()];
+  }
+
+  /// The sorted, encoded identifiers
+  const std::vector<GeometryID::Value>& ids() const { return m_ids; }
+
+  /// The values in the order of the identifiers
+  const std::vector<value_t>& values() const { return m_values; }
+
+ private:
+  /// Number of distinct volume identifiers
+  static constexpr size_t kNumVolumes = 256;
+
+  /// Fill the offsets of the first entry of each volume
+  void fillVolumeOffsets() {
+    size_t i = 0;
+    for (size_t volume = 0; volume < kNumVolumes; ++volume) {
+      m_volumeOffsets[volume] = i;
+      while (i < m_ids.size() and GeometryID(m_ids[i]).volume() == volume) {
+        ++i;
+      }
+    }
+    m_volumeOffsets[kNumVolumes] = i;
+  }
+
+  /// The encoded identifiers, sorted
+  std::vector<GeometryID::Value> m_ids;
+  /// The values, aligned with the identifiers
+  std::vector<value_t> m_values;
+  /// The entries of volume v are in [m_volumeOffsets[v], m_volumeOffsets[v+1])
+  std::array<size_t, kNumVolumes + 1> m_volumeOffsets;
+};
+
+}  // namespace Acts
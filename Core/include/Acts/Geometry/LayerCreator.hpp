@@ -170,6 +170,56 @@ class LayerCreator {
       std::shared_ptr<const Transform3D> transform = nullptr,
       std::unique_ptr<ApproachDescriptor> ad = nullptr) const;
 
+  /// returning a cylindrical layer with a bounding volume hierarchy lookup
+  ///
+  /// The sensitive surfaces are not binned, but looked up through their
+  /// bounding boxes, which suits tilted or irregularly placed modules.
+  ///
+  /// @param gctx ist the geometry context with which the geometry is built
+  /// @param surfaces is the vector of pointers to sensitive surfaces
+  /// represented by this layer
+  /// @pre the pointers to the sensitive surfaces in the surfaces vectors all
+  /// need to be valid, since no check is performed
+  /// @param _protoLayer (optional) proto layer specifying the dimensions and
+  /// envelopes
+  /// @param transform is the (optional) transform of the layer
+  /// @param ad possibility to hand over a specific ApproachDescriptor, which is
+  /// needed for material mapping. Otherwise the default ApproachDescriptor will
+  /// be taken used for this layer
+  ///
+  /// @return shared pointer to a newly created layer
+  MutableLayerPtr cylinderLayerOnBVH(
+      const GeometryContext& gctx,
+      std::vector<std::shared_ptr<const Surface>> surfaces,
+      std::optional<ProtoLayer> _protoLayer = std::nullopt,
+      std::shared_ptr<const Transform3D> transform = nullptr,
+      std::unique_ptr<ApproachDescriptor> ad = nullptr) const;
+
+  /// returning a disc layer with a bounding volume hierarchy lookup
+  ///
+  /// The sensitive surfaces are not binned, but looked up through their
+  /// bounding boxes, which suits endcap petals or overlapping rings.
+  ///
+  /// @param gctx ist the geometry context with which the geometry is built
+  /// @param surfaces is the vector of pointers to sensitive surfaces
+  /// represented by this layer
+  /// @pre the pointers to the sensitive surfaces in the surfaces vectors all
+  /// need to be valid, since no check is performed
+  /// @param _protoLayer (optional) proto layer specifying the dimensions and
+  /// envelopes
+  /// @param transform is the (optional) transform of the layer
+  /// @param ad possibility to hand over a specific ApproachDescriptor, which is
+  /// needed for material mapping. Otherwise the default ApproachDescriptor will
+  /// be taken used for this layer
+  ///
+  /// @return shared pointer to a newly created layer
+  MutableLayerPtr discLayerOnBVH(
+      const GeometryContext& gctx,
+      std::vector<std::shared_ptr<const Surface>> surfaces,
+      std::optional<ProtoLayer> _protoLayer = std::nullopt,
+      std::shared_ptr<const Transform3D> transform = nullptr,
+      std::unique_ptr<ApproachDescriptor> ad = nullptr) const;
+
   /// returning a plane layer
   ///
   /// @param gctx ist the geometry context with which the geometry is built
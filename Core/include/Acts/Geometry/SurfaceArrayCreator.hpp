@@ -79,6 +79,13 @@ class SurfaceArrayCreator {
     /// of bins to the lowest number of non-equivalent phi surfaces
     /// of all r-bins. If false, this step is skipped.
     bool doPhiBinningOptimization = true;
+
+    /// Envelope added to the bounding box of each surface in the bounding
+    /// volume hierarchy lookup
+    double bvhEnvelope = 1 * UnitConstants::mm;
+
+    /// Maximum depth of the bounding volume hierarchy lookup
+    size_t bvhMaxDepth = 4;
   };
 
   /// Constructor with default config
@@ -221,6 +228,23 @@ class SurfaceArrayCreator {
       std::optional<ProtoLayer> protoLayerOpt = std::nullopt,
       const std::shared_ptr<const Transform3D>& transformOpt = nullptr) const;
 
+  /// SurfaceArrayCreator interface method
+  /// - create an array with a bounding volume hierarchy lookup
+  ///
+  /// This needs no binning and is suited for layers where the surfaces are
+  /// not arranged regularly in two local coordinates, e.g. endcap petals or
+  /// tilted modules, which would fill many surfaces into each grid bin.
+  ///
+  /// @param [in] gctx The gometry context fro this building call
+  /// @param [in] surfaces is the vector of pointers to sensitive surfaces
+  /// @pre the pointers to the sensitive surfaces in the surfaces vectors all
+  /// need to be valid, since no check is performed
+  ///
+  /// @return a unique pointer a new SurfaceArray
+  std::unique_ptr<SurfaceArray> surfaceArrayOnBVH(
+      const GeometryContext& gctx,
+      std::vector<std::shared_ptr<const Surface>> surfaces) const;
+
   /// Static check funtion for surface equivalent
   ///
   /// @param [in] gctx the geometry context for this check
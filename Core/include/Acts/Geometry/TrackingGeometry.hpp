@@ -14,6 +14,7 @@
 
 #include "Acts/Geometry/GeometryContext.hpp"
 #include "Acts/Geometry/GeometryID.hpp"
+#include "Acts/Geometry/GeometryIDMap.hpp"
 #include "Acts/Utilities/Definitions.hpp"
 
 #include <functional>
@@ -98,6 +99,16 @@ class TrackingGeometry {
   ///         (could be a null pointer)
   const Surface* getBeamline() const;
 
+  /// @brief Find a surface by its identifier
+  ///
+  /// All boundary, layer, approach and sensitive surfaces are indexed once
+  /// at construction, the lookup does not traverse the geometry.
+  ///
+  /// @param id is the geometry identifier of the surface
+  ///
+  /// @return plain pointer to the surface, nullptr if it does not exist
+  const Surface* findSurface(GeometryID id) const;
+
   /// @brief Visit all sensitive surfaces
   ///
   /// @param visitor The callable. Will be called for each sensitive surface
@@ -112,6 +123,9 @@ class TrackingGeometry {
 
   /// The Volumes in a map for string based search
   std::map<std::string, const TrackingVolume*> m_trackingVolumes;
+
+  /// All surfaces with an identifier for the search by GeometryID
+  GeometryIDMap<const Surface*> m_surfacesById;
 };
 
 }  // namespace Acts
@@ -180,6 +180,24 @@ class TrackingVolume : public Volume {
       const GeometryContext& gctx, const Vector3D& position,
       const Vector3D& direction, const options_t& options) const;
 
+  /// @brief Resolves the given candidate layers into (compatible) Layers
+  ///
+  /// @tparam options_t Type of navigation options object for decomposition
+  ///
+  /// @param gctx The current geometry context object, e.g. alignment
+  /// @param position Position for the search
+  /// @param direction Direction for the search
+  /// @param options The templated navigation options
+  /// @param candidates The layers to be tested, e.g. the result of a
+  ///        previous search through this volume
+  ///
+  /// @return vector of compatible intersections with layers
+  template <typename options_t>
+  std::vector<LayerIntersection> compatibleLayers(
+      const GeometryContext& gctx, const Vector3D& position,
+      const Vector3D& direction, const options_t& options,
+      const std::vector<const Layer*>& candidates) const;
+
   /// @brief Returns all boundary surfaces sorted by the user.
   ///
   /// @tparam options_t Type of navigation options object for decomposition
@@ -197,6 +215,24 @@ class TrackingVolume : public Volume {
       const GeometryContext& gctx, const Vector3D& position,
       const Vector3D& direction, const options_t& options) const;
 
+  /// @brief Returns the given candidate boundary surfaces sorted by the user.
+  ///
+  /// @tparam options_t Type of navigation options object for decomposition
+  ///
+  /// @param gctx The current geometry context object, e.g. alignment
+  /// @param position The position for searching
+  /// @param direction The direction for searching
+  /// @param options The templated navigation options
+  /// @param candidates The boundary surfaces to be tested, e.g. the result
+  ///        of a previous search through this volume
+  ///
+  /// @return is the templated boundary intersection
+  template <typename options_t>
+  std::vector<BoundaryIntersection> compatibleBoundaries(
+      const GeometryContext& gctx, const Vector3D& position,
+      const Vector3D& direction, const options_t& options,
+      const std::vector<const BoundarySurface*>& candidates) const;
+
   /// @brief Return surfaces in given direction from bounding volume hierarchy
   /// @tparam options_t Type of navigation options object for decomposition
   ///
@@ -395,6 +431,26 @@ class TrackingVolume : public Volume {
       const std::string& volumeName = "undefined");
 
  private:
+  /// Private helper method for the compatible layers search
+  ///
+  /// @param candidates Optional candidate layers, the confined layers are
+  ///        searched if not given
+  template <typename options_t>
+  std::vector<LayerIntersection> compatibleLayers(
+      const GeometryContext& gctx, const Vector3D& position,
+      const Vector3D& direction, const options_t& options,
+      const std::vector<const Layer*>* candidates) const;
+
+  /// Private helper method for the compatible boundaries search
+  ///
+  /// @param candidates Optional candidate boundaries, all boundaries of this
+  ///        volume and its dense volumes are searched if not given
+  template <typename options_t>
+  std::vector<BoundaryIntersection> compatibleBoundaries(
+      const GeometryContext& gctx, const Vector3D& position,
+      const Vector3D& direction, const options_t& options,
+      const std::vector<const BoundarySurface*>* candidates) const;
+
   void connectDenseBoundarySurfaces(
       MutableTrackingVolumeVector& confinedDenseVolumes);
 
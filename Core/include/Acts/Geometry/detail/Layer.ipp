@@ -181,14 +181,20 @@ std::vector<SurfaceIntersection> Layer::compatibleSurfaces(
   // check the sensitive surfaces if you have some
   if (m_surfaceArray && (options.resolveMaterial || options.resolvePassive ||
                          options.resolveSensitive)) {
-    // get the canditates
-    const std::vector<const Surface*>& sensitiveSurfaces =
-        m_surfaceArray->neighbors(position);
-    // loop through and veto
+    // loop through the canditates and veto
     // - if the approach surface is the parameter surface
     // - if the surface is not compatible with the type(s) that are collected
-    for (auto& sSurface : sensitiveSurfaces) {
-      processSurface(*sSurface, true);
+    if (m_surfaceArray->isDirectionDependent()) {
+      // candidates along the direction are collected into a new vector
+      for (auto& sSurface :
+           m_surfaceArray->candidates(position, options.navDir * direction)) {
+        processSurface(*sSurface, true);
+      }
+    } else {
+      // grid neighbors are used in place
+      for (auto& sSurface : m_surfaceArray->neighbors(position)) {
+        processSurface(*sSurface, true);
+      }
     }
   }
 
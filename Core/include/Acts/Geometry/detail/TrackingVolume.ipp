@@ -25,42 +25,68 @@ template <typename options_t>
 std::vector<LayerIntersection> TrackingVolume::compatibleLayers(
     const GeometryContext& gctx, const Vector3D& position,
     const Vector3D& direction, const options_t& options) const {
+  return compatibleLayers(gctx, position, direction, options, nullptr);
+}
+
+template <typename options_t>
+std::vector<LayerIntersection> TrackingVolume::compatibleLayers(
+    const GeometryContext& gctx, const Vector3D& position,
+    const Vector3D& direction, const options_t& options,
+    const std::vector<const Layer*>& candidates) const {
+  return compatibleLayers(gctx, position, direction, options, &candidates);
+}
+
+template <typename options_t>
+std::vector<LayerIntersection> TrackingVolume::compatibleLayers(
+    const GeometryContext& gctx, const Vector3D& position,
+    const Vector3D& direction, const options_t& options,
+    const std::vector<const Layer*>* candidates) const {
   // the layer intersections which are valid
   std::vector<LayerIntersection> lIntersections;
 
+  // check if the layer needs resolving
+  // - resolveSensitive -> always take layer if it has a surface array
+  // - resolveMaterial -> always take layer if it has material
+  // - resolvePassive -> always take, unless it's a navigation layer
+  // skip the start object
+  auto processLayer = [&](const Layer* tLayer) -> void {
+    if (tLayer != options.startObject && tLayer->resolve(options)) {
+      // if it's a resolveable start layer, you are by definition on it
+      // layer on approach intersection
+      auto atIntersection =
+          tLayer->surfaceOnApproach(gctx, position, direction, options);
+      auto path = atIntersection.intersection.pathLength;
+      bool withinLimit = (path * path <= options.pathLimit * options.pathLimit);
+      // Intersection is ok - take it (move to surface on appraoch)
+      if (atIntersection &&
+          (atIntersection.object != options.targetSurface) && withinLimit) {
+        // create a layer intersection
+        lIntersections.push_back(LayerIntersection(
+            atIntersection.intersection, tLayer, atIntersection.object));
+      }
+    }
+  };
+
   // the confinedLayers
   if (m_confinedLayers != nullptr) {
-    // start layer given or not - test layer
-    const Layer* tLayer = options.startObject != nullptr
-                              ? options.startObject
-                              : associatedLayer(gctx, position);
-    while (tLayer != nullptr) {
-      // check if the layer needs resolving
-      // - resolveSensitive -> always take layer if it has a surface array
-      // - resolveMaterial -> always take layer if it has material
-      // - resolvePassive -> always take, unless it's a navigation layer
-      // skip the start object
-      if (tLayer != options.startObject && tLayer->resolve(options)) {
-        // if it's a resolveable start layer, you are by definition on it
-        // layer on approach intersection
-        auto atIntersection =
-            tLayer->surfaceOnApproach(gctx, position, direction, options);
-        auto path = atIntersection.intersection.pathLength;
-        bool withinLimit =
-            (path * path <= options.pathLimit * options.pathLimit);
-        // Intersection is ok - take it (move to surface on appraoch)
-        if (atIntersection &&
-            (atIntersection.object != options.targetSurface) && withinLimit) {
-          // create a layer intersection
-          lIntersections.push_back(LayerIntersection(
-              atIntersection.intersection, tLayer, atIntersection.object));
-        }
+    if (candidates != nullptr) {
+      // only the given candidates are tested, e.g. from a navigation cache
+      for (auto& cLayer : *candidates) {
+        processLayer(cLayer);
+      }
+    } else {
+      // start layer given or not - test layer
+      const Layer* tLayer = options.startObject != nullptr
+                                ? options.startObject
+                                : associatedLayer(gctx, position);
+      while (tLayer != nullptr) {
+        processLayer(tLayer);
+        // move to next one or break because you reached the end layer
+        tLayer =
+            (tLayer == options.endObject)
+                ? nullptr
+                : tLayer->nextLayer(gctx, position, options.navDir * direction);
       }
-      // move to next one or break because you reached the end layer
-      tLayer =
-          (tLayer == options.endObject)
-              ? nullptr
-              : tLayer->nextLayer(gctx, position, options.navDir * direction);
     }
     // sort them accordingly to the navigation direction
     if (options.navDir == forward) {
@@ -78,6 +104,22 @@ template <typename options_t>
 std::vector<BoundaryIntersection> TrackingVolume::compatibleBoundaries(
     const GeometryContext& gctx, const Vector3D& position,
     const Vector3D& direction, const options_t& options) const {
+  return compatibleBoundaries(gctx, position, direction, options, nullptr);
+}
+
+template <typename options_t>
+std::vector<BoundaryIntersection> TrackingVolume::compatibleBoundaries(
+    const GeometryContext& gctx, const Vector3D& position,
+    const Vector3D& direction, const options_t& options,
+    const std::vector<const BoundarySurface*>& candidates) const {
+  return compatibleBoundaries(gctx, position, direction, options, &candidates);
+}
+
+template <typename options_t>
+std::vector<BoundaryIntersection> TrackingVolume::compatibleBoundaries(
+    const GeometryContext& gctx, const Vector3D& position,
+    const Vector3D& direction, const options_t& options,
+    const std::vector<const BoundarySurface*>* candidates) const {
   // Loop over boundarySurfaces and calculate the intersection
   auto excludeObject = options.startObject;
   std::vector<BoundaryIntersection> bIntersections;
@@ -126,35 +168,47 @@ std::vector<BoundaryIntersection> TrackingVolume::compatibleBoundaries(
     return BoundaryIntersection();
   };
 
+  /// Helper function to process a boundary surface
+  auto processBoundary = [&](const BoundarySurface* bSurface) -> void {
+    // Get the boundary surface representation
+    const auto& bSurfaceRep = bSurface->surfaceRepresentation();
+    // Exclude the boundary where you are on
+    if (excludeObject != &bSurfaceRep) {
+      auto bCandidate = bSurfaceRep.intersect(gctx, position, sDirection,
+                                              options.boundaryCheck);
+      // Intersect and continue
+      auto bIntersection = checkIntersection(bCandidate, bSurface);
+      if (bIntersection) {
+        bIntersections.push_back(bIntersection);
+      }
+    }
+  };
+
   /// Helper function to process boundary surfaces
   auto processBoundaries =
       [&](const TrackingVolumeBoundaries& bSurfaces) -> void {
     // Loop over the boundary surfaces
     for (auto& bsIter : bSurfaces) {
-      // Get the boundary surface pointer
-      const auto& bSurfaceRep = bsIter->surfaceRepresentation();
-      // Exclude the boundary where you are on
-      if (excludeObject != &bSurfaceRep) {
-        auto bCandidate = bSurfaceRep.intersect(gctx, position, sDirection,
-                                                options.boundaryCheck);
-        // Intersect and continue
-        auto bIntersection = checkIntersection(bCandidate, bsIter.get());
-        if (bIntersection) {
-          bIntersections.push_back(bIntersection);
-        }
-      }
+      processBoundary(bsIter.get());
     }
   };
 
-  // Process the boundaries of the current volume
-  auto& bSurfaces = boundarySurfaces();
-  processBoundaries(bSurfaces);
+  if (candidates != nullptr) {
+    // Only the given candidates are tested, e.g. from a navigation cache
+    for (auto& cBoundary : *candidates) {
+      processBoundary(cBoundary);
+    }
+  } else {
+    // Process the boundaries of the current volume
+    auto& bSurfaces = boundarySurfaces();
+    processBoundaries(bSurfaces);
 
-  // Process potential boundaries of contained volumes
-  auto confinedDenseVolumes = denseVolumes();
-  for (const auto& dv : confinedDenseVolumes) {
-    auto& bSurfacesConfined = dv->boundarySurfaces();
-    processBoundaries(bSurfacesConfined);
+    // Process potential boundaries of contained volumes
+    auto confinedDenseVolumes = denseVolumes();
+    for (const auto& dv : confinedDenseVolumes) {
+      auto& bSurfacesConfined = dv->boundarySurfaces();
+      processBoundaries(bSurfacesConfined);
+    }
   }
 
   // Sort them accordingly to the navigation direction
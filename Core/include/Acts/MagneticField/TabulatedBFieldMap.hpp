@@ -0,0 +1,350 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "Acts/MagneticField/MagneticFieldContext.hpp"
+#include "Acts/Utilities/Definitions.hpp"
+
+namespace Acts {
+
+/// @ingroup MagneticField
+/// @brief magnetic field map tabulated on a regular grid
+///
+/// Specialized alternative to the InterpolatedBFieldMap for the two common
+/// field map formats:
+/// - DIM = 3: cartesian map with (Bx,By,Bz) given on a (x,y,z) grid,
+/// - DIM = 2: cylindrical map with (Br,Bz) given on a (r,z) grid.
+///
+/// The field values are stored in one contiguous, aligned buffer, which is
+/// either owned by the map or provided externally, e.g. memory-mapped with
+/// Acts::mapTabulatedBFieldMap. The coordinate transformations are fixed at
+/// compile time instead of being called through std::function. The (x,y,z)
+/// field values are padded to four components, such that the interpolation
+/// of the corner values is performed with full SIMD packets by Eigen.
+///
+/// The field is interpolated (bi/tri)linearly within the cell containing the
+/// position, and the gradient is the exact derivative of this interpolation.
+/// Positions outside of the grid are extrapolated from the closest cell.
+template <unsigned int DIM>
+class TabulatedBFieldMap final {
+  static_assert(DIM == 2 or DIM == 3, "Only (r,z) and (x,y,z) maps");
+
+ public:
+  /// Number of corner points of a grid cell
+  static constexpr unsigned int N = 1 << DIM;
+  /// Number of stored field components, including the padding
+  static constexpr int VALUE_DIM = (DIM == 3) ? 4 : 2;
+
+  /// Field value type as given at the grid points
+  using FieldType = ActsVectorD<DIM>;
+  /// Field value type as stored at the grid points
+  using StoredType = Eigen::Matrix<double, VALUE_DIM, 1>;
+  /// Corner values of a grid cell, one column per corner
+  using CornerValues = Eigen::Matrix<double, VALUE_DIM, N>;
+
+  /// @brief grid cell used for the interpolation
+  struct FieldCell {
+    /// global index of the lower-left grid point, invalid if not set
+    size_t index = std::numeric_limits<size_t>::max();
+    /// field values at the corners of the cell
+    CornerValues corners = CornerValues::Zero();
+  };
+
+  struct Cache {
+    /// @brief Constructor with magnetic field context
+    ///
+    /// @param mcfg the magnetic field context
+    Cache(std::reference_wrapper<const MagneticFieldContext> /*mcfg*/) {}
+
+    /// the most recently used grid cell
+    FieldCell fieldCell;
+  };
+
+  /// @brief create the tabulated magnetic field map
+  ///
+  /// @param [in] min position of the first grid point along each axis
+  /// @param [in] max position of the last grid point along each axis
+  /// @param [in] nPoints number of grid points along each axis, at least two
+  /// @param [in] values field values at the grid points, the last axis runs
+  ///             fastest, i.e. for (x,y,z) the index of the grid point
+  ///             (i,j,k) is (i * nPoints[1] + j) * nPoints[2] + k
+  TabulatedBFieldMap(std::array<double, DIM> min, std::array<double, DIM> max,
+                     std::array<size_t, DIM> nPoints,
+                     const std::vector<FieldType>& values)
+      : m_min(min), m_max(max), m_nPoints(nPoints) {
+    initialize();
+    if (values.size() != m_nValues) {
+      throw std::invalid_argument("Wrong number of field values");
+    }
+    auto storage =
+        std::make_shared<StoredValues>(m_nValues, StoredType::Zero());
+    for (size_t i = 0; i < m_nValues; ++i) {
+      (*storage)[i].template head<DIM>() = values[i];
+    }
+    m_values = storage->data();
+    m_storage = std::move(storage);
+  }
+
+  /// @brief create the tabulated magnetic field map on external storage
+  ///
+  /// The field values are used in place, e.g. from a memory-mapped file,
+  /// and are kept alive by the shared @p storage. Copies of the map share
+  /// the storage.
+  ///
+  /// @param [in] min position of the first grid point along each axis
+  /// @param [in] max position of the last grid point along each axis
+  /// @param [in] nPoints number of grid points along each axis, at least two
+  /// @param [in] storage owner of the memory containing the field values
+  /// @param [in] values the stored field values in the order described
+  ///             above, must be aligned for StoredType
+  TabulatedBFieldMap(std::array<double, DIM> min, std::array<double, DIM> max,
+                     std::array<size_t, DIM> nPoints,
+                     std::shared_ptr<const void> storage,
+                     const StoredType* values)
+      : m_min(min),
+        m_max(max),
+        m_nPoints(nPoints),
+        m_storage(std::move(storage)),
+        m_values(values) {
+    initialize();
+  }
+
+  /// @brief retrieve magnetic field value
+  ///
+  /// @param [in] position global 3D position
+  ///
+  /// @return magnetic field vector at given position
+  Vector3D getField(const Vector3D& position) const {
+    FieldCell cell;
+    return evaluate(position, cell, nullptr);
+  }
+
+  /// @brief retrieve magnetic field value
+  ///
+  /// @param [in] position global 3D position
+  /// @param [in,out] cache Cache object. Contains field cell used for
+  /// interpolation
+  ///
+  /// @return magnetic field vector at given position
+  Vector3D getField(const Vector3D& position, Cache& cache) const {
+    return evaluate(position, cache.fieldCell, nullptr);
+  }
+
+  /// @brief retrieve magnetic field value & its gradient
+  ///
+  /// @param [in]  position   global 3D position
+  /// @param [out] derivative gradient of magnetic field vector as (3x3)
+  ///              matrix, with derivative(i, j) = dB_i / dx_j
+  /// @return magnetic field vector
+  Vector3D getFieldGradient(const Vector3D& position,
+                            ActsMatrixD<3, 3>& derivative) const {
+    FieldCell cell;
+    return evaluate(position, cell, &derivative);
+  }
+
+  /// @brief retrieve magnetic field value & its gradient
+  ///
+  /// @param [in]  position   global 3D position
+  /// @param [out] derivative gradient of magnetic field vector as (3x3)
+  ///              matrix, with derivative(i, j) = dB_i / dx_j
+  /// @param [in,out] cache Cache object. Contains field cell used for
+  /// interpolation
+  /// @return magnetic field vector
+  Vector3D getFieldGradient(const Vector3D& position,
+                            ActsMatrixD<3, 3>& derivative,
+                            Cache& cache) const {
+    return evaluate(position, cache.fieldCell, &derivative);
+  }
+
+  /// @brief check whether given 3D position is inside look-up domain
+  ///
+  /// @param [in] position global 3D position
+  /// @return @c true if position is inside the defined grid,
+  ///         otherwise @c false
+  bool isInside(const Vector3D& position) const {
+    const ActsVectorD<DIM> local = localPosition(position);
+    for (unsigned int d = 0; d < DIM; ++d) {
+      if (local[d] < m_min[d] or m_max[d] < local[d]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// @brief get the number of grid points for all axes of the field map
+  std::vector<size_t> getNBins() const {
+    return std::vector<size_t>(m_nPoints.begin(), m_nPoints.end());
+  }
+
+  /// @brief get the minimum value of all axes of the field map
+  std::vector<double> getMin() const {
+    return std::vector<double>(m_min.begin(), m_min.end());
+  }
+
+  /// @brief get the maximum value of all axes of the field map
+  std::vector<double> getMax() const {
+    return std::vector<double>(m_max.begin(), m_max.end());
+  }
+
+  /// @brief get the stored field values, in the order of the grid points
+  const StoredType* data() const { return m_values; }
+
+  /// @brief get the number of grid points
+  size_t size() const { return m_nValues; }
+
+ private:
+  using StoredValues =
+      std::vector<StoredType, Eigen::aligned_allocator<StoredType>>;
+
+  /// check the axes and set up the derived quantities
+  void initialize() {
+    m_nValues = 1;
+    for (int d = DIM - 1; 0 <= d; --d) {
+      if (m_nPoints[d] < 2 or not(m_min[d] < m_max[d])) {
+        throw std::invalid_argument("Invalid axis of tabulated field map");
+      }
+      m_strides[d] = m_nValues;
+      m_invWidths[d] = (m_nPoints[d] - 1) / (m_max[d] - m_min[d]);
+      m_nValues *= m_nPoints[d];
+    }
+    // corner c has the offset 1 along axis d if bit (DIM - 1 - d) is set
+    for (unsigned int c = 0; c < N; ++c) {
+      m_cornerOffsets[c] = 0;
+      for (unsigned int d = 0; d < DIM; ++d) {
+        if ((c >> (DIM - 1 - d)) & 1) {
+          m_cornerOffsets[c] += m_strides[d];
+        }
+      }
+    }
+  }
+
+  /// map global 3D coordinates onto the grid space
+  static ActsVectorD<DIM> localPosition(const Vector3D& position) {
+    if constexpr (DIM == 3) {
+      return position;
+    } else {
+      return ActsVectorD<2>(std::hypot(position.x(), position.y()),
+                            position.z());
+    }
+  }
+
+  /// @brief interpolate the field and its gradient
+  ///
+  /// @param [in] position global 3D position
+  /// @param [in,out] cell the cell of the previous call, updated if the
+  ///                 position lies in a different cell
+  /// @param [out] derivative the gradient, not computed if nullptr
+  Vector3D evaluate(const Vector3D& position, FieldCell& cell,
+                    ActsMatrixD<3, 3>* derivative) const {
+    const ActsVectorD<DIM> local = localPosition(position);
+
+    // locate the cell and the fractional position within
+    std::array<double, DIM> frac;
+    size_t index = 0;
+    for (unsigned int d = 0; d < DIM; ++d) {
+      const double u = (local[d] - m_min[d]) * m_invWidths[d];
+      const double bin = std::clamp(std::floor(u), 0., m_nPoints[d] - 2.);
+      frac[d] = u - bin;
+      index += static_cast<size_t>(bin) * m_strides[d];
+    }
+    if (index != cell.index) {
+      cell.index = index;
+      for (unsigned int c = 0; c < N; ++c) {
+        cell.corners.col(c) = m_values[index + m_cornerOffsets[c]];
+      }
+    }
+
+    // interpolation weights of the corners and their derivatives along
+    // the grid axes
+    Eigen::Matrix<double, N, 1> weights;
+    Eigen::Matrix<double, N, DIM> dWeights;
+    for (unsigned int c = 0; c < N; ++c) {
+      weights[c] = 1.;
+      for (unsigned int d = 0; d < DIM; ++d) {
+        const bool upper = (c >> (DIM - 1 - d)) & 1;
+        weights[c] *= upper ? frac[d] : 1. - frac[d];
+        double dw = upper ? m_invWidths[d] : -m_invWidths[d];
+        for (unsigned int e = 0; e < DIM; ++e) {
+          if (e != d) {
+            dw *= ((c >> (DIM - 1 - e)) & 1) ? frac[e] : 1. - frac[e];
+          }
+        }
+        dWeights(c, d) = dw;
+      }
+    }
+
+    const StoredType field = cell.corners * weights;
+    if constexpr (DIM == 3) {
+      if (derivative != nullptr) {
+        *derivative = (cell.corners * dWeights).template topRows<3>();
+      }
+      return field.template head<3>();
+    } else {
+      // map (Br,Bz) -> (Bx,By,Bz)
+      const double r = local[0];
+      double cosPhi = 1., sinPhi = 0.;
+      if (r > std::numeric_limits<double>::min()) {
+        cosPhi = position.x() / r;
+        sinPhi = position.y() / r;
+      }
+      if (derivative != nullptr) {
+        // (dBr/dr, dBz/dr) and (dBr/dz, dBz/dz)
+        const ActsMatrixD<2, 2> localDerivative = cell.corners * dWeights;
+        const double dBrdr = localDerivative(0, 0);
+        const double dBrdz = localDerivative(0, 1);
+        // Br/r, which tends to dBr/dr on the axis
+        const double brOverR = (r > std::numeric_limits<double>::min())
+                                   ? field[0] / r
+                                   : dBrdr;
+        const double mixed = cosPhi * sinPhi * (dBrdr - brOverR);
+        *derivative << dBrdr * cosPhi * cosPhi + brOverR * sinPhi * sinPhi,
+            mixed, dBrdz * cosPhi, mixed,
+            dBrdr * sinPhi * sinPhi + brOverR * cosPhi * cosPhi,
+            dBrdz * sinPhi, localDerivative(1, 0) * cosPhi,
+            localDerivative(1, 0) * sinPhi, localDerivative(1, 1);
+      }
+      return Vector3D(field[0] * cosPhi, field[0] * sinPhi, field[1]);
+    }
+  }
+
+  /// position of the first grid point along each axis
+  std::array<double, DIM> m_min;
+  /// position of the last grid point along each axis
+  std::array<double, DIM> m_max;
+  /// number of grid points along each axis
+  std::array<size_t, DIM> m_nPoints;
+  /// inverse distance of the grid points along each axis
+  std::array<double, DIM> m_invWidths;
+  /// index distance of neighbouring grid points along each axis
+  std::array<size_t, DIM> m_strides;
+  /// index offsets of the corners of a cell w.r.t. its lower-left corner
+  std::array<size_t, N> m_cornerOffsets;
+  /// number of grid points
+  size_t m_nValues = 0;
+  /// owner of the field values, shared between copies
+  std::shared_ptr<const void> m_storage;
+  /// field values at the grid points
+  const StoredType* m_values = nullptr;
+};
+
+/// Tabulated (x,y,z) field map
+using TabulatedBFieldMapXYZ = TabulatedBFieldMap<3>;
+/// Tabulated (r,z) field map
+using TabulatedBFieldMapRZ = TabulatedBFieldMap<2>;
+
+}  // namespace Acts
@@ -0,0 +1,76 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "Acts/MagneticField/TabulatedBFieldMap.hpp"
+
+/// Binary file format for tabulated magnetic field maps.
+///
+/// The file consists of a header of fixed size followed by the field values
+/// exactly as they are stored by Acts::TabulatedBFieldMap, i.e. padded and
+/// in the native byte order. A file can therefore be memory-mapped read-only
+/// and the field values used in place: loading is independent of the size of
+/// the map, and processes mapping the same file share the physical pages.
+
+namespace Acts {
+
+/// @brief header of the binary field map file
+struct TabulatedBFieldMapHeader {
+  /// identifies the file format
+  static constexpr char kMagic[8] = "ACTSBFM";
+  /// current version of the format
+  static constexpr uint32_t kVersion = 1;
+  /// written in native byte order to detect foreign files
+  static constexpr uint32_t kByteOrderMark = 0x01020304;
+
+  char magic[8] = {};
+  uint32_t version = kVersion;
+  uint32_t byteOrderMark = kByteOrderMark;
+  /// dimension of the grid, 3 for (x,y,z) and 2 for (r,z)
+  uint32_t dim = 0;
+  /// number of stored doubles per grid point
+  uint32_t valueDim = 0;
+  /// number of grid points along each axis, unused axes are zero
+  uint64_t nPoints[3] = {0, 0, 0};
+  /// position of the first grid point along each axis
+  double min[3] = {0., 0., 0.};
+  /// position of the last grid point along each axis
+  double max[3] = {0., 0., 0.};
+  /// pads the header such that the field values are aligned
+  char reserved[32] = {};
+};
+static_assert(sizeof(TabulatedBFieldMapHeader) == 128,
+              "Header size is part of the file format");
+
+/// Write a tabulated field map to a binary file
+///
+/// @param path of the output file, overwritten if it exists
+/// @param field the field map
+///
+/// @throw std::runtime_error if the file can not be written
+template <unsigned int DIM>
+void writeTabulatedBFieldMap(const std::string& path,
+                             const TabulatedBFieldMap<DIM>& field);
+
+/// Memory-map a binary field map file read-only
+///
+/// The returned map, and all of its copies, use the mapped field values in
+/// place. The mapping is released with the last copy.
+///
+/// @param path of the input file
+///
+/// @throw std::runtime_error if the file can not be mapped or is not a
+///        valid field map of dimension @p DIM
+template <unsigned int DIM>
+TabulatedBFieldMap<DIM> mapTabulatedBFieldMap(const std::string& path);
+
+}  // namespace Acts
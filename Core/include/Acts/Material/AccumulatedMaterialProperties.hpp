@@ -77,6 +77,15 @@ class AccumulatedMaterialProperties {
   /// @param pathCorreciton is the correction to nominal incident
   void accumulate(const MaterialProperties& amp, double pathCorrection = 1.);
 
+  /// Merge the information accumulated by another instance
+  ///
+  /// All stores are plain sums, the merged result is therefore identical
+  /// to having accumulated the material of both instances into this one.
+  /// This allows to map material with one instance per thread.
+  ///
+  /// @param amp the source Accumulated properties
+  void merge(const AccumulatedMaterialProperties& amp);
+
   /// Average the information accumulated for one track
   /// - in case of an empty hit this will just increase the event counter
   /// @param emtpyHit indicate an empty hit
@@ -127,6 +136,24 @@ inline void AccumulatedMaterialProperties::accumulate(
   m_eventPathCorrection += pathCorrection * t;
 }
 
+inline void AccumulatedMaterialProperties::merge(
+    const AccumulatedMaterialProperties& amp) {
+  m_eventPathInX0 += amp.m_eventPathInX0;
+  m_eventPathInL0 += amp.m_eventPathInL0;
+  m_eventAr += amp.m_eventAr;
+  m_eventZ += amp.m_eventZ;
+  m_eventRho += amp.m_eventRho;
+  m_eventPath += amp.m_eventPath;
+  m_eventPathCorrection += amp.m_eventPathCorrection;
+
+  m_totalPathInX0 += amp.m_totalPathInX0;
+  m_totalPathInL0 += amp.m_totalPathInL0;
+  m_totalAr += amp.m_totalAr;
+  m_totalZ += amp.m_totalZ;
+  m_totalRho += amp.m_totalRho;
+  m_totalEvents += amp.m_totalEvents;
+}
+
 inline void AccumulatedMaterialProperties::trackAverage(bool emptyHit) {
   // Increase the total event count either for empty hit or by touched hit
   if (emptyHit || m_eventPath > 0.) {
@@ -115,6 +115,13 @@ class AccumulatedSurfaceMaterial {
   /// @param emptyHit indicator if this is an empty assignment
   void trackAverage(const Vector3D& gp, bool emptyHit = false);
 
+  /// Merge the material accumulated by another instance, bin by bin
+  ///
+  /// @param asma is the source object, it must have the same binning
+  ///
+  /// @throw std::invalid_argument if the binning does not match
+  void merge(const AccumulatedSurfaceMaterial& asma);
+
   /// Total average creates SurfaceMaterial
   std::unique_ptr<const ISurfaceMaterial> totalAverage();
 
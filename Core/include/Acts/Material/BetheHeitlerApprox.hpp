@@ -0,0 +1,78 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace Acts {
+
+/// Gaussian mixture approximation of the Bethe-Heitler distribution.
+///
+/// The Bethe-Heitler model describes the fraction z = E_final/E_initial of
+/// the energy kept by an electron traversing a material slab of thickness t
+/// (in units of the radiation length) via bremsstrahlung
+///
+///     f(z) = (-ln z)^(c - 1) / Gamma(c),  c = t / ln 2
+///
+/// The distribution is split into components of equal probability along z.
+/// Each component is described by its weight and the mean and variance of z
+/// within its range. The mixtures are tabulated on an equidistant grid in t
+/// and linearly interpolated, such that the lookup during the track fit is
+/// cheap; slabs thicker than the tabulated range are computed on demand.
+class BetheHeitlerApprox {
+ public:
+  /// A single component of the mixture.
+  struct Component {
+    /// Weight of the component, all weights add up to one
+    float weight = 0.f;
+    /// Mean of the energy fraction z
+    float mean = 1.f;
+    /// Variance of the energy fraction z
+    float variance = 0.f;
+  };
+
+  /// Construct and fill the lookup table.
+  ///
+  /// @param nComponents Number of components of the mixture
+  /// @param maxThicknessInX0 Maximum tabulated thickness in radiation lengths
+  /// @param nBins Number of thickness bins of the table
+  BetheHeitlerApprox(size_t nComponents = 6, float maxThicknessInX0 = 0.2f,
+                     size_t nBins = 100);
+
+  /// Number of components of the mixture
+  size_t numComponents() const { return m_nComponents; }
+
+  /// Maximum tabulated thickness in radiation lengths
+  float maxThicknessInX0() const { return m_maxThicknessInX0; }
+
+  /// Get the mixture for a given material thickness.
+  ///
+  /// @param thicknessInX0 The traversed thickness in radiation lengths
+  /// @param [out] mixture The mixture components, previous content is
+  ///        replaced
+  void mixture(float thicknessInX0, std::vector<Component>& mixture) const;
+
+  /// Compute the mixture for a given material thickness without table.
+  ///
+  /// @param thicknessInX0 The traversed thickness in radiation lengths
+  /// @param nComponents Number of components of the mixture
+  /// @param [out] mixture Output for @p nComponents components
+  static void computeMixture(float thicknessInX0, size_t nComponents,
+                             Component* mixture);
+
+ private:
+  size_t m_nComponents;
+  float m_maxThicknessInX0;
+  size_t m_nBins;
+  /// Mixtures for the nBins + 1 grid points, one after the other
+  std::vector<Component> m_table;
+};
+
+}  // namespace Acts
@@ -0,0 +1,72 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <string>
+
+#include "Acts/Geometry/TrackingVolume.hpp"
+#include "Acts/Material/BinaryMaterialMap.hpp"
+#include "Acts/Material/IMaterialDecorator.hpp"
+#include "Acts/Surfaces/Surface.hpp"
+
+namespace Acts {
+
+/// @brief Material decorator from the binary material map format
+///
+/// The file is memory-mapped and the material of a surface or volume is
+/// only decoded when the surface or volume is decorated.
+class BinaryMaterialDecorator : public IMaterialDecorator {
+ public:
+  /// Constructor
+  ///
+  /// @param fileName is the binary material map file
+  /// @param clearSurfaceMaterial removes existing surface material first
+  /// @param clearVolumeMaterial removes existing volume material first
+  BinaryMaterialDecorator(const std::string& fileName,
+                          bool clearSurfaceMaterial = true,
+                          bool clearVolumeMaterial = true)
+      : m_reader(fileName),
+        m_clearSurfaceMaterial(clearSurfaceMaterial),
+        m_clearVolumeMaterial(clearVolumeMaterial) {}
+
+  /// Decorate a surface
+  ///
+  /// @param surface the non-cost surface that is decorated
+  void decorate(Surface& surface) const final {
+    // Clear the material if registered to do so
+    if (m_clearSurfaceMaterial) {
+      surface.assignSurfaceMaterial(nullptr);
+    }
+    auto sMaterial = m_reader.surfaceMaterial(surface.geoID());
+    if (sMaterial != nullptr) {
+      surface.assignSurfaceMaterial(std::move(sMaterial));
+    }
+  }
+
+  /// Decorate a TrackingVolume
+  ///
+  /// @param volume the non-cost volume that is decorated
+  void decorate(TrackingVolume& volume) const final {
+    // Clear the material if registered to do so
+    if (m_clearVolumeMaterial) {
+      volume.assignVolumeMaterial(nullptr);
+    }
+    auto vMaterial = m_reader.volumeMaterial(volume.geoID());
+    if (vMaterial != nullptr) {
+      volume.assignVolumeMaterial(std::move(vMaterial));
+    }
+  }
+
+ private:
+  BinaryMaterialMap::Reader m_reader;
+
+  bool m_clearSurfaceMaterial{true};
+  bool m_clearVolumeMaterial{true};
+};
+}  // namespace Acts
@@ -0,0 +1,167 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "Acts/Geometry/GeometryID.hpp"
+#include "Acts/Material/ISurfaceMaterial.hpp"
+#include "Acts/Material/IVolumeMaterial.hpp"
+
+namespace Acts {
+
+/// @brief Binary file format for surface and volume material maps
+///
+/// The file consists of a header, the serialized material objects and an
+/// index sorted by GeometryID:
+///
+///     Header | record 0 | record 1 | ... | IndexEntry[nEntries]
+///
+/// All numbers are written in native byte order, a byte order mark in the
+/// header rejects foreign files. Each record holds exactly one material
+/// object and can be decoded independently of the others, such that a
+/// reader only needs to touch the index and the requested records.
+///
+/// Supported material types are HomogeneousSurfaceMaterial,
+/// BinnedSurfaceMaterial and ProtoSurfaceMaterial for surfaces and
+/// HomogeneousVolumeMaterial for volumes.
+namespace BinaryMaterialMap {
+
+using SurfaceMaterialMap =
+    std::map<GeometryID, std::shared_ptr<const ISurfaceMaterial>>;
+using VolumeMaterialMap =
+    std::map<GeometryID, std::shared_ptr<const IVolumeMaterial>>;
+using DetectorMaterialMaps = std::pair<SurfaceMaterialMap, VolumeMaterialMap>;
+
+/// Type of a serialized material object
+enum class RecordType : uint32_t {
+  HomogeneousSurface = 1,
+  BinnedSurface = 2,
+  ProtoSurface = 3,
+  HomogeneousVolume = 4,
+};
+
+/// @brief header at the start of the file
+struct Header {
+  /// identifies the file format
+  static constexpr char kMagic[8] = "ACTSMAT";
+  /// current version of the format
+  static constexpr uint32_t kVersion = 1;
+  /// written in native byte order to detect foreign files
+  static constexpr uint32_t kByteOrderMark = 0x01020304;
+
+  char magic[8] = {};
+  uint32_t version = kVersion;
+  uint32_t byteOrderMark = kByteOrderMark;
+  /// number of entries in the index
+  uint64_t nEntries = 0;
+  /// position of the index in the file
+  uint64_t indexOffset = 0;
+  char reserved[32] = {};
+};
+static_assert(sizeof(Header) == 64, "Header size is part of the file format");
+
+/// @brief index entry locating one record
+///
+/// The entries of the surface material come first, followed by the volume
+/// material, each sorted by GeometryID.
+struct IndexEntry {
+  /// the encoded GeometryID
+  uint64_t geoID = 0;
+  /// 0 for surface material, 1 for volume material
+  uint32_t isVolume = 0;
+  /// the RecordType
+  uint32_t type = 0;
+  /// position of the record in the file
+  uint64_t offset = 0;
+  /// size of the record in bytes
+  uint64_t size = 0;
+};
+static_assert(sizeof(IndexEntry) == 32, "Index size is part of the format");
+
+/// Write material maps to a binary file
+///
+/// @param path of the output file, overwritten if it exists
+/// @param maps the surface and volume material maps
+///
+/// @throw std::invalid_argument for unsupported material types
+/// @throw std::runtime_error if the file can not be written
+void write(const std::string& path, const DetectorMaterialMaps& maps);
+
+/// @brief Lazy reader of binary material map files
+///
+/// The file is memory-mapped read-only, the material objects are only
+/// decoded when they are requested.
+class Reader {
+ public:
+  /// Map the file and validate the header and the index
+  ///
+  /// @param path of the input file
+  ///
+  /// @throw std::runtime_error if the file is not a valid material map
+  explicit Reader(const std::string& path);
+
+  /// Number of surfaces with material
+  size_t numSurfaces() const { return m_nSurfaces; }
+
+  /// Number of volumes with material
+  size_t numVolumes() const { return m_nEntries - m_nSurfaces; }
+
+  /// Decode the material of a single surface
+  ///
+  /// @param geoID of the surface
+  /// @return the material, nullptr if there is none
+  std::shared_ptr<const ISurfaceMaterial> surfaceMaterial(
+      GeometryID geoID) const;
+
+  /// Decode the material of a single volume
+  ///
+  /// @param geoID of the volume
+  /// @return the material, nullptr if there is none
+  std::shared_ptr<const IVolumeMaterial> volumeMaterial(
+      GeometryID geoID) const;
+
+  /// Decode all material belonging to one volume, i.e. the material of its
+  /// boundaries, layers and sensitive surfaces and the volume material
+  ///
+  /// @param volume identifier of the volume
+  DetectorMaterialMaps readVolume(GeometryID::Value volume) const;
+
+  /// Decode the complete file
+  DetectorMaterialMaps read() const;
+
+ private:
+  /// Decode the record of an index entry
+  std::shared_ptr<const ISurfaceMaterial> decodeSurface(
+      const IndexEntry& entry) const;
+  std::shared_ptr<const IVolumeMaterial> decodeVolume(
+      const IndexEntry& entry) const;
+
+  /// Decode all index entries in [begin, end)
+  DetectorMaterialMaps decodeRange(const IndexEntry* begin,
+                                   const IndexEntry* end) const;
+
+  /// Owner of the mapping
+  std::shared_ptr<const void> m_mapping;
+  /// The mapped file
+  const char* m_data = nullptr;
+  /// The index, surfaces first
+  const IndexEntry* m_index = nullptr;
+  size_t m_nEntries = 0;
+  size_t m_nSurfaces = 0;
+  /// The path for error messages
+  std::string m_path;
+};
+
+}  // namespace BinaryMaterialMap
+}  // namespace Acts
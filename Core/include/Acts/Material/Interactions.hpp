@@ -8,7 +8,9 @@
 
 #pragma once
 
+#include <cstdint>
 #include <utility>
+#include <vector>
 
 #include "Acts/Material/MaterialProperties.hpp"
 #include "Acts/Utilities/Units.hpp"
@@ -137,4 +139,114 @@ float computeMultipleScatteringTheta0(const MaterialProperties& slab, int pdg,
                                       float m, float qOverP,
                                       float q = UnitConstants::e);
 
+/// Material slab constants for the batched interaction computations.
+///
+/// Stores the quantities of each slab that enter the energy loss and
+/// multiple scattering computations, including their logarithms, as
+/// separate arrays. The table is filled once, e.g. for all material slabs of
+/// a geometry, and is then referenced by index from the batched computations.
+struct InteractionSlabTable {
+  /// Bethe prefactor (K/2) * (Z/A)*rho * x without the q²/beta² term
+  std::vector<float> epsilonFactor;
+  /// Logarithm of the mean excitation energy
+  std::vector<float> logI;
+  /// Constant part log(E_plasma/I) - 1/2 of the density correction delta/2
+  std::vector<float> deltaHalfOffset;
+  /// Thickness in units of the radiation length
+  std::vector<float> thicknessInX0;
+  /// The thickness dependent term of the Rossi-Greisen formula
+  std::vector<float> rossiGreisenFactor;
+  /// Whether the slab contains material
+  std::vector<uint8_t> valid;
+
+  InteractionSlabTable() = default;
+  /// Construct from a list of slabs, the index is the position in the list.
+  ///
+  /// @param slabs are the material slabs
+  InteractionSlabTable(const std::vector<MaterialProperties>& slabs);
+
+  /// Add a slab to the table.
+  ///
+  /// @param slab The material slab to be added
+  /// @return Index of the slab in the table
+  size_t add(const MaterialProperties& slab);
+  /// Number of slabs in the table.
+  size_t size() const { return valid.size(); }
+};
+
+/// Particles crossing material slabs, stored as separate arrays.
+///
+/// Each entry references a slab of an InteractionSlabTable by its index.
+struct InteractionBatch {
+  std::vector<uint32_t> slab;
+  std::vector<int> pdg;
+  std::vector<float> mass;
+  std::vector<float> qOverP;
+  std::vector<float> charge;
+
+  /// Add a particle crossing a slab.
+  ///
+  /// @param slabIndex Index of the slab in the table
+  /// @param pdg_      Particle type PDG identifier
+  /// @param m         Particle mass
+  /// @param qOverP_   Particle charge divided by absolute momentum
+  /// @param q         Particle charge
+  void add(size_t slabIndex, int pdg_, float m, float qOverP_,
+           float q = UnitConstants::e) {
+    slab.push_back(slabIndex);
+    pdg.push_back(pdg_);
+    mass.push_back(m);
+    qOverP.push_back(qOverP_);
+    charge.push_back(q);
+  }
+  /// Number of entries in the batch.
+  size_t size() const { return slab.size(); }
+  /// Remove all entries but keep the allocated memory.
+  void clear() {
+    slab.clear();
+    pdg.clear();
+    mass.clear();
+    qOverP.clear();
+    charge.clear();
+  }
+};
+
+/// Compute the mean ionisation energy loss for a batch of particles.
+///
+/// @param table  The material slabs referenced by the batch
+/// @param batch  The particles and the slabs they cross
+/// @param[out] energyLoss The energy loss per batch entry
+///
+/// The batch is evaluated in fixed-size blocks using vectorized math; the
+/// results agree with computeEnergyLossBethe within float precision.
+void computeEnergyLossBethe(const InteractionSlabTable& table,
+                            const InteractionBatch& batch,
+                            std::vector<float>& energyLoss);
+/// Derivative of the Bethe energy loss with respect to q/p for a batch.
+///
+/// @see computeEnergyLossBethe for parameters description
+void deriveEnergyLossBetheQOverP(const InteractionSlabTable& table,
+                                 const InteractionBatch& batch,
+                                 std::vector<float>& derivative);
+/// Compute the most probable ionisation energy loss for a batch.
+///
+/// @see computeEnergyLossBethe for parameters description
+void computeEnergyLossLandau(const InteractionSlabTable& table,
+                             const InteractionBatch& batch,
+                             std::vector<float>& energyLoss);
+/// Derivative of the most probable energy loss with respect to q/p.
+///
+/// @see computeEnergyLossBethe for parameters description
+void deriveEnergyLossLandauQOverP(const InteractionSlabTable& table,
+                                  const InteractionBatch& batch,
+                                  std::vector<float>& derivative);
+/// Compute the multiple scattering core width for a batch.
+///
+/// @param table  The material slabs referenced by the batch
+/// @param batch  The particles and the slabs they cross
+/// @param[out] theta0 The scattering width per batch entry
+void computeMultipleScatteringTheta0(const InteractionSlabTable& table,
+                                     const InteractionBatch& batch,
+                                     std::vector<float>& theta0);
+
 }  // namespace Acts
@@ -48,8 +48,8 @@ struct MaterialSurface {
 ///     ProtoSurfaceMaterial a local store is initialized
 ///     the identification is done hereby through the Surface::GeometryID
 ///
-///  2) A Cache is generated that is used to keep the filling thread local,
-///     the filling is protected with std::mutex
+///  2) A State is generated that is used to keep the filling thread local,
+///     states filled by different threads are merged afterwards
 ///
 ///  3) A number of N material tracks is read in, each track has :
 ///       origin, direction, material steps < position, step length, x0, l0, a,
@@ -142,7 +142,37 @@ class SurfaceMaterialMapper {
   /// to be ordered from the starting position along the starting direction
   void mapMaterialTrack(State& mState, RecordedMaterialTrack& mTrack) const;
 
+  /// Process/map a collection of tracks using several threads
+  ///
+  /// The tracks are split into one contiguous block per thread. Each block
+  /// is mapped into its own copy of the state, the copies are merged into
+  /// the given state in block order afterwards. The result is therefore
+  /// reproducible for a given number of threads.
+  ///
+  /// @param mState The current state map
+  /// @param mTracks The material tracks to be mapped
+  /// @param nThreads The number of threads, 0 means all hardware threads
+  void mapMaterialTracks(State& mState,
+                         std::vector<RecordedMaterialTrack>& mTracks,
+                         size_t nThreads = 0) const;
+
+  /// @brief Merge the material accumulated in another state
+  ///
+  /// @param mState The state to be merged into
+  /// @param other The source state, it must have been created for the same
+  ///        geometry and not be finalized
+  ///
+  /// @throw std::invalid_argument if the states do not match
+  void mergeState(State& mState, const State& other) const;
+
  private:
+  /// @brief create a state with the binning of another one
+  ///
+  /// @param mState The prototype state
+  ///
+  /// @return a state with the same contexts and surfaces, but no material
+  State emptyCopy(const State& mState) const;
+
   /// @brief finds all surfaces with ProtoSurfaceMaterial of a volume
   ///
   /// @param mState The state to be filled
@@ -272,7 +272,7 @@ class AtlasStepper {
     // accummulated path length cache
     double pathAccumulated = 0.;
     // Starting time
-    const double t0;
+    double t0;
 
     // Adaptive step size of the runge-kutta integration
     ConstrainedStep stepSize = std::numeric_limits<double>::max();
@@ -0,0 +1,567 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "Acts/EventData/TrackParameters.hpp"
+#include "Acts/MagneticField/MagneticFieldContext.hpp"
+#include "Acts/Propagator/EigenStepper.hpp"
+#include "Acts/Propagator/EigenStepperError.hpp"
+#include "Acts/Propagator/detail/SteppingHelper.hpp"
+#include "Acts/Utilities/Definitions.hpp"
+#include "Acts/Utilities/Intersection.hpp"
+#include "Acts/Utilities/Result.hpp"
+#include "Acts/Utilities/Units.hpp"
+
+namespace Acts {
+
+/// @brief Runge-Kutta-Nystroem stepper for a bundle of tracks
+///
+/// Solves the same equations of motion as the EigenStepper, but for K tracks
+/// at once. The positions, directions and momenta of the tracks are gathered
+/// as structure of arrays, i.e. one column per track, and each stage of the
+/// RKN4 integration is evaluated for all tracks with Eigen array expressions.
+/// The magnetic field is queried with one cache shared by the whole bundle,
+/// such that tracks which are close to each other reuse the cached field
+/// cell. Each track keeps its own adaptive step size, a step is repeated
+/// with reduced step sizes for the tracks whose error estimate is too large.
+///
+/// The stepper fulfills the StepperConcept and is used with the Propagator.
+/// The navigation follows the weighted mean of the bundle, which is what the
+/// single track accessors return. Every track is stepped onto each surface
+/// the bundle reaches: tracks which arrived first wait on the surface until
+/// the others caught up. The covariance of every track is transported, the
+/// bound and curvilinear states of the bundle combine those of the tracks.
+/// Individual tracks are accessed with the accessors taking a track index.
+///
+/// @note The tracks of a bundle have to be close enough to cross the same
+/// surfaces, e.g. the components of a Gaussian mixture.
+template <typename bfield_t>
+class MultiEigenStepper {
+ public:
+  /// Jacobian, Covariance and State defintions
+  using Jacobian = BoundMatrix;
+  using Covariance = BoundSymMatrix;
+  using BoundState = std::tuple<BoundParameters, Jacobian, double>;
+  using CurvilinearState = std::tuple<CurvilinearParameters, Jacobian, double>;
+  using BField = bfield_t;
+
+  /// The stepper used for the transport of the individual tracks
+  using SingleStepper = EigenStepper<bfield_t>;
+  using SingleState = typename SingleStepper::State;
+
+  /// One column per track
+  using Vectors = Eigen::Array<double, 3, Eigen::Dynamic>;
+  using Scalars = Eigen::Array<double, 1, Eigen::Dynamic>;
+
+  /// @brief State for the propagation of a bundle of tracks
+  ///
+  /// It contains the stepping information of every track and is provided
+  /// thread local by the propagator
+  struct State {
+    /// Default constructor - deleted
+    State() = delete;
+
+    /// Constructor from the initial track parameters of a single track
+    ///
+    /// @param [in] gctx is the context object for the geometry
+    /// @param [in] mctx is the context object for the magnetic field
+    /// @param [in] par The track parameters at start
+    /// @param [in] ndir The navigation direciton w.r.t momentum
+    /// @param [in] ssize is the maximum step size
+    /// @param [in] stolerance is the stepping tolerance
+    template <typename parameters_t>
+    explicit State(std::reference_wrapper<const GeometryContext> gctx,
+                   std::reference_wrapper<const MagneticFieldContext> mctx,
+                   const parameters_t& par, NavigationDirection ndir = forward,
+                   double ssize = std::numeric_limits<double>::max(),
+                   double stolerance = s_onSurfaceTolerance)
+        : State(gctx, mctx, std::vector<parameters_t>{par}, ndir, ssize,
+                stolerance) {}
+
+    /// Constructor from the initial track parameters of the bundle
+    ///
+    /// @param [in] gctx is the context object for the geometry
+    /// @param [in] mctx is the context object for the magnetic field
+    /// @param [in] pars The track parameters at start, one per track, the
+    ///        tracks are weighted equally
+    /// @param [in] ndir The navigation direciton w.r.t momentum
+    /// @param [in] ssize is the maximum step size
+    /// @param [in] stolerance is the stepping tolerance
+    template <typename parameters_t>
+    State(std::reference_wrapper<const GeometryContext> gctx,
+          std::reference_wrapper<const MagneticFieldContext> mctx,
+          const std::vector<parameters_t>& pars,
+          NavigationDirection ndir = forward,
+          double ssize = std::numeric_limits<double>::max(),
+          double stolerance = s_onSurfaceTolerance)
+        : magFieldContext(mctx),
+          navDir(ndir),
+          stepSize(ndir * std::abs(ssize)),
+          tolerance(stolerance),
+          fieldCache(mctx),
+          geoContext(gctx) {
+      if (pars.empty()) {
+        throw std::invalid_argument("Bundle of tracks without tracks");
+      }
+      tracks.reserve(pars.size());
+      for (const auto& par : pars) {
+        tracks.emplace_back(gctx, mctx, par, ndir, ssize, stolerance);
+      }
+      weights = Scalars::Constant(pars.size(), 1. / pars.size());
+      covTransport = tracks.front().covTransport;
+    }
+
+    /// The stepping states of the tracks
+    std::vector<SingleState> tracks;
+
+    /// The weights of the tracks, normalized to one
+    Scalars weights;
+
+    /// The context object for the magnetic field
+    std::reference_wrapper<const MagneticFieldContext> magFieldContext;
+
+    /// Navigation direction, this is needed for searching
+    NavigationDirection navDir;
+
+    /// Covariance matrix (and indicator) of the bundle, combined from the
+    /// tracks with the last bound or curvilinear state
+    bool covTransport = false;
+    Covariance cov = Covariance::Zero();
+
+    /// Accummulated path length of the bundle, the weighted mean of the
+    /// path lengths of the tracks
+    double pathAccumulated = 0.;
+
+    /// Step size of the bundle, the actor, aborter and user constraints are
+    /// applied to every track
+    ConstrainedStep stepSize{std::numeric_limits<double>::max()};
+
+    /// Last performed step (for overstep limit calculation)
+    double previousStepSize = 0.;
+
+    /// The tolerance for the stepping
+    double tolerance = s_onSurfaceTolerance;
+
+    /// Field cache shared by all tracks of the bundle
+    typename BField::Cache fieldCache;
+
+    /// The geometry context
+    std::reference_wrapper<const GeometryContext> geoContext;
+
+    /// The surface status of every track with the last surface
+    std::vector<Intersection::Status> surfaceStatus;
+
+    /// @brief Storage of the sub steps during a RKN4 step of several tracks
+    struct StepData {
+      /// Positions, directions and q/p at the start of the step
+      Vectors pos0, dir0;
+      Scalars qop;
+      /// Step sizes and local integration errors
+      Scalars h, errorEstimate;
+      /// Magnetic field evaluations
+      Vectors B_first, B_middle, B_last;
+      /// k_i of the RKN4 algorithm
+      Vectors k1, k2, k3, k4;
+      /// Intermediate positions and directions
+      Vectors pos, dir;
+    };
+
+    /// The sub steps of all tracks
+    StepData stepData;
+    /// The sub steps of the tracks which repeat a step with a smaller size
+    StepData retryData;
+    /// Indices of the tracks which repeat a step with a smaller size
+    std::vector<Eigen::Index> retryTracks;
+  };
+
+  /// Constructor requires knowledge of the detector's magnetic field
+  MultiEigenStepper(BField bField = BField())
+      : m_bField(bField), m_single(std::move(bField)) {}
+
+  /// Number of tracks in the bundle
+  ///
+  /// @param state [in] The stepping state (thread-local cache)
+  size_t size(const State& state) const { return state.tracks.size(); }
+
+  /// Get the field for the stepping, using the cache of the bundle
+  ///
+  /// @param [in,out] state is the propagation state associated with the track
+  ///                 the magnetic field cell is used (and potentially updated)
+  /// @param [in] pos is the field position
+  Vector3D getField(State& state, const Vector3D& pos) const {
+    return m_bField.getField(pos, state.fieldCache);
+  }
+
+  /// Get the field for all tracks of the bundle
+  ///
+  /// @param [in,out] state is the stepping state, the field cache is shared
+  ///                 by all tracks and potentially updated
+  /// @param [in] pos are the field positions, one column per track
+  /// @param [out] field are the field values, one column per track
+  void getField(State& state, const Vectors& pos, Vectors& field) const {
+    field.resize(3, pos.cols());
+    for (Eigen::Index i = 0; i < pos.cols(); ++i) {
+      field.col(i) = m_bField.getField(pos.col(i).matrix(), state.fieldCache);
+    }
+  }
+
+  /// Global particle position accessor, weighted mean of the bundle
+  ///
+  /// @param state [in] The stepping state (thread-local cache)
+  Vector3D position(const State& state) const {
+    Vector3D pos = Vector3D::Zero();
+    for (size_t i = 0; i < state.tracks.size(); ++i) {
+      pos += state.weights[i] * state.tracks[i].pos;
+    }
+    return pos;
+  }
+
+  /// Momentum direction accessor, weighted mean of the bundle
+  ///
+  /// @param state [in] The stepping state (thread-local cache)
+  Vector3D direction(const State& state) const {
+    Vector3D dir = Vector3D::Zero();
+    for (size_t i = 0; i < state.tracks.size(); ++i) {
+      dir += state.weights[i] * state.tracks[i].dir;
+    }
+    return dir.normalized();
+  }
+
+  /// Actual momentum accessor, weighted mean of the bundle
+  ///
+  /// @param state [in] The stepping state (thread-local cache)
+  double momentum(const State& state) const {
+    double p = 0.;
+    for (size_t i = 0; i < state.tracks.size(); ++i) {
+      p += state.weights[i] * state.tracks[i].p;
+    }
+    return p;
+  }
+
+  /// Charge access, weighted mean of the bundle
+  ///
+  /// @param state [in] The stepping state (thread-local cache)
+  double charge(const State& state) const {
+    double q = 0.;
+    for (size_t i = 0; i < state.tracks.size(); ++i) {
+      q += state.weights[i] * state.tracks[i].q;
+    }
+    return q;
+  }
+
+  /// Time access, weighted mean of the bundle
+  ///
+  /// @param state [in] The stepping state (thread-local cache)
+  double time(const State& state) const {
+    double t = 0.;
+    for (size_t i = 0; i < state.tracks.size(); ++i) {
+      t += state.weights[i] * state.tracks[i].t;
+    }
+    return t;
+  }
+
+  /// Global particle position accessor
+  ///
+  /// @param state [in] The stepping state (thread-local cache)
+  /// @param i [in] The index of the track
+  Vector3D position(const State& state, size_t i) const {
+    return state.tracks[i].pos;
+  }
+
+  /// Momentum direction accessor
+  ///
+  /// @param state [in] The stepping state (thread-local cache)
+  /// @param i [in] The index of the track
+  Vector3D direction(const State& state, size_t i) const {
+    return state.tracks[i].dir;
+  }
+
+  /// Actual momentum accessor
+  ///
+  /// @param state [in] The stepping state (thread-local cache)
+  /// @param i [in] The index of the track
+  double momentum(const State& state, size_t i) const {
+    return state.tracks[i].p;
+  }
+
+  /// Charge access
+  ///
+  /// @param state [in] The stepping state (thread-local cache)
+  /// @param i [in] The index of the track
+  double charge(const State& state, size_t i) const {
+    return state.tracks[i].q;
+  }
+
+  /// Time access
+  ///
+  /// @param state [in] The stepping state (thread-local cache)
+  /// @param i [in] The index of the track
+  double time(const State& state, size_t i) const { return state.tracks[i].t; }
+
+  /// Weight access
+  ///
+  /// @param state [in] The stepping state (thread-local cache)
+  /// @param i [in] The index of the track
+  double weight(const State& state, size_t i) const {
+    return state.weights[i];
+  }
+
+  /// Update surface status
+  ///
+  /// The boundary check is done for the mean of the bundle. Every track is
+  /// then intersected with the surface and its step size updated. Tracks
+  /// which are on the surface, or cannot reach it, wait until the other
+  /// tracks are on the surface as well.
+  ///
+  /// @param state [in,out] The stepping state (thread-local cache)
+  /// @param surface [in] The surface provided
+  /// @param bcheck [in] The boundary check for this status update
+  Intersection::Status updateSurfaceStatus(State& state, const Surface& surface,
+                                           const BoundaryCheck& bcheck) const;
+
+  /// Update step size
+  ///
+  /// This method intersect the provided surface with every track and
+  /// updates the step sizes accordingly (hence it changes the state).
+  ///
+  /// @param state [in,out] The stepping state (thread-local cache)
+  /// @param oIntersection [in] The ObjectIntersection to layer, boundary, etc
+  /// @param release [in] boolean to trigger step size release
+  template <typename object_intersection_t>
+  void updateStepSize(State& state, const object_intersection_t& oIntersection,
+                      bool release = true) const {
+    const double stepSize = oIntersection.intersection.pathLength;
+    state.stepSize.update(stepSize, ConstrainedStep::actor, release);
+    for (auto& track : state.tracks) {
+      // The solution ahead of the track, the bundle one if there is none
+      auto sIntersection = oIntersection.representation->intersect(
+          state.geoContext, track.pos, state.navDir * track.dir, false);
+      const double oLimit = m_single.overstepLimit(track);
+      double trackStepSize = stepSize;
+      if (sIntersection.intersection and
+          sIntersection.intersection.pathLength > oLimit) {
+        trackStepSize = state.navDir * sIntersection.intersection.pathLength;
+      } else if (sIntersection.alternative and
+                 sIntersection.alternative.pathLength > oLimit) {
+        trackStepSize = state.navDir * sIntersection.alternative.pathLength;
+      }
+      track.stepSize.update(trackStepSize, ConstrainedStep::actor, release);
+    }
+  }
+
+  /// Set Step size - explicitely with a double
+  ///
+  /// @param state [in,out] The stepping state (thread-local cache)
+  /// @param stepSize [in] The step size value
+  /// @param stype [in] The step size type to be set
+  void setStepSize(State& state, double stepSize,
+                   ConstrainedStep::Type stype = ConstrainedStep::actor) const {
+    state.previousStepSize = state.stepSize;
+    state.stepSize.update(stepSize, stype, true);
+    for (auto& track : state.tracks) {
+      m_single.setStepSize(track, stepSize, stype);
+    }
+  }
+
+  /// Release the Step size
+  ///
+  /// @param state [in,out] The stepping state (thread-local cache)
+  void releaseStepSize(State& state) const {
+    state.stepSize.release(ConstrainedStep::actor);
+    for (auto& track : state.tracks) {
+      m_single.releaseStepSize(track);
+    }
+  }
+
+  /// Output the Step Size of the bundle
+  ///
+  /// @param state [in,out] The stepping state (thread-local cache)
+  std::string outputStepSize(const State& state) const {
+    return state.stepSize.toString();
+  }
+
+  /// Overstep limit
+  ///
+  /// @param state [in] The stepping state (thread-local cache)
+  double overstepLimit(const State& state) const {
+    return m_single.overstepLimit(state.tracks.front());
+  }
+
+  /// Create and return the bound state of the bundle at the current position
+  ///
+  /// @brief This transports (if necessary) the covariance of every track
+  /// to the surface and combines the bound states of the tracks, i.e. the
+  /// parameters and covariance are the mean and covariance of the weighted
+  /// mixture of the tracks, the jacobian is the weighted mean. It does not
+  /// check if the tracks are at the surface, this needs to be guaranteed by
+  /// the propagator
+  ///
+  /// @param [in] state State that will be presented as @c BoundState
+  /// @param [in] surface The surface to which we bind the state
+  /// @param [in] reinitialize Boolean flag whether reinitialization is needed,
+  /// i.e. if this is an intermediate state of a larger propagation
+  ///
+  /// @return A bound state:
+  ///   - the parameters at the surface
+  ///   - the stepwise jacobian towards it (from last bound)
+  ///   - and the path length (from start - for ordering)
+  BoundState boundState(State& state, const Surface& surface,
+                        bool reinitialize = true) const;
+
+  /// Create and return the bound state of a track at the current position
+  ///
+  /// @param [in] state State of the bundle
+  /// @param [in] i The index of the track
+  /// @param [in] surface The surface to which we bind the state
+  /// @param [in] reinitialize Boolean flag whether reinitialization is needed
+  BoundState boundState(State& state, size_t i, const Surface& surface,
+                        bool reinitialize = true) const {
+    return m_single.boundState(state.tracks[i], surface, reinitialize);
+  }
+
+  /// Create and return the curvilinear state of the bundle at the current
+  /// position
+  ///
+  /// @brief The bound states of the tracks are combined on the plane through
+  /// the mean position which is normal to the mean direction, i.e. in the
+  /// curvilinear frame of the mean. Every track is transported to its own
+  /// curvilinear frame, the jacobian is the weighted mean of theirs.
+  ///
+  /// @param [in] state State that will be presented as @c CurvilinearState
+  /// @param [in] reinitialize Boolean flag whether reinitialization is needed
+  /// i.e. if this is an intermediate state of a larger propagation
+  ///
+  /// @return A curvilinear state:
+  ///   - the curvilinear parameters at given position
+  ///   - the stepweise jacobian towards it (from last bound)
+  ///   - and the path length (from start - for ordering)
+  CurvilinearState curvilinearState(State& state,
+                                    bool reinitialize = true) const;
+
+  /// Create and return the curvilinear state of a track at the current
+  /// position
+  ///
+  /// @param [in] state State of the bundle
+  /// @param [in] i The index of the track
+  /// @param [in] reinitialize Boolean flag whether reinitialization is needed
+  CurvilinearState curvilinearState(State& state, size_t i,
+                                    bool reinitialize = true) const {
+    return m_single.curvilinearState(state.tracks[i], reinitialize);
+  }
+
+  /// Method to update the stepper state to some parameters, the bundle is
+  /// replaced by a single track
+  ///
+  /// @param [in,out] state State object that will be updated
+  /// @param [in] pars Parameters that will be written into @p state
+  void update(State& state, const BoundParameters& pars) const {
+    update(state, std::vector<BoundParameters>{pars}, {1.});
+  }
+
+  /// Method to replace the tracks of the bundle
+  ///
+  /// @param [in,out] state State object that will be updated
+  /// @param [in] pars Parameters of the new tracks
+  /// @param [in] weights Weights of the new tracks, they are normalized
+  void update(State& state, const std::vector<BoundParameters>& pars,
+              const std::vector<double>& weights) const;
+
+  /// Method to update momentum, direction and p of the mean, the change is
+  /// applied to every track
+  ///
+  /// @param [in,out] state State object that will be updated
+  /// @param [in] uposition the updated position
+  /// @param [in] udirection the updated direction
+  /// @param [in] up the updated momentum value
+  /// @param [in] time the updated time
+  void update(State& state, const Vector3D& uposition,
+              const Vector3D& udirection, double up, double time) const;
+
+  /// Method for on-demand transport of the covariance of every track
+  /// to the curvilinear frame of the mean, the combined covariance is
+  /// stored in the state
+  ///
+  /// @param [in,out] state State of the stepper
+  /// @param [in] reinitialize is a flag to steer whether the state should be
+  /// reinitialized at the new position
+  void covarianceTransport(State& state, bool reinitialize = false) const {
+    curvilinearState(state, reinitialize);
+  }
+
+  /// Method for on-demand transport of the covariance of every track
+  /// to a surface, the combined covariance is stored in the state
+  ///
+  /// @param [in,out] state State of the stepper
+  /// @param [in] surface is the surface to which the covariance is forwarded to
+  /// @param [in] reinitialize is a flag to steer whether the state should be
+  /// reinitialized at the new position
+  /// @note no check is done if the position is actually on the surface
+  void covarianceTransport(State& state, const Surface& surface,
+                           bool reinitialize = true) const {
+    boundState(state, surface, reinitialize);
+  }
+
+  /// Perform a Runge-Kutta step for all tracks of the bundle
+  ///
+  /// Every track is stepped with its own step size, limited by the
+  /// constraints of the bundle.
+  ///
+  /// @param [in,out] state is the propagation state associated with the
+  ///        bundle of tracks
+  ///
+  /// @return the step size of the mean, i.e. the weighted mean of the step
+  ///         sizes of the tracks
+  template <typename propagator_state_t>
+  Result<double> step(propagator_state_t& state) const;
+
+ private:
+  /// Combine the bound states of the tracks into the one of the bundle
+  ///
+  /// @param [in,out] state State of the bundle, the combined covariance is
+  ///        stored
+  /// @param [in] trackStates The bound states of the tracks
+  /// @param [in] surface The surface the tracks are bound to
+  BoundState combineStates(State& state,
+                           const std::vector<BoundState>& trackStates,
+                           const Surface& surface) const;
+
+  /// Weighted mean and covariance of the parameters of the tracks
+  ///
+  /// @tparam track_parameters_t Callable returning the parameter vector of
+  ///         a track
+  /// @tparam track_covariance_t Callable returning the covariance of a track
+  ///
+  /// @param [in,out] state State of the bundle, the combined covariance is
+  ///        stored if the covariance is transported
+  /// @param [in] parameters The parameters of a track, all given in the
+  ///        same frame
+  /// @param [in] covariance The covariance of a track, only called if the
+  ///        covariance is transported
+  ///
+  /// @return The weighted mean of the parameters
+  template <typename track_parameters_t, typename track_covariance_t>
+  BoundVector combineParameters(State& state, track_parameters_t&& parameters,
+                                track_covariance_t&& covariance) const;
+
+  /// Magnetic field inside of the detector
+  BField m_bField;
+
+  /// Stepper for the transport of the individual tracks
+  SingleStepper m_single;
+};
+
+}  // namespace Acts
+
+#include "Acts/Propagator/MultiEigenStepper.ipp"
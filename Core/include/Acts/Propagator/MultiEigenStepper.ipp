@@ -0,0 +1,431 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Acts/Utilities/UnitVectors.hpp"
+#include "Acts/Utilities/detail/periodic.hpp"
+
+namespace Acts {
+namespace detail {
+/// Column-wise evaluation of k = q/p * (T x B) for a bundle of tracks
+///
+/// @param [in] dir are the directions T
+/// @param [in] field are the field values B
+/// @param [in] qop are the charges over momenta q/p
+/// @param [out] k is the result, must not alias the inputs
+inline void bundleDerivative(
+    const Eigen::Array<double, 3, Eigen::Dynamic>& dir,
+    const Eigen::Array<double, 3, Eigen::Dynamic>& field,
+    const Eigen::Array<double, 1, Eigen::Dynamic>& qop,
+    Eigen::Array<double, 3, Eigen::Dynamic>& k) {
+  k.resize(3, dir.cols());
+  k.row(0) = qop * (dir.row(1) * field.row(2) - dir.row(2) * field.row(1));
+  k.row(1) = qop * (dir.row(2) * field.row(0) - dir.row(0) * field.row(2));
+  k.row(2) = qop * (dir.row(0) * field.row(1) - dir.row(1) * field.row(0));
+}
+
+/// Propagator state of a single track of a bundle, as expected by the
+/// stepper extensions
+template <typename stepping_t, typename options_t>
+struct BundleTrackPropagatorState {
+  stepping_t& stepping;
+  const options_t& options;
+};
+
+/// Set the aborter constraint of every track from the one of the bundle,
+/// which is given for the path length of the bundle
+template <typename state_t>
+void updateBundleAborter(state_t& state) {
+  const double aborter = state.stepSize.value(ConstrainedStep::aborter);
+  for (auto& track : state.tracks) {
+    track.stepSize.update(
+        aborter - (track.pathAccumulated - state.pathAccumulated),
+        ConstrainedStep::aborter, true);
+  }
+}
+}  // namespace detail
+}  // namespace Acts
+
+template <typename B>
+Acts::Intersection::Status Acts::MultiEigenStepper<B>::updateSurfaceStatus(
+    State& state, const Surface& surface, const BoundaryCheck& bcheck) const {
+  // The boundary check is done for the mean of the bundle
+  auto sIntersection = surface.intersect(
+      state.geoContext, position(state), state.navDir * direction(state),
+      bcheck);
+  if (not sIntersection.intersection and not sIntersection.alternative) {
+    return Intersection::Status::unreachable;
+  }
+
+  detail::updateBundleAborter(state);
+  state.surfaceStatus.resize(state.tracks.size());
+  bool reachable = false;
+  bool onSurface = false;
+  for (size_t i = 0; i < state.tracks.size(); ++i) {
+    auto status = detail::updateSingleSurfaceStatus<SingleStepper>(
+        m_single, state.tracks[i], surface, false);
+    reachable = reachable or (status == Intersection::Status::reachable);
+    onSurface = onSurface or (status == Intersection::Status::onSurface);
+    state.surfaceStatus[i] = status;
+  }
+
+  if (reachable) {
+    // The tracks on the surface, or which cannot reach it, wait for the
+    // others, the bundle steps by the mean distance
+    double stepSize = 0.;
+    for (size_t i = 0; i < state.tracks.size(); ++i) {
+      auto& track = state.tracks[i];
+      if (state.surfaceStatus[i] != Intersection::Status::reachable) {
+        track.stepSize.update(0., ConstrainedStep::actor, true);
+      }
+      stepSize +=
+          state.weights[i] * track.stepSize.value(ConstrainedStep::actor);
+    }
+    state.previousStepSize = state.stepSize;
+    state.stepSize.update(stepSize, ConstrainedStep::actor, true);
+    return Intersection::Status::reachable;
+  }
+  if (onSurface) {
+    releaseStepSize(state);
+    return Intersection::Status::onSurface;
+  }
+  return Intersection::Status::unreachable;
+}
+
+template <typename B>
+auto Acts::MultiEigenStepper<B>::boundState(State& state,
+                                            const Surface& surface,
+                                            bool reinitialize) const
+    -> BoundState {
+  std::vector<BoundState> trackStates;
+  trackStates.reserve(state.tracks.size());
+  for (auto& track : state.tracks) {
+    trackStates.push_back(m_single.boundState(track, surface, reinitialize));
+  }
+  return combineStates(state, trackStates, surface);
+}
+
+template <typename B>
+auto Acts::MultiEigenStepper<B>::curvilinearState(State& state,
+                                                  bool reinitialize) const
+    -> CurvilinearState {
+  std::vector<CurvilinearState> trackStates;
+  trackStates.reserve(state.tracks.size());
+  for (auto& track : state.tracks) {
+    trackStates.push_back(m_single.curvilinearState(track, reinitialize));
+  }
+
+  // The tracks are expressed in the curvilinear frame of the mean: the local
+  // positions are their offsets from the mean position projected onto the
+  // frame, the covariances in their own curvilinear frames agree with the
+  // one of the mean to first order in the spread of the bundle
+  const Vector3D meanPosition = position(state);
+  const auto [unitU, unitV] = makeCurvilinearUnitVectors(direction(state));
+  const BoundVector mean = combineParameters(
+      state,
+      [&](size_t i) -> BoundVector {
+        const auto& pars = std::get<CurvilinearParameters>(trackStates[i]);
+        const Vector3D offset = pars.position() - meanPosition;
+        BoundVector vector = pars.parameters();
+        vector[eLOC_0] = offset.dot(unitU);
+        vector[eLOC_1] = offset.dot(unitV);
+        return vector;
+      },
+      [&](size_t i) -> const Covariance& {
+        return *std::get<CurvilinearParameters>(trackStates[i]).covariance();
+      });
+  Jacobian jacobian = Jacobian::Zero();
+  for (size_t i = 0; i < trackStates.size(); ++i) {
+    jacobian += state.weights[i] * std::get<Jacobian>(trackStates[i]);
+  }
+
+  std::optional<Covariance> covOpt = std::nullopt;
+  if (state.covTransport) {
+    covOpt = state.cov;
+  }
+  CurvilinearParameters parameters(
+      std::move(covOpt),
+      meanPosition + mean[eLOC_0] * unitU + mean[eLOC_1] * unitV,
+      detail::coordinate_transformation::parameters2globalMomentum(mean),
+      std::copysign(1., mean[eQOP]), mean[eT]);
+  return CurvilinearState{std::move(parameters), jacobian,
+                          state.pathAccumulated};
+}
+
+template <typename B>
+auto Acts::MultiEigenStepper<B>::combineStates(
+    State& state, const std::vector<BoundState>& trackStates,
+    const Surface& surface) const -> BoundState {
+  const BoundVector mean = combineParameters(
+      state,
+      [&](size_t i) -> BoundVector {
+        return std::get<BoundParameters>(trackStates[i]).parameters();
+      },
+      [&](size_t i) -> const Covariance& {
+        return *std::get<BoundParameters>(trackStates[i]).covariance();
+      });
+  Jacobian jacobian = Jacobian::Zero();
+  for (size_t i = 0; i < trackStates.size(); ++i) {
+    jacobian += state.weights[i] * std::get<Jacobian>(trackStates[i]);
+  }
+
+  std::optional<Covariance> covOpt = std::nullopt;
+  if (state.covTransport) {
+    covOpt = state.cov;
+  }
+  BoundParameters parameters(state.geoContext, std::move(covOpt), mean,
+                             surface.getSharedPtr());
+  return BoundState{std::move(parameters), jacobian, state.pathAccumulated};
+}
+
+template <typename B>
+template <typename track_parameters_t, typename track_covariance_t>
+Acts::BoundVector Acts::MultiEigenStepper<B>::combineParameters(
+    State& state, track_parameters_t&& parameters,
+    track_covariance_t&& covariance) const {
+  // The mean is accumulated relative to the first track, such that phi is
+  // averaged correctly across its boundary
+  const BoundVector reference = parameters(0);
+  auto difference = [&](size_t i, const BoundVector& origin) {
+    BoundVector diff = parameters(i) - origin;
+    diff[ePHI] = detail::radian_sym(diff[ePHI]);
+    return diff;
+  };
+  BoundVector mean = BoundVector::Zero();
+  for (size_t i = 0; i < state.tracks.size(); ++i) {
+    mean += state.weights[i] * difference(i, reference);
+  }
+  mean += reference;
+  mean[ePHI] = detail::radian_sym(mean[ePHI]);
+
+  if (state.covTransport) {
+    state.cov = Covariance::Zero();
+    for (size_t i = 0; i < state.tracks.size(); ++i) {
+      const BoundVector diff = difference(i, mean);
+      state.cov += state.weights[i] * (covariance(i) + diff * diff.transpose());
+    }
+  }
+  return mean;
+}
+
+template <typename B>
+void Acts::MultiEigenStepper<B>::update(
+    State& state, const std::vector<BoundParameters>& pars,
+    const std::vector<double>& weights) const {
+  if (pars.empty()) {
+    throw std::invalid_argument("Bundle of tracks without tracks");
+  }
+  const double ssize = state.stepSize.value(ConstrainedStep::user);
+  state.tracks.clear();
+  for (const auto& par : pars) {
+    state.tracks.emplace_back(state.geoContext, state.magFieldContext, par,
+                              state.navDir, ssize, state.tolerance);
+    state.tracks.back().pathAccumulated = state.pathAccumulated;
+  }
+  state.weights.resize(weights.size());
+  for (size_t i = 0; i < weights.size(); ++i) {
+    state.weights[i] = weights[i];
+  }
+  state.weights /= state.weights.sum();
+  state.covTransport = state.tracks.front().covTransport;
+  if (state.covTransport) {
+    state.cov = *pars.front().covariance();
+  }
+}
+
+template <typename B>
+void Acts::MultiEigenStepper<B>::update(State& state,
+                                        const Vector3D& uposition,
+                                        const Vector3D& udirection, double up,
+                                        double time) const {
+  const Vector3D dPosition = uposition - position(state);
+  const Vector3D dDirection = udirection - direction(state);
+  const double pScale = up / momentum(state);
+  const double dTime = time - this->time(state);
+  for (auto& track : state.tracks) {
+    m_single.update(track, track.pos + dPosition,
+                    (track.dir + dDirection).normalized(), pScale * track.p,
+                    track.t + dTime);
+  }
+}
+
+template <typename B>
+template <typename propagator_state_t>
+Acts::Result<double> Acts::MultiEigenStepper<B>::step(
+    propagator_state_t& state) const {
+  auto& stepping = state.stepping;
+  auto& sd = stepping.stepData;
+  const Eigen::Index n = stepping.tracks.size();
+
+  // Gather the tracks and their step sizes, limited by the path of the bundle
+  detail::updateBundleAborter(stepping);
+  sd.pos0.resize(3, n);
+  sd.dir0.resize(3, n);
+  sd.qop.resize(n);
+  sd.h.resize(n);
+  for (Eigen::Index i = 0; i < n; ++i) {
+    const auto& track = stepping.tracks[i];
+    sd.pos0.col(i) = track.pos.array();
+    sd.dir0.col(i) = track.dir.array();
+    sd.qop[i] = track.q / track.p;
+    sd.h[i] = track.stepSize;
+  }
+
+  // First Runge-Kutta point (at current positions)
+  getField(stepping, sd.pos0, sd.B_first);
+  detail::bundleDerivative(sd.dir0, sd.B_first, sd.qop, sd.k1);
+
+  // Performs the remaining stages for the tracks of the step data with their
+  // current step sizes and estimates the local integration error of each
+  Scalars h2, half_h;
+  const auto tryRungeKuttaStep = [&](auto& d) {
+    h2 = d.h.square();
+    half_h = d.h * 0.5;
+
+    // Second Runge-Kutta point
+    d.pos = d.pos0 + d.dir0.rowwise() * half_h + d.k1.rowwise() * (h2 * 0.125);
+    getField(stepping, d.pos, d.B_middle);
+    d.dir = d.dir0 + d.k1.rowwise() * half_h;
+    detail::bundleDerivative(d.dir, d.B_middle, d.qop, d.k2);
+
+    // Third Runge-Kutta point
+    d.dir = d.dir0 + d.k2.rowwise() * half_h;
+    detail::bundleDerivative(d.dir, d.B_middle, d.qop, d.k3);
+
+    // Last Runge-Kutta point
+    d.pos = d.pos0 + d.dir0.rowwise() * d.h + d.k3.rowwise() * (h2 * 0.5);
+    getField(stepping, d.pos, d.B_last);
+    d.dir = d.dir0 + d.k3.rowwise() * d.h;
+    detail::bundleDerivative(d.dir, d.B_last, d.qop, d.k4);
+
+    d.errorEstimate =
+        (h2 * (d.k1 - d.k2 - d.k3 + d.k4).abs().colwise().sum()).max(1e-20);
+  };
+
+  tryRungeKuttaStep(sd);
+  size_t nStepTrials = 0;
+  auto& rd = stepping.retryData;
+  auto& retryTracks = stepping.retryTracks;
+  // Select and adjust the step sizes of the tracks with a too large error
+  // as given in ATL-SOFT-PUB-2009-001, the accepted tracks keep theirs
+  while (true) {
+    retryTracks.clear();
+    for (Eigen::Index i = 0; i < n; ++i) {
+      if (sd.errorEstimate[i] <= state.options.tolerance) {
+        continue;
+      }
+      const double stepSizeScaling = std::min(
+          std::max(0.25, std::pow((state.options.tolerance /
+                                   std::abs(2. * sd.errorEstimate[i])),
+                                  0.25)),
+          4.);
+      if (stepSizeScaling == 1.) {
+        continue;
+      }
+      retryTracks.push_back(i);
+      sd.h[i] *= stepSizeScaling;
+      stepping.tracks[i].stepSize = sd.h[i];
+      // If step size becomes too small the particle remains at the initial
+      // place
+      if (sd.h[i] * sd.h[i] <
+          state.options.stepSizeCutOff * state.options.stepSizeCutOff) {
+        // Not moving due to too low momentum needs an aborter
+        return EigenStepperError::StepSizeStalled;
+      }
+    }
+    if (retryTracks.empty()) {
+      break;
+    }
+    // If the parameter is off track too much or given stepSize is not
+    // appropriate
+    if (nStepTrials > state.options.maxRungeKuttaStepTrials) {
+      // Too many trials, have to abort
+      return EigenStepperError::StepSizeAdjustmentFailed;
+    }
+    nStepTrials++;
+
+    // Only the rejected tracks repeat the step, the first stage does not
+    // depend on the step size
+    const Eigen::Index m = retryTracks.size();
+    rd.pos0.resize(3, m);
+    rd.dir0.resize(3, m);
+    rd.qop.resize(m);
+    rd.h.resize(m);
+    rd.k1.resize(3, m);
+    for (Eigen::Index j = 0; j < m; ++j) {
+      const Eigen::Index i = retryTracks[j];
+      rd.pos0.col(j) = sd.pos0.col(i);
+      rd.dir0.col(j) = sd.dir0.col(i);
+      rd.qop[j] = sd.qop[i];
+      rd.h[j] = sd.h[i];
+      rd.k1.col(j) = sd.k1.col(i);
+    }
+    tryRungeKuttaStep(rd);
+    for (Eigen::Index j = 0; j < m; ++j) {
+      const Eigen::Index i = retryTracks[j];
+      sd.B_middle.col(i) = rd.B_middle.col(j);
+      sd.B_last.col(i) = rd.B_last.col(j);
+      sd.k2.col(i) = rd.k2.col(j);
+      sd.k3.col(i) = rd.k3.col(j);
+      sd.k4.col(i) = rd.k4.col(j);
+      sd.errorEstimate[i] = rd.errorEstimate[j];
+    }
+  }
+
+  // Update the track parameters according to the equations of motion
+  h2 = sd.h.square();
+  sd.pos = sd.pos0 + sd.dir0.rowwise() * sd.h +
+           (sd.k1 + sd.k2 + sd.k3).rowwise() * (h2 / 6.);
+  sd.dir = sd.dir0 +
+           (sd.k1 + 2. * (sd.k2 + sd.k3) + sd.k4).rowwise() * (sd.h / 6.);
+  const Scalars norm = sd.dir.matrix().colwise().norm().array();
+  sd.dir.rowwise() /= norm;
+
+  // The time and the transport of every track, which wait with a zero step
+  // size are untouched
+  const DefaultExtension extension;
+  for (Eigen::Index i = 0; i < n; ++i) {
+    const double h = sd.h[i];
+    if (h == 0.) {
+      continue;
+    }
+    auto& track = stepping.tracks[i];
+    auto& tsd = track.stepData;
+    tsd.B_first = sd.B_first.col(i).matrix();
+    tsd.B_middle = sd.B_middle.col(i).matrix();
+    tsd.B_last = sd.B_last.col(i).matrix();
+    tsd.k1 = sd.k1.col(i).matrix();
+    tsd.k2 = sd.k2.col(i).matrix();
+    tsd.k3 = sd.k3.col(i).matrix();
+    tsd.k4 = sd.k4.col(i).matrix();
+    tsd.kQoP = {0., 0., 0., 0.};
+    detail::BundleTrackPropagatorState<SingleState,
+                                       decltype(state.options)>
+        trackState{track, state.options};
+    if (track.covTransport) {
+      // The step transport matrix in global coordinates
+      FreeMatrix D;
+      if (!extension.finalize(trackState, m_single, h, D)) {
+        return EigenStepperError::StepInvalid;
+      }
+      track.jacTransport = D * track.jacTransport;
+    } else {
+      extension.finalize(trackState, m_single, h);
+    }
+    track.pos = sd.pos.col(i).matrix();
+    track.dir = sd.dir.col(i).matrix();
+    if (track.covTransport) {
+      track.derivative.template head<3>() = track.dir;
+      track.derivative.template segment<3>(4) = tsd.k4;
+    }
+    track.pathAccumulated += h;
+  }
+
+  const double h = (stepping.weights * sd.h).sum();
+  stepping.pathAccumulated += h;
+  return h;
+}
@@ -0,0 +1,258 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Acts/Geometry/Layer.hpp"
+#include "Acts/Geometry/TrackingVolume.hpp"
+#include "Acts/Utilities/Definitions.hpp"
+#include "Acts/Utilities/Helpers.hpp"
+#include "Acts/Utilities/Units.hpp"
+
+namespace Acts {
+
+/// Navigation candidates shared between propagations.
+///
+/// Tracks from the same vertex region follow nearly identical paths through
+/// the geometry. The cache stores the layers and boundaries found by the
+/// full candidate search in a volume, keyed by the volume, a coarse position
+/// bin, and a coarse direction bin. Subsequent searches with the same key
+/// only re-intersect the stored candidates.
+///
+/// Only these volume lookups are cached: the layers and boundaries crossed
+/// are the same within a bin, the navigator falls back to the full search
+/// if any stored candidate is not compatible anymore. The surfaces within a
+/// layer are not cached, which overlapping modules are crossed depends on
+/// the exact position and direction.
+///
+/// The number of entries is bounded, the entries of a candidate type are
+/// dropped once it is full. Call clear() to start from an empty cache, e.g.
+/// for every event when the cache is not shared across events.
+///
+/// The cache can be shared by navigators in different threads, but all of
+/// them must use the same resolve configuration and tracking geometry.
+class NavigationCache {
+ public:
+  /// Candidate objects for a cache key.
+  template <typename object_t>
+  using Candidates = std::vector<const object_t*>;
+  template <typename object_t>
+  using CandidatesPtr = std::shared_ptr<const Candidates<object_t>>;
+
+  /// Nested configuration struct.
+  struct Config {
+    /// Edge length of the cubic position bins
+    double positionBinSize = 10 * UnitConstants::mm;
+    /// Number of bins in the azimuthal direction
+    unsigned int nPhiBins = 512;
+    /// Number of bins in the polar direction
+    unsigned int nThetaBins = 256;
+    /// Maximum number of entries per candidate type
+    size_t maxEntries = 65536;
+  };
+
+  /// Usage statistics.
+  struct Statistics {
+    /// Lookups that found stored candidates
+    size_t hits = 0;
+    /// Lookups that required the full search
+    size_t misses = 0;
+    /// Hits whose stored candidates were not compatible anymore
+    size_t rejected = 0;
+    /// Entries dropped because the cache was full
+    size_t dropped = 0;
+
+    /// Fraction of lookups that used the stored candidates.
+    double hitRate() const {
+      const size_t lookups = hits + misses;
+      return (0 < lookups) ? double(hits - rejected) / lookups : 0.;
+    }
+  };
+
+  /// Cache key from the navigation object and the binned track state.
+  struct Key {
+    const void* object = nullptr;
+    int32_t position[3] = {0, 0, 0};
+    int32_t phi = 0;
+    int32_t theta = 0;
+    int32_t navDir = 0;
+
+    bool operator==(const Key& other) const {
+      return (object == other.object) and
+             std::equal(position, position + 3, other.position) and
+             (phi == other.phi) and (theta == other.theta) and
+             (navDir == other.navDir);
+    }
+  };
+
+  /// Constructor with default configuration.
+  NavigationCache() = default;
+  /// Constructor from configuration.
+  ///
+  /// @param cfg The cache configuration
+  NavigationCache(const Config& cfg) : m_cfg(cfg) {}
+
+  /// Compute the cache key.
+  ///
+  /// @param object The volume in which the candidates are searched
+  /// @param position The current global position
+  /// @param direction The current normalized direction
+  /// @param navDir The navigation direction
+  Key key(const void* object, const Vector3D& position,
+          const Vector3D& direction, NavigationDirection navDir) const {
+    // flip the direction such that both navigation directions are consistent
+    const Vector3D sDirection = navDir * direction;
+    const double phi = VectorHelpers::phi(sDirection);
+    const double theta = VectorHelpers::theta(sDirection);
+
+    Key k;
+    k.object = object;
+    for (int i = 0; i < 3; ++i) {
+      k.position[i] =
+          static_cast<int32_t>(std::floor(position[i] / m_cfg.positionBinSize));
+    }
+    k.phi = bin((phi + M_PI) / (2 * M_PI), m_cfg.nPhiBins);
+    k.theta = bin(theta / M_PI, m_cfg.nThetaBins);
+    k.navDir = navDir;
+    return k;
+  }
+
+  /// Find the stored candidates and update the statistics.
+  ///
+  /// @tparam object_t The candidate type: Layer or BoundarySurface
+  /// @param k The cache key
+  ///
+  /// @return The stored candidates or a nullptr if there are none
+  template <typename object_t>
+  CandidatesPtr<object_t> find(const Key& k) const {
+    CandidatesPtr<object_t> candidates;
+    {
+      std::shared_lock<std::shared_mutex> lock(m_mutex);
+      const auto& entries = store<object_t>();
+      auto it = entries.find(k);
+      if (it != entries.end()) {
+        candidates = it->second;
+      }
+    }
+    if (candidates) {
+      ++m_hits;
+    } else {
+      ++m_misses;
+    }
+    return candidates;
+  }
+
+  /// Store the candidates for a key, unless there are some already.
+  ///
+  /// All entries of the candidate type are dropped if the maximum number
+  /// of entries is reached.
+  ///
+  /// @tparam object_t The candidate type: Layer or BoundarySurface
+  /// @param k The cache key
+  /// @param candidates The candidates found by the full search
+  template <typename object_t>
+  void insert(const Key& k, Candidates<object_t> candidates) {
+    auto entry =
+        std::make_shared<const Candidates<object_t>>(std::move(candidates));
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    auto& entries = store<object_t>();
+    if (m_cfg.maxEntries <= entries.size()) {
+      m_dropped += entries.size();
+      entries.clear();
+    }
+    entries.emplace(k, std::move(entry));
+  }
+
+  /// Record that a hit was not usable and the full search was needed.
+  void reject() const { ++m_rejected; }
+
+  /// Number of stored entries.
+  size_t size() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return std::get<0>(m_stores).size() + std::get<1>(m_stores).size();
+  }
+
+  /// Remove all entries and reset the statistics.
+  void clear() {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    std::get<0>(m_stores).clear();
+    std::get<1>(m_stores).clear();
+    m_hits = 0;
+    m_misses = 0;
+    m_rejected = 0;
+    m_dropped = 0;
+  }
+
+  /// Current usage statistics.
+  Statistics statistics() const {
+    Statistics stats;
+    stats.hits = m_hits;
+    stats.misses = m_misses;
+    stats.rejected = m_rejected;
+    stats.dropped = m_dropped;
+    return stats;
+  }
+
+ private:
+  struct KeyHash {
+    size_t operator()(const Key& k) const {
+      size_t h = std::hash<const void*>()(k.object);
+      auto combine = [&h](int32_t value) {
+        h ^= std::hash<int32_t>()(value) + 0x9e3779b9 + (h << 6) + (h >> 2);
+      };
+      combine(k.position[0]);
+      combine(k.position[1]);
+      combine(k.position[2]);
+      combine(k.phi);
+      combine(k.theta);
+      combine(k.navDir);
+      return h;
+    }
+  };
+
+  template <typename object_t>
+  using Store = std::unordered_map<Key, CandidatesPtr<object_t>, KeyHash>;
+
+  template <typename object_t>
+  Store<object_t>& store() {
+    return std::get<Store<object_t>>(m_stores);
+  }
+  template <typename object_t>
+  const Store<object_t>& store() const {
+    return std::get<Store<object_t>>(m_stores);
+  }
+
+  /// Bin a value in [0,1] into the given number of bins.
+  static int32_t bin(double value, unsigned int nBins) {
+    const auto b = static_cast<int32_t>(value * nBins);
+    return std::clamp<int32_t>(b, 0, nBins - 1);
+  }
+
+  Config m_cfg;
+  std::tuple<Store<Layer>, Store<BoundarySurface>> m_stores;
+  mutable std::shared_mutex m_mutex;
+  mutable std::atomic<size_t> m_hits{0};
+  mutable std::atomic<size_t> m_misses{0};
+  mutable std::atomic<size_t> m_rejected{0};
+  std::atomic<size_t> m_dropped{0};
+};
+
+}  // namespace Acts
@@ -18,6 +18,7 @@
 #include "Acts/Geometry/TrackingGeometry.hpp"
 #include "Acts/Geometry/TrackingVolume.hpp"
 #include "Acts/Propagator/ConstrainedStep.hpp"
+#include "Acts/Propagator/NavigationCache.hpp"
 #include "Acts/Propagator/Propagator.hpp"
 #include "Acts/Surfaces/Surface.hpp"
 #include "Acts/Utilities/Units.hpp"
@@ -152,6 +153,12 @@ class Navigator {
   /// stop at every surface regardless what it is
   bool resolvePassive = false;
 
+  /// Optional cache of navigation candidates shared between propagations
+  ///
+  /// Only used for the layer and boundary search when no target surface is
+  /// given, see NavigationCache for details.
+  std::shared_ptr<NavigationCache> navigationCache = nullptr;
+
   /// Nested State struct
   ///
   /// It acts as an internal state which is
@@ -887,10 +894,15 @@ class Navigator {
         return ss.str();
       });
       // Evaluate the boundary surfaces
-      state.navigation.navBoundaries =
-          state.navigation.currentVolume->compatibleBoundaries(
-              state.geoContext, stepper.position(state.stepping),
-              stepper.direction(state.stepping), navOpts);
+      if (navigationCache and state.navigation.targetSurface == nullptr) {
+        state.navigation.navBoundaries =
+            cachedBoundaries(state, stepper, navOpts);
+      } else {
+        state.navigation.navBoundaries =
+            state.navigation.currentVolume->compatibleBoundaries(
+                state.geoContext, stepper.position(state.stepping),
+                stepper.direction(state.stepping), navOpts);
+      }
       // The number of boundary candidates
       debugLog(state, [&] {
         std::stringstream dstream;
@@ -1157,10 +1169,14 @@ class Navigator {
     navOpts.pathLimit = state.stepping.stepSize.value(ConstrainedStep::aborter);
     navOpts.overstepLimit = stepper.overstepLimit(state.stepping);
     // Request the compatible layers
-    state.navigation.navLayers =
-        state.navigation.currentVolume->compatibleLayers(
-            state.geoContext, stepper.position(state.stepping),
-            stepper.direction(state.stepping), navOpts);
+    if (navigationCache and state.navigation.targetSurface == nullptr) {
+      state.navigation.navLayers = cachedLayers(state, stepper, navOpts);
+    } else {
+      state.navigation.navLayers =
+          state.navigation.currentVolume->compatibleLayers(
+              state.geoContext, stepper.position(state.stepping),
+              stepper.direction(state.stepping), navOpts);
+    }
 
     // Layer candidates have been found
     if (!state.navigation.navLayers.empty()) {
@@ -1206,6 +1222,140 @@ class Navigator {
     return false;
   }
 
+  /// Navigation candidates from the navigation cache
+  ///
+  /// Looks up the candidates for the current volume and track state; only
+  /// the stored candidates are intersected in case of a hit. The full search
+  /// is done on a miss, its result is stored, and if any stored candidate is
+  /// not compatible anymore.
+  ///
+  /// @tparam object_t Type of the candidate objects
+  /// @tparam search_t Callable for the full search
+  /// @tparam candidates_search_t Callable for the search within candidates
+  ///
+  /// @param [in] object The volume that is searched
+  /// @param [in] position The current position
+  /// @param [in] direction The current direction
+  /// @param [in] navDir The navigation direction
+  /// @param [in] search Returns the intersections of the full search
+  /// @param [in] candidatesSearch Returns the intersections of the candidates
+  ///
+  /// @return The compatible intersections ordered by path length
+  template <typename object_t, typename search_t, typename candidates_search_t>
+  auto cachedCandidates(const void* object, const Vector3D& position,
+                        const Vector3D& direction, NavigationDirection navDir,
+                        search_t&& search,
+                        candidates_search_t&& candidatesSearch) const {
+    auto key = navigationCache->key(object, position, direction, navDir);
+    auto candidates = navigationCache->find<object_t>(key);
+    if (candidates) {
+      auto intersections = candidatesSearch(*candidates);
+      if (intersections.size() == candidates->size()) {
+        return intersections;
+      }
+      navigationCache->reject();
+      return search();
+    }
+    auto intersections = search();
+    NavigationCache::Candidates<object_t> objects;
+    objects.reserve(intersections.size());
+    for (const auto& intersection : intersections) {
+      objects.push_back(intersection.object);
+    }
+    navigationCache->insert<object_t>(key, std::move(objects));
+    return intersections;
+  }
+
+  /// Compatible layers of the current volume from the navigation cache
+  ///
+  /// The cached layers do not depend on the path limit, it is applied to
+  /// the resulting intersections.
+  ///
+  /// @tparam propagator_state_t The state type of the propagagor
+  /// @tparam stepper_t The type of stepper used for the propagation
+  ///
+  /// @param [in] state is the propagation state object
+  /// @param [in] stepper Stepper in use
+  /// @param [in] navOpts The navigation options for the layer search
+  template <typename propagator_state_t, typename stepper_t>
+  NavigationLayers cachedLayers(const propagator_state_t& state,
+                                const stepper_t& stepper,
+                                const NavigationOptions<Layer>& navOpts) const {
+    const auto volume = state.navigation.currentVolume;
+    const auto position = stepper.position(state.stepping);
+    const auto direction = stepper.direction(state.stepping);
+    auto unlimitedOpts = navOpts;
+    unlimitedOpts.pathLimit =
+        navOpts.navDir * std::numeric_limits<double>::max();
+
+    auto layers = cachedCandidates<Layer>(
+        volume, position, direction, navOpts.navDir,
+        [&]() {
+          return volume->compatibleLayers(state.geoContext, position,
+                                          direction, unlimitedOpts);
+        },
+        [&](const auto& candidates) {
+          return volume->compatibleLayers(state.geoContext, position,
+                                          direction, unlimitedOpts,
+                                          candidates);
+        });
+    // apply the path limit, the ordering is kept
+    double pLimit = navOpts.pathLimit;
+    layers.erase(std::remove_if(layers.begin(), layers.end(),
+                                [&](const auto& layer) {
+                                  double path = layer.intersection.pathLength;
+                                  return path * path > pLimit * pLimit;
+                                }),
+                 layers.end());
+    return layers;
+  }
+
+  /// Compatible boundaries of the current volume from the navigation cache
+  ///
+  /// The cached boundaries do not depend on the path limit, it is applied
+  /// to the resulting intersections.
+  ///
+  /// @tparam propagator_state_t The state type of the propagagor
+  /// @tparam stepper_t The type of stepper used for the propagation
+  ///
+  /// @param [in] state is the propagation state object
+  /// @param [in] stepper Stepper in use
+  /// @param [in] navOpts The navigation options for the boundary search
+  template <typename propagator_state_t, typename stepper_t>
+  NavigationBoundaries cachedBoundaries(
+      const propagator_state_t& state, const stepper_t& stepper,
+      const NavigationOptions<Surface>& navOpts) const {
+    const auto volume = state.navigation.currentVolume;
+    const auto position = stepper.position(state.stepping);
+    const auto direction = stepper.direction(state.stepping);
+    auto unlimitedOpts = navOpts;
+    unlimitedOpts.pathLimit =
+        navOpts.navDir * std::numeric_limits<double>::max();
+
+    auto boundaries = cachedCandidates<BoundarySurface>(
+        volume, position, direction, navOpts.navDir,
+        [&]() {
+          return volume->compatibleBoundaries(state.geoContext, position,
+                                              direction, unlimitedOpts);
+        },
+        [&](const auto& candidates) {
+          return volume->compatibleBoundaries(state.geoContext, position,
+                                              direction, unlimitedOpts,
+                                              candidates);
+        });
+    // apply the path limit, the ordering is kept
+    double pLimit = navOpts.pathLimit;
+    boundaries.erase(
+        std::remove_if(boundaries.begin(), boundaries.end(),
+                       [&](const auto& boundary) {
+                         double path = boundary.intersection.pathLength;
+                         return path * path >
+                                pLimit * pLimit + s_onSurfaceTolerance;
+                       }),
+        boundaries.end());
+    return boundaries;
+  }
+
   /// --------------------------------------------------------------------
   /// Inactive
   ///
@@ -324,7 +324,28 @@ class Propagator final {
   template <typename result_t, typename propagator_state_t>
   Result<result_t> propagate_impl(propagator_state_t& state) const;
 
+  /// @brief Propagate track parameters into a given result object
+  ///
+  /// @tparam propagator_state_t Type of of propagator state with options
+  /// @tparam result_t Type of the result object for this propagation
+  ///
+  /// @param [in,out] state the propagator state object
+  /// @param [in,out] result of the propagation
+  ///
+  /// @return Propagation PropagatorStatus
+  template <typename propagator_state_t, typename result_t>
+  Result<void> propagate_impl(propagator_state_t& state,
+                              result_t& result) const;
+
  public:
+  /// @brief Short-hand type definition for the result of propagate() without
+  ///        target surface and of propagateState()
+  ///
+  /// @tparam propagator_options_t Type of the propagator options
+  template <typename propagator_options_t>
+  using result_type = action_list_t_result_t<
+      CurvilinearParameters, typename propagator_options_t::action_list_type>;
+
   /// @brief Propagate track parameters
   ///
   /// This function performs the propagation of the track parameters using the
@@ -377,6 +398,58 @@ class Propagator final {
   propagate(const parameters_t& start, const Surface& target,
             const propagator_options_t& options) const;
 
+  /// @brief Create a propagator state that can be reused
+  ///
+  /// The state holds the options, extended by a path aborter, as well as the
+  /// stepper and navigator states. It can be propagated several times, e.g.
+  /// for every track in a batch, with resetState() and propagateState()
+  /// in order to avoid setting up the options for every propagation.
+  ///
+  /// @tparam parameters_t Type of initial track parameters to propagate
+  /// @tparam propagator_options_t Type of the propagator options
+  ///
+  /// @param [in] start Initial track parameters to propagate
+  /// @param [in] options Propagation options
+  ///
+  /// @return The propagator state ready for propagateState()
+  template <typename parameters_t, typename propagator_options_t,
+            typename path_aborter_t = detail::PathLimitReached>
+  auto makeState(const parameters_t& start,
+                 const propagator_options_t& options) const;
+
+  /// @brief Reset a propagator state to new initial track parameters
+  ///
+  /// The options are kept, the stepper and navigator states are initialized
+  /// from the initial track parameters as in makeState().
+  ///
+  /// @tparam parameters_t Type of initial track parameters to propagate
+  /// @tparam propagator_state_t Type of the propagator state from makeState()
+  ///
+  /// @param [in,out] state The propagator state to reset
+  /// @param [in] start Initial track parameters to propagate
+  template <typename parameters_t, typename propagator_state_t,
+            typename path_aborter_t = detail::PathLimitReached>
+  void resetState(propagator_state_t& state, const parameters_t& start) const;
+
+  /// @brief Propagate a prepared propagator state - User method
+  ///
+  /// This function performs the propagation as propagate() without target
+  /// surface, but with a state from makeState() or resetState() and into a
+  /// result object owned by the caller. The result is not reset, such that
+  /// storage held by the action results can be reused across propagations.
+  ///
+  /// @tparam propagator_state_t Type of the propagator state from makeState()
+  /// @tparam result_t Type of the result, type result_type<>
+  ///
+  /// @param [in,out] state The propagator state
+  /// @param [in,out] result The propagation result, end parameters and
+  ///        transport jacobian are filled if the propagation succeeds
+  ///
+  /// @return Propagation status
+  template <typename propagator_state_t, typename result_t>
+  Result<void> propagateState(propagator_state_t& state,
+                              result_t& result) const;
+
  private:
   /// Implementation of propagation algorithm
   stepper_t m_stepper;
@@ -13,7 +13,18 @@ template <typename result_t, typename propagator_state_t>
 auto Acts::Propagator<S, N>::propagate_impl(propagator_state_t& state) const
     -> Result<result_t> {
   result_t result;
+  auto status = propagate_impl(state, result);
+  if (not status.ok()) {
+    return status.error();
+  }
+  return std::move(result);
+}
 
+template <typename S, typename N>
+template <typename propagator_state_t, typename result_t>
+auto Acts::Propagator<S, N>::propagate_impl(propagator_state_t& state,
+                                            result_t& result) const
+    -> Result<void> {
   // Pre-stepping call to the navigator and action list
   debugLog(state, [&] { return std::string("Entering propagation."); });
 
@@ -80,7 +91,7 @@ auto Acts::Propagator<S, N>::propagate_impl(propagator_state_t& state) const
   state.options.actionList(state, m_stepper, result);
 
   // return progress flag here, decide on SUCCESS later
-  return std::move(result);
+  return Result<void>::success();
 }
 
 template <typename S, typename N>
@@ -91,19 +102,26 @@ auto Acts::Propagator<S, N>::propagate(
     -> Result<action_list_t_result_t<
         CurvilinearParameters,
         typename propagator_options_t::action_list_type>> {
-  static_assert(ParameterConcept<parameters_t>,
-                "Parameters do not fulfill parameter concept.");
-
-  // Type of track parameters produced by the propagation
-  using ReturnParameterType = CurvilinearParameters;
+  // Initialize the internal propagator state
+  auto state = makeState<parameters_t, propagator_options_t, path_aborter_t>(
+      start, options);
 
-  // Type of the full propagation result, including output from actions
-  using ResultType =
-      action_list_t_result_t<ReturnParameterType,
-                             typename propagator_options_t::action_list_type>;
+  // Perform the actual propagation & check its outcome
+  result_type<propagator_options_t> result;
+  auto status = propagateState(state, result);
+  if (not status.ok()) {
+    return status.error();
+  }
+  return std::move(result);
+}
 
-  static_assert(std::is_copy_constructible<ReturnParameterType>::value,
-                "return track parameter type must be copy-constructible");
+template <typename S, typename N>
+template <typename parameters_t, typename propagator_options_t,
+          typename path_aborter_t>
+auto Acts::Propagator<S, N>::makeState(
+    const parameters_t& start, const propagator_options_t& options) const {
+  static_assert(ParameterConcept<parameters_t>,
+                "Parameters do not fulfill parameter concept.");
 
   // Expand the abort list with a path aborter
   path_aborter_t pathAborter;
@@ -129,26 +147,58 @@ auto Acts::Propagator<S, N>::propagate(
     detail::LoopProtection<path_aborter_t> lProtection;
     lProtection(state, m_stepper);
   }
+  return state;
+}
+
+template <typename S, typename N>
+template <typename parameters_t, typename propagator_state_t,
+          typename path_aborter_t>
+void Acts::Propagator<S, N>::resetState(propagator_state_t& state,
+                                        const parameters_t& start) const {
+  static_assert(ParameterConcept<parameters_t>,
+                "Parameters do not fulfill parameter concept.");
+
+  const auto& options = state.options;
+  state.stepping = StepperState(options.geoContext, options.magFieldContext,
+                                start, options.direction, options.maxStepSize,
+                                options.tolerance);
+  state.navigation = NavigatorState();
+  state.navigation.startSurface = &start.referenceSurface();
+
+  // Restore the path limit before the loop protection of this start
+  auto& pathAborter = state.options.abortList.template get<path_aborter_t>();
+  pathAborter.internalLimit = options.pathLimit;
+  if (options.loopProtection) {
+    detail::LoopProtection<path_aborter_t> lProtection;
+    lProtection(state, m_stepper);
+  }
+}
+
+template <typename S, typename N>
+template <typename propagator_state_t, typename result_t>
+auto Acts::Propagator<S, N>::propagateState(propagator_state_t& state,
+                                            result_t& result) const
+    -> Result<void> {
+  static_assert(std::is_copy_constructible<CurvilinearParameters>::value,
+                "return track parameter type must be copy-constructible");
+
   // Perform the actual propagation & check its outcome
-  auto result = propagate_impl<ResultType>(state);
-  if (result.ok()) {
-    auto& propRes = *result;
+  auto status = propagate_impl(state, result);
+  if (status.ok()) {
     /// Convert into return type and fill the result object
     auto curvState = m_stepper.curvilinearState(state.stepping, true);
     auto& curvParameters = std::get<CurvilinearParameters>(curvState);
     // Fill the end parameters
-    propRes.endParameters = std::make_unique<const CurvilinearParameters>(
+    result.endParameters = std::make_unique<const CurvilinearParameters>(
         std::move(curvParameters));
     // Only fill the transport jacobian when covariance transport was done
     if (state.stepping.covTransport) {
       auto& tJacobian = std::get<Jacobian>(curvState);
-      propRes.transportJacobian =
+      result.transportJacobian =
           std::make_unique<const Jacobian>(std::move(tJacobian));
     }
-    return result;
-  } else {
-    return result.error();
   }
+  return status;
 }
 
 template <typename S, typename N>
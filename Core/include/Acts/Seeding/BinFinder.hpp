@@ -32,6 +32,17 @@ class BinFinder {
   std::vector<size_t> findBins(
       size_t phiBin, size_t zBin,
       const SpacePointGrid<external_spacepoint_t>* binnedSP);
+
+  /// Fill the bins that could contain space points that can be used with the
+  /// space points in the bin with the provided indices to create seeds.
+  /// @param phiBin phi index of bin with middle space points
+  /// @param zBin z index of bin with middle space points
+  /// @param binnedSP phi-z grid containing all bins
+  /// @param indices [out] the bin indices, replaces the previous content and
+  /// only allocates if the capacity is too small
+  void findBins(size_t phiBin, size_t zBin,
+                const SpacePointGrid<external_spacepoint_t>* binnedSP,
+                std::vector<size_t>& indices);
 };
 }  // namespace Acts
 #include "Acts/Seeding/BinFinder.ipp"
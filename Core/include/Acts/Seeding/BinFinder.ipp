@@ -11,3 +11,14 @@ std::vector<size_t> Acts::BinFinder<external_spacepoint_t>::findBins(
     const Acts::SpacePointGrid<external_spacepoint_t>* binnedSP) {
   return binnedSP->neighborHoodIndices({phiBin, zBin}).collect();
 }
+
+template <typename external_spacepoint_t>
+void Acts::BinFinder<external_spacepoint_t>::findBins(
+    size_t phiBin, size_t zBin,
+    const Acts::SpacePointGrid<external_spacepoint_t>* binnedSP,
+    std::vector<size_t>& indices) {
+  indices.clear();
+  for (size_t index : binnedSP->neighborHoodIndices({phiBin, zBin})) {
+    indices.push_back(index);
+  }
+}
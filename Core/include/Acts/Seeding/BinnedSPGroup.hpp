@@ -14,6 +14,7 @@
 #include "Acts/Seeding/SeedfinderConfig.hpp"
 #include "Acts/Seeding/SpacePointGrid.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -30,30 +31,32 @@ class NeighborhoodIterator {
 
   NeighborhoodIterator() = delete;
 
-  NeighborhoodIterator(std::vector<size_t> indices,
+  /// @note the indices are not copied and must outlive the iterator. They
+  /// are owned by the BinnedSPGroupIterator the Neighborhood was taken from.
+  NeighborhoodIterator(const std::vector<size_t>& indices,
                        const SpacePointGrid<external_spacepoint_t>* spgrid) {
     m_grid = spgrid;
-    m_indices = indices;
+    m_indices = &indices;
     m_curInd = 0;
-    if (m_indices.size() > m_curInd) {
-      m_curIt = std::begin(spgrid->at(m_indices[m_curInd]));
-      m_binEnd = std::end(spgrid->at(m_indices[m_curInd]));
+    if (m_indices->size() > m_curInd) {
+      m_curIt = std::begin(spgrid->at((*m_indices)[m_curInd]));
+      m_binEnd = std::end(spgrid->at((*m_indices)[m_curInd]));
     }
   }
 
-  NeighborhoodIterator(std::vector<size_t> indices,
+  NeighborhoodIterator(const std::vector<size_t>& indices,
                        const SpacePointGrid<external_spacepoint_t>* spgrid,
                        size_t curInd, sp_it_t curIt) {
     m_grid = spgrid;
-    m_indices = indices;
+    m_indices = &indices;
     m_curInd = curInd;
     m_curIt = curIt;
-    if (m_indices.size() > m_curInd) {
-      m_binEnd = std::end(spgrid->at(m_indices[m_curInd]));
+    if (m_indices->size() > m_curInd) {
+      m_binEnd = std::end(spgrid->at((*m_indices)[m_curInd]));
     }
   }
   static NeighborhoodIterator<external_spacepoint_t> begin(
-      std::vector<size_t> indices,
+      const std::vector<size_t>& indices,
       const SpacePointGrid<external_spacepoint_t>* spgrid) {
     auto nIt = NeighborhoodIterator<external_spacepoint_t>(indices, spgrid);
     // advance until first non-empty bin or last bin
@@ -83,10 +86,10 @@ class NeighborhoodIterator {
     }
     // increase bin index m_curInd until you find non-empty bin
     // or until m_curInd >= m_indices.size()-1
-    while (m_curIt == m_binEnd && m_indices.size() - 1 > m_curInd) {
+    while (m_curIt == m_binEnd && m_indices->size() - 1 > m_curInd) {
       m_curInd++;
-      m_curIt = std::begin(m_grid->at(m_indices[m_curInd]));
-      m_binEnd = std::end(m_grid->at(m_indices[m_curInd]));
+      m_curIt = std::begin(m_grid->at((*m_indices)[m_curInd]));
+      m_binEnd = std::end(m_grid->at((*m_indices)[m_curInd]));
     }
   }
 
@@ -101,8 +104,8 @@ class NeighborhoodIterator {
   // iterators within current bin
   sp_it_t m_curIt;
   sp_it_t m_binEnd;
-  // number of bins
-  std::vector<size_t> m_indices;
+  // number of bins, owned by the Neighborhood
+  const std::vector<size_t>* m_indices;
   // current bin
   size_t m_curInd;
   const Acts::SpacePointGrid<external_spacepoint_t>* m_grid;
@@ -111,32 +114,42 @@ class NeighborhoodIterator {
 ///@class Neighborhood Used to access iterators to access a group of bins
 /// returned by a BinFinder.
 /// Fulfills the range_expression interface
+///
+/// The Neighborhood does not copy the bin indices, it refers to the ones
+/// stored in the BinnedSPGroupIterator it was taken from. It is only valid
+/// until that iterator is advanced or destroyed.
 template <typename external_spacepoint_t>
 class Neighborhood {
  public:
   Neighborhood() = delete;
-  Neighborhood(std::vector<size_t> indices,
+  Neighborhood(const std::vector<size_t>& indices,
                const SpacePointGrid<external_spacepoint_t>* spgrid) {
-    m_indices = indices;
+    m_indices = &indices;
     m_spgrid = spgrid;
   }
-  NeighborhoodIterator<external_spacepoint_t> begin() {
-    return NeighborhoodIterator<external_spacepoint_t>::begin(m_indices,
+  /// The indices are not copied, they can not be a temporary
+  Neighborhood(std::vector<size_t>&& indices,
+               const SpacePointGrid<external_spacepoint_t>* spgrid) = delete;
+  NeighborhoodIterator<external_spacepoint_t> begin() const {
+    return NeighborhoodIterator<external_spacepoint_t>::begin(*m_indices,
                                                               m_spgrid);
   }
-  NeighborhoodIterator<external_spacepoint_t> end() {
+  NeighborhoodIterator<external_spacepoint_t> end() const {
     return NeighborhoodIterator<external_spacepoint_t>(
-        m_indices, m_spgrid, m_indices.size() - 1,
-        std::end(m_spgrid->at(m_indices.back())));
+        *m_indices, m_spgrid, m_indices->size() - 1,
+        std::end(m_spgrid->at(m_indices->back())));
   }
 
  private:
-  std::vector<size_t> m_indices;
+  const std::vector<size_t>* m_indices;
   const SpacePointGrid<external_spacepoint_t>* m_spgrid;
 };
 
 ///@class BinnedSPGroupIterator Allows to iterate over all groups of bins
 /// a provided BinFinder can generate for each bin of a provided SPGrid
+///
+/// The bin indices of the current group are stored in buffers which are
+/// reused when the iterator is advanced, the neighborhoods refer to them.
 template <typename external_spacepoint_t>
 class BinnedSPGroupIterator {
  public:
@@ -150,10 +163,9 @@ class BinnedSPGroupIterator {
     }
     // set current & neighbor bins only if bin indices valid
     if (phiIndex <= phiZbins[0] && zIndex <= phiZbins[1]) {
-      currentBin =
-          std::vector<size_t>{grid->globalBinFromLocalBins({phiIndex, zIndex})};
-      bottomBinIndices = m_bottomBinFinder->findBins(phiIndex, zIndex, grid);
-      topBinIndices = m_topBinFinder->findBins(phiIndex, zIndex, grid);
+      currentBin.assign(1, grid->globalBinFromLocalBins({phiIndex, zIndex}));
+      m_bottomBinFinder->findBins(phiIndex, zIndex, grid, bottomBinIndices);
+      m_topBinFinder->findBins(phiIndex, zIndex, grid, topBinIndices);
       outputIndex++;
       return *this;
     }
@@ -166,15 +178,16 @@ class BinnedSPGroupIterator {
     return (zIndex == otherState.zIndex && phiIndex == otherState.phiIndex);
   }
 
-  Neighborhood<external_spacepoint_t> middle() {
+  /// @note the neighborhoods are valid until the iterator is advanced
+  Neighborhood<external_spacepoint_t> middle() const {
     return Neighborhood<external_spacepoint_t>(currentBin, grid);
   }
 
-  Neighborhood<external_spacepoint_t> bottom() {
+  Neighborhood<external_spacepoint_t> bottom() const {
     return Neighborhood<external_spacepoint_t>(bottomBinIndices, grid);
   }
 
-  Neighborhood<external_spacepoint_t> top() {
+  Neighborhood<external_spacepoint_t> top() const {
     return Neighborhood<external_spacepoint_t>(topBinIndices, grid);
   }
 
@@ -189,8 +202,8 @@ class BinnedSPGroupIterator {
     phiIndex = 1;
     zIndex = 1;
     outputIndex = 0;
-    bottomBinIndices = m_bottomBinFinder->findBins(phiIndex, zIndex, grid);
-    topBinIndices = m_topBinFinder->findBins(phiIndex, zIndex, grid);
+    m_bottomBinFinder->findBins(phiIndex, zIndex, grid, bottomBinIndices);
+    m_topBinFinder->findBins(phiIndex, zIndex, grid, topBinIndices);
   }
 
   BinnedSPGroupIterator(const SpacePointGrid<external_spacepoint_t>* spgrid,
@@ -206,8 +219,8 @@ class BinnedSPGroupIterator {
     phiZbins = grid->numLocalBins();
     outputIndex = (phiInd - 1) * phiZbins[1] + zInd - 1;
     if (phiIndex <= phiZbins[0] && zIndex <= phiZbins[1]) {
-      bottomBinIndices = m_bottomBinFinder->findBins(phiIndex, zIndex, grid);
-      topBinIndices = m_topBinFinder->findBins(phiIndex, zIndex, grid);
+      m_bottomBinFinder->findBins(phiIndex, zIndex, grid, bottomBinIndices);
+      m_topBinFinder->findBins(phiIndex, zIndex, grid, topBinIndices);
     }
   }
 
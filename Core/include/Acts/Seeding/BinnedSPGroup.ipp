@@ -81,6 +81,21 @@ Acts::BinnedSPGroup<external_spacepoint_t>::BinnedSPGroup(
       bin.push_back(std::move(isp));
     }
   }
+  // remove the residual disorder below the r-bin size if requested, such
+  // that the seed finder can use binary searches in r
+  if (config.sortBinsInR) {
+    for (size_t i = 0; i < grid->size(); ++i) {
+      auto& bin = grid->at(i);
+      std::stable_sort(
+          bin.begin(), bin.end(),
+          [](const std::unique_ptr<
+                 const InternalSpacePoint<external_spacepoint_t>>& a,
+             const std::unique_ptr<
+                 const InternalSpacePoint<external_spacepoint_t>>& b) {
+            return a->radius() < b->radius();
+          });
+    }
+  }
   m_binnedSP = std::move(grid);
   m_bottomBinFinder = botBinFinder;
   m_topBinFinder = tBinFinder;
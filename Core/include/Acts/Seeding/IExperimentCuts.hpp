@@ -9,6 +9,9 @@
 #pragma once
 
 #include <memory>
+#include <utility>
+#include <vector>
+
 #include "Acts/Seeding/InternalSeed.hpp"
 
 namespace Acts {
@@ -40,15 +43,41 @@ class IExperimentCuts {
       const InternalSpacePoint<SpacePoint>& middle,
       const InternalSpacePoint<SpacePoint>& top) const = 0;
 
+  /// @param [in,out] seeds contains pairs of weight and seed created for one
+  /// middle space point, sorted by descending weight. Seeds that do not pass
+  /// the cut are removed in place.
+  /// @note The default implementation forwards to the deprecated overload
+  /// below, such that implementations of the old interface keep working.
+  virtual void cutPerMiddleSP(
+      std::vector<std::pair<float, InternalSeed<SpacePoint>>>& seeds) const {
+    std::vector<
+        std::pair<float, std::unique_ptr<const InternalSeed<SpacePoint>>>>
+        seedPtrs;
+    seedPtrs.reserve(seeds.size());
+    for (const auto& seed : seeds) {
+      seedPtrs.emplace_back(
+          seed.first,
+          std::make_unique<const InternalSeed<SpacePoint>>(seed.second));
+    }
+    seedPtrs = cutPerMiddleSP(std::move(seedPtrs));
+    seeds.clear();
+    for (const auto& seed : seedPtrs) {
+      seeds.emplace_back(seed.first, *seed.second);
+    }
+  }
+
+  /// @deprecated allocates every seed, override the in-place overload
+  /// above instead. The default implementation keeps all seeds.
   /// @param seeds contains pairs of weight and seed created for one middle
-  /// space
-  /// point
+  /// space point
   /// @return vector of seeds that pass the cut
   virtual std::vector<
       std::pair<float, std::unique_ptr<const InternalSeed<SpacePoint>>>>
   cutPerMiddleSP(
       std::vector<
           std::pair<float, std::unique_ptr<const InternalSeed<SpacePoint>>>>
-          seeds) const = 0;
+          seeds) const {
+    return seeds;
+  }
 };
 }  // namespace Acts
@@ -0,0 +1,60 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace Acts {
+
+/// Parameters of a space point duplet required to calculate the helix circle
+/// with a linear equation (u,v transform relative to the middle space point)
+struct LinCircle {
+  float Zo;
+  float cotTheta;
+  float iDeltaR;
+  float Er;
+  float U;
+  float V;
+};
+
+/// Structure-of-arrays storage of LinCircle objects, one contiguous column
+/// per parameter, such that loops over all duplets of a middle space point
+/// can be vectorized.
+struct LinCircleColumns {
+  std::vector<float> Zo;
+  std::vector<float> cotTheta;
+  std::vector<float> iDeltaR;
+  std::vector<float> Er;
+  std::vector<float> U;
+  std::vector<float> V;
+
+  size_t size() const { return Zo.size(); }
+
+  /// Remove all entries but keep the allocated capacity
+  void clear() {
+    Zo.clear();
+    cotTheta.clear();
+    iDeltaR.clear();
+    Er.clear();
+    U.clear();
+    V.clear();
+  }
+
+  void push_back(const LinCircle& l) {
+    Zo.push_back(l.Zo);
+    cotTheta.push_back(l.cotTheta);
+    iDeltaR.push_back(l.iDeltaR);
+    Er.push_back(l.Er);
+    U.push_back(l.U);
+    V.push_back(l.V);
+  }
+};
+
+}  // namespace Acts
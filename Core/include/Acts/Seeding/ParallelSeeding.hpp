@@ -0,0 +1,61 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <vector>
+
+#include "Acts/Seeding/BinnedSPGroup.hpp"
+#include "Acts/Seeding/Seed.hpp"
+#include "Acts/Seeding/Seedfinder.hpp"
+#include "Acts/Utilities/ParallelFor.hpp"
+
+namespace Acts {
+
+/// Create the seeds for all groups of a BinnedSPGroup using several threads
+///
+/// The (bottom, middle, top) neighborhoods of all phi-z bins are collected
+/// first and then distributed dynamically over the threads. Every thread
+/// uses its own Seedfinder state, the seeds of each group are stored in a
+/// separate output slot. The result is therefore identical to calling
+/// Seedfinder::createSeedsForGroup in a serial loop over the BinnedSPGroup,
+/// independent of the number of threads.
+///
+/// @param seedfinder the seed finder, must be safe to call concurrently
+/// @param spGroup the binned space points
+/// @param nThreads number of threads, 0 uses all hardware threads
+///
+/// @return one vector of seeds per group, in the order of iteration over
+///         the BinnedSPGroup
+template <typename external_spacepoint_t>
+std::vector<std::vector<Seed<external_spacepoint_t>>> createSeedsParallel(
+    const Seedfinder<external_spacepoint_t>& seedfinder,
+    BinnedSPGroup<external_spacepoint_t>& spGroup, size_t nThreads = 0) {
+  // The neighborhoods refer to the bin indices of the iterator, one copy of
+  // the iterator is kept per group
+  std::vector<BinnedSPGroupIterator<external_spacepoint_t>> groups;
+  auto groupIt = spGroup.begin();
+  auto endOfGroups = spGroup.end();
+  for (; !(groupIt == endOfGroups); ++groupIt) {
+    groups.push_back(groupIt);
+  }
+
+  std::vector<std::vector<Seed<external_spacepoint_t>>> seeds(groups.size());
+  std::vector<typename Seedfinder<external_spacepoint_t>::State> states(
+      resolveNumberOfThreads(nThreads, groups.size()));
+  parallelFor(groups.size(), states.size(),
+              [&](size_t groupIndex, size_t threadIndex) {
+                const auto& group = groups[groupIndex];
+                seeds[groupIndex] = seedfinder.createSeedsForGroup(
+                    states[threadIndex], group.bottom(), group.middle(),
+                    group.top());
+              });
+  return seeds;
+}
+
+}  // namespace Acts
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <array>
 #include <vector>
 
 namespace Acts {
@@ -21,13 +22,18 @@ class Seed {
   Seed(const SpacePoint& b, const SpacePoint& m, const SpacePoint& u,
        float vertex);
   Seed(const Seed&) = default;
-  Seed& operator=(const Seed&);
-
-  const std::vector<const SpacePoint*>& sp() const { return m_spacepoints; }
+  Seed& operator=(const Seed&) = default;
+
+  /// @return the bottom, middle and top space point of the seed
+  const std::array<const SpacePoint*, 3>& spacePoints() const {
+    return m_spacepoints;
+  }
+  /// @deprecated use spacePoints()
+  const std::array<const SpacePoint*, 3>& sp() const { return m_spacepoints; }
   double z() const { return m_zvertex; }
 
  private:
-  std::vector<const SpacePoint*> m_spacepoints;
+  std::array<const SpacePoint*, 3> m_spacepoints;
   float m_zvertex;
 };
 
@@ -37,11 +43,9 @@ class Seed {
 
 template <typename SpacePoint>
 Seed<SpacePoint>::Seed(const SpacePoint& b, const SpacePoint& m,
-                       const SpacePoint& u, float vertex) {
+                       const SpacePoint& u, float vertex)
+    : m_spacepoints({&b, &m, &u}) {
   m_zvertex = vertex;
-  m_spacepoints.push_back(&b);
-  m_spacepoints.push_back(&m);
-  m_spacepoints.push_back(&u);
 }
 
 }  // namespace Acts
@@ -38,6 +38,13 @@ struct SeedFilterConfig {
   // Tool to apply experiment specific cuts on collected middle space points
 };
 
+/// Scratch buffers of the SeedFilter, owned by the caller. Reusing the same
+/// state for many calls avoids repeated allocations.
+struct SeedFilterState {
+  // radii of the compatible seeds found for the current seed
+  std::vector<float> compatibleSeedR;
+};
+
 /// @class Filter seeds at various stages with the currently
 /// available information.
 template <typename external_spacepoint_t>
@@ -51,6 +58,30 @@ class SeedFilter {
 
   /// Create InternalSeeds for the all seeds with the same bottom and middle
   /// space point and discard all others.
+  /// @param state scratch buffers, must not be shared between threads
+  /// @param bottomSP fixed bottom space point
+  /// @param middleSP fixed middle space point
+  /// @param topSpVec vector containing all space points that may be compatible
+  /// with both bottom and middle space point
+  /// @param origin on the z axis as defined by bottom and middle space point
+  /// @param selectedSeeds [out] pairs containing seed weight and seed for all
+  /// valid created seeds are appended
+  virtual void filterSeeds_2SpFixed(
+      SeedFilterState& state,
+      const InternalSpacePoint<external_spacepoint_t>& bottomSP,
+      const InternalSpacePoint<external_spacepoint_t>& middleSP,
+      std::vector<const InternalSpacePoint<external_spacepoint_t>*>& topSpVec,
+      std::vector<float>& invHelixDiameterVec,
+      std::vector<float>& impactParametersVec, float zOrigin,
+      std::vector<std::pair<float, InternalSeed<external_spacepoint_t>>>&
+          selectedSeeds) const;
+
+  /// Create InternalSeeds for the all seeds with the same bottom and middle
+  /// space point and discard all others.
+  /// @deprecated allocates the scratch buffers and every seed, use the
+  /// overload with a SeedFilterState. The seed finder only calls the new
+  /// overload, this one is final such that overrides fail to compile
+  /// instead of being silently bypassed.
   /// @param bottomSP fixed bottom space point
   /// @param middleSP fixed middle space point
   /// @param topSpVec vector containing all space points that may be compatible
@@ -65,17 +96,30 @@ class SeedFilter {
       const InternalSpacePoint<external_spacepoint_t>& middleSP,
       std::vector<const InternalSpacePoint<external_spacepoint_t>*>& topSpVec,
       std::vector<float>& invHelixDiameterVec,
-      std::vector<float>& impactParametersVec, float zOrigin) const;
+      std::vector<float>& impactParametersVec, float zOrigin) const final;
+
+  /// Filter seeds once all seeds for one middle space point have been created
+  /// @param seedsPerSpM vector of pairs containing weight and seed for all
+  /// for all seeds with the same middle space point, is sorted and cut
+  /// @param outVec [out] all seeds that are not filtered out are appended
+  virtual void filterSeeds_1SpFixed(
+      std::vector<std::pair<float, InternalSeed<external_spacepoint_t>>>&
+          seedsPerSpM,
+      std::vector<Seed<external_spacepoint_t>>& outVec) const;
 
   /// Filter seeds once all seeds for one middle space point have been created
+  /// @deprecated allocates every seed, use the overload with seeds stored
+  /// by value. The seed finder only calls the new overload, this one is
+  /// final such that overrides fail to compile instead of being silently
+  /// bypassed.
   /// @param seedsPerSpM vector of pairs containing weight and seed for all
-  /// for all seeds with the same middle space point
-  /// @return vector of all InternalSeeds that not filtered out
+  /// for all seeds with the same middle space point, is sorted and cut
+  /// @param outVec [out] all seeds that are not filtered out are appended
   virtual void filterSeeds_1SpFixed(
       std::vector<std::pair<
           float, std::unique_ptr<const InternalSeed<external_spacepoint_t>>>>&
           seedsPerSpM,
-      std::vector<Seed<external_spacepoint_t>>& outVec) const;
+      std::vector<Seed<external_spacepoint_t>>& outVec) const final;
 
  private:
   const SeedFilterConfig m_cfg;
@@ -6,6 +6,8 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
+#include <algorithm>
+#include <memory>
 #include <utility>
 
 namespace Acts {
@@ -20,23 +22,22 @@ SeedFilter<external_spacepoint_t>::SeedFilter(
 // middle-spacepoint.
 // return vector must contain weight of each seed
 template <typename external_spacepoint_t>
-std::vector<std::pair<
-    float, std::unique_ptr<const InternalSeed<external_spacepoint_t>>>>
-SeedFilter<external_spacepoint_t>::filterSeeds_2SpFixed(
+void SeedFilter<external_spacepoint_t>::filterSeeds_2SpFixed(
+    SeedFilterState& state,
     const InternalSpacePoint<external_spacepoint_t>& bottomSP,
     const InternalSpacePoint<external_spacepoint_t>& middleSP,
     std::vector<const InternalSpacePoint<external_spacepoint_t>*>& topSpVec,
     std::vector<float>& invHelixDiameterVec,
-    std::vector<float>& impactParametersVec, float zOrigin) const {
-  std::vector<std::pair<
-      float, std::unique_ptr<const InternalSeed<external_spacepoint_t>>>>
-      selectedSeeds;
+    std::vector<float>& impactParametersVec, float zOrigin,
+    std::vector<std::pair<float, InternalSeed<external_spacepoint_t>>>&
+        selectedSeeds) const {
+  std::vector<float>& compatibleSeedR = state.compatibleSeedR;
 
   for (size_t i = 0; i < topSpVec.size(); i++) {
     // if two compatible seeds with high distance in r are found, compatible
     // seeds span 5 layers
     // -> very good seed
-    std::vector<float> compatibleSeedR;
+    compatibleSeedR.clear();
 
     float invHelixDiameter = invHelixDiameterVec[i];
     float lowerLimitCurv = invHelixDiameter - m_cfg.deltaInvHelixDiameter;
@@ -92,9 +93,35 @@ SeedFilter<external_spacepoint_t>::filterSeeds_2SpFixed(
         continue;
       }
     }
-    selectedSeeds.push_back(std::make_pair(
-        weight, std::make_unique<const InternalSeed<external_spacepoint_t>>(
-                    bottomSP, middleSP, *topSpVec[i], zOrigin)));
+    selectedSeeds.emplace_back(
+        weight, InternalSeed<external_spacepoint_t>(bottomSP, middleSP,
+                                                    *topSpVec[i], zOrigin));
+  }
+}
+
+template <typename external_spacepoint_t>
+std::vector<std::pair<
+    float, std::unique_ptr<const InternalSeed<external_spacepoint_t>>>>
+SeedFilter<external_spacepoint_t>::filterSeeds_2SpFixed(
+    const InternalSpacePoint<external_spacepoint_t>& bottomSP,
+    const InternalSpacePoint<external_spacepoint_t>& middleSP,
+    std::vector<const InternalSpacePoint<external_spacepoint_t>*>& topSpVec,
+    std::vector<float>& invHelixDiameterVec,
+    std::vector<float>& impactParametersVec, float zOrigin) const {
+  SeedFilterState state;
+  std::vector<std::pair<float, InternalSeed<external_spacepoint_t>>> seeds;
+  filterSeeds_2SpFixed(state, bottomSP, middleSP, topSpVec,
+                       invHelixDiameterVec, impactParametersVec, zOrigin,
+                       seeds);
+  std::vector<std::pair<
+      float, std::unique_ptr<const InternalSeed<external_spacepoint_t>>>>
+      selectedSeeds;
+  selectedSeeds.reserve(seeds.size());
+  for (const auto& seed : seeds) {
+    selectedSeeds.emplace_back(
+        seed.first,
+        std::make_unique<const InternalSeed<external_spacepoint_t>>(
+            seed.second));
   }
   return selectedSeeds;
 }
@@ -102,21 +129,18 @@ SeedFilter<external_spacepoint_t>::filterSeeds_2SpFixed(
 // after creating all seeds with a common middle space point, filter again
 template <typename external_spacepoint_t>
 void SeedFilter<external_spacepoint_t>::filterSeeds_1SpFixed(
-    std::vector<std::pair<
-        float, std::unique_ptr<const InternalSeed<external_spacepoint_t>>>>&
+    std::vector<std::pair<float, InternalSeed<external_spacepoint_t>>>&
         seedsPerSpM,
     std::vector<Seed<external_spacepoint_t>>& outVec) const {
   // sort by weight and iterate only up to configured max number of seeds per
   // middle SP
-  std::sort((seedsPerSpM.begin()), (seedsPerSpM.end()),
-            [](const std::pair<float, std::unique_ptr<const Acts::InternalSeed<
-                                          external_spacepoint_t>>>& i1,
-               const std::pair<float, std::unique_ptr<const Acts::InternalSeed<
-                                          external_spacepoint_t>>>& i2) {
-              return i1.first > i2.first;
-            });
+  std::sort(
+      (seedsPerSpM.begin()), (seedsPerSpM.end()),
+      [](const std::pair<float, Acts::InternalSeed<external_spacepoint_t>>& i1,
+         const std::pair<float, Acts::InternalSeed<external_spacepoint_t>>&
+             i2) { return i1.first > i2.first; });
   if (m_experimentCuts != nullptr) {
-    seedsPerSpM = m_experimentCuts->cutPerMiddleSP(std::move(seedsPerSpM));
+    m_experimentCuts->cutPerMiddleSP(seedsPerSpM);
   }
   unsigned int maxSeeds = seedsPerSpM.size();
   if (maxSeeds > m_cfg.maxSeedsPerSpM) {
@@ -129,8 +153,30 @@ void SeedFilter<external_spacepoint_t>::filterSeeds_1SpFixed(
   // weight seeds
   for (; it < itBegin + maxSeeds; ++it) {
     outVec.push_back(Seed<external_spacepoint_t>(
-        (*it).second->sp[0]->sp(), (*it).second->sp[1]->sp(),
-        (*it).second->sp[2]->sp(), (*it).second->z()));
+        (*it).second.sp[0]->sp(), (*it).second.sp[1]->sp(),
+        (*it).second.sp[2]->sp(), (*it).second.z()));
+  }
+}
+
+template <typename external_spacepoint_t>
+void SeedFilter<external_spacepoint_t>::filterSeeds_1SpFixed(
+    std::vector<std::pair<
+        float, std::unique_ptr<const InternalSeed<external_spacepoint_t>>>>&
+        seedsPerSpM,
+    std::vector<Seed<external_spacepoint_t>>& outVec) const {
+  std::vector<std::pair<float, InternalSeed<external_spacepoint_t>>> seeds;
+  seeds.reserve(seedsPerSpM.size());
+  for (const auto& seed : seedsPerSpM) {
+    seeds.emplace_back(seed.first, *seed.second);
+  }
+  filterSeeds_1SpFixed(seeds, outVec);
+  // hand the sorted and cut seeds back to the caller
+  seedsPerSpM.clear();
+  for (const auto& seed : seeds) {
+    seedsPerSpM.emplace_back(
+        seed.first,
+        std::make_unique<const InternalSeed<external_spacepoint_t>>(
+            seed.second));
   }
 }
 
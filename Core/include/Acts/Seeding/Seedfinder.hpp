@@ -10,7 +10,10 @@
 
 #include "Acts/Seeding/InternalSeed.hpp"
 #include "Acts/Seeding/InternalSpacePoint.hpp"
+#include "Acts/Seeding/LinCircle.hpp"
 #include "Acts/Seeding/SeedfinderConfig.hpp"
+#include "Acts/Seeding/SeedfinderState.hpp"
+#include "Acts/Seeding/detail/SeedfinderKernels.hpp"
 
 #include <array>
 #include <list>
@@ -22,14 +25,6 @@
 #include <vector>
 
 namespace Acts {
-struct LinCircle {
-  float Zo;
-  float cotTheta;
-  float iDeltaR;
-  float Er;
-  float U;
-  float V;
-};
 template <typename external_spacepoint_t>
 class Seedfinder {
   ///////////////////////////////////////////////////////////////////
@@ -37,6 +32,8 @@ class Seedfinder {
   ///////////////////////////////////////////////////////////////////
 
  public:
+  using State = SeedfinderState<external_spacepoint_t>;
+
   /// The only constructor. Requires a config object.
   /// @param config the configuration for the Seedfinder
   Seedfinder(Acts::SeedfinderConfig<external_spacepoint_t> config);
@@ -61,11 +58,56 @@ class Seedfinder {
   std::vector<Seed<external_spacepoint_t>> createSeedsForGroup(
       sp_range_t bottomSPs, sp_range_t middleSPs, sp_range_t topSPs) const;
 
+  /// Create all seeds from the space points in the three iterators using
+  /// caller-owned scratch buffers.
+  /// @param state scratch buffers, reused between calls. Parallel calls
+  /// must use separate states.
+  /// @param bottom group of space points to be used as innermost SP in a seed.
+  /// @param middle group of space points to be used as middle SP in a seed.
+  /// @param top group of space points to be used as outermost SP in a seed.
+  /// @return vector in which all found seeds for this group are stored.
+  template <typename sp_range_t>
+  std::vector<Seed<external_spacepoint_t>> createSeedsForGroup(
+      State& state, sp_range_t&& bottomSPs, sp_range_t&& middleSPs,
+      sp_range_t&& topSPs) const;
+
+  /// Create all seeds from the space points in the three iterators using
+  /// caller-owned scratch buffers and output container. Once the buffers
+  /// have grown to the size required by the largest group, no further heap
+  /// allocations are performed.
+  /// @param state scratch buffers, reused between calls. Parallel calls
+  /// must use separate states.
+  /// @param outputVec [out] the seeds found for this group are appended
+  /// @param bottom group of space points to be used as innermost SP in a seed.
+  /// @param middle group of space points to be used as middle SP in a seed.
+  /// @param top group of space points to be used as outermost SP in a seed.
+  template <typename sp_range_t>
+  void createSeedsForGroup(State& state,
+                           std::vector<Seed<external_spacepoint_t>>& outputVec,
+                           sp_range_t&& bottomSPs, sp_range_t&& middleSPs,
+                           sp_range_t&& topSPs) const;
+
  private:
+  template <typename lin_circle_container_t>
   void transformCoordinates(
       std::vector<const InternalSpacePoint<external_spacepoint_t>*>& vec,
       const InternalSpacePoint<external_spacepoint_t>& spM, bool bottom,
-      std::vector<LinCircle>& linCircleVec) const;
+      lin_circle_container_t& linCircleVec) const;
+
+  /// Select the compatible duplets of a middle space point using the
+  /// vectorized duplet kernel. With r-sorted bins, only the candidates in
+  /// the deltaR window are evaluated.
+  /// @param candidates columns of all bottom or top space points
+  /// @param spM the middle space point
+  /// @param bottom true if the candidates are bottom space points
+  /// @param accept scratch buffer for the kernel output
+  /// @param compatSP [out] the compatible space points
+  void columnDoublets(
+      const detail::SpacePointColumns<external_spacepoint_t>& candidates,
+      const InternalSpacePoint<external_spacepoint_t>& spM, bool bottom,
+      std::vector<int>& accept,
+      std::vector<const InternalSpacePoint<external_spacepoint_t>*>& compatSP)
+      const;
 
   Acts::SeedfinderConfig<external_spacepoint_t> m_config;
 };
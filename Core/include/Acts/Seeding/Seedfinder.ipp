@@ -6,6 +6,7 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
+#include <algorithm>
 #include <cmath>
 #include <numeric>
 #include <type_traits>
@@ -39,7 +40,47 @@ template <typename sp_range_t>
 std::vector<Seed<external_spacepoint_t>>
 Seedfinder<external_spacepoint_t>::createSeedsForGroup(
     sp_range_t bottomSPs, sp_range_t middleSPs, sp_range_t topSPs) const {
+  State state;
+  return createSeedsForGroup(state, bottomSPs, middleSPs, topSPs);
+}
+
+template <typename external_spacepoint_t>
+template <typename sp_range_t>
+std::vector<Seed<external_spacepoint_t>>
+Seedfinder<external_spacepoint_t>::createSeedsForGroup(
+    State& state, sp_range_t&& bottomSPs, sp_range_t&& middleSPs,
+    sp_range_t&& topSPs) const {
   std::vector<Seed<external_spacepoint_t>> outputVec;
+  createSeedsForGroup(state, outputVec, bottomSPs, middleSPs, topSPs);
+  return outputVec;
+}
+
+template <typename external_spacepoint_t>
+template <typename sp_range_t>
+void Seedfinder<external_spacepoint_t>::createSeedsForGroup(
+    State& state, std::vector<Seed<external_spacepoint_t>>& outputVec,
+    sp_range_t&& bottomSPs, sp_range_t&& middleSPs,
+    sp_range_t&& topSPs) const {
+  auto& compatBottomSP = state.compatBottomSP;
+  auto& compatTopSP = state.compatTopSP;
+  auto& linCircleBottom = state.linCircleBottom;
+  auto& linCircleTop = state.linCircleTop;
+  auto& topSpVec = state.topSpVec;
+  auto& curvatures = state.curvatures;
+  auto& impactParameters = state.impactParameters;
+  auto& seedsPerSpM = state.seedsPerSpM;
+
+  // structure-of-arrays buffers for the vectorized kernels, the bottom and
+  // top candidates are the same for all middle space points of the group
+  auto& linCircleTopColumns = state.linCircleTopColumns;
+  auto& accept = state.accept;
+  const bool useColumns =
+      m_config.useVectorizedKernels || m_config.sortBinsInR;
+  if (useColumns) {
+    state.bottomColumns.fill(bottomSPs);
+    state.topColumns.fill(topSPs);
+  }
+
   for (auto spM : middleSPs) {
     float rM = spM->radius();
     float zM = spM->z();
@@ -47,81 +88,86 @@ Seedfinder<external_spacepoint_t>::createSeedsForGroup(
     float varianceZM = spM->varianceZ();
 
     // bottom space point
-    std::vector<const InternalSpacePoint<external_spacepoint_t>*>
-        compatBottomSP;
+    compatBottomSP.clear();
 
-    for (auto bottomSP : bottomSPs) {
-      float rB = bottomSP->radius();
-      float deltaR = rM - rB;
-      // if r-distance is too big, try next SP in bin
-      if (deltaR > m_config.deltaRMax) {
-        continue;
-      }
-      // if r-distance is too small, break because bins are NOT r-sorted
-      if (deltaR < m_config.deltaRMin) {
-        continue;
-      }
-      // ratio Z/R (forward angle) of space point duplet
-      float cotTheta = (zM - bottomSP->z()) / deltaR;
-      if (std::fabs(cotTheta) > m_config.cotThetaMax) {
-        continue;
-      }
-      // check if duplet origin on z axis within collision region
-      float zOrigin = zM - rM * cotTheta;
-      if (zOrigin < m_config.collisionRegionMin ||
-          zOrigin > m_config.collisionRegionMax) {
-        continue;
+    if (useColumns) {
+      columnDoublets(state.bottomColumns, *spM, true, accept, compatBottomSP);
+    } else {
+      for (auto bottomSP : bottomSPs) {
+        float rB = bottomSP->radius();
+        float deltaR = rM - rB;
+        // if r-distance is too big, try next SP in bin
+        if (deltaR > m_config.deltaRMax) {
+          continue;
+        }
+        // if r-distance is too small, break because bins are NOT r-sorted
+        if (deltaR < m_config.deltaRMin) {
+          continue;
+        }
+        // ratio Z/R (forward angle) of space point duplet
+        float cotTheta = (zM - bottomSP->z()) / deltaR;
+        if (std::fabs(cotTheta) > m_config.cotThetaMax) {
+          continue;
+        }
+        // check if duplet origin on z axis within collision region
+        float zOrigin = zM - rM * cotTheta;
+        if (zOrigin < m_config.collisionRegionMin ||
+            zOrigin > m_config.collisionRegionMax) {
+          continue;
+        }
+        compatBottomSP.push_back(bottomSP);
       }
-      compatBottomSP.push_back(bottomSP);
     }
     // no bottom SP found -> try next spM
     if (compatBottomSP.empty()) {
       continue;
     }
 
-    std::vector<const InternalSpacePoint<external_spacepoint_t>*> compatTopSP;
+    compatTopSP.clear();
 
-    for (auto topSP : topSPs) {
-      float rT = topSP->radius();
-      float deltaR = rT - rM;
-      // this condition is the opposite of the condition for bottom SP
-      if (deltaR < m_config.deltaRMin) {
-        continue;
-      }
-      if (deltaR > m_config.deltaRMax) {
-        break;
-      }
+    if (useColumns) {
+      columnDoublets(state.topColumns, *spM, false, accept, compatTopSP);
+    } else {
+      for (auto topSP : topSPs) {
+        float rT = topSP->radius();
+        float deltaR = rT - rM;
+        // this condition is the opposite of the condition for bottom SP
+        if (deltaR < m_config.deltaRMin) {
+          continue;
+        }
+        if (deltaR > m_config.deltaRMax) {
+          break;
+        }
 
-      float cotTheta = (topSP->z() - zM) / deltaR;
-      if (std::fabs(cotTheta) > m_config.cotThetaMax) {
-        continue;
-      }
-      float zOrigin = zM - rM * cotTheta;
-      if (zOrigin < m_config.collisionRegionMin ||
-          zOrigin > m_config.collisionRegionMax) {
-        continue;
+        float cotTheta = (topSP->z() - zM) / deltaR;
+        if (std::fabs(cotTheta) > m_config.cotThetaMax) {
+          continue;
+        }
+        float zOrigin = zM - rM * cotTheta;
+        if (zOrigin < m_config.collisionRegionMin ||
+            zOrigin > m_config.collisionRegionMax) {
+          continue;
+        }
+        compatTopSP.push_back(topSP);
       }
-      compatTopSP.push_back(topSP);
     }
     if (compatTopSP.empty()) {
       continue;
     }
     // contains parameters required to calculate circle with linear equation
     // ...for bottom-middle
-    std::vector<LinCircle> linCircleBottom;
+    linCircleBottom.clear();
     // ...for middle-top
-    std::vector<LinCircle> linCircleTop;
+    linCircleTop.clear();
     transformCoordinates(compatBottomSP, *spM, true, linCircleBottom);
-    transformCoordinates(compatTopSP, *spM, false, linCircleTop);
-
-    // create vectors here to avoid reallocation in each loop
-    std::vector<const InternalSpacePoint<external_spacepoint_t>*> topSpVec;
-    std::vector<float> curvatures;
-    std::vector<float> impactParameters;
+    if (m_config.useVectorizedKernels) {
+      linCircleTopColumns.clear();
+      transformCoordinates(compatTopSP, *spM, false, linCircleTopColumns);
+    } else {
+      transformCoordinates(compatTopSP, *spM, false, linCircleTop);
+    }
 
-    std::vector<std::pair<
-        float, std::unique_ptr<const InternalSeed<external_spacepoint_t>>>>
-        seedsPerSpM;
+    seedsPerSpM.clear();
     size_t numBotSP = compatBottomSP.size();
     size_t numTopSP = compatTopSP.size();
 
@@ -154,102 +200,160 @@ Seedfinder<external_spacepoint_t>::createSeedsForGroup(
       topSpVec.clear();
       curvatures.clear();
       impactParameters.clear();
-      for (size_t t = 0; t < numTopSP; t++) {
-        auto lt = linCircleTop[t];
+      if (m_config.useVectorizedKernels) {
+        detail::tripletCompatibility(lb, linCircleTopColumns, compatTopSP, rM,
+                                     varianceRM, varianceZM, m_config,
+                                     topSpVec, curvatures, impactParameters);
+      } else {
+        for (size_t t = 0; t < numTopSP; t++) {
+          auto lt = linCircleTop[t];
 
-        // add errors of spB-spM and spM-spT pairs and add the correlation term
-        // for errors on spM
-        float error2 = lt.Er + ErB +
-                       2 * (cotThetaB * lt.cotTheta * varianceRM + varianceZM) *
-                           iDeltaRB * lt.iDeltaR;
+          // add errors of spB-spM and spM-spT pairs and add the correlation
+          // term for errors on spM
+          float error2 =
+              lt.Er + ErB +
+              2 * (cotThetaB * lt.cotTheta * varianceRM + varianceZM) *
+                  iDeltaRB * lt.iDeltaR;
 
-        float deltaCotTheta = cotThetaB - lt.cotTheta;
-        float deltaCotTheta2 = deltaCotTheta * deltaCotTheta;
-        float error;
-        float dCotThetaMinusError2;
-        // if the error is larger than the difference in theta, no need to
-        // compare with scattering
-        if (deltaCotTheta2 - error2 > 0) {
-          deltaCotTheta = std::abs(deltaCotTheta);
-          // if deltaTheta larger than the scattering for the lower pT cut, skip
-          error = std::sqrt(error2);
-          dCotThetaMinusError2 =
-              deltaCotTheta2 + error2 - 2 * deltaCotTheta * error;
-          // avoid taking root of scatteringInRegion
-          // if left side of ">" is positive, both sides of unequality can be
-          // squared
-          // (scattering is always positive)
+          float deltaCotTheta = cotThetaB - lt.cotTheta;
+          float deltaCotTheta2 = deltaCotTheta * deltaCotTheta;
+          float error;
+          float dCotThetaMinusError2;
+          // if the error is larger than the difference in theta, no need to
+          // compare with scattering
+          if (deltaCotTheta2 - error2 > 0) {
+            deltaCotTheta = std::abs(deltaCotTheta);
+            // if deltaTheta larger than the scattering for the lower pT cut,
+            // skip
+            error = std::sqrt(error2);
+            dCotThetaMinusError2 =
+                deltaCotTheta2 + error2 - 2 * deltaCotTheta * error;
+            // avoid taking root of scatteringInRegion
+            // if left side of ">" is positive, both sides of unequality can be
+            // squared
+            // (scattering is always positive)
 
-          if (dCotThetaMinusError2 > scatteringInRegion2) {
-            continue;
+            if (dCotThetaMinusError2 > scatteringInRegion2) {
+              continue;
+            }
           }
-        }
 
-        // protects against division by 0
-        float dU = lt.U - Ub;
-        if (dU == 0.) {
-          continue;
-        }
-        // A and B are evaluated as a function of the circumference parameters
-        // x_0 and y_0
-        float A = (lt.V - Vb) / dU;
-        float S2 = 1. + A * A;
-        float B = Vb - A * Ub;
-        float B2 = B * B;
-        // sqrt(S2)/B = 2 * helixradius
-        // calculated radius must not be smaller than minimum radius
-        if (S2 < B2 * m_config.minHelixDiameter2) {
-          continue;
-        }
-        // 1/helixradius: (B/sqrt(S2))/2 (we leave everything squared)
-        float iHelixDiameter2 = B2 / S2;
-        // calculate scattering for p(T) calculated from seed curvature
-        float pT2scatter = 4 * iHelixDiameter2 * m_config.pT2perRadius;
-        // TODO: include upper pT limit for scatter calc
-        // convert p(T) to p scaling by sin^2(theta) AND scale by 1/sin^4(theta)
-        // from rad to deltaCotTheta
-        float p2scatter = pT2scatter * iSinTheta2;
-        // if deltaTheta larger than allowed scattering for calculated pT, skip
-        if ((deltaCotTheta2 - error2 > 0) &&
-            (dCotThetaMinusError2 >
-             p2scatter * m_config.sigmaScattering * m_config.sigmaScattering)) {
-          continue;
-        }
-        // A and B allow calculation of impact params in U/V plane with linear
-        // function
-        // (in contrast to having to solve a quadratic function in x/y plane)
-        float Im = std::abs((A - B * rM) * rM);
+          // protects against division by 0
+          float dU = lt.U - Ub;
+          if (dU == 0.) {
+            continue;
+          }
+          // A and B are evaluated as a function of the circumference parameters
+          // x_0 and y_0
+          float A = (lt.V - Vb) / dU;
+          float S2 = 1. + A * A;
+          float B = Vb - A * Ub;
+          float B2 = B * B;
+          // sqrt(S2)/B = 2 * helixradius
+          // calculated radius must not be smaller than minimum radius
+          if (S2 < B2 * m_config.minHelixDiameter2) {
+            continue;
+          }
+          // 1/helixradius: (B/sqrt(S2))/2 (we leave everything squared)
+          float iHelixDiameter2 = B2 / S2;
+          // calculate scattering for p(T) calculated from seed curvature
+          float pT2scatter = 4 * iHelixDiameter2 * m_config.pT2perRadius;
+          // TODO: include upper pT limit for scatter calc
+          // convert p(T) to p scaling by sin^2(theta) AND scale by
+          // 1/sin^4(theta) from rad to deltaCotTheta
+          float p2scatter = pT2scatter * iSinTheta2;
+          // if deltaTheta larger than allowed scattering for calculated pT,
+          // skip
+          if ((deltaCotTheta2 - error2 > 0) &&
+              (dCotThetaMinusError2 > p2scatter * m_config.sigmaScattering *
+                                          m_config.sigmaScattering)) {
+            continue;
+          }
+          // A and B allow calculation of impact params in U/V plane with linear
+          // function
+          // (in contrast to having to solve a quadratic function in x/y plane)
+          float Im = std::abs((A - B * rM) * rM);
 
-        if (Im <= m_config.impactMax) {
-          topSpVec.push_back(compatTopSP[t]);
-          // inverse diameter is signed depending if the curvature is
-          // positive/negative in phi
-          curvatures.push_back(B / std::sqrt(S2));
-          impactParameters.push_back(Im);
+          if (Im <= m_config.impactMax) {
+            topSpVec.push_back(compatTopSP[t]);
+            // inverse diameter is signed depending if the curvature is
+            // positive/negative in phi
+            curvatures.push_back(B / std::sqrt(S2));
+            impactParameters.push_back(Im);
+          }
         }
       }
       if (!topSpVec.empty()) {
-        std::vector<std::pair<
-            float, std::unique_ptr<const InternalSeed<external_spacepoint_t>>>>
-            sameTrackSeeds;
-        sameTrackSeeds = std::move(m_config.seedFilter->filterSeeds_2SpFixed(
-            *compatBottomSP[b], *spM, topSpVec, curvatures, impactParameters,
-            Zob));
-        seedsPerSpM.insert(seedsPerSpM.end(),
-                           std::make_move_iterator(sameTrackSeeds.begin()),
-                           std::make_move_iterator(sameTrackSeeds.end()));
+        m_config.seedFilter->filterSeeds_2SpFixed(
+            state.filterState, *compatBottomSP[b], *spM, topSpVec, curvatures,
+            impactParameters, Zob, seedsPerSpM);
       }
     }
     m_config.seedFilter->filterSeeds_1SpFixed(seedsPerSpM, outputVec);
   }
-  return outputVec;
 }
 
 template <typename external_spacepoint_t>
+void Seedfinder<external_spacepoint_t>::columnDoublets(
+    const detail::SpacePointColumns<external_spacepoint_t>& candidates,
+    const InternalSpacePoint<external_spacepoint_t>& spM, bool bottom,
+    std::vector<int>& accept,
+    std::vector<const InternalSpacePoint<external_spacepoint_t>*>& compatSP)
+    const {
+  float rM = spM.radius();
+  float zM = spM.z();
+  size_t numCandidates = candidates.size();
+  accept.resize(numCandidates);
+
+  if (!m_config.sortBinsInR) {
+    size_t numConsidered = detail::doubletCompatibility(
+        candidates.r.data(), candidates.z.data(), numCandidates, rM, zM,
+        bottom, m_config, accept.data());
+    for (size_t i = 0; i < numConsidered; i++) {
+      if (accept[i]) {
+        compatSP.push_back(candidates.sp[i]);
+      }
+    }
+    return;
+  }
+
+  // allowed r window of the candidates. it is widened by a small margin to
+  // absorb the rounding of deltaR, the exact cuts are applied by the kernel
+  float margin = 1e-6f * (rM + m_config.deltaRMax);
+  float rLow = bottom ? rM - m_config.deltaRMax : rM + m_config.deltaRMin;
+  float rHigh = bottom ? rM - m_config.deltaRMin : rM + m_config.deltaRMax;
+  rLow -= margin;
+  rHigh += margin;
+
+  auto rBegin = candidates.r.begin();
+  size_t runBegin = 0;
+  for (size_t runEnd : candidates.runEnds) {
+    size_t lo = std::lower_bound(rBegin + runBegin, rBegin + runEnd, rLow) -
+                rBegin;
+    size_t hi = std::upper_bound(rBegin + lo, rBegin + runEnd, rHigh) - rBegin;
+    size_t numConsidered = detail::doubletCompatibility(
+        candidates.r.data() + lo, candidates.z.data() + lo, hi - lo, rM, zM,
+        bottom, m_config, accept.data() + lo);
+    for (size_t i = lo; i < lo + numConsidered; i++) {
+      if (accept[i]) {
+        compatSP.push_back(candidates.sp[i]);
+      }
+    }
+    // the scalar top loop stops at the first space point beyond deltaRMax,
+    // which is either inside the window or the first one above it
+    if (!bottom && (numConsidered < hi - lo || hi < runEnd)) {
+      return;
+    }
+    runBegin = runEnd;
+  }
+}
+
+template <typename external_spacepoint_t>
+template <typename lin_circle_container_t>
 void Seedfinder<external_spacepoint_t>::transformCoordinates(
     std::vector<const InternalSpacePoint<external_spacepoint_t>*>& vec,
     const InternalSpacePoint<external_spacepoint_t>& spM, bool bottom,
-    std::vector<LinCircle>& linCircleVec) const {
+    lin_circle_container_t& linCircleVec) const {
   float xM = spM.x();
   float yM = spM.y();
   float zM = spM.z();
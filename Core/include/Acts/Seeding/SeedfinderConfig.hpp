@@ -88,6 +88,19 @@ struct SeedfinderConfig {
   // find seeds within 5sigma error ellipse
   float sigmaError = 5;
 
+  // evaluate the duplet and triplet cuts with the vectorizable
+  // structure-of-arrays kernels instead of the scalar loops. both paths
+  // create identical seeds. the instruction set is chosen by the compiler
+  // flags (e.g. -O3 -mavx2 -fno-math-errno); without vectorization the
+  // branch-free kernels are slower than the scalar loops.
+  bool useVectorizedKernels = false;
+
+  // sort the space points of each grid bin in r when filling the
+  // BinnedSPGroup. the duplet search then only visits the space points
+  // inside the deltaR window, found by binary search on the sorted bins.
+  // creates the same seeds as a full scan over the same bins.
+  bool sortBinsInR = false;
+
   // derived values, set on Seedfinder construction
   float highland = 0;
   float maxScatteringAngle2 = 0;
@@ -0,0 +1,63 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "Acts/Seeding/InternalSeed.hpp"
+#include "Acts/Seeding/InternalSpacePoint.hpp"
+#include "Acts/Seeding/LinCircle.hpp"
+#include "Acts/Seeding/SeedFilter.hpp"
+#include "Acts/Seeding/detail/SeedfinderKernels.hpp"
+
+namespace Acts {
+
+/// @brief Scratch buffers of the Seedfinder
+///
+/// The state is owned by the caller and passed to
+/// Seedfinder::createSeedsForGroup, similar to the Cache of the magnetic
+/// field classes. The buffers are cleared but never shrunk, so reusing one
+/// state for all groups and events makes the steady-state seeding free of
+/// heap allocations. Each thread calling the Seedfinder concurrently needs
+/// its own state.
+template <typename external_spacepoint_t>
+struct SeedfinderState {
+  using sp_vector_t =
+      std::vector<const InternalSpacePoint<external_spacepoint_t>*>;
+
+  /// bottom and top space points compatible with the current middle SP
+  sp_vector_t compatBottomSP;
+  sp_vector_t compatTopSP;
+
+  /// circle parameters of the bottom-middle and middle-top duplets
+  std::vector<LinCircle> linCircleBottom;
+  std::vector<LinCircle> linCircleTop;
+
+  /// top space points, curvatures and impact parameters of the triplets
+  /// accepted for the current bottom-middle duplet
+  sp_vector_t topSpVec;
+  std::vector<float> curvatures;
+  std::vector<float> impactParameters;
+
+  /// weighted seeds of the current middle space point
+  std::vector<std::pair<float, InternalSeed<external_spacepoint_t>>>
+      seedsPerSpM;
+
+  /// scratch buffers of the SeedFilter
+  SeedFilterState filterState;
+
+  /// structure-of-arrays buffers of the vectorized kernels
+  detail::SpacePointColumns<external_spacepoint_t> bottomColumns;
+  detail::SpacePointColumns<external_spacepoint_t> topColumns;
+  LinCircleColumns linCircleTopColumns;
+  std::vector<int> accept;
+};
+
+}  // namespace Acts
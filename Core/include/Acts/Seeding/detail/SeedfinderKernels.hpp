@@ -0,0 +1,217 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "Acts/Seeding/InternalSpacePoint.hpp"
+#include "Acts/Seeding/LinCircle.hpp"
+
+namespace Acts {
+namespace detail {
+
+// The kernels in this file evaluate the Seedfinder cuts for one fixed
+// space point (or duplet) against a whole column of candidates. The loop
+// bodies are free of branches and early exits and operate on contiguous
+// float columns, such that the compiler can vectorize them for whatever
+// instruction set is enabled (e.g. -mavx2, -mavx512f), falling back to
+// plain scalar code otherwise. Every expression replicates the operation
+// order of the scalar implementation in Seedfinder.ipp so that both paths
+// produce identical seeds. Cuts are written as negated comparisons to keep
+// the NaN behaviour of the scalar `if (x > cut) continue;` statements.
+
+/// Structure-of-arrays copy of the radius and z coordinate of a range of
+/// internal space points.
+///
+/// The range is additionally split into maximal runs of space points with
+/// non-decreasing radius. Each run can be searched in r with a binary search.
+/// A range concatenated from r-sorted bins has (at most) one run per bin.
+template <typename external_spacepoint_t>
+struct SpacePointColumns {
+  std::vector<float> r;
+  std::vector<float> z;
+  std::vector<const InternalSpacePoint<external_spacepoint_t>*> sp;
+  /// one past the last index of each r-sorted run
+  std::vector<size_t> runEnds;
+
+  size_t size() const { return sp.size(); }
+
+  /// Fill the columns from a range returning space point pointers
+  /// @param range the space points to be stored
+  template <typename sp_range_t>
+  void fill(sp_range_t&& range) {
+    r.clear();
+    z.clear();
+    sp.clear();
+    runEnds.clear();
+    for (auto isp : range) {
+      if (!r.empty() && isp->radius() < r.back()) {
+        runEnds.push_back(r.size());
+      }
+      r.push_back(isp->radius());
+      z.push_back(isp->z());
+      sp.push_back(isp);
+    }
+    if (!r.empty()) {
+      runEnds.push_back(r.size());
+    }
+  }
+};
+
+/// Evaluate the duplet compatibility cuts of a middle space point with a
+/// column of bottom or top candidates.
+///
+/// @param r radii of the candidates
+/// @param z z positions of the candidates
+/// @param n number of candidates
+/// @param rM radius of the middle space point
+/// @param zM z position of the middle space point
+/// @param bottom true if the candidates are bottom space points
+/// @param config the Seedfinder configuration
+/// @param accept [out] non-zero for every compatible candidate
+///
+/// @return the number of leading candidates to be considered; for top
+///         candidates the scalar implementation stops at the first space
+///         point beyond deltaRMax, which is reproduced here
+template <typename config_t>
+size_t doubletCompatibility(const float* r, const float* z, size_t n,
+                            float rM, float zM, bool bottom,
+                            const config_t& config, int* accept) {
+  // negation is exact, hence (rM - rB) == -(rB - rM) bit by bit
+  const float sign = bottom ? -1.f : 1.f;
+  const float deltaRMin = config.deltaRMin;
+  const float deltaRMax = config.deltaRMax;
+  const float cotThetaMax = config.cotThetaMax;
+  const float collisionRegionMin = config.collisionRegionMin;
+  const float collisionRegionMax = config.collisionRegionMax;
+  for (size_t i = 0; i < n; ++i) {
+    float deltaR = sign * (r[i] - rM);
+    float cotTheta = (sign * (z[i] - zM)) / deltaR;
+    float zOrigin = zM - rM * cotTheta;
+    accept[i] = !(deltaR > deltaRMax) & !(deltaR < deltaRMin) &
+                !(std::fabs(cotTheta) > cotThetaMax) &
+                !(zOrigin < collisionRegionMin) &
+                !(zOrigin > collisionRegionMax);
+  }
+  if (bottom) {
+    return n;
+  }
+  for (size_t i = 0; i < n; ++i) {
+    float deltaR = r[i] - rM;
+    if (!(deltaR < deltaRMin) && deltaR > deltaRMax) {
+      return i;
+    }
+  }
+  return n;
+}
+
+/// Number of candidates evaluated per block by the triplet kernel. The
+/// intermediate results live in local arrays which cannot alias the input
+/// columns, hence the compiler does not need runtime alias checks.
+constexpr size_t kTripletBlockSize = 64;
+
+/// Evaluate the triplet cuts (scattering, helix diameter and impact
+/// parameter) of a fixed bottom-middle duplet with a column of middle-top
+/// duplets and collect the accepted top candidates.
+///
+/// @param lb the LinCircle of the bottom-middle duplet
+/// @param top the LinCircles of all middle-top duplets
+/// @param topSP the top space points, same order as @p top
+/// @param rM radius of the middle space point
+/// @param varianceRM radial variance of the middle space point
+/// @param varianceZM z variance of the middle space point
+/// @param config the Seedfinder configuration (with derived values set)
+/// @param topSpVec [out] accepted top space points
+/// @param curvatures [out] signed inverse helix diameter per accepted top
+/// @param impactParameters [out] impact parameter per accepted top
+template <typename config_t, typename sp_t>
+void tripletCompatibility(const LinCircle& lb, const LinCircleColumns& top,
+                          const std::vector<sp_t>& topSP, float rM,
+                          float varianceRM, float varianceZM,
+                          const config_t& config, std::vector<sp_t>& topSpVec,
+                          std::vector<float>& curvatures,
+                          std::vector<float>& impactParameters) {
+  const size_t numTop = top.size();
+  const float cotThetaB = lb.cotTheta;
+  const float Vb = lb.V;
+  const float Ub = lb.U;
+  const float ErB = lb.Er;
+  const float iDeltaRB = lb.iDeltaR;
+  const float sigmaScattering = config.sigmaScattering;
+  const float minHelixDiameter2 = config.minHelixDiameter2;
+  const float pT2perRadius = config.pT2perRadius;
+  const float impactMax = config.impactMax;
+
+  // per-duplet quantities, see Seedfinder::createSeedsForGroup
+  float iSinTheta2 = (1. + cotThetaB * cotThetaB);
+  float scatteringInRegion2 = config.maxScatteringAngle2 * iSinTheta2;
+  scatteringInRegion2 *= sigmaScattering * sigmaScattering;
+
+  float blockCurvatures[kTripletBlockSize];
+  float blockImpacts[kTripletBlockSize];
+  int blockAccept[kTripletBlockSize];
+
+  for (size_t first = 0; first < numTop; first += kTripletBlockSize) {
+    const size_t n = std::min(kTripletBlockSize, numTop - first);
+    const float* tCotTheta = top.cotTheta.data() + first;
+    const float* tIDeltaR = top.iDeltaR.data() + first;
+    const float* tEr = top.Er.data() + first;
+    const float* tU = top.U.data() + first;
+    const float* tV = top.V.data() + first;
+
+    for (size_t t = 0; t < n; ++t) {
+      float error2 = tEr[t] + ErB +
+                     2 * (cotThetaB * tCotTheta[t] * varianceRM + varianceZM) *
+                         iDeltaRB * tIDeltaR[t];
+      float deltaCotTheta = cotThetaB - tCotTheta[t];
+      float deltaCotTheta2 = deltaCotTheta * deltaCotTheta;
+      // scattering is only compared if the error is smaller than deltaTheta
+      bool compareScattering = deltaCotTheta2 - error2 > 0;
+      float error = std::sqrt(error2);
+      float dCotThetaMinusError2 =
+          deltaCotTheta2 + error2 - 2 * std::fabs(deltaCotTheta) * error;
+
+      float dU = tU[t] - Ub;
+      float A = (tV[t] - Vb) / dU;
+      // 1.f + A * A is identical to the double precision expression rounded
+      // to float, as the double rounding is innocuous for float operands
+      float S2 = 1.f + A * A;
+      float B = Vb - A * Ub;
+      float B2 = B * B;
+      float iHelixDiameter2 = B2 / S2;
+      float pT2scatter = 4 * iHelixDiameter2 * pT2perRadius;
+      float p2scatter = pT2scatter * iSinTheta2;
+      float Im = std::fabs((A - B * rM) * rM);
+
+      blockAccept[t] =
+          !(compareScattering & (dCotThetaMinusError2 > scatteringInRegion2)) &
+          !(dU == 0.f) & !(S2 < B2 * minHelixDiameter2) &
+          !(compareScattering &
+            (dCotThetaMinusError2 >
+             p2scatter * sigmaScattering * sigmaScattering)) &
+          (Im <= impactMax);
+      blockCurvatures[t] = B / std::sqrt(S2);
+      blockImpacts[t] = Im;
+    }
+
+    for (size_t t = 0; t < n; ++t) {
+      if (blockAccept[t]) {
+        topSpVec.push_back(topSP[first + t]);
+        curvatures.push_back(blockCurvatures[t]);
+        impactParameters.push_back(blockImpacts[t]);
+      }
+    }
+  }
+}
+
+}  // namespace detail
+}  // namespace Acts
@@ -13,8 +13,10 @@
 #include "Acts/Geometry/GeometryContext.hpp"
 #include "Acts/Surfaces/Surface.hpp"
 #include "Acts/Utilities/BinningType.hpp"
+#include "Acts/Utilities/BoundingBox.hpp"
 #include "Acts/Utilities/Definitions.hpp"
 #include "Acts/Utilities/IAxis.hpp"
+#include "Acts/Utilities/Units.hpp"
 #include "Acts/Utilities/detail/Axis.hpp"
 #include "Acts/Utilities/detail/Grid.hpp"
 
@@ -78,6 +80,27 @@ class SurfaceArray {
     /// @return @c SurfaceVector at given bin. Copy of all bins selected
     virtual const SurfaceVector& neighbors(const Vector3D& position) const = 0;
 
+    /// @brief Whether the candidates depend on the lookup direction
+    ///
+    /// Lookups which do not make use of the direction are served by
+    /// @c neighbors without copying the surfaces.
+    ///
+    /// @return false, unless the lookup traverses the straight line
+    virtual bool isDirectionDependent() const { return false; }
+
+    /// @brief Performs a lookup along the straight line from @c position
+    ///
+    /// Lookups which do not make use of the direction return a copy of the
+    /// neighbors of @c position.
+    ///
+    /// @param position Lookup position
+    /// @param direction Lookup direction
+    /// @return @c SurfaceVector of candidate surfaces
+    virtual SurfaceVector candidates(const Vector3D& position,
+                                     const Vector3D& /*direction*/) const {
+      return neighbors(position);
+    }
+
     /// @brief Returns the total size of the grid (including under/overflow
     /// bins)
     /// @return Size of the grid data structure
@@ -415,6 +438,118 @@ class SurfaceArray {
     SurfaceVector m_element;
   };
 
+  /// @brief Lookup implementation which stores the axis aligned bounding
+  ///        boxes of the surfaces in a bounding volume hierarchy
+  ///
+  /// Only the surfaces whose boxes are crossed by the straight line along
+  /// the lookup direction are returned as candidates. Unlike the bins of a
+  /// @c SurfaceGridLookup, this does not depend on the surfaces being
+  /// arranged regularly in two local coordinates, e.g. for endcap petals or
+  /// tilted modules. Lookups without a direction return all surfaces.
+  struct SurfaceBVHLookup : ISurfaceGridLookup {
+    using BoundingBox = AxisAlignedBoundingBox<Surface, double, 3>;
+
+    /// @brief Default constructor
+    /// @param envelope Envelope added to the bounding box of each surface,
+    ///        needs to be positive for surfaces aligned with an axis
+    /// @param maxDepth Maximum depth of the octree
+    SurfaceBVHLookup(double envelope = 1 * UnitConstants::mm,
+                     size_t maxDepth = 4)
+        : m_envelope(envelope), m_maxDepth(maxDepth) {}
+
+    /// @brief Builds the bounding volume hierarchy of the surfaces
+    ///
+    /// @param gctx The current geometry context object, e.g. alignment
+    /// @param surfaces Input surface pointers
+    void fill(const GeometryContext& gctx,
+              const SurfaceVector& surfaces) override;
+
+    /// @brief Comply with concept and provide completeBinning method
+    /// @note Does nothing, all surfaces are contained in the hierarchy
+    size_t completeBinning(const GeometryContext& /*gctx*/,
+                           const SurfaceVector& /*surfaces*/) override {
+      return 0;
+    }
+
+    /// @brief Lookup, always returns all surfaces
+    /// @param position is ignored
+    /// @return reference to vector containing all surfaces
+    SurfaceVector& lookup(const Vector3D& /*position*/) override {
+      return m_surfaces;
+    }
+
+    /// @brief Lookup, always returns all surfaces
+    /// @param position is ignored
+    /// @return reference to vector containing all surfaces
+    const SurfaceVector& lookup(const Vector3D& /*position*/) const override {
+      return m_surfaces;
+    }
+
+    /// @brief Lookup, always returns all surfaces
+    /// @param bin is ignored
+    /// @return reference to vector containing all surfaces
+    SurfaceVector& lookup(size_t /*bin*/) override { return m_surfaces; }
+
+    /// @brief Lookup, always returns all surfaces
+    /// @param bin is ignored
+    /// @return reference to vector containing all surfaces
+    const SurfaceVector& lookup(size_t /*bin*/) const override {
+      return m_surfaces;
+    }
+
+    /// @brief Lookup, always returns all surfaces
+    /// @param position is ignored
+    /// @return reference to vector containing all surfaces
+    const SurfaceVector& neighbors(
+        const Vector3D& /*position*/) const override {
+      return m_surfaces;
+    }
+
+    /// @brief The candidates are found along the lookup direction
+    /// @return always true
+    bool isDirectionDependent() const override { return true; }
+
+    /// @brief Traverses the hierarchy with a ray from @c position
+    ///
+    /// @param position Lookup position
+    /// @param direction Lookup direction
+    /// @return @c SurfaceVector of surfaces whose boxes are crossed
+    SurfaceVector candidates(const Vector3D& position,
+                             const Vector3D& direction) const override;
+
+    /// @brief returns 1
+    /// @return 1
+    size_t size() const override { return 1; }
+
+    /// @brief Gets the center of the top level bounding box
+    /// @param bin is ignored
+    /// @return the center, (0, 0, 0) if the lookup is empty
+    Vector3D getBinCenter(size_t /*bin*/) const override {
+      return m_top != nullptr ? m_top->center() : Vector3D(0, 0, 0);
+    }
+
+    /// @brief Returns an empty vector of @c AnyAxis
+    /// @return empty vector
+    std::vector<const IAxis*> getAxes() const override { return {}; }
+
+    /// @brief Get the number of dimensions
+    /// @return always 0
+    size_t dimensions() const override { return 0; }
+
+    /// @brief Returns if the bin is valid (it is)
+    /// @param bin is ignored
+    /// @return always true
+    bool isValidBin(size_t /*bin*/) const override { return true; }
+
+   private:
+    double m_envelope;
+    size_t m_maxDepth;
+    SurfaceVector m_surfaces;
+    // owns the boxes of the surfaces and the octree nodes
+    std::vector<std::unique_ptr<BoundingBox>> m_boxes;
+    const BoundingBox* m_top{nullptr};
+  };
+
   /// @brief Default constructor which takes a @c SurfaceLookup and a vector of
   /// surfaces
   /// @param gridLookup The grid storage. @c SurfaceArray does not fill it on
@@ -469,13 +604,31 @@ class SurfaceArray {
   /// @param position The position to lookup as nominal
   /// @param size How many neighbors we want in each direction. (default: 1)
   /// @return Merged @c SurfaceVector of neighbors and nominal
-  /// @note The @c SurfaceVector will be combined. For technical reasons, the
-  ///       different bin content vectors have to be copied, so the resulting
-  ///       vector contains copies.
-  SurfaceVector neighbors(const Vector3D& position) const {
+  /// @note The neighbors of every bin are combined when the lookup is
+  ///       filled, the returned vector is owned by the lookup.
+  const SurfaceVector& neighbors(const Vector3D& position) const {
     return p_gridLookup->neighbors(position);
   }
 
+  /// @brief Whether the candidates depend on the lookup direction
+  /// @return true if @c candidates has to be used instead of @c neighbors
+  bool isDirectionDependent() const {
+    return p_gridLookup->isDirectionDependent();
+  }
+
+  /// @brief Get all surfaces which are candidates to be crossed along a
+  ///        straight line from @p position
+  /// @param position The position to lookup as nominal
+  /// @param direction The direction of the straight line
+  /// @return @c SurfaceVector of candidates, a copy of the neighbors of
+  ///         @p position if the lookup does not make use of the direction
+  /// @note Only direction dependent lookups need a new vector, prefer
+  ///       @c neighbors otherwise.
+  SurfaceVector candidates(const Vector3D& position,
+                           const Vector3D& direction) const {
+    return p_gridLookup->candidates(position, direction);
+  }
+
   /// @brief Get the size of the underlying grid structure including
   /// under/overflow bins
   /// @return the size
@@ -0,0 +1,106 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace Acts {
+
+/// Resolve a requested number of threads
+///
+/// @param nThreads the requested number of threads, 0 means all hardware
+///        threads
+/// @param nTasks the number of tasks to be processed
+///
+/// @return the number of threads to be started, at least 1 and not more
+///         than the number of tasks
+inline size_t resolveNumberOfThreads(size_t nThreads, size_t nTasks) {
+  if (nThreads == 0) {
+    nThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  return std::max<size_t>(1, std::min(nThreads, nTasks));
+}
+
+/// Call a function for every index in [0, nTasks) using a number of threads
+///
+/// The indices are handed out dynamically, i.e. a thread that finishes its
+/// task early picks up the next unprocessed index. The function is called
+/// as `func(taskIndex, threadIndex)` with `threadIndex < nThreads` such that
+/// it can access per-thread scratch data without locking. The order in which
+/// the tasks are executed is unspecified; results must be stored per task
+/// index to be reproducible. With a single thread all tasks are executed in
+/// order on the calling thread.
+///
+/// @tparam function_t callable with signature void(size_t, size_t)
+///
+/// @param nTasks the number of tasks
+/// @param nThreads the number of threads (see resolveNumberOfThreads)
+/// @param func the function to be called for every task
+///
+/// @note The first exception thrown by any task is rethrown on the calling
+///       thread after all threads have finished; remaining tasks are skipped.
+///       If a thread can not be started, the tasks are processed by fewer
+///       threads.
+template <typename function_t>
+void parallelFor(size_t nTasks, size_t nThreads, function_t&& func) {
+  nThreads = resolveNumberOfThreads(nThreads, nTasks);
+  if (nThreads == 1) {
+    for (size_t i = 0; i < nTasks; ++i) {
+      func(i, 0);
+    }
+    return;
+  }
+
+  std::atomic<size_t> next{0};
+  std::exception_ptr error;
+  std::mutex errorMutex;
+  auto worker = [&](size_t threadIndex) {
+    for (size_t i = next++; i < nTasks; i = next++) {
+      try {
+        func(i, threadIndex);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+        // skip all remaining tasks
+        next = nTasks;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(nThreads - 1);
+  for (size_t t = 1; t < nThreads; ++t) {
+    try {
+      threads.emplace_back(worker, t);
+    } catch (const std::system_error&) {
+      // no more threads can be started, the remaining tasks are shared by
+      // the running threads and the calling thread
+      break;
+    }
+  }
+  // the calling thread participates as thread 0
+  worker(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+}  // namespace Acts
@@ -0,0 +1,38 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace Acts {
+namespace detail {
+
+/// @brief read-only memory mapping of a complete file
+struct MappedFile {
+  /// owner of the mapping, the file is unmapped with the last copy
+  std::shared_ptr<const void> mapping;
+  /// first byte of the file, page aligned
+  const char* data = nullptr;
+  /// size of the file in bytes
+  size_t size = 0;
+};
+
+/// Map a file read-only into memory
+///
+/// The pages are shared with all other processes mapping the same file.
+///
+/// @param path of the file
+///
+/// @throw std::runtime_error if the file can not be opened or mapped
+MappedFile mapFile(const std::string& path);
+
+}  // namespace detail
+}  // namespace Acts
@@ -12,7 +12,8 @@
 #include "Acts/Utilities/Definitions.hpp"
 #include "Acts/Vertexing/Vertex.hpp"
 
-#include <map>
+#include <optional>
+#include <vector>
 
 namespace Acts {
 
@@ -43,10 +44,13 @@ struct VertexInfo {
   // Needs relinearization bool
   bool relinearize = true;
 
-  // Vector of all track currently held by vertex
-  std::vector<const input_track_t*> trackLinks;
+  // Vector of all track currently held by vertex, given as indices of the
+  // tracks at vertices stored in the fitter state
+  std::vector<size_t> trackLinks;
 
-  std::map<const input_track_t*, const BoundParameters> ip3dParams;
+  // Track parameters at the point of closest approach to the vertex for
+  // each entry in trackLinks, only set once they are needed
+  std::vector<std::optional<BoundParameters>> ip3dParams;
 };
 
 }  // namespace Acts
\ No newline at end of file
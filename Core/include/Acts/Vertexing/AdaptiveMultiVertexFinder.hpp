@@ -12,6 +12,7 @@
 #include "Acts/Utilities/Definitions.hpp"
 #include "Acts/Utilities/Logger.hpp"
 #include "Acts/Utilities/Result.hpp"
+#include "Acts/Utilities/TypeTraits.hpp"
 #include "Acts/Utilities/Units.hpp"
 #include "Acts/Vertexing/AMVFInfo.hpp"
 #include "Acts/Vertexing/TrackToVertexIPEstimator.hpp"
@@ -38,6 +39,17 @@ class AdaptiveMultiVertexFinder {
   using Linearizer_t = typename vfitter_t::Linearizer_t;
   using FitterState_t = typename vfitter_t::State;
 
+  // Seed finders providing a State keep it between the seeding iterations,
+  // such that it only needs to be updated with the removed seed tracks
+  template <typename T>
+  using seed_finder_state_t = typename T::State;
+  struct NoSeedFinderState {};
+  static constexpr bool hasSeedFinderState =
+      concept::exists<seed_finder_state_t, sfinder_t>;
+  using SeedFinderState_t =
+      typename concept::detected_or<NoSeedFinderState, seed_finder_state_t,
+                                    sfinder_t>::type;
+
  public:
   /// @struct Config Configuration struct
   struct Config {
@@ -218,12 +230,14 @@ class AdaptiveMultiVertexFinder {
   /// @param trackVector All tracks to be used for seeding
   /// @param currentConstraint Vertex constraint
   /// @param vertexingOptions Vertexing options
+  /// @param seedFinderState The seed finder state
   ///
   /// @return The seed vertex
   Result<Vertex<InputTrack_t>> doSeeding(
       const std::vector<const InputTrack_t*>& trackVector,
       Vertex<InputTrack_t>& currentConstraint,
-      const VertexingOptions<InputTrack_t>& vertexingOptions) const;
+      const VertexingOptions<InputTrack_t>& vertexingOptions,
+      SeedFinderState_t& seedFinderState) const;
 
   /// @brief Estimates delta Z between a track and a vertex position
   ///
@@ -23,6 +23,9 @@ auto Acts::AdaptiveMultiVertexFinder<vfitter_t, sfinder_t>::find(
   std::vector<const InputTrack_t*> seedTracks = allTracks;
 
   FitterState_t fitterState;
+  fitterState.reserve(allTracks.size(), allTracks.size(), allTracks.size());
+
+  SeedFinderState_t seedFinderState;
 
   std::vector<std::unique_ptr<Vertex<InputTrack_t>>> allVertices;
 
@@ -44,8 +47,8 @@ auto Acts::AdaptiveMultiVertexFinder<vfitter_t, sfinder_t>::find(
     }
     Vertex<InputTrack_t> currentConstraint = vertexingOptions.vertexConstraint;
     // Retrieve seed vertex from all remaining seedTracks
-    auto seedResult =
-        doSeeding(seedTracks, currentConstraint, vertexingOptions);
+    auto seedResult = doSeeding(seedTracks, currentConstraint,
+                                vertexingOptions, seedFinderState);
     if (!seedResult.ok()) {
       return seedResult.error();
     }
@@ -77,7 +80,7 @@ auto Acts::AdaptiveMultiVertexFinder<vfitter_t, sfinder_t>::find(
       break;
     }
     // Update fitter state with all vertices
-    fitterState.addVertexToMultiMap(vtxCandidate);
+    fitterState.addVertexToTrackLinks(vtxCandidate);
 
     // Perform the fit
     auto fitResult = m_cfg.vertexFitter.addVtxToFit(
@@ -130,12 +133,20 @@ template <typename vfitter_t, typename sfinder_t>
 auto Acts::AdaptiveMultiVertexFinder<vfitter_t, sfinder_t>::doSeeding(
     const std::vector<const InputTrack_t*>& trackVector,
     Vertex<InputTrack_t>& currentConstraint,
-    const VertexingOptions<InputTrack_t>& vertexingOptions) const
+    const VertexingOptions<InputTrack_t>& vertexingOptions,
+    SeedFinderState_t& seedFinderState) const
     -> Result<Vertex<InputTrack_t>> {
   VertexingOptions<InputTrack_t> seedOptions = vertexingOptions;
   seedOptions.vertexConstraint = currentConstraint;
   // Run seed finder
-  auto seedResult = m_cfg.seedFinder.find(trackVector, seedOptions);
+  auto seedResult = [&]() {
+    if constexpr (hasSeedFinderState) {
+      return m_cfg.seedFinder.find(trackVector, seedOptions, seedFinderState);
+    } else {
+      (void)seedFinderState;
+      return m_cfg.seedFinder.find(trackVector, seedOptions);
+    }
+  }();
 
   if (!seedResult.ok()) {
     return seedResult.error();
@@ -229,13 +240,9 @@ auto Acts::AdaptiveMultiVertexFinder<vfitter_t, sfinder_t>::
     if ((std::abs(estimateDeltaZ(params, vtx.position())) <
          m_cfg.tracksMaxZinterval) &&
         (ipSig < m_cfg.tracksMaxSignificance)) {
-      // Create TrackAtVertex objects, unique for each (track, vertex) pair
-      // fitterState.tracksAtVerticesMap.clear();
-      fitterState.tracksAtVerticesMap.emplace(std::make_pair(trk, &vtx),
-                                              TrackAtVertex(params, trk));
-
-      // Add the original track parameters to the list for vtx
-      fitterState.vtxInfoMap[&vtx].trackLinks.push_back(trk);
+      // Create TrackAtVertex objects, unique for each (track, vertex) pair,
+      // and add them to the list for vtx
+      fitterState.addTrackToVertex(vtx, TrackAtVertex(params, trk));
     }
   }
   return {};
@@ -255,7 +262,7 @@ auto Acts::AdaptiveMultiVertexFinder<vfitter_t, sfinder_t>::
   // candidate were found
   // TODO: This is for now how it's done in athena... this look a bit
   // nasty to me
-  if (fitterState.vtxInfoMap[&vtx].trackLinks.empty()) {
+  if (fitterState.vertexInfo(vtx).trackLinks.empty()) {
     // Find nearest track to vertex candidate
     double smallestDeltaZ = std::numeric_limits<double>::max();
     double newZ = 0;
@@ -274,7 +281,7 @@ auto Acts::AdaptiveMultiVertexFinder<vfitter_t, sfinder_t>::
       vtx.setFullPosition(SpacePointVector(0., 0., newZ, 0.));
 
       // Update vertex info for current vertex
-      fitterState.vtxInfoMap[&vtx] =
+      fitterState.vertexInfo(vtx) =
           VertexInfo<InputTrack_t>(currentConstraint, vtx.fullPosition());
 
       // Try to add compatible track with adapted vertex position
@@ -284,7 +291,7 @@ auto Acts::AdaptiveMultiVertexFinder<vfitter_t, sfinder_t>::
         return Result<bool>::failure(res.error());
       }
 
-      if (fitterState.vtxInfoMap[&vtx].trackLinks.empty()) {
+      if (fitterState.vertexInfo(vtx).trackLinks.empty()) {
         ACTS_DEBUG(
             "No tracks near seed were found, while at least one was "
             "expected. Break.");
@@ -311,7 +318,7 @@ auto Acts::AdaptiveMultiVertexFinder<vfitter_t, sfinder_t>::
         const VertexingOptions<InputTrack_t>& vertexingOptions) const
     -> Result<bool> {
   // Add vertex info to fitter state
-  fitterState.vtxInfoMap[&vtx] =
+  fitterState.vertexInfo(vtx) =
       VertexInfo<InputTrack_t>(currentConstraint, vtx.fullPosition());
 
   // Add all compatible tracks to vertex
@@ -340,9 +347,9 @@ auto Acts::AdaptiveMultiVertexFinder<vfitter_t, sfinder_t>::
         FitterState_t& fitterState) const -> std::pair<int, bool> {
   bool isGoodVertex = false;
   int nCompatibleTracks = 0;
-  for (const auto& trk : fitterState.vtxInfoMap[&vtx].trackLinks) {
-    const auto& trkAtVtx =
-        fitterState.tracksAtVerticesMap.at(std::make_pair(trk, &vtx));
+  for (const auto& link : fitterState.vertexInfo(vtx).trackLinks) {
+    const auto& trkAtVtx = fitterState.tracksAtVertices[link];
+    const InputTrack_t* trk = trkAtVtx.originalParams;
     if ((trkAtVtx.vertexCompatibility < m_cfg.maxVertexChi2 &&
          m_cfg.useFastCompatibility) ||
         (trkAtVtx.trackWeight > m_cfg.minWeight &&
@@ -377,9 +384,9 @@ auto Acts::AdaptiveMultiVertexFinder<vfitter_t, sfinder_t>::
     removeCompatibleTracksFromSeedTracks(
         Vertex<InputTrack_t>& vtx, std::vector<const InputTrack_t*>& seedTracks,
         FitterState_t& fitterState) const -> void {
-  for (const auto& trk : fitterState.vtxInfoMap[&vtx].trackLinks) {
-    const auto& trkAtVtx =
-        fitterState.tracksAtVerticesMap.at(std::make_pair(trk, &vtx));
+  for (const auto& link : fitterState.vertexInfo(vtx).trackLinks) {
+    const auto& trkAtVtx = fitterState.tracksAtVertices[link];
+    const InputTrack_t* trk = trkAtVtx.originalParams;
     if ((trkAtVtx.vertexCompatibility < m_cfg.maxVertexChi2 &&
          m_cfg.useFastCompatibility) ||
         (trkAtVtx.trackWeight > m_cfg.minWeight &&
@@ -405,9 +412,9 @@ auto Acts::AdaptiveMultiVertexFinder<vfitter_t, sfinder_t>::
   double maxCompatibility = 0;
 
   auto maxCompSeedIt = seedTracks.end();
-  for (const auto& trk : fitterState.vtxInfoMap[&vtx].trackLinks) {
-    const auto& trkAtVtx =
-        fitterState.tracksAtVerticesMap.at(std::make_pair(trk, &vtx));
+  for (const auto& link : fitterState.vertexInfo(vtx).trackLinks) {
+    const auto& trkAtVtx = fitterState.tracksAtVertices[link];
+    const InputTrack_t* trk = trkAtVtx.originalParams;
     double compatibility = trkAtVtx.vertexCompatibility;
     if (compatibility > maxCompatibility) {
       // Try to find track in seed tracks
@@ -456,9 +463,8 @@ auto Acts::AdaptiveMultiVertexFinder<vfitter_t, sfinder_t>::keepNewVertex(
   double contamination = 0.;
   double contaminationNum = 0;
   double contaminationDeNom = 0;
-  for (const auto& trk : fitterState.vtxInfoMap[&vtx].trackLinks) {
-    const auto& trkAtVtx =
-        fitterState.tracksAtVerticesMap.at(std::make_pair(trk, &vtx));
+  for (const auto& link : fitterState.vertexInfo(vtx).trackLinks) {
+    const auto& trkAtVtx = fitterState.tracksAtVertices[link];
     double trackWeight = trkAtVtx.trackWeight;
     contaminationNum += trackWeight * (1. - trackWeight);
     contaminationDeNom += trackWeight * trackWeight;
@@ -532,21 +538,14 @@ auto Acts::AdaptiveMultiVertexFinder<vfitter_t, sfinder_t>::deleteLastVertex(
   allVerticesPtr.pop_back();
 
   if (!m_cfg.refitAfterBadVertex) {
-    fitterState.vertexCollection = oldFitterState.vertexCollection;
-    fitterState.annealingState = oldFitterState.annealingState;
-    fitterState.vtxInfoMap.clear();
-    for (const auto& vtx : allVerticesPtr) {
-      fitterState.vtxInfoMap.emplace(vtx, oldFitterState.vtxInfoMap[vtx]);
-    }
-    fitterState.trackToVerticesMultiMap =
-        oldFitterState.trackToVerticesMultiMap;
-    fitterState.tracksAtVerticesMap = oldFitterState.tracksAtVerticesMap;
+    // The old state only knows the remaining vertices
+    fitterState = oldFitterState;
 
   } else {
     // Update fitter state with removed vertex candidate
-    fitterState.removeVertexFromMultiMap(vtx);
+    fitterState.removeVertexFromTrackLinks(vtx);
 
-    // TODO: clean tracksAtVerticesMap maybe here? i.e. remove all entries
+    // TODO: clean tracksAtVertices maybe here? i.e. remove all entries
     // with old vertex?
 
     // Do the fit with removed vertex
@@ -567,9 +566,8 @@ auto Acts::AdaptiveMultiVertexFinder<vfitter_t, sfinder_t>::getVertexOutputList(
   for (auto vtx : allVerticesPtr) {
     auto& outVtx = *vtx;
     std::vector<TrackAtVertex<InputTrack_t>> tracksAtVtx;
-    for (const auto& trk : fitterState.vtxInfoMap[vtx].trackLinks) {
-      tracksAtVtx.push_back(
-          fitterState.tracksAtVerticesMap.at(std::make_pair(trk, vtx)));
+    for (const auto& link : fitterState.vertexInfo(*vtx).trackLinks) {
+      tracksAtVtx.push_back(fitterState.tracksAtVertices[link]);
     }
     outVtx.setTracksAtVertex(tracksAtVtx);
     outputVec.push_back(outVtx);
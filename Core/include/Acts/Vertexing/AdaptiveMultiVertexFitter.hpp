@@ -12,6 +12,7 @@
 #include "Acts/Utilities/AnnealingUtility.hpp"
 #include "Acts/Utilities/Definitions.hpp"
 #include "Acts/Utilities/Logger.hpp"
+#include "Acts/Utilities/ParallelFor.hpp"
 #include "Acts/Utilities/Result.hpp"
 #include "Acts/Vertexing/AMVFInfo.hpp"
 #include "Acts/Vertexing/ImpactPoint3dEstimator.hpp"
@@ -20,7 +21,12 @@
 #include "Acts/Vertexing/Vertex.hpp"
 #include "Acts/Vertexing/VertexingOptions.hpp"
 
+#include <algorithm>
 #include <functional>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace Acts {
 
@@ -51,6 +57,12 @@ class AdaptiveMultiVertexFitter {
 
  public:
   /// @brief The fitter state
+  ///
+  /// Vertices and tracks are identified by dense indices assigned when they
+  /// are first used. The tracks at vertices, unique for each (track, vertex)
+  /// pair, are stored contiguously and referenced by link indices. The
+  /// vertices that use a track are available in compressed sparse row format
+  /// such that the fit itself does not need any pointer lookups.
   struct State {
     // Vertex collection to be fitted
     std::vector<Vertex<InputTrack_t>*> vertexCollection;
@@ -58,37 +70,147 @@ class AdaptiveMultiVertexFitter {
     // Annealing state
     AnnealingUtility::State annealingState;
 
-    // Map to store vertices information
-    std::map<Vertex<InputTrack_t>*, VertexInfo<InputTrack_t>> vtxInfoMap;
+    // All known vertices and their information, by vertex index
+    std::vector<Vertex<InputTrack_t>*> vertices;
+    std::vector<VertexInfo<InputTrack_t>> vertexInfos;
+
+    // All known tracks, by track index
+    std::vector<const InputTrack_t*> tracks;
+
+    // All tracks at vertices and their (track, vertex) indices, by link index
+    std::vector<TrackAtVertex<InputTrack_t>> tracksAtVertices;
+    std::vector<std::pair<size_t, size_t>> links;
 
-    std::multimap<const InputTrack_t*, Vertex<InputTrack_t>*>
-        trackToVerticesMultiMap;
+    // Links of all vertices added to the fit, in the order they were added
+    std::vector<size_t> activeLinks;
 
-    std::map<std::pair<const InputTrack_t*, Vertex<InputTrack_t>*>,
-             TrackAtVertex<InputTrack_t>>
-        tracksAtVerticesMap;
+    // Active links of track i, in the order they were added, are stored in
+    // trackVertexLinks[trackVertexOffsets[i]] to
+    // trackVertexLinks[trackVertexOffsets[i + 1]]. Only valid after
+    // updateTrackVertexLinks() was called.
+    std::vector<size_t> trackVertexOffsets;
+    std::vector<size_t> trackVertexLinks;
 
     /// @brief Default State constructor
     State() = default;
 
-    // Adds a vertex to trackToVerticesMultiMap
-    void addVertexToMultiMap(Vertex<InputTrack_t>& vtx) {
-      for (auto trk : vtxInfoMap[&vtx].trackLinks) {
-        trackToVerticesMultiMap.emplace(trk, &vtx);
+    // Reserves memory for the given number of vertices, tracks, and tracks
+    // at vertices
+    void reserve(size_t nVertices, size_t nTracks, size_t nLinks) {
+      vertices.reserve(nVertices);
+      vertexInfos.reserve(nVertices);
+      vertexIndices.reserve(nVertices);
+      tracks.reserve(nTracks);
+      trackIndices.reserve(nTracks);
+      tracksAtVertices.reserve(nLinks);
+      links.reserve(nLinks);
+      linkIndices.reserve(nLinks);
+      activeLinks.reserve(nLinks);
+    }
+
+    // Returns the index of the vertex and registers it if needed
+    size_t vertexIndex(Vertex<InputTrack_t>& vtx) {
+      auto [it, inserted] = vertexIndices.emplace(&vtx, vertices.size());
+      if (inserted) {
+        vertices.push_back(&vtx);
+        vertexInfos.emplace_back();
+      }
+      return it->second;
+    }
+
+    // Returns the index of the track and registers it if needed
+    size_t trackIndex(const InputTrack_t* trk) {
+      auto [it, inserted] = trackIndices.emplace(trk, tracks.size());
+      if (inserted) {
+        tracks.push_back(trk);
+      }
+      return it->second;
+    }
+
+    // Returns the information of the vertex and registers it if needed
+    VertexInfo<InputTrack_t>& vertexInfo(Vertex<InputTrack_t>& vtx) {
+      return vertexInfos[vertexIndex(vtx)];
+    }
+
+    // Adds the track given by trkAtVtx.originalParams to the vertex. A track
+    // at vertex that already exists for the same (track, vertex) pair is kept
+    // and the new one is dropped.
+    size_t addTrackToVertex(Vertex<InputTrack_t>& vtx,
+                            TrackAtVertex<InputTrack_t> trkAtVtx) {
+      const size_t ivtx = vertexIndex(vtx);
+      const size_t itrk = trackIndex(trkAtVtx.originalParams);
+      auto [it, inserted] = linkIndices.emplace(
+          std::make_pair(itrk, ivtx), tracksAtVertices.size());
+      if (inserted) {
+        tracksAtVertices.push_back(std::move(trkAtVtx));
+        links.emplace_back(itrk, ivtx);
+      }
+      vertexInfos[ivtx].trackLinks.push_back(it->second);
+      return it->second;
+    }
+
+    // Adds the current tracks of a vertex to the track-to-vertex links
+    void addVertexToTrackLinks(Vertex<InputTrack_t>& vtx) {
+      const auto& trackLinks = vertexInfo(vtx).trackLinks;
+      activeLinks.insert(activeLinks.end(), trackLinks.begin(),
+                         trackLinks.end());
+      trackVertexLinksValid = false;
+    }
+
+    // Removes a vertex from the track-to-vertex links
+    void removeVertexFromTrackLinks(Vertex<InputTrack_t>& vtx) {
+      const size_t ivtx = vertexIndex(vtx);
+      activeLinks.erase(
+          std::remove_if(activeLinks.begin(), activeLinks.end(),
+                         [&](size_t l) { return links[l].second == ivtx; }),
+          activeLinks.end());
+      trackVertexLinksValid = false;
+    }
+
+    // Returns the positions of the active links of the track in
+    // trackVertexLinks as [begin, end)
+    std::pair<size_t, size_t> trackVertexRange(size_t itrk) const {
+      if (trackVertexOffsets.size() <= itrk + 1) {
+        return {0, 0};
       }
+      return {trackVertexOffsets[itrk], trackVertexOffsets[itrk + 1]};
     }
 
-    // Removes a vertex from trackToVerticesMultiMap
-    void removeVertexFromMultiMap(Vertex<InputTrack_t>& vtx) {
-      for (auto iter = trackToVerticesMultiMap.begin();
-           iter != trackToVerticesMultiMap.end();) {
-        if (iter->second == &vtx) {
-          iter = trackToVerticesMultiMap.erase(iter);
-        } else {
-          ++iter;
-        }
+    // Rebuilds the track-to-vertex links from the active links if they
+    // changed since the last call
+    void updateTrackVertexLinks() {
+      if (trackVertexLinksValid) {
+        return;
+      }
+      trackVertexOffsets.assign(tracks.size() + 1, 0);
+      for (size_t l : activeLinks) {
+        ++trackVertexOffsets[links[l].first + 1];
+      }
+      std::partial_sum(trackVertexOffsets.begin(), trackVertexOffsets.end(),
+                       trackVertexOffsets.begin());
+      trackVertexLinks.resize(activeLinks.size());
+      std::vector<size_t> next(trackVertexOffsets.begin(),
+                               trackVertexOffsets.end() - 1);
+      for (size_t l : activeLinks) {
+        trackVertexLinks[next[links[l].first]++] = l;
       }
+      trackVertexLinksValid = true;
     }
+
+   private:
+    struct PairHash {
+      size_t operator()(const std::pair<size_t, size_t>& p) const {
+        size_t h = std::hash<size_t>()(p.first);
+        h ^= std::hash<size_t>()(p.second) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        return h;
+      }
+    };
+
+    std::unordered_map<const Vertex<InputTrack_t>*, size_t> vertexIndices;
+    std::unordered_map<const InputTrack_t*, size_t> trackIndices;
+    std::unordered_map<std::pair<size_t, size_t>, size_t, PairHash>
+        linkIndices;
+    bool trackVertexLinksValid = true;
   };
 
   struct Config {
@@ -126,6 +248,19 @@ class AdaptiveMultiVertexFitter {
 
     // Do smoothing after multivertex fit
     bool doSmoothing{false};
+
+    // Keep the linearization of each track until the vertex moves further
+    // than maxDistToLinPoint in 3D from the point where this track was
+    // linearized. Otherwise all tracks of a vertex are relinearized once the
+    // vertex moves further than maxDistToLinPoint in the transverse plane
+    // from the last linearization point of the vertex.
+    bool cacheLinearizations{false};
+
+    // Number of threads used to estimate the impact points, compatibilities,
+    // and linearizations of all (track, vertex) pairs of an iteration, 0 means
+    // all hardware threads. The vertex updates are always done sequentially
+    // and the results do not depend on the number of threads.
+    unsigned int nThreads{1};
   };
 
   /// @brief Constructor used if InputTrack_t type == BoundParameters
@@ -249,19 +384,37 @@ class AdaptiveMultiVertexFitter {
       State& state, Vertex<InputTrack_t>* vtx,
       const VertexingOptions<InputTrack_t>& vertexingOptions) const;
 
+  /// @brief Estimates the `ip3dParams` of a single track at a vertex
+  ///
+  /// @param state The state object
+  /// @param vtxInfo The information of the vertex
+  /// @param i The position of the track in vtxInfo.trackLinks
+  /// @param refPos The reference position for the impact point estimation
+  /// @param vertexingOptions Vertexing options
+  Result<void> estimateIp3dParams(
+      const State& state, VertexInfo<InputTrack_t>& vtxInfo, size_t i,
+      const Vector3D& refPos,
+      const VertexingOptions<InputTrack_t>& vertexingOptions) const;
+
   /// @brief Sets vertexCompatibility for all TrackAtVertex objects
-  /// at current vertex
+  /// at all vertices in state.vertexCollection
+  ///
+  /// Missing `ip3dParams` are estimated at the seed position for vertices
+  /// that need relinearization and at the linearization point otherwise.
+  /// All (track, vertex) pairs are processed in parallel.
   ///
   /// @param state The state object
-  /// @param currentVtx Current vertex
   /// @param vertexingOptions Vertexing options
   Result<void> setAllVertexCompatibilities(
-      State& state, Vertex<InputTrack_t>* currentVtx,
+      State& state,
       const VertexingOptions<input_track_t>& vertexingOptions) const;
 
   /// @brief Sets weights to the track according to Eq.(5.46) in Ref.(1)
   ///  and updates the vertices by calling the VertexUpdater
   ///
+  /// The required (re-)linearizations of all tracks are done in parallel
+  /// before the vertices are updated.
+  ///
   /// @param state The state object
   /// @param linearizer The track linearizer
   /// @param vertexingOptions Vertexing options
@@ -269,16 +422,16 @@ class AdaptiveMultiVertexFitter {
       State& state, const Linearizer_t& linearizer,
       const VertexingOptions<input_track_t>& vertexingOptions) const;
 
-  /// @brief Collects all compatibility values of the track `trk`
+  /// @brief Collects all compatibility values of the track with index `itrk`
   /// at all vertices it is currently attached to and outputs
   /// these values in a vector
   ///
   /// @param state The state object
-  /// @param trk The track
-  ///
-  /// @return Vector of compatibility values
-  std::vector<double> collectTrackToVertexCompatibilities(
-      State& state, const InputTrack_t* trk) const;
+  /// @param itrk The track index
+  /// @param [out] compatibilities Vector of compatibility values
+  void collectTrackToVertexCompatibilities(
+      const State& state, size_t itrk,
+      std::vector<double>& compatibilities) const;
 
   /// @brief Determines if vertex position has shifted more than
   /// m_cfg.maxRelativeShift in last iteration
@@ -39,6 +39,13 @@ Acts::AdaptiveMultiVertexFitter<input_track_t, linearizer_t>::fitImpl(
   // Reset annealing tool
   state.annealingState = AnnealingUtility::State();
 
+  // Register all vertices upfront such that references to their information
+  // remain valid during the fit
+  for (auto vtx : state.vertexCollection) {
+    state.vertexIndex(*vtx);
+  }
+  state.updateTrackVertexLinks();
+
   // Indicates how much the vertex positions have shifted
   // in last fit iteration. Will be false if vertex position
   // shift was too big. Needed if equilibrium is reached in
@@ -56,7 +63,8 @@ Acts::AdaptiveMultiVertexFitter<input_track_t, linearizer_t>::fitImpl(
     // Initial loop over all vertices in state.vertexCollection
 
     for (auto currentVtx : state.vertexCollection) {
-      VertexInfo<input_track_t>& currentVtxInfo = state.vtxInfoMap[currentVtx];
+      VertexInfo<input_track_t>& currentVtxInfo =
+          state.vertexInfo(*currentVtx);
       currentVtxInfo.relinearize = false;
       // Store old position of vertex, i.e. seed position
       // in case of first iteration or position determined
@@ -70,18 +78,15 @@ Acts::AdaptiveMultiVertexFitter<input_track_t, linearizer_t>::fitImpl(
       if (perpDist > m_cfg.maxDistToLinPoint) {
         // Relinearization needed, distance too big
         currentVtxInfo.relinearize = true;
-        // Prepare for fit with new vertex position
-        prepareVertexForFit(state, currentVtx, vertexingOptions);
       }
       // Determine if constraint vertex exist
-      if (state.vtxInfoMap[currentVtx].constraintVertex.fullCovariance() !=
+      if (currentVtxInfo.constraintVertex.fullCovariance() !=
           SpacePointSymMatrix::Zero()) {
         currentVtx->setFullPosition(
-            state.vtxInfoMap[currentVtx].constraintVertex.fullPosition());
-        currentVtx->setFitQuality(
-            state.vtxInfoMap[currentVtx].constraintVertex.fitQuality());
+            currentVtxInfo.constraintVertex.fullPosition());
+        currentVtx->setFitQuality(currentVtxInfo.constraintVertex.fitQuality());
         currentVtx->setFullCovariance(
-            state.vtxInfoMap[currentVtx].constraintVertex.fullCovariance());
+            currentVtxInfo.constraintVertex.fullCovariance());
       }
 
       else if (currentVtx->fullCovariance() == SpacePointSymMatrix::Zero()) {
@@ -91,16 +96,22 @@ Acts::AdaptiveMultiVertexFitter<input_track_t, linearizer_t>::fitImpl(
           1. / m_cfg.annealingTool.getWeight(state.annealingState, 1.);
 
       currentVtx->setFullCovariance(currentVtx->fullCovariance() * weight);
-
-      // Set vertexCompatibility for all TrackAtVertex objects
-      // at current vertex
-      setAllVertexCompatibilities(state, currentVtx, vertexingOptions);
     }  // End loop over vertex collection
 
+    // Set vertexCompatibility for all TrackAtVertex objects
+    // at all vertices
+    auto compRes = setAllVertexCompatibilities(state, vertexingOptions);
+    if (!compRes.ok()) {
+      return compRes.error();
+    }
+
     // Now after having estimated all compatibilities of all tracks at
     // all vertices, run again over all vertices to set track weights
     // and update the vertex
-    setWeightsAndUpdate(state, linearizer, vertexingOptions);
+    auto updateRes = setWeightsAndUpdate(state, linearizer, vertexingOptions);
+    if (!updateRes.ok()) {
+      return updateRes.error();
+    }
     if (!state.annealingState.equilibriumReached) {
       m_cfg.annealingTool.anneal(state.annealingState);
     }
@@ -124,11 +135,12 @@ Acts::AdaptiveMultiVertexFitter<input_track_t, linearizer_t>::addVtxToFit(
     State& state, Vertex<input_track_t>& newVertex,
     const linearizer_t& linearizer,
     const VertexingOptions<input_track_t>& vertexingOptions) const {
-  if (state.vtxInfoMap[&newVertex].trackLinks.empty()) {
+  if (state.vertexInfo(newVertex).trackLinks.empty()) {
     return VertexingError::EmptyInput;
   }
 
   std::vector<Vertex<input_track_t>*> verticesToFit;
+  state.updateTrackVertexLinks();
 
   // Prepares vtx and tracks for fast estimation method of their
   // compatibility with vertex
@@ -146,17 +158,18 @@ Acts::AdaptiveMultiVertexFitter<input_track_t, linearizer_t>::addVtxToFit(
   while (!lastIterAddedVertices.empty()) {
     for (auto& lastVtxIter : lastIterAddedVertices) {
       // Loop over all track at current lastVtxIter
-      const std::vector<const input_track_t*>& trks =
-          state.vtxInfoMap[lastVtxIter].trackLinks;
-      for (const auto& trk : trks) {
+      const std::vector<size_t>& trks =
+          state.vertexInfo(*lastVtxIter).trackLinks;
+      for (size_t trk : trks) {
         // Retrieve list of links to all vertices that currently use the current
         // track
-        auto range = state.trackToVerticesMultiMap.equal_range(trk);
+        auto [begin, end] = state.trackVertexRange(state.links[trk].first);
 
         // Loop over all attached vertices and add those to vertex fit
         // which are not already in `verticesToFit`
-        for (auto vtxIter = range.first; vtxIter != range.second; ++vtxIter) {
-          auto newVtxIter = vtxIter->second;
+        for (size_t i = begin; i < end; ++i) {
+          const size_t ivtx = state.links[state.trackVertexLinks[i]].second;
+          auto newVtxIter = state.vertices[ivtx];
           if (!isAlreadyInList(newVtxIter, verticesToFit)) {
             // Add newVtxIter to verticesToFit
             verticesToFit.push_back(newVtxIter);
@@ -201,59 +214,105 @@ Acts::Result<void> Acts::
         State& state, Vertex<input_track_t>* vtx,
         const VertexingOptions<input_track_t>& vertexingOptions) const {
   // The current vertex info object
-  auto& currentVtxInfo = state.vtxInfoMap[vtx];
+  auto& currentVtxInfo = state.vertexInfo(*vtx);
   // The seed position
   const Vector3D& seedPos = currentVtxInfo.seedPosition.template head<3>();
+  currentVtxInfo.ip3dParams.resize(currentVtxInfo.trackLinks.size());
+
+  // Keep already existing ip3dParams
+  std::vector<size_t> missing;
+  for (size_t i = 0; i < currentVtxInfo.ip3dParams.size(); ++i) {
+    if (!currentVtxInfo.ip3dParams[i]) {
+      missing.push_back(i);
+    }
+  }
 
-  // Loop over all tracks at current vertex
-  for (const auto& trk : currentVtxInfo.trackLinks) {
-    auto res = m_cfg.ipEst.getParamsAtClosestApproach(
-        vertexingOptions.geoContext, vertexingOptions.magFieldContext,
-        m_extractParameters(*trk), seedPos);
+  // Estimate all missing ip3dParams at current vertex
+  std::vector<Result<void>> results(missing.size());
+  parallelFor(missing.size(), m_cfg.nThreads, [&](size_t itask, size_t) {
+    results[itask] = estimateIp3dParams(state, currentVtxInfo, missing[itask],
+                                        seedPos, vertexingOptions);
+  });
+  for (auto& res : results) {
     if (!res.ok()) {
       return res.error();
     }
-    // Set ip3dParams for current trackAtVertex
-    currentVtxInfo.ip3dParams.emplace(trk, *(res.value()));
   }
   return {};
 }
 
+template <typename input_track_t, typename linearizer_t>
+Acts::Result<void> Acts::
+    AdaptiveMultiVertexFitter<input_track_t, linearizer_t>::estimateIp3dParams(
+        const State& state, VertexInfo<input_track_t>& vtxInfo, size_t i,
+        const Vector3D& refPos,
+        const VertexingOptions<input_track_t>& vertexingOptions) const {
+  const auto& trkAtVtx = state.tracksAtVertices[vtxInfo.trackLinks[i]];
+  auto res = m_cfg.ipEst.getParamsAtClosestApproach(
+      vertexingOptions.geoContext, vertexingOptions.magFieldContext,
+      m_extractParameters(*trkAtVtx.originalParams), refPos);
+  if (!res.ok()) {
+    return res.error();
+  }
+  // Set ip3dParams for current trackAtVertex
+  vtxInfo.ip3dParams[i] = *(res.value());
+  return {};
+}
+
 template <typename input_track_t, typename linearizer_t>
 Acts::Result<void>
 Acts::AdaptiveMultiVertexFitter<input_track_t, linearizer_t>::
     setAllVertexCompatibilities(
-        State& state, Vertex<input_track_t>* currentVtx,
+        State& state,
         const VertexingOptions<input_track_t>& vertexingOptions) const {
-  VertexInfo<input_track_t>& currentVtxInfo = state.vtxInfoMap[currentVtx];
+  // All (vertex, track) pairs given as the vertex info and the position of
+  // the track in its track links
+  std::vector<std::pair<VertexInfo<input_track_t>*, size_t>> pairs;
+  for (auto vtx : state.vertexCollection) {
+    VertexInfo<input_track_t>& currentVtxInfo = state.vertexInfo(*vtx);
+    currentVtxInfo.ip3dParams.resize(currentVtxInfo.trackLinks.size());
+    for (size_t i = 0; i < currentVtxInfo.trackLinks.size(); ++i) {
+      pairs.emplace_back(&currentVtxInfo, i);
+    }
+  }
 
-  // Loop over tracks at current vertex and
-  // estimate compatibility with vertex
-  for (const auto& trk : currentVtxInfo.trackLinks) {
-    auto& trkAtVtx =
-        state.tracksAtVerticesMap.at(std::make_pair(trk, currentVtx));
+  // Estimate compatibility of all tracks with their vertices
+  std::vector<double> compatibilities(pairs.size());
+  std::vector<Result<void>> results(pairs.size());
+  parallelFor(pairs.size(), m_cfg.nThreads, [&](size_t ipair, size_t) {
+    auto [currentVtxInfo, i] = pairs[ipair];
     // Recover from cases where linearization point != 0 but
     // more tracks were added later on
-    if (currentVtxInfo.ip3dParams.find(trk) ==
-        currentVtxInfo.ip3dParams.end()) {
-      auto res = m_cfg.ipEst.getParamsAtClosestApproach(
-          vertexingOptions.geoContext, vertexingOptions.magFieldContext,
-          m_extractParameters(*trk),
-          VectorHelpers::position(currentVtxInfo.linPoint));
-      if (!res.ok()) {
-        return res.error();
+    if (!currentVtxInfo->ip3dParams[i]) {
+      // Vertices to be relinearized are prepared at their seed position
+      const Vector3D refPos =
+          currentVtxInfo->relinearize
+              ? Vector3D(currentVtxInfo->seedPosition.template head<3>())
+              : Vector3D(VectorHelpers::position(currentVtxInfo->linPoint));
+      results[ipair] = estimateIp3dParams(state, *currentVtxInfo, i, refPos,
+                                          vertexingOptions);
+      if (!results[ipair].ok()) {
+        return;
       }
-      // Set ip3dParams for current trackAtVertex
-      currentVtxInfo.ip3dParams.emplace(trk, *(res.value()));
     }
     // Set compatibility with current vertex
     auto compRes = m_cfg.ipEst.getVertexCompatibility(
-        vertexingOptions.geoContext, &(currentVtxInfo.ip3dParams.at(trk)),
-        VectorHelpers::position(currentVtxInfo.oldPosition));
+        vertexingOptions.geoContext, &(*currentVtxInfo->ip3dParams[i]),
+        VectorHelpers::position(currentVtxInfo->oldPosition));
     if (!compRes.ok()) {
-      return compRes.error();
+      results[ipair] = compRes.error();
+      return;
     }
-    trkAtVtx.vertexCompatibility = *compRes;
+    compatibilities[ipair] = *compRes;
+  });
+
+  for (size_t ipair = 0; ipair < pairs.size(); ++ipair) {
+    if (!results[ipair].ok()) {
+      return results[ipair].error();
+    }
+    auto [currentVtxInfo, i] = pairs[ipair];
+    state.tracksAtVertices[currentVtxInfo->trackLinks[i]].vertexCompatibility =
+        compatibilities[ipair];
   }
   return {};
 }
@@ -263,32 +322,72 @@ Acts::Result<void> Acts::
     AdaptiveMultiVertexFitter<input_track_t, linearizer_t>::setWeightsAndUpdate(
         State& state, const linearizer_t& linearizer,
         const VertexingOptions<input_track_t>& vertexingOptions) const {
+  // Compatibilities of the current track with all its vertices
+  std::vector<double> trkToVtxCompatibilities;
+  // Tracks at vertices that need to be (re-)linearized, given as the link
+  // index and the vertex info
+  std::vector<std::pair<size_t, VertexInfo<input_track_t>*>> toLinearize;
+
   for (auto vtx : state.vertexCollection) {
-    VertexInfo<input_track_t>& currentVtxInfo = state.vtxInfoMap[vtx];
+    VertexInfo<input_track_t>& currentVtxInfo = state.vertexInfo(*vtx);
 
-    for (const auto& trk : currentVtxInfo.trackLinks) {
-      auto& trkAtVtx = state.tracksAtVerticesMap.at(std::make_pair(trk, vtx));
+    for (size_t trk : currentVtxInfo.trackLinks) {
+      auto& trkAtVtx = state.tracksAtVertices[trk];
 
       // Set trackWeight for current track
+      collectTrackToVertexCompatibilities(state, state.links[trk].first,
+                                          trkToVtxCompatibilities);
       double currentTrkWeight = m_cfg.annealingTool.getWeight(
           state.annealingState, trkAtVtx.vertexCompatibility,
-          collectTrackToVertexCompatibilities(state, trk));
+          trkToVtxCompatibilities);
       trkAtVtx.trackWeight = currentTrkWeight;
 
       if (trkAtVtx.trackWeight > m_cfg.minWeight) {
         // Check if linearization state exists or need to be relinearized
+        bool relinearize = currentVtxInfo.relinearize;
+        if (m_cfg.cacheLinearizations) {
+          SpacePointVector dist = currentVtxInfo.oldPosition -
+                                  trkAtVtx.linearizedState.linearizationPoint;
+          relinearize =
+              dist.template head<3>().norm() > m_cfg.maxDistToLinPoint;
+        }
         if (trkAtVtx.linearizedState.covarianceAtPCA ==
                 BoundSymMatrix::Zero() ||
-            state.vtxInfoMap[vtx].relinearize) {
-          auto result = linearizer.linearizeTrack(
-              m_extractParameters(*trk), state.vtxInfoMap[vtx].oldPosition,
-              vertexingOptions.geoContext, vertexingOptions.magFieldContext);
-          if (!result.ok()) {
-            return result.error();
-          }
-          trkAtVtx.linearizedState = *result;
-          state.vtxInfoMap[vtx].linPoint = state.vtxInfoMap[vtx].oldPosition;
+            relinearize) {
+          toLinearize.emplace_back(trk, &currentVtxInfo);
         }
+      }
+    }  // End loop over tracks at vertex
+  }    // End loop over vertex collection
+
+  // Linearize all tracks at the old position of their vertex
+  std::vector<LinearizedTrack> linearizedStates(toLinearize.size());
+  std::vector<Result<void>> results(toLinearize.size());
+  parallelFor(toLinearize.size(), m_cfg.nThreads, [&](size_t itask, size_t) {
+    auto [trk, currentVtxInfo] = toLinearize[itask];
+    auto result = linearizer.linearizeTrack(
+        m_extractParameters(*state.tracksAtVertices[trk].originalParams),
+        currentVtxInfo->oldPosition, vertexingOptions.geoContext,
+        vertexingOptions.magFieldContext);
+    if (!result.ok()) {
+      results[itask] = result.error();
+      return;
+    }
+    linearizedStates[itask] = std::move(*result);
+  });
+  for (size_t itask = 0; itask < toLinearize.size(); ++itask) {
+    if (!results[itask].ok()) {
+      return results[itask].error();
+    }
+    auto [trk, currentVtxInfo] = toLinearize[itask];
+    state.tracksAtVertices[trk].linearizedState = linearizedStates[itask];
+    currentVtxInfo->linPoint = currentVtxInfo->oldPosition;
+  }
+
+  for (auto vtx : state.vertexCollection) {
+    for (size_t trk : state.vertexInfo(*vtx).trackLinks) {
+      auto& trkAtVtx = state.tracksAtVertices[trk];
+      if (trkAtVtx.trackWeight > m_cfg.minWeight) {
         // Update the vertex with the new track
         KalmanVertexUpdater::updateVertexWithTrack<input_track_t>(*vtx,
                                                                   trkAtVtx);
@@ -304,28 +403,23 @@ Acts::Result<void> Acts::
 }
 
 template <typename input_track_t, typename linearizer_t>
-std::vector<double>
-Acts::AdaptiveMultiVertexFitter<input_track_t, linearizer_t>::
-    collectTrackToVertexCompatibilities(State& state,
-                                        const input_track_t* trk) const {
-  std::vector<double> trkToVtxCompatibilities;
-  trkToVtxCompatibilities.reserve(state.vertexCollection.size());
-  auto range = state.trackToVerticesMultiMap.equal_range(trk);
-
-  for (auto vtxIter = range.first; vtxIter != range.second; ++vtxIter) {
-    trkToVtxCompatibilities.push_back(
-        state.tracksAtVerticesMap.at(std::make_pair(trk, vtxIter->second))
-            .vertexCompatibility);
+void Acts::AdaptiveMultiVertexFitter<input_track_t, linearizer_t>::
+    collectTrackToVertexCompatibilities(
+        const State& state, size_t itrk,
+        std::vector<double>& compatibilities) const {
+  compatibilities.clear();
+  auto [begin, end] = state.trackVertexRange(itrk);
+  for (size_t i = begin; i < end; ++i) {
+    compatibilities.push_back(
+        state.tracksAtVertices[state.trackVertexLinks[i]].vertexCompatibility);
   }
-
-  return trkToVtxCompatibilities;
 }
 
 template <typename input_track_t, typename linearizer_t>
 bool Acts::AdaptiveMultiVertexFitter<
     input_track_t, linearizer_t>::checkSmallShift(State& state) const {
   for (auto vtx : state.vertexCollection) {
-    auto diff = state.vtxInfoMap[vtx].oldPosition.template head<3>() -
+    auto diff = state.vertexInfo(*vtx).oldPosition.template head<3>() -
                 vtx->fullPosition().template head<3>();
     const auto& vtxWgt =
         (vtx->fullCovariance().template block<3, 3>(0, 0)).inverse();
@@ -341,10 +435,9 @@ template <typename input_track_t, typename linearizer_t>
 void Acts::AdaptiveMultiVertexFitter<input_track_t, linearizer_t>::
     doVertexSmoothing(State& state, const GeometryContext& geoContext) const {
   for (const auto vtx : state.vertexCollection) {
-    for (const auto trk : state.vtxInfoMap[vtx].trackLinks) {
+    for (const auto trk : state.vertexInfo(*vtx).trackLinks) {
       KalmanVertexTrackUpdater::update<input_track_t>(
-          geoContext, state.tracksAtVerticesMap.at(std::make_pair(trk, vtx)),
-          *vtx);
+          geoContext, state.tracksAtVertices[trk], *vtx);
     }
   }
 }
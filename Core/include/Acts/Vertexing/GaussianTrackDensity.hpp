@@ -57,10 +57,21 @@ class GaussianTrackDensity {
   ///
   /// @param trackList The list of tracks
   /// @param state The GaussianTrackDensity state
+  /// @param trackIds Optional identifiers of the tracks, one per track, with
+  /// which they can be removed from the state again
   ///
   /// @return The z position of the maximum and its width
   std::pair<double, double> globalMaximumWithWidth(
-      const std::vector<Acts::BoundParameters>& trackList, State& state) const;
+      const std::vector<Acts::BoundParameters>& trackList, State& state,
+      const std::vector<const void*>& trackIds = {}) const;
+
+  /// @brief Removes tracks from the density, such that the state can be
+  /// reused for a subset of the previously added tracks
+  ///
+  /// @param trackIds The identifiers of the tracks to remove
+  /// @param state The GaussianTrackDensity state
+  void removeTracks(const std::vector<const void*>& trackIds,
+                    State& state) const;
 
  private:
   /// The configuration
@@ -70,7 +81,9 @@ class GaussianTrackDensity {
   ///
   /// @param trackList The list of tracks
   /// @param state The GaussianTrackDensity state
+  /// @param trackIds Identifiers of the tracks, or empty
   void addTracks(const std::vector<Acts::BoundParameters>& trackList,
-                 State& state) const;
+                 State& state,
+                 const std::vector<const void*>& trackIds = {}) const;
 };
 }  // namespace Acts
@@ -37,6 +37,10 @@ namespace Acts {
 ///
 /// Ref.(1) - CERN-THESIS-2010-027, Giacinto Piacquadio (Freiburg U.)
 ///
+/// If enabled in the configuration, the track parameters are transported
+/// to the perigee along a closed-form helix instead of being propagated,
+/// whenever the magnetic field is uniform along z within tolerance.
+///
 /// @tparam propagator_t Propagator type
 /// @tparam propagator_options_t Propagator options type
 template <typename propagator_t,
@@ -72,6 +76,11 @@ class HelicalTrackLinearizer {
     double minQoP = 1e-15;
     // Maximum curvature value
     double maxRho = 1e+15;
+    // Use the closed-form helix transport to the perigee if the field at
+    // the track and at the linearization point is uniform along z
+    bool useAnalyticTransport = false;
+    // Relative tolerance on the deviation from a uniform field along z
+    double uniformFieldTolerance = 1e-4;
   };
 
   /// @brief Constructor
@@ -7,6 +7,7 @@
 // file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 #include "Acts/Surfaces/PerigeeSurface.hpp"
+#include "Acts/Vertexing/detail/HelixTransport.hpp"
 
 template <typename propagator_t, typename propagator_options_t>
 Acts::Result<Acts::LinearizedTrack> Acts::
@@ -23,14 +24,29 @@ Acts::Result<Acts::LinearizedTrack> Acts::
   propagator_options_t pOptions(gctx, mctx);
   pOptions.direction = backward;
 
-  const BoundParameters* endParams = nullptr;
-  // Do the propagation to linPointPos
-  auto result = m_cfg.propagator->propagate(params, *perigeeSurface, pOptions);
-  if (result.ok()) {
-    endParams = (*result).endParameters.get();
-
-  } else {
-    return result.error();
+  std::unique_ptr<const BoundParameters> endParams;
+  if (m_cfg.useAnalyticTransport) {
+    const Vector3D fieldAtTrack = m_cfg.bField.getField(params.position());
+    if (detail::isHelixTransportApplicable(
+            gctx, params, fieldAtTrack, m_cfg.bField.getField(linPointPos),
+            m_cfg.uniformFieldTolerance)) {
+      // Closed-form transport to linPointPos
+      auto result = detail::transportHelixToPerigee(
+          gctx, params, fieldAtTrack[eZ], pOptions.mass, perigeeSurface);
+      if (!result.ok()) {
+        return result.error();
+      }
+      endParams = std::make_unique<const BoundParameters>(std::move(*result));
+    }
+  }
+  if (endParams == nullptr) {
+    // Do the propagation to linPointPos
+    auto result =
+        m_cfg.propagator->propagate(params, *perigeeSurface, pOptions);
+    if (!result.ok()) {
+      return result.error();
+    }
+    endParams = std::move((*result).endParameters);
   }
 
   BoundVector paramsAtPCA = endParams->parameters();
@@ -57,6 +57,11 @@ class ImpactPoint3dEstimator {
     double minQoP = 1e-15;
     /// Maximum curvature value
     double maxRho = 1e+15;
+    /// Use the closed-form helix transport to the plane at the point of
+    /// closest approach if the field is uniform along z
+    bool useAnalyticTransport = false;
+    /// Relative tolerance on the deviation from a uniform field along z
+    double uniformFieldTolerance = 1e-4;
   };
 
   /// @brief Constructor
@@ -10,7 +10,9 @@
 #include "Acts/Surfaces/PerigeeSurface.hpp"
 #include "Acts/Surfaces/PlaneSurface.hpp"
 #include "Acts/Utilities/Helpers.hpp"
+#include "Acts/Utilities/detail/periodic.hpp"
 #include "Acts/Vertexing/VertexingError.hpp"
+#include "Acts/Vertexing/detail/HelixTransport.hpp"
 
 template <typename input_track_t, typename propagator_t,
           typename propagator_options_t>
@@ -75,6 +77,25 @@ Acts::ImpactPoint3dEstimator<input_track_t, propagator_t,
   propagator_options_t pOptions(gctx, mctx);
   pOptions.direction = backward;
 
+  if (m_cfg.useAnalyticTransport) {
+    const Vector3D fieldAtTrack = m_cfg.bField.getField(trkParams.position());
+    if (detail::isHelixTransportApplicable(gctx, trkParams, fieldAtTrack,
+                                           m_cfg.bField.getField(vtxPos),
+                                           m_cfg.uniformFieldTolerance)) {
+      // Closed-form transport, starting from the change in phi to the
+      // point of closest approach found above
+      double deltaPhi = detail::radian_sym(
+          VectorHelpers::phi(momDir) - trkParams.parameters()[ParID_t::ePHI]);
+      auto result = detail::transportHelixToPlane(
+          gctx, trkParams, fieldAtTrack[eZ], pOptions.mass, planeSurface,
+          deltaPhi, m_cfg.maxIterations, m_cfg.precision);
+      if (!result.ok()) {
+        return result.error();
+      }
+      return std::make_unique<const BoundParameters>(std::move(*result));
+    }
+  }
+
   // Do the propagation to linPointPos
   auto result = m_cfg.propagator->propagate(trkParams, *planeSurface, pOptions);
   if (result.ok()) {
@@ -8,8 +8,8 @@
 
 #pragma once
 
-#include <map>
-#include <set>
+#include <utility>
+#include <vector>
 #include "Acts/EventData/TrackParameters.hpp"
 
 namespace Acts {
@@ -24,13 +24,19 @@ class TrackDensity {
   /// @brief Struct to store information for a single track
   struct TrackEntry {
     TrackEntry() = default;
-    TrackEntry(double c0in, double c1in, double c2in, double zMin, double zMax)
-        : c0(c0in), c1(c1in), c2(c2in), lowerBound(zMin), upperBound(zMax) {}
-
-    // Dummy constructor for binary search
-    TrackEntry(double z) : lowerBound(z), upperBound(z) {}
+    TrackEntry(double zIn, double c0in, double c1in, double c2in, double zMin,
+               double zMax, const void* idIn = nullptr)
+        : z(zIn),
+          c0(c0in),
+          c1(c1in),
+          c2(c2in),
+          lowerBound(zMin),
+          upperBound(zMax),
+          id(idIn) {}
 
     // Cached information for a single track
+    // z0 of the track
+    double z = 0;
     // z-independent term in exponent
     double c0 = 0;
     // linear coefficient in exponent
@@ -39,37 +45,10 @@ class TrackDensity {
     double c2 = 0;
     double lowerBound = 0;
     double upperBound = 0;
+    // identifier of the track, used to remove it again
+    const void* id = nullptr;
   };
 
-  /// @brief Functor to compare two z0 values
-  struct predPerigee {
-    bool operator()(const BoundParameters& left,
-                    const BoundParameters& right) const {
-      return left.parameters()[ParID_t::eLOC_Z0] <
-             right.parameters()[ParID_t::eLOC_Z0];
-    }
-  };
-
-  /// @brief Functor to compare two TrackEntry values based
-  /// on their lower limits (low to high)
-  struct predEntryByMin {
-    bool operator()(const TrackEntry& left, const TrackEntry& right) const {
-      return left.lowerBound < right.lowerBound;
-    }
-  };
-
-  /// @brief Functor to compare two TrackEntry values based on
-  /// their upper limits (low to high)
-  struct predEntryByMax {
-    bool operator()(const TrackEntry& left, const TrackEntry& right) const {
-      return left.upperBound < right.upperBound;
-    }
-  };
-
-  using TrackMap = std::map<BoundParameters, TrackEntry, predPerigee>;
-  using LowerMap = std::map<TrackEntry, BoundParameters, predEntryByMax>;
-  using UpperMap = std::map<TrackEntry, BoundParameters, predEntryByMin>;
-
   /// @brief The Config struct
   struct Config {
     // Assumed shape of density function:
@@ -79,12 +58,14 @@ class TrackDensity {
 
   /// @brief The State struct
   struct State {
+    // Maximum distance of the range bounds of any track from its z0. It is
+    // not reduced when tracks are removed.
     double maxZRange = 0;
 
-    // Maps to cache track information
-    std::set<BoundParameters, predPerigee> trackSet;
-    LowerMap lowerMap;
-    UpperMap upperMap;
+    // Cached track information, one entry per track, sorted by z0
+    // if isSorted is set
+    std::vector<TrackEntry> trackEntries;
+    bool isSorted = true;
   };
 
   /// Default constructor
@@ -99,8 +80,22 @@ class TrackDensity {
   /// @param trk Track parameters.
   /// @param d0SignificanceCut Significance cut on d0.
   /// @param z0SignificanceCut Significance cut on z0.
+  /// @param trackId Identifier of the track, e.g. the address of the
+  /// input track, needed to remove the track again
   void addTrack(State& state, const BoundParameters& trk,
-                double d0SignificanceCut, double z0SignificanceCut) const;
+                double d0SignificanceCut, double z0SignificanceCut,
+                const void* trackId = nullptr) const;
+
+  /// @brief Remove tracks from the set being considered
+  ///
+  /// Tracks are identified by the identifier they were added with. Tracks
+  /// added without identifier are never removed, identifiers that are not
+  /// in the set are ignored.
+  ///
+  /// @param state The track density state
+  /// @param trackIds Identifiers of the tracks to remove
+  void removeTracks(State& state,
+                    const std::vector<const void*>& trackIds) const;
 
   /// @brief Calculates z position of global maximum with Gaussian width
   /// for density function.
@@ -152,6 +147,34 @@ class TrackDensity {
   /// The configuration
   Config m_cfg;
 
+  /// @brief Sort the track entries by z0
+  ///
+  /// @param state The track density state
+  void sortTracks(State& state) const;
+
+  /// @brief Evaluate the density function and its two first derivatives
+  /// at the specified coordinate using only a range of track entries
+  ///
+  /// @param state The track density state
+  /// @param z z-position along the beamline
+  /// @param begin First track entry that may overlap z
+  /// @param end One past the last track entry that may overlap z
+  /// @param[out] firstDerivative The first derivative
+  /// @param[out] secondDerivative The second derivative
+  ///
+  /// @return The track density value
+  double trackDensity(const State& state, double z, size_t begin, size_t end,
+                      double& firstDerivative, double& secondDerivative) const;
+
+  /// @brief Find the track entries that may overlap z, i.e. those with
+  /// z0 within maxZRange of z
+  ///
+  /// @param state The track density state
+  /// @param z z-position along the beamline
+  ///
+  /// @return First and one past the last track entry
+  std::pair<size_t, size_t> overlapRange(const State& state, double z) const;
+
   /// @brief Update the current maximum values
   ///
   /// @param newZ The new z value
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <unordered_set>
+#include <vector>
 #include "Acts/EventData/TrackParameters.hpp"
 #include "Acts/Utilities/Definitions.hpp"
 #include "Acts/Utilities/Result.hpp"
@@ -48,6 +50,18 @@ class TrackDensityVertexFinder {
     track_density_t trackDensityEstimator;
   };
 
+  /// @brief The State struct
+  ///
+  /// Keeps the track density between calls, such that only the tracks that
+  /// differ from the previous call need to be added or removed
+  struct State {
+    // The track density state
+    typename track_density_t::State densityState;
+
+    // The tracks currently contained in the density state
+    std::vector<const InputTrack_t*> tracks;
+  };
+
   /// @brief Function that finds single vertex candidate
   ///
   /// @param trackVector Input track collection
@@ -59,6 +73,20 @@ class TrackDensityVertexFinder {
       const std::vector<const InputTrack_t*>& trackVector,
       const VertexingOptions<InputTrack_t>& vertexingOptions) const;
 
+  /// @brief Function that finds single vertex candidate, reusing the
+  /// track density of a previous call on the same state
+  ///
+  /// @param trackVector Input track collection
+  /// @param vertexingOptions Vertexing options
+  /// @param state The finder state
+  ///
+  /// @return Vector of vertices, filled with a single
+  ///         vertex (for consistent interfaces)
+  Result<std::vector<Vertex<InputTrack_t>>> find(
+      const std::vector<const InputTrack_t*>& trackVector,
+      const VertexingOptions<InputTrack_t>& vertexingOptions,
+      State& state) const;
+
   /// @brief Constructor used if InputTrack_t type == BoundParameters
   ///
   /// @param cfg Configuration object
@@ -11,19 +11,46 @@ auto Acts::TrackDensityVertexFinder<vfitter_t, track_density_t>::find(
     const std::vector<const InputTrack_t*>& trackVector,
     const VertexingOptions<InputTrack_t>& vertexingOptions) const
     -> Result<std::vector<Vertex<InputTrack_t>>> {
-  typename track_density_t::State densityState;
+  State state;
+  return find(trackVector, vertexingOptions, state);
+}
 
-  std::vector<BoundParameters> trackList;
-  trackList.reserve(trackVector.size());
+template <typename vfitter_t, typename track_density_t>
+auto Acts::TrackDensityVertexFinder<vfitter_t, track_density_t>::find(
+    const std::vector<const InputTrack_t*>& trackVector,
+    const VertexingOptions<InputTrack_t>& vertexingOptions,
+    State& state) const -> Result<std::vector<Vertex<InputTrack_t>>> {
+  // Remove the tracks that are no longer requested from the density
+  // and add the ones that are not contained yet
+  std::unordered_set<const InputTrack_t*> requested(trackVector.begin(),
+                                                    trackVector.end());
+  // The tracks are identified in the density by their address
+  std::vector<const void*> removedIds;
+  for (const auto& trk : state.tracks) {
+    if (requested.erase(trk) == 0) {
+      removedIds.push_back(trk);
+    }
+  }
+  if (!removedIds.empty()) {
+    m_cfg.trackDensityEstimator.removeTracks(removedIds, state.densityState);
+  }
 
+  std::vector<BoundParameters> trackList;
+  std::vector<const void*> trackIds;
+  trackList.reserve(requested.size());
+  trackIds.reserve(requested.size());
   for (const auto& trk : trackVector) {
-    trackList.push_back(m_extractParameters(*trk));
+    if (requested.count(trk) != 0) {
+      trackList.push_back(m_extractParameters(*trk));
+      trackIds.push_back(trk);
+    }
   }
+  state.tracks = trackVector;
 
   // Calculate z seed position
   std::pair<double, double> zAndWidth =
-      m_cfg.trackDensityEstimator.globalMaximumWithWidth(trackList,
-                                                         densityState);
+      m_cfg.trackDensityEstimator.globalMaximumWithWidth(
+          trackList, state.densityState, trackIds);
 
   double z = zAndWidth.first;
 
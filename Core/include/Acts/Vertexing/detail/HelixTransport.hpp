@@ -0,0 +1,85 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <memory>
+#include "Acts/EventData/TrackParameters.hpp"
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/Surfaces/PerigeeSurface.hpp"
+#include "Acts/Surfaces/PlaneSurface.hpp"
+#include "Acts/Utilities/Definitions.hpp"
+#include "Acts/Utilities/Result.hpp"
+
+namespace Acts {
+namespace detail {
+
+/// @brief Closed-form transport of track parameters along a helix
+///
+/// In a magnetic field that is uniform and parallel to the z axis, a
+/// charged track follows a helix and both the transported parameters and
+/// their Jacobian with respect to the initial parameters can be written
+/// down exactly. This replaces the numerical propagation in the vertexing
+/// tools for tracks close to the beam line, where the field is uniform.
+///
+/// The initial parameters need to be bound to a perigee surface, the
+/// covariance is transported if present.
+
+/// @brief Checks whether the closed-form transport can be used
+///
+/// @param gctx The geometry context
+/// @param params The initial track parameters
+/// @param fieldAtStart The magnetic field at the initial track position
+/// @param fieldAtTarget The magnetic field at the target position
+/// @param tolerance Relative tolerance on the deviation of the field from
+///        a uniform field along z
+///
+/// @return True if the track is charged, bound to a perigee surface
+///         aligned with z and the field is uniform along z within tolerance
+bool isHelixTransportApplicable(const GeometryContext& gctx,
+                                const BoundParameters& params,
+                                const Vector3D& fieldAtStart,
+                                const Vector3D& fieldAtTarget,
+                                double tolerance);
+
+/// @brief Transports the track parameters to the point of closest
+/// approach in the transverse plane to the line of a perigee surface
+///
+/// @param gctx The geometry context
+/// @param params The initial track parameters
+/// @param bZ The z component of the uniform magnetic field
+/// @param mass The particle mass used to transport the time
+/// @param surface The target perigee surface, aligned with z
+///
+/// @return The track parameters bound to the target surface
+Result<BoundParameters> transportHelixToPerigee(
+    const GeometryContext& gctx, const BoundParameters& params, double bZ,
+    double mass, std::shared_ptr<const PerigeeSurface> surface);
+
+/// @brief Transports the track parameters to the intersection with a plane
+///
+/// The intersection is found with a Newton method, starting from the given
+/// change of the transverse momentum direction along the helix.
+///
+/// @param gctx The geometry context
+/// @param params The initial track parameters
+/// @param bZ The z component of the uniform magnetic field
+/// @param mass The particle mass used to transport the time
+/// @param surface The target plane surface
+/// @param deltaPhi Initial estimate of the change in phi along the helix
+/// @param maxIterations Maximum number of Newton iterations
+/// @param precision Desired precision of the change in phi
+///
+/// @return The track parameters bound to the target surface
+Result<BoundParameters> transportHelixToPlane(
+    const GeometryContext& gctx, const BoundParameters& params, double bZ,
+    double mass, std::shared_ptr<const PlaneSurface> surface, double deltaPhi,
+    int maxIterations = 20, double precision = 1e-10);
+
+}  // namespace detail
+}  // namespace Acts
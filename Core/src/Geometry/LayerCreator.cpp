@@ -396,6 +396,109 @@ Acts::MutableLayerPtr Acts::LayerCreator::planeLayer(
   return pLayer;
 }
 
+Acts::MutableLayerPtr Acts::LayerCreator::cylinderLayerOnBVH(
+    const GeometryContext& gctx,
+    std::vector<std::shared_ptr<const Surface>> surfaces,
+    std::optional<ProtoLayer> _protoLayer,
+    std::shared_ptr<const Transform3D> transform,
+    std::unique_ptr<ApproachDescriptor> ad) const {
+  ProtoLayer protoLayer =
+      _protoLayer ? *_protoLayer : ProtoLayer(gctx, surfaces);
+
+  // remaining layer parameters
+  double layerR = 0.5 * (protoLayer.minR - protoLayer.envR.first +
+                         protoLayer.maxR + protoLayer.envR.second);
+  double binPosZ = 0.5 * (protoLayer.minZ + protoLayer.maxZ);
+  double envZShift = 0.5 * (-protoLayer.envZ.first + protoLayer.envZ.second);
+  double layerZ = binPosZ + envZShift;
+  double layerHalfZ = 0.5 * std::abs(protoLayer.maxZ + protoLayer.envZ.second -
+                                     (protoLayer.minZ - protoLayer.envZ.first));
+  double layerThickness = (protoLayer.maxR - protoLayer.minR) +
+                          protoLayer.envR.first + protoLayer.envR.second;
+
+  ACTS_VERBOSE("Creating a cylindrical Layer with a BVH lookup:");
+  ACTS_VERBOSE(" - with layer R     = " << layerR);
+  ACTS_VERBOSE(" - with R thickness = " << layerThickness);
+  ACTS_VERBOSE(" - z center         = " << layerZ);
+  ACTS_VERBOSE(" - halflength z     = " << layerHalfZ);
+  ACTS_VERBOSE(" - # of modules     = " << surfaces.size());
+
+  // create the layer transforms if not given
+  if (!transform) {
+    transform =
+        std::make_shared<const Transform3D>(Translation3D(0., 0., layerZ));
+  }
+
+  // create the surface array
+  std::unique_ptr<SurfaceArray> sArray;
+  if (!surfaces.empty()) {
+    sArray = m_cfg.surfaceArrayCreator->surfaceArrayOnBVH(gctx,
+                                                          std::move(surfaces));
+  }
+
+  // create the layer
+  auto cBounds = std::make_shared<const CylinderBounds>(layerR, layerHalfZ);
+  MutableLayerPtr cLayer =
+      CylinderLayer::create(transform, cBounds, std::move(sArray),
+                            layerThickness, std::move(ad), active);
+
+  if (!cLayer)
+    ACTS_ERROR("Creation of cylinder layer did not succeed!");
+  associateSurfacesToLayer(*cLayer);
+
+  return cLayer;
+}
+
+Acts::MutableLayerPtr Acts::LayerCreator::discLayerOnBVH(
+    const GeometryContext& gctx,
+    std::vector<std::shared_ptr<const Surface>> surfaces,
+    std::optional<ProtoLayer> _protoLayer,
+    std::shared_ptr<const Transform3D> transform,
+    std::unique_ptr<ApproachDescriptor> ad) const {
+  ProtoLayer protoLayer =
+      _protoLayer ? *_protoLayer : ProtoLayer(gctx, surfaces);
+
+  double layerZ = 0.5 * (protoLayer.minZ - protoLayer.envZ.first +
+                         protoLayer.maxZ + protoLayer.envZ.second);
+  double layerThickness = (protoLayer.maxZ - protoLayer.minZ) +
+                          protoLayer.envZ.first + protoLayer.envZ.second;
+
+  ACTS_VERBOSE("Creating a disk Layer with a BVH lookup:");
+  ACTS_VERBOSE(" - at Z position    = " << layerZ);
+  ACTS_VERBOSE(" - with Z thickness = " << layerThickness);
+  ACTS_VERBOSE(" - with R min/max   = "
+               << protoLayer.minR << " (-" << protoLayer.envR.first << ") / "
+               << protoLayer.maxR << " (+" << protoLayer.envR.second << ")");
+  ACTS_VERBOSE(" - # of modules     = " << surfaces.size());
+
+  // create the layer transforms if not given
+  if (!transform) {
+    transform =
+        std::make_shared<const Transform3D>(Translation3D(0., 0., layerZ));
+  }
+
+  // create the surface array
+  std::unique_ptr<SurfaceArray> sArray;
+  if (!surfaces.empty()) {
+    sArray = m_cfg.surfaceArrayCreator->surfaceArrayOnBVH(gctx,
+                                                          std::move(surfaces));
+  }
+
+  // create the layer
+  auto dBounds = std::make_shared<const RadialBounds>(
+      protoLayer.minR - protoLayer.envR.first,
+      protoLayer.maxR + protoLayer.envR.second);
+  MutableLayerPtr dLayer =
+      DiscLayer::create(transform, dBounds, std::move(sArray), layerThickness,
+                        std::move(ad), active);
+
+  if (!dLayer)
+    ACTS_ERROR("Creation of disc layer did not succeed!");
+  associateSurfacesToLayer(*dLayer);
+
+  return dLayer;
+}
+
 void Acts::LayerCreator::associateSurfacesToLayer(Layer& layer) const {
   if (layer.surfaceArray() != nullptr) {
     auto surfaces = layer.surfaceArray()->surfaces();
@@ -388,6 +388,28 @@ Acts::SurfaceArrayCreator::surfaceArrayOnPlane(
   //!< @todo implement - take from ATLAS complex TRT builder
 }
 
+/// SurfaceArrayCreator interface method - create an array with a BVH lookup
+std::unique_ptr<Acts::SurfaceArray>
+Acts::SurfaceArrayCreator::surfaceArrayOnBVH(
+    const GeometryContext& gctx,
+    std::vector<std::shared_ptr<const Surface>> surfaces) const {
+  std::vector<const Surface*> surfacesRaw = unpack_shared_vector(surfaces);
+
+  ACTS_VERBOSE("Creating a SurfaceArray with a bounding volume hierarchy");
+  ACTS_VERBOSE(" -- with " << surfaces.size() << " surfaces.")
+  ACTS_VERBOSE(" -- with envelope " << m_cfg.bvhEnvelope
+                                    << " and maximum depth "
+                                    << m_cfg.bvhMaxDepth);
+
+  auto sl = std::make_unique<SurfaceArray::SurfaceBVHLookup>(
+      m_cfg.bvhEnvelope, m_cfg.bvhMaxDepth);
+  sl->fill(gctx, surfacesRaw);
+
+  return std::make_unique<SurfaceArray>(
+      std::move(sl), std::move(surfaces),
+      std::make_shared<const Transform3D>(Transform3D::Identity()));
+}
+
 std::vector<const Acts::Surface*> Acts::SurfaceArrayCreator::findKeySurfaces(
     const std::vector<const Surface*>& surfaces,
     const std::function<bool(const Surface*, const Surface*)>& equal) const {
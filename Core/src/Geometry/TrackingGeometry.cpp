@@ -10,6 +10,7 @@
 // TrackingGeometry.cpp, Acts project
 ///////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <functional>
 
 #include "Acts/Geometry/Layer.hpp"
@@ -18,6 +19,43 @@
 #include "Acts/Surfaces/PerigeeSurface.hpp"
 #include "Acts/Surfaces/Surface.hpp"
 
+namespace {
+/// Collect all identified surfaces of a volume and its sub volumes
+void collectSurfaces(
+    const Acts::TrackingVolume& tVolume,
+    std::vector<std::pair<Acts::GeometryID, const Acts::Surface*>>& surfaces) {
+  auto insert = [&](const Acts::Surface* surface) {
+    if (surface != nullptr and surface->geoID().value() != 0) {
+      surfaces.emplace_back(surface->geoID(), surface);
+    }
+  };
+  for (const auto& bSurface : tVolume.boundarySurfaces()) {
+    insert(&bSurface->surfaceRepresentation());
+  }
+  if (tVolume.confinedLayers() != nullptr) {
+    for (const auto& layer : tVolume.confinedLayers()->arrayObjects()) {
+      insert(&layer->surfaceRepresentation());
+      if (layer->approachDescriptor() != nullptr) {
+        for (const auto& aSurface :
+             layer->approachDescriptor()->containedSurfaces()) {
+          insert(aSurface);
+        }
+      }
+      if (layer->surfaceArray() != nullptr) {
+        for (const auto& sSurface : layer->surfaceArray()->surfaces()) {
+          insert(sSurface);
+        }
+      }
+    }
+  }
+  if (tVolume.confinedVolumes()) {
+    for (const auto& volume : tVolume.confinedVolumes()->arrayObjects()) {
+      collectSurfaces(*volume, surfaces);
+    }
+  }
+}
+}  // namespace
+
 Acts::TrackingGeometry::TrackingGeometry(
     const MutableTrackingVolumePtr& highestVolume,
     const IMaterialDecorator* materialDecorator)
@@ -26,6 +64,21 @@ Acts::TrackingGeometry::TrackingGeometry(
   // Close the geometry: assign geometryID and successively the material
   size_t volumeID = 0;
   highestVolume->closeGeometry(materialDecorator, m_trackingVolumes, volumeID);
+
+  // Index the surfaces, glued boundary surfaces are shared between volumes
+  // and appear more than once, the first occurence is kept
+  std::vector<std::pair<GeometryID, const Surface*>> surfaces;
+  collectSurfaces(*highestVolume, surfaces);
+  std::stable_sort(surfaces.begin(), surfaces.end(),
+                   [](const auto& lhs, const auto& rhs) {
+                     return lhs.first.value() < rhs.first.value();
+                   });
+  surfaces.erase(std::unique(surfaces.begin(), surfaces.end(),
+                             [](const auto& lhs, const auto& rhs) {
+                               return lhs.first == rhs.first;
+                             }),
+                 surfaces.end());
+  m_surfacesById = GeometryIDMap<const Surface*>(std::move(surfaces));
 }
 
 Acts::TrackingGeometry::~TrackingGeometry() = default;
@@ -75,3 +128,8 @@ void Acts::TrackingGeometry::visitSurfaces(
     const std::function<void(const Acts::Surface*)>& visitor) const {
   highestTrackingVolume()->visitSurfaces(visitor);
 }
+
+const Acts::Surface* Acts::TrackingGeometry::findSurface(GeometryID id) const {
+  const auto surface = m_surfacesById.find(id);
+  return (surface != nullptr) ? *surface : nullptr;
+}
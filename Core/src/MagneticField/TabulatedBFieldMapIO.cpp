@@ -0,0 +1,99 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Acts/MagneticField/TabulatedBFieldMapIO.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "Acts/Utilities/detail/MappedFile.hpp"
+
+template <unsigned int DIM>
+void Acts::writeTabulatedBFieldMap(const std::string& path,
+                                   const TabulatedBFieldMap<DIM>& field) {
+  using StoredType = typename TabulatedBFieldMap<DIM>::StoredType;
+  static_assert(sizeof(StoredType) ==
+                    TabulatedBFieldMap<DIM>::VALUE_DIM * sizeof(double),
+                "Field values have to be stored without padding");
+
+  TabulatedBFieldMapHeader header;
+  std::memcpy(header.magic, TabulatedBFieldMapHeader::kMagic,
+              sizeof(header.magic));
+  header.dim = DIM;
+  header.valueDim = TabulatedBFieldMap<DIM>::VALUE_DIM;
+  const auto nPoints = field.getNBins();
+  const auto min = field.getMin();
+  const auto max = field.getMax();
+  for (unsigned int d = 0; d < DIM; ++d) {
+    header.nPoints[d] = nPoints[d];
+    header.min[d] = min[d];
+    header.max[d] = max[d];
+  }
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char*>(field.data()),
+             field.size() * sizeof(StoredType));
+  if (not file) {
+    throw std::runtime_error("Could not write field map to " + path);
+  }
+}
+
+template <unsigned int DIM>
+Acts::TabulatedBFieldMap<DIM> Acts::mapTabulatedBFieldMap(
+    const std::string& path) {
+  using StoredType = typename TabulatedBFieldMap<DIM>::StoredType;
+
+  const auto file = detail::mapFile(path);
+  if (file.size < sizeof(TabulatedBFieldMapHeader)) {
+    throw std::runtime_error("Invalid field map " + path);
+  }
+
+  const auto& header =
+      *reinterpret_cast<const TabulatedBFieldMapHeader*>(file.data);
+  if (std::memcmp(header.magic, TabulatedBFieldMapHeader::kMagic,
+                  sizeof(header.magic)) != 0 or
+      header.version != TabulatedBFieldMapHeader::kVersion or
+      header.byteOrderMark != TabulatedBFieldMapHeader::kByteOrderMark or
+      header.dim != DIM or
+      header.valueDim != TabulatedBFieldMap<DIM>::VALUE_DIM) {
+    throw std::runtime_error("Incompatible field map " + path);
+  }
+  std::array<double, DIM> min, max;
+  std::array<size_t, DIM> nPoints;
+  // The number of values is checked against the file size before each
+  // multiplication, such that it can not overflow
+  const size_t maxValues = (file.size - sizeof(header)) / sizeof(StoredType);
+  size_t nValues = 1;
+  for (unsigned int d = 0; d < DIM; ++d) {
+    min[d] = header.min[d];
+    max[d] = header.max[d];
+    nPoints[d] = header.nPoints[d];
+    if (nValues != 0 and nPoints[d] > maxValues / nValues) {
+      throw std::runtime_error("Truncated field map " + path);
+    }
+    nValues *= nPoints[d];
+  }
+  if (file.size != sizeof(header) + nValues * sizeof(StoredType)) {
+    throw std::runtime_error("Truncated field map " + path);
+  }
+
+  const auto* values =
+      reinterpret_cast<const StoredType*>(file.data + sizeof(header));
+  return TabulatedBFieldMap<DIM>(min, max, nPoints, file.mapping, values);
+}
+
+template void Acts::writeTabulatedBFieldMap<2>(const std::string&,
+                                               const TabulatedBFieldMap<2>&);
+template void Acts::writeTabulatedBFieldMap<3>(const std::string&,
+                                               const TabulatedBFieldMap<3>&);
+template Acts::TabulatedBFieldMap<2> Acts::mapTabulatedBFieldMap<2>(
+    const std::string&);
+template Acts::TabulatedBFieldMap<3> Acts::mapTabulatedBFieldMap<3>(
+    const std::string&);
@@ -14,6 +14,8 @@
 #include "Acts/Material/BinnedSurfaceMaterial.hpp"
 #include "Acts/Material/HomogeneousSurfaceMaterial.hpp"
 
+#include <stdexcept>
+
 // Default Constructor - for homogeneous material
 Acts::AccumulatedSurfaceMaterial::AccumulatedSurfaceMaterial(double splitFactor)
     : m_splitFactor(splitFactor) {
@@ -91,6 +93,25 @@ void Acts::AccumulatedSurfaceMaterial::trackAverage(
   }
 }
 
+// Merge the material accumulated by another instance
+void Acts::AccumulatedSurfaceMaterial::merge(
+    const AccumulatedSurfaceMaterial& asma) {
+  const auto& other = asma.m_accumulatedMaterial;
+  bool compatible = (other.size() == m_accumulatedMaterial.size());
+  for (size_t ib1 = 0; compatible and ib1 < other.size(); ++ib1) {
+    compatible = (other[ib1].size() == m_accumulatedMaterial[ib1].size());
+  }
+  if (not compatible) {
+    throw std::invalid_argument(
+        "AccumulatedSurfaceMaterial: can not merge different binnings");
+  }
+  for (size_t ib1 = 0; ib1 < other.size(); ++ib1) {
+    for (size_t ib0 = 0; ib0 < other[ib1].size(); ++ib0) {
+      m_accumulatedMaterial[ib1][ib0].merge(other[ib1][ib0]);
+    }
+  }
+}
+
 /// Total average creates SurfaceMaterial
 std::unique_ptr<const Acts::ISurfaceMaterial>
 Acts::AccumulatedSurfaceMaterial::totalAverage() {
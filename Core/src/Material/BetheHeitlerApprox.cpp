@@ -0,0 +1,139 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Acts/Material/BetheHeitlerApprox.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+// The distribution is integrated in s = ln(y) with y = -ln(z). Below yMin
+// the energy fraction is one for all practical purposes, above yMax it is
+// negligible.
+constexpr double kYMin = 1e-12;
+constexpr double kYMax = 30.;
+constexpr size_t kIntegrationPoints = 4096;
+
+/// Accumulates the moments of one component.
+struct Moments {
+  double w = 0.;
+  double wz = 0.;
+  double wz2 = 0.;
+
+  void add(double m, double z) {
+    w += m;
+    wz += m * z;
+    wz2 += m * z * z;
+  }
+};
+}  // namespace
+
+Acts::BetheHeitlerApprox::BetheHeitlerApprox(size_t nComponents,
+                                             float maxThicknessInX0,
+                                             size_t nBins)
+    : m_nComponents(std::max<size_t>(1, nComponents)),
+      m_maxThicknessInX0(maxThicknessInX0),
+      m_nBins(std::max<size_t>(1, nBins)) {
+  m_table.resize((m_nBins + 1) * m_nComponents);
+  for (size_t ibin = 0; ibin <= m_nBins; ++ibin) {
+    const float t = m_maxThicknessInX0 * ibin / m_nBins;
+    computeMixture(t, m_nComponents, m_table.data() + ibin * m_nComponents);
+  }
+}
+
+void Acts::BetheHeitlerApprox::mixture(float thicknessInX0,
+                                       std::vector<Component>& mixture) const {
+  mixture.resize(m_nComponents);
+  if (m_maxThicknessInX0 <= thicknessInX0) {
+    computeMixture(thicknessInX0, m_nComponents, mixture.data());
+    return;
+  }
+  const float x = std::max(0.f, thicknessInX0) / m_maxThicknessInX0 * m_nBins;
+  const size_t ibin = std::min(static_cast<size_t>(x), m_nBins - 1);
+  const float f = x - ibin;
+  const Component* lower = m_table.data() + ibin * m_nComponents;
+  const Component* upper = lower + m_nComponents;
+  for (size_t i = 0; i < m_nComponents; ++i) {
+    mixture[i].weight = (1 - f) * lower[i].weight + f * upper[i].weight;
+    mixture[i].mean = (1 - f) * lower[i].mean + f * upper[i].mean;
+    mixture[i].variance = (1 - f) * lower[i].variance + f * upper[i].variance;
+  }
+}
+
+void Acts::BetheHeitlerApprox::computeMixture(float thicknessInX0,
+                                              size_t nComponents,
+                                              Component* mixture) {
+  const double weight = 1. / nComponents;
+  // No material, no energy loss
+  if (thicknessInX0 <= 0.f) {
+    std::fill(mixture, mixture + nComponents, Component{float(weight), 1, 0});
+    return;
+  }
+
+  // y = -ln(z) is Gamma distributed with shape c. Integrating in s = ln(y)
+  // removes the singularity of the density at y = 0 for c < 1:
+  //
+  //     f(y) dy = exp(c s - exp(s)) / Gamma(c) ds
+  //
+  const double c = thicknessInX0 / std::log(2.);
+  const double norm = 1. / std::tgamma(c);
+  const double sMin = std::log(kYMin);
+  const double ds = (std::log(kYMax) - sMin) / kIntegrationPoints;
+  // Probability below yMin, where exp(-y) = 1
+  const double head = std::pow(kYMin, c) / std::tgamma(c + 1.);
+  auto density = [&](size_t i) {
+    const double s = sMin + (i + 0.5) * ds;
+    const double y = std::exp(s);
+    return std::make_pair(norm * std::exp(c * s - y) * ds, std::exp(-y));
+  };
+
+  // The total probability, to correct for the truncation and the
+  // integration error
+  double total = head;
+  for (size_t i = 0; i < kIntegrationPoints; ++i) {
+    total += density(i).first;
+  }
+
+  // Distribute the probability with increasing y, i.e. decreasing z, onto
+  // components of equal probability
+  const double capacity = total / nComponents;
+  size_t icmp = 0;
+  Moments moments;
+  auto fill = [&](double m, double z) {
+    while (0 < m) {
+      const double take = (icmp + 1 < nComponents)
+                              ? std::min(m, capacity - moments.w)
+                              : m;
+      moments.add(take, z);
+      m -= take;
+      // allow for rounding when the component is exactly filled
+      if (icmp + 1 < nComponents and capacity <= moments.w * (1 + 1e-12)) {
+        const double mean = moments.wz / moments.w;
+        mixture[icmp].weight = weight;
+        mixture[icmp].mean = mean;
+        mixture[icmp].variance =
+            std::max(0., moments.wz2 / moments.w - mean * mean);
+        moments = Moments();
+        ++icmp;
+      }
+    }
+  };
+  fill(head, 1.);
+  for (size_t i = 0; i < kIntegrationPoints; ++i) {
+    auto [m, z] = density(i);
+    fill(m, z);
+  }
+  // The last component takes the remaining tail
+  const double mean = (0 < moments.w) ? moments.wz / moments.w : 0.;
+  mixture[icmp].weight = weight;
+  mixture[icmp].mean = mean;
+  mixture[icmp].variance =
+      (0 < moments.w) ? std::max(0., moments.wz2 / moments.w - mean * mean)
+                      : 0.;
+}
@@ -0,0 +1,457 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Acts/Material/BinaryMaterialMap.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include "Acts/Material/BinnedSurfaceMaterial.hpp"
+#include "Acts/Material/HomogeneousSurfaceMaterial.hpp"
+#include "Acts/Material/HomogeneousVolumeMaterial.hpp"
+#include "Acts/Material/ProtoSurfaceMaterial.hpp"
+#include "Acts/Utilities/BinUtility.hpp"
+#include "Acts/Utilities/detail/MappedFile.hpp"
+
+namespace Acts {
+namespace BinaryMaterialMap {
+namespace {
+
+/// Records start at multiples of this
+constexpr size_t kRecordAlignment = 8;
+
+/// @brief Growing byte buffer for the encoding of one record
+class Buffer {
+ public:
+  template <typename T>
+  void put(T value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    m_bytes.insert(m_bytes.end(), bytes, bytes + sizeof(T));
+  }
+
+  void put(const MaterialProperties& mp) {
+    const Material& mat = mp.material();
+    put(mat.X0());
+    put(mat.L0());
+    put(mat.Ar());
+    put(mat.Z());
+    put(mat.massDensity());
+    put(mp.thickness());
+  }
+
+  void put(const BinUtility& bu) {
+    const auto& bData = bu.binningData();
+    put<uint32_t>(bData.size());
+    const auto transform = bu.transform();
+    put<uint32_t>(transform != nullptr);
+    if (transform) {
+      for (Eigen::Index i = 0; i < 16; ++i) {
+        put<double>(transform->matrix().data()[i]);
+      }
+    }
+    for (const auto& bd : bData) {
+      if (bd.subBinningData) {
+        throw std::invalid_argument(
+            "BinaryMaterialMap: binning sub structure is not supported");
+      }
+      put<uint32_t>(bd.type);
+      put<uint32_t>(bd.option);
+      put<uint32_t>(bd.binvalue);
+      if (bd.type == equidistant) {
+        put<uint64_t>(bd.bins());
+        put(bd.min);
+        put(bd.max);
+      } else {
+        const auto& boundaries = bd.boundaries();
+        put<uint64_t>(boundaries.size());
+        for (float b : boundaries) {
+          put(b);
+        }
+      }
+    }
+  }
+
+  const std::vector<char>& bytes() const { return m_bytes; }
+
+ private:
+  std::vector<char> m_bytes;
+};
+
+/// @brief Bounds-checked reader of one record
+class Stream {
+ public:
+  Stream(const char* begin, size_t size, const std::string& path)
+      : m_pos(begin), m_end(begin + size), m_path(path) {}
+
+  template <typename T>
+  T get() {
+    require(sizeof(T));
+    T value;
+    std::memcpy(&value, m_pos, sizeof(T));
+    m_pos += sizeof(T);
+    return value;
+  }
+
+  /// Ensure that n more elements of the given size can be read
+  void require(uint64_t n, uint64_t size = 1) const {
+    if (n > static_cast<uint64_t>(m_end - m_pos) / size) {
+      throw std::runtime_error("BinaryMaterialMap: truncated record in " +
+                               m_path);
+    }
+  }
+
+  MaterialProperties getMaterialProperties() {
+    const float X0 = get<float>();
+    const float L0 = get<float>();
+    const float Ar = get<float>();
+    const float Z = get<float>();
+    const float rho = get<float>();
+    const float thickness = get<float>();
+    return MaterialProperties(X0, L0, Ar, Z, rho, thickness);
+  }
+
+  BinUtility getBinUtility() {
+    const uint32_t nDims = get<uint32_t>();
+    if (nDims == 0 or nDims > 3) {
+      throw std::runtime_error("BinaryMaterialMap: invalid binning in " +
+                               m_path);
+    }
+    std::shared_ptr<const Transform3D> transform = nullptr;
+    if (get<uint32_t>() != 0) {
+      auto tf = std::make_shared<Transform3D>();
+      for (Eigen::Index i = 0; i < 16; ++i) {
+        tf->matrix().data()[i] = get<double>();
+      }
+      transform = std::move(tf);
+    }
+    BinUtility bu;
+    for (uint32_t idim = 0; idim < nDims; ++idim) {
+      const uint32_t type = get<uint32_t>();
+      const auto option = static_cast<BinningOption>(get<uint32_t>());
+      const auto value = static_cast<BinningValue>(get<uint32_t>());
+      const uint64_t n = get<uint64_t>();
+      if (type == equidistant) {
+        const float min = get<float>();
+        const float max = get<float>();
+        if (n == 0) {
+          throw std::runtime_error("BinaryMaterialMap: invalid binning in " +
+                                   m_path);
+        }
+        bu += BinUtility(BinningData(option, value, n, min, max),
+                         idim == 0 ? transform : nullptr);
+      } else {
+        require(n, sizeof(float));
+        if (n < 2) {
+          throw std::runtime_error("BinaryMaterialMap: invalid binning in " +
+                                   m_path);
+        }
+        std::vector<float> boundaries(n);
+        for (auto& b : boundaries) {
+          b = get<float>();
+        }
+        bu += BinUtility(BinningData(option, value, boundaries),
+                         idim == 0 ? transform : nullptr);
+      }
+    }
+    return bu;
+  }
+
+ private:
+  const char* m_pos;
+  const char* m_end;
+  const std::string& m_path;
+};
+
+/// Encode a surface material object
+RecordType encode(const ISurfaceMaterial& material, Buffer& buffer) {
+  const double splitFactor = material.factor(forward, postUpdate);
+  if (auto hsm = dynamic_cast<const HomogeneousSurfaceMaterial*>(&material)) {
+    buffer.put(splitFactor);
+    buffer.put(hsm->materialProperties(Vector2D(0., 0.)));
+    return RecordType::HomogeneousSurface;
+  }
+  if (auto bsm = dynamic_cast<const BinnedSurfaceMaterial*>(&material)) {
+    buffer.put(splitFactor);
+    buffer.put(bsm->binUtility());
+    const auto& matrix = bsm->fullMaterial();
+    const uint64_t nRows = matrix.size();
+    const uint64_t nCols = nRows == 0 ? 0 : matrix.front().size();
+    buffer.put(nRows);
+    buffer.put(nCols);
+    for (const auto& row : matrix) {
+      if (row.size() != nCols) {
+        throw std::invalid_argument(
+            "BinaryMaterialMap: binned material is not rectangular");
+      }
+      for (const auto& mp : row) {
+        buffer.put(mp);
+      }
+    }
+    return RecordType::BinnedSurface;
+  }
+  if (auto psm = dynamic_cast<const ProtoSurfaceMaterial*>(&material)) {
+    buffer.put(psm->binUtility());
+    return RecordType::ProtoSurface;
+  }
+  throw std::invalid_argument(
+      "BinaryMaterialMap: unsupported surface material type");
+}
+
+/// Encode a volume material object
+RecordType encode(const IVolumeMaterial& material, Buffer& buffer) {
+  if (auto hvm = dynamic_cast<const HomogeneousVolumeMaterial*>(&material)) {
+    const Material& mat = hvm->material(Vector3D(0., 0., 0.));
+    buffer.put(mat.X0());
+    buffer.put(mat.L0());
+    buffer.put(mat.Ar());
+    buffer.put(mat.Z());
+    buffer.put(mat.massDensity());
+    return RecordType::HomogeneousVolume;
+  }
+  throw std::invalid_argument(
+      "BinaryMaterialMap: unsupported volume material type");
+}
+
+/// Find the first index entry in [begin, end) not smaller than geoID
+const IndexEntry* lowerBound(const IndexEntry* begin, const IndexEntry* end,
+                             GeometryID::Value geoID) {
+  return std::lower_bound(begin, end, geoID,
+                          [](const IndexEntry& entry, GeometryID::Value id) {
+                            return entry.geoID < id;
+                          });
+}
+
+}  // namespace
+}  // namespace BinaryMaterialMap
+}  // namespace Acts
+
+void Acts::BinaryMaterialMap::write(const std::string& path,
+                                    const DetectorMaterialMaps& maps) {
+  std::vector<IndexEntry> index;
+  index.reserve(maps.first.size() + maps.second.size());
+  std::vector<char> records;
+
+  // std::map iterates in GeometryID order, the index is hence sorted
+  const auto append = [&](GeometryID geoID, bool isVolume, RecordType type,
+                          const Buffer& buffer) {
+    IndexEntry entry;
+    entry.geoID = geoID.value();
+    entry.isVolume = isVolume;
+    entry.type = static_cast<uint32_t>(type);
+    entry.offset = sizeof(Header) + records.size();
+    entry.size = buffer.bytes().size();
+    index.push_back(entry);
+    records.insert(records.end(), buffer.bytes().begin(),
+                   buffer.bytes().end());
+    records.resize((records.size() + kRecordAlignment - 1) /
+                   kRecordAlignment * kRecordAlignment);
+  };
+  for (const auto& [geoID, material] : maps.first) {
+    Buffer buffer;
+    const RecordType type = encode(*material, buffer);
+    append(geoID, false, type, buffer);
+  }
+  for (const auto& [geoID, material] : maps.second) {
+    Buffer buffer;
+    const RecordType type = encode(*material, buffer);
+    append(geoID, true, type, buffer);
+  }
+
+  Header header;
+  std::memcpy(header.magic, Header::kMagic, sizeof(header.magic));
+  header.nEntries = index.size();
+  header.indexOffset = sizeof(Header) + records.size();
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.write(records.data(), records.size());
+  out.write(reinterpret_cast<const char*>(index.data()),
+            index.size() * sizeof(IndexEntry));
+  out.close();
+  if (not out) {
+    throw std::runtime_error("BinaryMaterialMap: could not write " + path);
+  }
+}
+
+Acts::BinaryMaterialMap::Reader::Reader(const std::string& path)
+    : m_path(path) {
+  auto file = detail::mapFile(path);
+  const auto invalid = [&](const std::string& reason) {
+    return std::runtime_error("BinaryMaterialMap: " + path + " " + reason);
+  };
+  if (file.size < sizeof(Header)) {
+    throw invalid("is too small");
+  }
+  Header header;
+  std::memcpy(&header, file.data, sizeof(Header));
+  if (std::memcmp(header.magic, Header::kMagic, sizeof(header.magic)) != 0) {
+    throw invalid("is not a material map");
+  }
+  if (header.byteOrderMark != Header::kByteOrderMark) {
+    throw invalid("has a foreign byte order");
+  }
+  if (header.version != Header::kVersion) {
+    throw invalid("has unsupported version " +
+                  std::to_string(header.version));
+  }
+  if (header.indexOffset < sizeof(Header) or
+      header.indexOffset > file.size or
+      header.indexOffset % alignof(IndexEntry) != 0 or
+      header.nEntries > (file.size - header.indexOffset) / sizeof(IndexEntry)) {
+    throw invalid("has an invalid index");
+  }
+
+  m_mapping = std::move(file.mapping);
+  m_data = file.data;
+  m_index = reinterpret_cast<const IndexEntry*>(m_data + header.indexOffset);
+  m_nEntries = header.nEntries;
+  for (size_t i = 0; i < m_nEntries; ++i) {
+    const IndexEntry& entry = m_index[i];
+    if (entry.offset < sizeof(Header) or entry.offset > header.indexOffset or
+        entry.size > header.indexOffset - entry.offset) {
+      throw invalid("has an invalid index");
+    }
+    if (entry.isVolume == 0) {
+      if (m_nSurfaces != i) {
+        throw invalid("has an unsorted index");
+      }
+      ++m_nSurfaces;
+    }
+    const bool sameRange =
+        i > 0 and m_index[i - 1].isVolume == entry.isVolume;
+    if (sameRange and m_index[i - 1].geoID >= entry.geoID) {
+      throw invalid("has an unsorted index");
+    }
+  }
+}
+
+std::shared_ptr<const Acts::ISurfaceMaterial>
+Acts::BinaryMaterialMap::Reader::surfaceMaterial(GeometryID geoID) const {
+  const IndexEntry* end = m_index + m_nSurfaces;
+  const IndexEntry* it = lowerBound(m_index, end, geoID.value());
+  if (it == end or it->geoID != geoID.value()) {
+    return nullptr;
+  }
+  return decodeSurface(*it);
+}
+
+std::shared_ptr<const Acts::IVolumeMaterial>
+Acts::BinaryMaterialMap::Reader::volumeMaterial(GeometryID geoID) const {
+  const IndexEntry* end = m_index + m_nEntries;
+  const IndexEntry* it =
+      lowerBound(m_index + m_nSurfaces, end, geoID.value());
+  if (it == end or it->geoID != geoID.value()) {
+    return nullptr;
+  }
+  return decodeVolume(*it);
+}
+
+Acts::BinaryMaterialMap::DetectorMaterialMaps
+Acts::BinaryMaterialMap::Reader::readVolume(GeometryID::Value volume) const {
+  // the volume occupies the most significant bits of the GeometryID, all
+  // identifiers of one volume therefore form a contiguous range
+  const GeometryID first = GeometryID().setVolume(volume);
+  const auto volumeRange = [&](const IndexEntry* begin,
+                               const IndexEntry* end) {
+    const IndexEntry* lo = lowerBound(begin, end, first.value());
+    const IndexEntry* hi = lo;
+    while (hi != end and GeometryID(hi->geoID).volume() == volume) {
+      ++hi;
+    }
+    return std::make_pair(lo, hi);
+  };
+
+  const auto [sBegin, sEnd] = volumeRange(m_index, m_index + m_nSurfaces);
+  const auto [vBegin, vEnd] =
+      volumeRange(m_index + m_nSurfaces, m_index + m_nEntries);
+  DetectorMaterialMaps maps = decodeRange(sBegin, sEnd);
+  maps.second = decodeRange(vBegin, vEnd).second;
+  return maps;
+}
+
+Acts::BinaryMaterialMap::DetectorMaterialMaps
+Acts::BinaryMaterialMap::Reader::read() const {
+  return decodeRange(m_index, m_index + m_nEntries);
+}
+
+Acts::BinaryMaterialMap::DetectorMaterialMaps
+Acts::BinaryMaterialMap::Reader::decodeRange(const IndexEntry* begin,
+                                             const IndexEntry* end) const {
+  DetectorMaterialMaps maps;
+  for (const IndexEntry* it = begin; it != end; ++it) {
+    if (it->isVolume == 0) {
+      maps.first.emplace_hint(maps.first.end(), GeometryID(it->geoID),
+                              decodeSurface(*it));
+    } else {
+      maps.second.emplace_hint(maps.second.end(), GeometryID(it->geoID),
+                               decodeVolume(*it));
+    }
+  }
+  return maps;
+}
+
+std::shared_ptr<const Acts::ISurfaceMaterial>
+Acts::BinaryMaterialMap::Reader::decodeSurface(const IndexEntry& entry) const {
+  Stream stream(m_data + entry.offset, entry.size, m_path);
+  switch (static_cast<RecordType>(entry.type)) {
+    case RecordType::HomogeneousSurface: {
+      const double splitFactor = stream.get<double>();
+      return std::make_shared<const HomogeneousSurfaceMaterial>(
+          stream.getMaterialProperties(), splitFactor);
+    }
+    case RecordType::BinnedSurface: {
+      const double splitFactor = stream.get<double>();
+      BinUtility bu = stream.getBinUtility();
+      const uint64_t nRows = stream.get<uint64_t>();
+      const uint64_t nCols = stream.get<uint64_t>();
+      // 6 floats per material properties
+      constexpr uint64_t mpSize = 6 * sizeof(float);
+      if (nCols != 0) {
+        stream.require(nRows, mpSize);
+        stream.require(nCols, nRows * mpSize);
+      }
+      MaterialPropertiesMatrix matrix(nRows);
+      for (auto& row : matrix) {
+        row.reserve(nCols);
+        for (uint64_t icol = 0; icol < nCols; ++icol) {
+          row.push_back(stream.getMaterialProperties());
+        }
+      }
+      return std::make_shared<const BinnedSurfaceMaterial>(
+          bu, std::move(matrix), splitFactor);
+    }
+    case RecordType::ProtoSurface:
+      return std::make_shared<const ProtoSurfaceMaterial>(
+          stream.getBinUtility());
+    default:
+      throw std::runtime_error(
+          "BinaryMaterialMap: unknown surface record type in " + m_path);
+  }
+}
+
+std::shared_ptr<const Acts::IVolumeMaterial>
+Acts::BinaryMaterialMap::Reader::decodeVolume(const IndexEntry& entry) const {
+  Stream stream(m_data + entry.offset, entry.size, m_path);
+  switch (static_cast<RecordType>(entry.type)) {
+    case RecordType::HomogeneousVolume: {
+      const float X0 = stream.get<float>();
+      const float L0 = stream.get<float>();
+      const float Ar = stream.get<float>();
+      const float Z = stream.get<float>();
+      const float rho = stream.get<float>();
+      return std::make_shared<const HomogeneousVolumeMaterial>(
+          Material(X0, L0, Ar, Z, rho));
+    }
+    default:
+      throw std::runtime_error(
+          "BinaryMaterialMap: unknown volume record type in " + m_path);
+  }
+}
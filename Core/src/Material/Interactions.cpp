@@ -8,9 +8,11 @@
 
 #include "Acts/Material/Interactions.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 
+#include "Acts/Utilities/Definitions.hpp"
 #include "Acts/Utilities/PdgParticle.hpp"
 
 using namespace Acts::UnitLiterals;
@@ -496,3 +498,227 @@ float Acts::computeMultipleScatteringTheta0(const MaterialProperties& slab,
     return theta0Highland(xOverX0, momentumInv, q2OverBeta2);
   }
 }
+
+namespace {
+/// Number of batch entries that are evaluated together.
+constexpr int BlockSize = 32;
+using BlockArray = Eigen::Array<float, BlockSize, 1>;
+using BlockMask = Eigen::Array<bool, BlockSize, 1>;
+
+/// Slab and particle quantities for one block of batch entries.
+///
+/// Unused entries at the end of the last block are filled with benign values
+/// and flagged as invalid such that all computations stay finite.
+struct Block {
+  BlockMask valid;
+  BlockMask electron;
+  BlockArray epsilonFactor;
+  BlockArray logI;
+  BlockArray deltaHalfOffset;
+  BlockArray thicknessInX0;
+  BlockArray rossiGreisenFactor;
+  BlockArray m;
+  BlockArray qOverP;
+  BlockArray q;
+  // relativistic quantities, see RelativisticQuantities
+  BlockArray q2OverBeta2;
+  BlockArray beta2;
+  BlockArray betaGamma;
+  BlockArray gamma;
+
+  Block(const Acts::InteractionSlabTable& table,
+        const Acts::InteractionBatch& batch, size_t begin, size_t count) {
+    for (size_t l = 0; l < BlockSize; ++l) {
+      if (l < count) {
+        const size_t i = begin + l;
+        const size_t s = batch.slab[i];
+        assert((s < table.size()) and "Slab index out of range");
+        assert((0 < batch.mass[i]) and "Mass must be positive");
+        assert((0 < (batch.qOverP[i] * batch.charge[i])) and
+               "Inconsistent q/p and q signs");
+        valid[l] = table.valid[s];
+        electron[l] = (batch.pdg[i] == Acts::PdgParticle::eElectron) or
+                      (batch.pdg[i] == Acts::PdgParticle::ePositron);
+        epsilonFactor[l] = table.epsilonFactor[s];
+        logI[l] = table.logI[s];
+        deltaHalfOffset[l] = table.deltaHalfOffset[s];
+        thicknessInX0[l] = table.thicknessInX0[s];
+        rossiGreisenFactor[l] = table.rossiGreisenFactor[s];
+        m[l] = batch.mass[i];
+        qOverP[l] = batch.qOverP[i];
+        q[l] = batch.charge[i];
+      } else {
+        valid[l] = false;
+        electron[l] = false;
+        epsilonFactor[l] = 1.0f;
+        logI[l] = 0.0f;
+        deltaHalfOffset[l] = 0.0f;
+        thicknessInX0[l] = 1.0f;
+        rossiGreisenFactor[l] = 1.0f;
+        m[l] = 1.0f;
+        qOverP[l] = 1.0f;
+        q[l] = 1.0f;
+      }
+    }
+    q2OverBeta2 = q * q + (m * qOverP).square();
+    const BlockArray mOverP = m * (qOverP / q).abs();
+    const BlockArray pOverM = mOverP.inverse();
+    beta2 = (1.0f + mOverP.square()).inverse();
+    betaGamma = pOverM;
+    gamma = (1.0f + pOverM.square()).sqrt();
+  }
+
+  /// Epsilon energy pre-factor, see computeEpsilon.
+  BlockArray epsilon() const { return epsilonFactor * q2OverBeta2; }
+  /// Density correction delta/2, see computeDeltaHalf.
+  BlockArray deltaHalf() const {
+    return (betaGamma < 10.0f)
+        .select(0.0f, betaGamma.log() + deltaHalfOffset);
+  }
+  /// Derivative of the density correction, see deriveDeltaHalf.
+  BlockArray deriveDeltaHalf() const {
+    return (betaGamma < 10.0f).select(0.0f, -qOverP.inverse());
+  }
+  /// Logarithmic derivative of epsilon, see logDeriveEpsilon.
+  BlockArray logDeriveEpsilon() const {
+    return 2.0f / (qOverP * gamma.square());
+  }
+  /// Derivative of beta², see deriveBeta2.
+  BlockArray deriveBeta2() const { return -2.0f / (qOverP * gamma.square()); }
+  /// Logarithm of the maximum energy transfer, see computeWMax.
+  BlockArray logWMax() const {
+    const BlockArray mfrac = Me / m;
+    const BlockArray nominator = 2 * Me * betaGamma.square();
+    const BlockArray denominator = 1.0f + 2 * gamma * mfrac + mfrac.square();
+    return (nominator / denominator).log();
+  }
+};
+
+/// Evaluate a block kernel over the full batch.
+template <typename kernel_t>
+void evaluateBlocks(const Acts::InteractionSlabTable& table,
+                    const Acts::InteractionBatch& batch,
+                    std::vector<float>& result, kernel_t&& kernel) {
+  const size_t n = batch.size();
+  result.resize(n);
+  for (size_t begin = 0; begin < n; begin += BlockSize) {
+    const size_t count = std::min<size_t>(BlockSize, n - begin);
+    const Block block(table, batch, begin, count);
+    // vacuum or zero thickness does not interact
+    const BlockArray values = block.valid.select(kernel(block), 0.0f);
+    std::copy_n(values.data(), count, result.begin() + begin);
+  }
+}
+}  // namespace
+
+Acts::InteractionSlabTable::InteractionSlabTable(
+    const std::vector<MaterialProperties>& slabs) {
+  epsilonFactor.reserve(slabs.size());
+  logI.reserve(slabs.size());
+  deltaHalfOffset.reserve(slabs.size());
+  thicknessInX0.reserve(slabs.size());
+  rossiGreisenFactor.reserve(slabs.size());
+  valid.reserve(slabs.size());
+  for (const auto& slab : slabs) {
+    add(slab);
+  }
+}
+
+size_t Acts::InteractionSlabTable::add(const MaterialProperties& slab) {
+  if (slab) {
+    const auto I = slab.material().meanExcitationEnergy();
+    const auto Ne = slab.material().molarElectronDensity();
+    const auto plasmaEnergy = PlasmaEnergyScale * std::sqrt(Ne);
+    epsilonFactor.push_back(0.5f * K * Ne * slab.thickness());
+    logI.push_back(std::log(I));
+    deltaHalfOffset.push_back(std::log(plasmaEnergy / I) - 0.5f);
+    thicknessInX0.push_back(slab.thicknessInX0());
+    rossiGreisenFactor.push_back(
+        1.0f + 0.125f * std::log10(10.0f * slab.thicknessInX0()));
+    valid.push_back(true);
+  } else {
+    // benign values that keep the computations finite
+    epsilonFactor.push_back(1.0f);
+    logI.push_back(0.0f);
+    deltaHalfOffset.push_back(0.0f);
+    thicknessInX0.push_back(1.0f);
+    rossiGreisenFactor.push_back(1.0f);
+    valid.push_back(false);
+  }
+  return valid.size() - 1;
+}
+
+void Acts::computeEnergyLossBethe(const InteractionSlabTable& table,
+                                  const InteractionBatch& batch,
+                                  std::vector<float>& energyLoss) {
+  evaluateBlocks(table, batch, energyLoss, [](const Block& b) -> BlockArray {
+    const BlockArray logU = (2 * Me * b.betaGamma.square()).log();
+    const BlockArray running = 0.5f * logU + 0.5f * b.logWMax() - b.logI -
+                               b.beta2 - b.deltaHalf();
+    return b.epsilon() * running;
+  });
+}
+
+void Acts::deriveEnergyLossBetheQOverP(const InteractionSlabTable& table,
+                                       const InteractionBatch& batch,
+                                       std::vector<float>& derivative) {
+  evaluateBlocks(table, batch, derivative, [](const Block& b) -> BlockArray {
+    const BlockArray logU = (2 * Me * b.betaGamma.square()).log();
+    const BlockArray logDerU = -2.0f / b.qOverP;
+    // see logDeriveWMax
+    const BlockArray a = (b.qOverP / b.q2OverBeta2.sqrt()).abs();
+    const BlockArray c = Me * (1.0f + (b.m / Me).square());
+    const BlockArray logDerWmax =
+        -2 * (a * c - 2 + b.beta2) / (b.qOverP * (a * c + 2));
+    const BlockArray rel =
+        b.logDeriveEpsilon() * (0.5f * logU + 0.5f * b.logWMax() - b.logI -
+                                b.beta2 - b.deltaHalf()) +
+        0.5f * logDerU + 0.5f * logDerWmax - b.deriveBeta2() -
+        b.deriveDeltaHalf();
+    return b.epsilon() * rel;
+  });
+}
+
+void Acts::computeEnergyLossLandau(const InteractionSlabTable& table,
+                                   const InteractionBatch& batch,
+                                   std::vector<float>& energyLoss) {
+  evaluateBlocks(table, batch, energyLoss, [](const Block& b) -> BlockArray {
+    const BlockArray eps = b.epsilon();
+    const BlockArray logT = (2 * b.m * b.betaGamma.square()).log();
+    const BlockArray running = logT + eps.log() - 2 * b.logI + 0.2f -
+                               b.beta2 - 2 * b.deltaHalf();
+    return eps * running;
+  });
+}
+
+void Acts::deriveEnergyLossLandauQOverP(const InteractionSlabTable& table,
+                                        const InteractionBatch& batch,
+                                        std::vector<float>& derivative) {
+  evaluateBlocks(table, batch, derivative, [](const Block& b) -> BlockArray {
+    const BlockArray eps = b.epsilon();
+    const BlockArray logT = (2 * b.m * b.betaGamma.square()).log();
+    const BlockArray logDerEps = b.logDeriveEpsilon();
+    const BlockArray logDerT = -2.0f / b.qOverP;
+    // uses the same expansion as the single particle version
+    const BlockArray rel = logDerEps * (logT + eps.log() - 2 * b.logI - 0.2f -
+                                        b.beta2 - 2 * b.deltaHalf()) +
+                           logDerT + logDerEps - b.deriveBeta2() -
+                           2 * b.deriveDeltaHalf();
+    return eps * rel;
+  });
+}
+
+void Acts::computeMultipleScatteringTheta0(const InteractionSlabTable& table,
+                                           const InteractionBatch& batch,
+                                           std::vector<float>& theta0) {
+  evaluateBlocks(table, batch, theta0, [](const Block& b) -> BlockArray {
+    const BlockArray momentumInv = (b.qOverP / b.q).abs();
+    const BlockArray t = (b.thicknessInX0 * b.q2OverBeta2).sqrt();
+    // see theta0RossiGreisen and theta0Highland
+    const BlockArray rossiGreisen =
+        17.5_MeV * momentumInv * t * b.rossiGreisenFactor;
+    const BlockArray highland =
+        13.6_MeV * momentumInv * t * (1.0f + 0.038f * 2 * t.log());
+    return b.electron.select(rossiGreisen, highland);
+  });
+}
@@ -22,6 +22,9 @@
 #include "Acts/Propagator/detail/StandardAborters.hpp"
 #include "Acts/Utilities/BinAdjustment.hpp"
 #include "Acts/Utilities/BinUtility.hpp"
+#include "Acts/Utilities/ParallelFor.hpp"
+
+#include <stdexcept>
 
 Acts::SurfaceMaterialMapper::SurfaceMaterialMapper(
     const Config& cfg, StraightLinePropagator propagator,
@@ -150,6 +153,67 @@ void Acts::SurfaceMaterialMapper::finalizeMaps(State& mState) const {
   }
 }
 
+Acts::SurfaceMaterialMapper::State Acts::SurfaceMaterialMapper::emptyCopy(
+    const State& mState) const {
+  State copy(mState.geoContext, mState.magFieldContext);
+  for (const auto& [geoID, accMaterial] : mState.accumulatedMaterial) {
+    copy.accumulatedMaterial.emplace_hint(
+        copy.accumulatedMaterial.end(), geoID,
+        AccumulatedSurfaceMaterial(accMaterial.binUtility(),
+                                   accMaterial.splitFactor()));
+  }
+  return copy;
+}
+
+void Acts::SurfaceMaterialMapper::mergeState(State& mState,
+                                             const State& other) const {
+  if (mState.accumulatedMaterial.size() != other.accumulatedMaterial.size()) {
+    throw std::invalid_argument(
+        "SurfaceMaterialMapper: states with different surfaces");
+  }
+  // Both maps are sorted by GeometryID, walk them in parallel
+  auto target = mState.accumulatedMaterial.begin();
+  for (const auto& [geoID, accMaterial] : other.accumulatedMaterial) {
+    if (not(target->first == geoID)) {
+      throw std::invalid_argument(
+          "SurfaceMaterialMapper: states with different surfaces");
+    }
+    target->second.merge(accMaterial);
+    ++target;
+  }
+}
+
+void Acts::SurfaceMaterialMapper::mapMaterialTracks(
+    State& mState, std::vector<RecordedMaterialTrack>& mTracks,
+    size_t nThreads) const {
+  const size_t nBlocks = resolveNumberOfThreads(nThreads, mTracks.size());
+  if (nBlocks == 1) {
+    for (auto& mTrack : mTracks) {
+      mapMaterialTrack(mState, mTrack);
+    }
+    return;
+  }
+  ACTS_DEBUG("Mapping " << mTracks.size() << " tracks with " << nBlocks
+                        << " threads.");
+
+  // One state per block, such that the mapping is reproducible
+  std::vector<State> blockStates;
+  blockStates.reserve(nBlocks);
+  for (size_t ib = 0; ib < nBlocks; ++ib) {
+    blockStates.push_back(emptyCopy(mState));
+  }
+  parallelFor(nBlocks, nBlocks, [&](size_t ib, size_t /*threadIndex*/) {
+    const size_t begin = ib * mTracks.size() / nBlocks;
+    const size_t end = (ib + 1) * mTracks.size() / nBlocks;
+    for (size_t it = begin; it < end; ++it) {
+      mapMaterialTrack(blockStates[ib], mTracks[it]);
+    }
+  });
+  for (const auto& blockState : blockStates) {
+    mergeState(mState, blockState);
+  }
+}
+
 void Acts::SurfaceMaterialMapper::mapMaterialTrack(
     State& mState, RecordedMaterialTrack& mTrack) const {
   // Neutral curvilinear parameters
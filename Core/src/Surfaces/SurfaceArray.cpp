@@ -6,16 +6,81 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
+#include <limits>
 #include <utility>
 
+#include "Acts/Geometry/Polyhedron.hpp"
 #include "Acts/Geometry/SurfaceArrayCreator.hpp"
 #include "Acts/Surfaces/SurfaceArray.hpp"
 #include "Acts/Utilities/Definitions.hpp"
+#include "Acts/Utilities/Ray.hpp"
 #include "Acts/Utilities/ThrowAssert.hpp"
 
 // implementation for pure virtual destructor of ISurfaceGridLookup
 Acts::SurfaceArray::ISurfaceGridLookup::~ISurfaceGridLookup() = default;
 
+void Acts::SurfaceArray::SurfaceBVHLookup::fill(
+    const GeometryContext& gctx, const SurfaceVector& surfaces) {
+  m_surfaces = surfaces;
+  m_boxes.clear();
+  m_top = nullptr;
+  if (surfaces.empty()) {
+    return;
+  }
+
+  // the boxes of the surfaces enclose the vertices of their polyhedron
+  // representation, with arcs approximated by 16 segments
+  const Vector3D envelope = Vector3D::Constant(m_envelope);
+  std::vector<BoundingBox*> prims;
+  prims.reserve(surfaces.size());
+  for (const auto& srf : surfaces) {
+    Polyhedron ph = srf->polyhedronRepresentation(gctx, 16);
+    Vector3D vmin = Vector3D::Constant(std::numeric_limits<double>::max());
+    Vector3D vmax = Vector3D::Constant(std::numeric_limits<double>::lowest());
+    for (const auto& vtx : ph.vertices) {
+      vmin = vmin.cwiseMin(vtx);
+      vmax = vmax.cwiseMax(vtx);
+    }
+    m_boxes.push_back(
+        std::make_unique<BoundingBox>(srf, vmin - envelope, vmax + envelope));
+    prims.push_back(m_boxes.back().get());
+  }
+
+  m_top = make_octree(m_boxes, prims, m_maxDepth);
+}
+
+Acts::SurfaceVector Acts::SurfaceArray::SurfaceBVHLookup::candidates(
+    const Vector3D& position, const Vector3D& direction) const {
+  // a vanishing direction does not define a ray, every surface is a
+  // candidate then
+  if (direction.isZero()) {
+    return m_surfaces;
+  }
+
+  SurfaceVector hits;
+  const BoundingBox* node = m_top;
+  if (node == nullptr) {
+    return hits;
+  }
+
+  // walk the hierarchy: descend into crossed boxes, skip the others
+  Ray3D ray(position, direction);
+  do {
+    if (node->intersect(ray)) {
+      if (node->hasEntity()) {
+        hits.push_back(node->entity());
+        node = node->getSkip();
+      } else {
+        node = node->getLeftChild();
+      }
+    } else {
+      node = node->getSkip();
+    }
+  } while (node != nullptr);
+
+  return hits;
+}
+
 Acts::SurfaceArray::SurfaceArray(
     std::unique_ptr<ISurfaceGridLookup> gridLookup,
     std::vector<std::shared_ptr<const Surface>> surfaces,
@@ -0,0 +1,44 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Acts/Utilities/detail/MappedFile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <stdexcept>
+
+Acts::detail::MappedFile Acts::detail::mapFile(const std::string& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Could not open " + path);
+  }
+  struct stat status;
+  if (::fstat(fd, &status) != 0 or status.st_size <= 0) {
+    ::close(fd);
+    throw std::runtime_error("Could not map empty file " + path);
+  }
+  const size_t size = status.st_size;
+  void* address = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  // the mapping stays valid after closing the file
+  ::close(fd);
+  if (address == MAP_FAILED) {
+    throw std::runtime_error("Could not map " + path);
+  }
+
+  MappedFile file;
+  file.mapping = std::shared_ptr<const void>(
+      address, [size](const void* mapped) {
+        ::munmap(const_cast<void*>(mapped), size);
+      });
+  file.data = static_cast<const char*>(address);
+  file.size = size;
+  return file;
+}
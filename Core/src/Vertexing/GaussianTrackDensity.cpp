@@ -15,20 +15,28 @@ double Acts::GaussianTrackDensity::globalMaximum(
 }
 
 std::pair<double, double> Acts::GaussianTrackDensity::globalMaximumWithWidth(
-    const std::vector<Acts::BoundParameters>& trackList, State& state) const {
-  addTracks(trackList, state);
+    const std::vector<Acts::BoundParameters>& trackList, State& state,
+    const std::vector<const void*>& trackIds) const {
+  addTracks(trackList, state, trackIds);
   return state.trackDensity.globalMaximumWithWidth(state.trackDensityState);
 }
 
 void Acts::GaussianTrackDensity::addTracks(
-    const std::vector<Acts::BoundParameters>& trackList, State& state) const {
+    const std::vector<Acts::BoundParameters>& trackList, State& state,
+    const std::vector<const void*>& trackIds) const {
   const double d0SignificanceCut =
       m_cfg.d0MaxSignificance * m_cfg.d0MaxSignificance;
   const double z0SignificanceCut =
       m_cfg.z0MaxSignificance * m_cfg.z0MaxSignificance;
 
-  for (const auto& trk : trackList) {
-    state.trackDensity.addTrack(state.trackDensityState, trk, d0SignificanceCut,
-                                z0SignificanceCut);
+  for (size_t i = 0; i < trackList.size(); ++i) {
+    state.trackDensity.addTrack(
+        state.trackDensityState, trackList[i], d0SignificanceCut,
+        z0SignificanceCut, trackIds.empty() ? nullptr : trackIds[i]);
   }
-}
\ No newline at end of file
+}
+
+void Acts::GaussianTrackDensity::removeTracks(
+    const std::vector<const void*>& trackIds, State& state) const {
+  state.trackDensity.removeTracks(state.trackDensityState, trackIds);
+}
@@ -8,13 +8,12 @@
 
 #include "Acts/Vertexing/TrackDensity.hpp"
 #include <math.h>
+#include <algorithm>
 
 void Acts::TrackDensity::addTrack(State& state, const BoundParameters& trk,
                                   const double d0SignificanceCut,
-                                  const double z0SignificanceCut) const {
-  if (state.trackSet.count(trk) != 0) {
-    return;
-  }
+                                  const double z0SignificanceCut,
+                                  const void* trackId) const {
   // Get required track parameters
   const double d0 = trk.parameters()[ParID_t::eLOC_D0];
   const double z0 = trk.parameters()[ParID_t::eLOC_Z0];
@@ -52,15 +51,50 @@ void Acts::TrackDensity::addTrack(State& state, const BoundParameters& trk,
   const double zMin = (-linearTerm + discriminant) / (2 * quadraticTerm);
   state.maxZRange = std::max(state.maxZRange, std::max(zMax - z0, z0 - zMin));
   constantTerm -= std::log(2 * M_PI * std::sqrt(covDeterminant));
-  state.trackSet.emplace(trk);
-  state.lowerMap.emplace(std::piecewise_construct,
-                         std::forward_as_tuple(constantTerm, linearTerm,
-                                               quadraticTerm, zMin, zMax),
-                         std::forward_as_tuple(trk));
-  state.upperMap.emplace(std::piecewise_construct,
-                         std::forward_as_tuple(constantTerm, linearTerm,
-                                               quadraticTerm, zMin, zMax),
-                         std::forward_as_tuple(trk));
+  state.trackEntries.emplace_back(z0, constantTerm, linearTerm, quadraticTerm,
+                                  zMin, zMax, trackId);
+  state.isSorted = false;
+}
+
+void Acts::TrackDensity::removeTracks(
+    State& state, const std::vector<const void*>& trackIds) const {
+  std::vector<const void*> sortedIds(trackIds);
+  std::sort(sortedIds.begin(), sortedIds.end());
+  // Removing keeps the order of the remaining entries
+  auto& entries = state.trackEntries;
+  entries.erase(std::remove_if(entries.begin(), entries.end(),
+                               [&](const TrackEntry& entry) {
+                                 return entry.id != nullptr &&
+                                        std::binary_search(sortedIds.begin(),
+                                                           sortedIds.end(),
+                                                           entry.id);
+                               }),
+                entries.end());
+}
+
+void Acts::TrackDensity::sortTracks(State& state) const {
+  if (state.isSorted) {
+    return;
+  }
+  // Stable sorting keeps tracks with equal z0 in the order they were added
+  std::stable_sort(state.trackEntries.begin(), state.trackEntries.end(),
+                   [](const TrackEntry& left, const TrackEntry& right) {
+                     return left.z < right.z;
+                   });
+  state.isSorted = true;
+}
+
+std::pair<size_t, size_t> Acts::TrackDensity::overlapRange(const State& state,
+                                                           double z) const {
+  // A track can only overlap z if its z0 is within maxZRange
+  const auto& entries = state.trackEntries;
+  auto begin = std::lower_bound(
+      entries.begin(), entries.end(), z - state.maxZRange,
+      [](const TrackEntry& entry, double value) { return entry.z < value; });
+  auto end = std::upper_bound(
+      begin, entries.end(), z + state.maxZRange,
+      [](double value, const TrackEntry& entry) { return value < entry.z; });
+  return {begin - entries.begin(), end - entries.begin()};
 }
 
 std::pair<double, double> Acts::TrackDensity::globalMaximumWithWidth(
@@ -69,12 +103,25 @@ std::pair<double, double> Acts::TrackDensity::globalMaximumWithWidth(
   double maximumDensity = 0.;
   double maxCurvature = 0.;
 
-  for (const auto& entry : state.trackSet) {
-    double trialZ = entry.parameters()[ParID_t::eLOC_Z0];
-    double density = 0.;
+  sortTracks(state);
+  const auto& entries = state.trackEntries;
+  // The track positions are visited in increasing order, such that the
+  // range of tracks overlapping them can be swept along
+  size_t begin = 0;
+  size_t end = 0;
+  for (const auto& entry : entries) {
+    double trialZ = entry.z;
+    while (begin < entries.size() &&
+           entries[begin].z < trialZ - state.maxZRange) {
+      ++begin;
+    }
+    while (end < entries.size() && entries[end].z <= trialZ + state.maxZRange) {
+      ++end;
+    }
     double slope = 0.;
     double curvature = 0.;
-    density = trackDensity(state, trialZ, slope, curvature);
+    double density =
+        trackDensity(state, trialZ, begin, end, slope, curvature);
     if (curvature >= 0. || density <= 0.) {
       continue;
     }
@@ -105,98 +152,40 @@ double Acts::TrackDensity::globalMaximum(State& state) const {
 }
 
 double Acts::TrackDensity::trackDensity(State& state, double z) const {
-  double sum = 0.;
-
-  TrackEntry target(z);
-  TrackMap overlaps;
-  LowerMap::const_iterator left = state.lowerMap.lower_bound(
-      target);  // first track whose UPPER bound is not less than z
-  if (left == state.lowerMap.end()) {
-    // z is to the right of every track's range
-    return sum;
-  }
-
-  UpperMap::const_iterator right = state.upperMap.upper_bound(
-      target);  // first track whose LOWER bound is greater than z
-  if (right == state.upperMap.begin()) {
-    // z is to the left of every track's range
-    return sum;
-  }
-
-  for (auto itrk = left; itrk != state.lowerMap.end(); itrk++) {
-    if (itrk->first.upperBound > z + state.maxZRange) {
-      break;
-    }
-    if (z >= itrk->first.lowerBound && z <= itrk->first.upperBound) {
-      overlaps[itrk->second] = itrk->first;
-    }
-  }
-  for (auto itrk = right; itrk-- != state.upperMap.begin();) {
-    if (itrk->first.lowerBound < z - state.maxZRange) {
-      break;
-    }
-    if (z >= itrk->first.lowerBound && z <= itrk->first.upperBound) {
-      overlaps[itrk->second] = itrk->first;
-    }
-  }
-  for (const auto& entry : overlaps) {
-    sum +=
-        std::exp(entry.second.c0 + z * (entry.second.c1 + z * entry.second.c2));
-  }
-  return sum;
+  double firstDerivative = 0.;
+  double secondDerivative = 0.;
+  return trackDensity(state, z, firstDerivative, secondDerivative);
 }
 
 double Acts::TrackDensity::trackDensity(State& state, double z,
                                         double& firstDerivative,
                                         double& secondDerivative) const {
+  sortTracks(state);
+  auto [begin, end] = overlapRange(state, z);
+  return trackDensity(state, z, begin, end, firstDerivative,
+                      secondDerivative);
+}
+
+double Acts::TrackDensity::trackDensity(const State& state, double z,
+                                        size_t begin, size_t end,
+                                        double& firstDerivative,
+                                        double& secondDerivative) const {
   double density = 0.;
   firstDerivative = 0.;
   secondDerivative = 0.;
-  TrackEntry target(z);
-  TrackMap overlaps;
-
-  LowerMap::const_iterator left = state.lowerMap.lower_bound(
-      target);  // first track whose UPPER bound is not less than z
-  if (left == state.lowerMap.end()) {
-    // z is to the right of every track's range
-    return density;
-  }
-
-  UpperMap::const_iterator right = state.upperMap.upper_bound(
-      target);  // first track whose LOWER bound is greater than z
-  if (right == state.upperMap.begin()) {
-    // z is to the left of every track's range
-    return density;
-  }
-
-  for (auto itrk = left; itrk != state.lowerMap.end(); itrk++) {
-    if (itrk->first.upperBound > z + state.maxZRange) {
-      break;
-    }
-    if (z >= itrk->first.lowerBound && z <= itrk->first.upperBound) {
-      overlaps[itrk->second] = itrk->first;
-    }
-  }
-  for (auto itrk = right; itrk-- != state.upperMap.begin();) {
-    if (itrk->first.lowerBound < z - state.maxZRange) {
-      break;
-    }
-    if (z >= itrk->first.lowerBound && z <= itrk->first.upperBound) {
-      overlaps[itrk->second] = itrk->first;
-    }
-  }
 
-  for (const auto& entry : overlaps) {
-    if (entry.second.lowerBound > z || entry.second.upperBound < z) {
+  // Contiguous loop over the candidates in order of their z0
+  for (size_t i = begin; i < end; ++i) {
+    const TrackEntry& entry = state.trackEntries[i];
+    if (entry.lowerBound > z || entry.upperBound < z) {
       continue;
     }
-    double delta =
-        std::exp(entry.second.c0 + z * (entry.second.c1 + z * entry.second.c2));
+    double delta = std::exp(entry.c0 + z * (entry.c1 + z * entry.c2));
     density += delta;
-    double qPrime = entry.second.c1 + 2 * z * entry.second.c2;
+    double qPrime = entry.c1 + 2 * z * entry.c2;
     double deltaPrime = delta * qPrime;
     firstDerivative += deltaPrime;
-    secondDerivative += 2 * entry.second.c2 * delta + qPrime * deltaPrime;
+    secondDerivative += 2 * entry.c2 * delta + qPrime * deltaPrime;
   }
 
   return density;
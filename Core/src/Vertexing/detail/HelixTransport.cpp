@@ -0,0 +1,261 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Acts/Vertexing/detail/HelixTransport.hpp"
+
+#include <cmath>
+
+#include "Acts/Utilities/detail/periodic.hpp"
+#include "Acts/Vertexing/VertexingError.hpp"
+
+namespace {
+
+using namespace Acts;
+
+/// @brief Helix of a track in a uniform magnetic field along z
+///
+/// Points on the helix are parametrised by the change psi of the transverse
+/// momentum direction with respect to the initial perigee parameters.
+struct Helix {
+  Helix(const GeometryContext& gctx, const BoundParameters& params,
+        double bZ, double mass)
+      : refPoint(params.referenceSurface().center(gctx)) {
+    const auto& par = params.parameters();
+    d0 = par[ParID_t::eLOC_D0];
+    z0 = par[ParID_t::eLOC_Z0];
+    phi = par[ParID_t::ePHI];
+    theta = par[ParID_t::eTHETA];
+    qOverP = par[ParID_t::eQOP];
+    time = par[ParID_t::eT];
+    qOverPBz = qOverP * bZ;
+    // signed(!) transverse radius
+    rho = std::sin(theta) / qOverPBz;
+    cotTheta = 1. / std::tan(theta);
+    // Time derivative with respect to the path length and its derivative
+    // with respect to q/p
+    const double massOverCharge = mass / params.charge();
+    timePerLength = std::hypot(1., massOverCharge * qOverP);
+    timePerLengthDerivative =
+        massOverCharge * massOverCharge * qOverP / timePerLength;
+  }
+
+  /// Center of the circle in the transverse plane
+  Vector2D center() const {
+    return Vector2D(refPoint.x() + (rho - d0) * std::sin(phi),
+                    refPoint.y() - (rho - d0) * std::cos(phi));
+  }
+
+  /// Position on the helix
+  Vector3D position(double psi) const {
+    const Vector2D c = center();
+    return Vector3D(c.x() - rho * std::sin(phi + psi),
+                    c.y() + rho * std::cos(phi + psi),
+                    refPoint.z() + z0 - rho * cotTheta * psi);
+  }
+
+  /// Derivative of the position with respect to psi
+  Vector3D positionDerivative(double psi) const {
+    return rho *
+           Vector3D(-std::cos(phi + psi), -std::sin(phi + psi), -cotTheta);
+  }
+
+  /// Derivatives of the position with respect to the initial parameters
+  /// at fixed psi
+  ActsMatrixD<3, eBoundParametersSize> positionJacobian(double psi) const {
+    const double sinPhi = std::sin(phi);
+    const double cosPhi = std::cos(phi);
+    const double sinPhiPsi = std::sin(phi + psi);
+    const double cosPhiPsi = std::cos(phi + psi);
+    // Derivative with respect to rho
+    const Vector3D rhoDerivative(sinPhi - sinPhiPsi, cosPhiPsi - cosPhi, 0.);
+
+    ActsMatrixD<3, eBoundParametersSize> jac;
+    jac.setZero();
+    jac.col(ParID_t::eLOC_D0) << -sinPhi, cosPhi, 0.;
+    jac.col(ParID_t::eLOC_Z0) << 0., 0., 1.;
+    jac.col(ParID_t::ePHI) << (rho - d0) * cosPhi - rho * cosPhiPsi,
+        (rho - d0) * sinPhi - rho * sinPhiPsi, 0.;
+    jac.col(ParID_t::eTHETA) =
+        rhoDerivative * rho * cotTheta + Vector3D(0., 0., rho * psi);
+    jac.col(ParID_t::eQOP) = rhoDerivative * (-rho / qOverP) +
+                             Vector3D(0., 0., rho * cotTheta * psi / qOverP);
+    return jac;
+  }
+
+  Vector3D refPoint;
+  double d0 = 0.;
+  double z0 = 0.;
+  double phi = 0.;
+  double theta = 0.;
+  double qOverP = 0.;
+  double time = 0.;
+  double qOverPBz = 0.;
+  double rho = 0.;
+  double cotTheta = 0.;
+  double timePerLength = 1.;
+  double timePerLengthDerivative = 0.;
+};
+
+/// @brief Creates the parameters at a point on the helix
+///
+/// The point is defined by a condition f(position, phi) = 0 of the target
+/// surface, which determines the change of psi with the initial parameters.
+///
+/// @param gctx The geometry context
+/// @param params The initial track parameters
+/// @param helix The helix of the track
+/// @param psi The helix parameter at the target point
+/// @param gradient Derivative of the condition with respect to the position
+/// @param phiTerm Derivative of the condition with respect to phi
+/// @param localAxes The local axes of the target surface
+/// @param surface The target surface
+///
+/// @return The parameters bound to the target surface
+Result<BoundParameters> makeParameters(
+    const GeometryContext& gctx, const BoundParameters& params,
+    const Helix& helix, double psi, const Vector3D& gradient, double phiTerm,
+    const ActsMatrixD<2, 3>& localAxes,
+    std::shared_ptr<const Surface> surface) {
+  const Vector3D position = helix.position(psi);
+  const Vector3D positionDerivative = helix.positionDerivative(psi);
+  const ActsMatrixD<3, eBoundParametersSize> positionJacobian =
+      helix.positionJacobian(psi);
+
+  // Derivatives of psi from the implicit surface condition
+  const double conditionDerivative = gradient.dot(positionDerivative) + phiTerm;
+  if (conditionDerivative == 0.) {
+    return VertexingError::NumericFailure;
+  }
+  ActsRowVectorD<eBoundParametersSize> psiJacobian =
+      gradient.transpose() * positionJacobian;
+  psiJacobian(ParID_t::ePHI) += phiTerm;
+  psiJacobian *= -1. / conditionDerivative;
+
+  // Path length and time along the helix
+  const double pathLength = -psi / helix.qOverPBz;
+  const double pathLengthDerivative = -1. / helix.qOverPBz;
+
+  BoundVector parameters;
+  parameters.head<2>() = localAxes * (position - surface->center(gctx));
+  parameters[ParID_t::ePHI] = detail::radian_sym(helix.phi + psi);
+  parameters[ParID_t::eTHETA] = helix.theta;
+  parameters[ParID_t::eQOP] = helix.qOverP;
+  parameters[ParID_t::eT] = helix.time + helix.timePerLength * pathLength;
+
+  std::optional<BoundSymMatrix> covariance = std::nullopt;
+  if (params.covariance()) {
+    BoundMatrix jacobian = BoundMatrix::Zero();
+    jacobian.topRows<2>() =
+        localAxes * (positionJacobian + positionDerivative * psiJacobian);
+    jacobian.row(ParID_t::ePHI) = psiJacobian;
+    jacobian(ParID_t::ePHI, ParID_t::ePHI) += 1.;
+    jacobian(ParID_t::eTHETA, ParID_t::eTHETA) = 1.;
+    jacobian(ParID_t::eQOP, ParID_t::eQOP) = 1.;
+    jacobian.row(ParID_t::eT) =
+        helix.timePerLength * pathLengthDerivative * psiJacobian;
+    jacobian(ParID_t::eT, ParID_t::eQOP) +=
+        helix.timePerLength * psi / (helix.qOverP * helix.qOverPBz) +
+        helix.timePerLengthDerivative * pathLength;
+    jacobian(ParID_t::eT, ParID_t::eT) += 1.;
+
+    covariance = jacobian * (*params.covariance()) * jacobian.transpose();
+  }
+
+  return BoundParameters(gctx, std::move(covariance), parameters,
+                         std::move(surface));
+}
+
+}  // namespace
+
+bool Acts::detail::isHelixTransportApplicable(const GeometryContext& gctx,
+                                              const BoundParameters& params,
+                                              const Vector3D& fieldAtStart,
+                                              const Vector3D& fieldAtTarget,
+                                              double tolerance) {
+  if (params.charge() == 0. || params.parameters()[ParID_t::eQOP] == 0.) {
+    return false;
+  }
+  const Surface& surface = params.referenceSurface();
+  if (surface.type() != Surface::Perigee ||
+      !surface.transform(gctx).linear().isIdentity()) {
+    return false;
+  }
+  const double bZ = fieldAtStart.z();
+  if (bZ == 0.) {
+    return false;
+  }
+  const double maxDeviation = tolerance * std::abs(bZ);
+  return fieldAtStart.head<2>().norm() <= maxDeviation &&
+         fieldAtTarget.head<2>().norm() <= maxDeviation &&
+         std::abs(fieldAtTarget.z() - bZ) <= maxDeviation;
+}
+
+Acts::Result<Acts::BoundParameters> Acts::detail::transportHelixToPerigee(
+    const GeometryContext& gctx, const BoundParameters& params, double bZ,
+    double mass, std::shared_ptr<const PerigeeSurface> surface) {
+  const Helix helix(gctx, params, bZ, mass);
+  const Vector3D target = surface->center(gctx);
+
+  // The point of closest approach in the transverse plane lies on the line
+  // from the circle center to the target
+  const Vector2D toCenter = helix.center() - target.head<2>();
+  const double distance = toCenter.norm();
+  if (distance == 0.) {
+    return VertexingError::NumericFailure;
+  }
+  const double sgnRho = (helix.rho < 0.) ? -1. : 1.;
+  const double phiAtPCA =
+      std::atan2(sgnRho * toCenter.x(), -sgnRho * toCenter.y());
+  const double psi = detail::radian_sym(phiAtPCA - helix.phi);
+
+  const Vector3D position = helix.position(psi);
+  const Vector3D direction(std::cos(phiAtPCA), std::sin(phiAtPCA), 0.);
+  const Vector3D radialAxis(-std::sin(phiAtPCA), std::cos(phiAtPCA), 0.);
+
+  ActsMatrixD<2, 3> localAxes;
+  localAxes.row(0) = radialAxis.transpose();
+  localAxes.row(1) = Vector3D::UnitZ().transpose();
+
+  // The transverse momentum is orthogonal to the distance at the perigee,
+  // f = (position - target) * direction(phi)
+  return makeParameters(gctx, params, helix, psi, direction,
+                        radialAxis.dot(position - target), localAxes,
+                        std::move(surface));
+}
+
+Acts::Result<Acts::BoundParameters> Acts::detail::transportHelixToPlane(
+    const GeometryContext& gctx, const BoundParameters& params, double bZ,
+    double mass, std::shared_ptr<const PlaneSurface> surface, double deltaPhi,
+    int maxIterations, double precision) {
+  const Helix helix(gctx, params, bZ, mass);
+  const Transform3D& transform = surface->transform(gctx);
+  const Vector3D center = transform.translation();
+  const Vector3D normal = transform.linear().col(2);
+
+  // Newton method for the intersection, f = (position - center) * normal
+  double psi = deltaPhi;
+  bool hasConverged = false;
+  for (int nIter = 0; nIter < maxIterations && !hasConverged; ++nIter) {
+    const double derivative = normal.dot(helix.positionDerivative(psi));
+    if (derivative == 0.) {
+      return VertexingError::NumericFailure;
+    }
+    const double step =
+        -normal.dot(helix.position(psi) - center) / derivative;
+    psi += step;
+    hasConverged = std::abs(step) < precision;
+  }
+  if (!hasConverged) {
+    return VertexingError::NotConverged;
+  }
+
+  ActsMatrixD<2, 3> localAxes = transform.linear().leftCols<2>().transpose();
+
+  return makeParameters(gctx, params, helix, psi, normal, 0., localAxes,
+                        std::move(surface));
+}
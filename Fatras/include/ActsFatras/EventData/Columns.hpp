@@ -0,0 +1,169 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Acts/Geometry/GeometryID.hpp"
+#include "Acts/Utilities/PdgParticle.hpp"
+#include "ActsFatras/EventData/Barcode.hpp"
+#include "ActsFatras/EventData/Hit.hpp"
+#include "ActsFatras/EventData/Particle.hpp"
+#include "ActsFatras/EventData/ProcessType.hpp"
+
+namespace ActsFatras {
+
+/// Simulation hits stored as one column per quantity.
+///
+/// Can be used as the hit output of the simulator. Clearing keeps the
+/// allocated memory such that the columns can be reused across events;
+/// downstream consumers, e.g. digitization, can read the columns directly.
+struct HitColumns {
+  using value_type = Hit;
+  using Vector4 = Hit::Vector4;
+
+  std::vector<Acts::GeometryID> geometryId;
+  std::vector<Barcode> particleId;
+  std::vector<int32_t> index;
+  /// Space-time positions [x,y,z,t]
+  std::vector<Vector4> position4;
+  /// Four-momenta [px,py,pz,E] before the hits
+  std::vector<Vector4> momentum4Before;
+  /// Four-momenta [px,py,pz,E] after the hits
+  std::vector<Vector4> momentum4After;
+
+  /// Number of stored hits.
+  std::size_t size() const { return geometryId.size(); }
+  /// Whether no hits are stored.
+  bool empty() const { return geometryId.empty(); }
+  /// Reserve memory for the given number of hits in all columns.
+  void reserve(std::size_t n) {
+    geometryId.reserve(n);
+    particleId.reserve(n);
+    index.reserve(n);
+    position4.reserve(n);
+    momentum4Before.reserve(n);
+    momentum4After.reserve(n);
+  }
+  /// Remove all hits but keep the allocated memory.
+  void clear() {
+    geometryId.clear();
+    particleId.clear();
+    index.clear();
+    position4.clear();
+    momentum4Before.clear();
+    momentum4After.clear();
+  }
+  /// Append a hit.
+  void push_back(const Hit& hit) {
+    geometryId.push_back(hit.geometryId());
+    particleId.push_back(hit.particleId());
+    index.push_back(hit.index());
+    position4.push_back(hit.position4());
+    momentum4Before.push_back(hit.momentum4Before());
+    momentum4After.push_back(hit.momentum4After());
+  }
+  /// Assemble the hit at the given position.
+  Hit operator[](std::size_t i) const {
+    return Hit(geometryId[i], particleId[i], position4[i], momentum4Before[i],
+               momentum4After[i], index[i]);
+  }
+};
+
+/// Simulation particles stored as one column per quantity.
+///
+/// Can be used as the particle output of the simulator. Clearing keeps the
+/// allocated memory such that the columns can be reused across events.
+struct ParticleColumns {
+  using value_type = Particle;
+  using Scalar = Particle::Scalar;
+  using Vector3 = Particle::Vector3;
+  using Vector4 = Particle::Vector4;
+
+  std::vector<Barcode> particleId;
+  std::vector<ProcessType> process;
+  std::vector<Acts::PdgParticle> pdg;
+  std::vector<Scalar> charge;
+  std::vector<Scalar> mass;
+  /// Space-time positions [x,y,z,t]
+  std::vector<Vector4> position4;
+  /// Normalized directions
+  std::vector<Vector3> unitDirection;
+  std::vector<Scalar> absMomentum;
+  /// Passed material in radiation and interaction lengths
+  std::vector<Scalar> pathInX0;
+  std::vector<Scalar> pathInL0;
+  /// Material limits in radiation and interaction lengths
+  std::vector<Scalar> pathLimitX0;
+  std::vector<Scalar> pathLimitL0;
+
+  /// Number of stored particles.
+  std::size_t size() const { return particleId.size(); }
+  /// Whether no particles are stored.
+  bool empty() const { return particleId.empty(); }
+  /// Reserve memory for the given number of particles in all columns.
+  void reserve(std::size_t n) {
+    particleId.reserve(n);
+    process.reserve(n);
+    pdg.reserve(n);
+    charge.reserve(n);
+    mass.reserve(n);
+    position4.reserve(n);
+    unitDirection.reserve(n);
+    absMomentum.reserve(n);
+    pathInX0.reserve(n);
+    pathInL0.reserve(n);
+    pathLimitX0.reserve(n);
+    pathLimitL0.reserve(n);
+  }
+  /// Remove all particles but keep the allocated memory.
+  void clear() {
+    particleId.clear();
+    process.clear();
+    pdg.clear();
+    charge.clear();
+    mass.clear();
+    position4.clear();
+    unitDirection.clear();
+    absMomentum.clear();
+    pathInX0.clear();
+    pathInL0.clear();
+    pathLimitX0.clear();
+    pathLimitL0.clear();
+  }
+  /// Append a particle.
+  void push_back(const Particle& particle) {
+    particleId.push_back(particle.particleId());
+    process.push_back(particle.process());
+    pdg.push_back(particle.pdg());
+    charge.push_back(particle.charge());
+    mass.push_back(particle.mass());
+    position4.push_back(particle.position4());
+    unitDirection.push_back(particle.unitDirection());
+    absMomentum.push_back(particle.absMomentum());
+    pathInX0.push_back(particle.pathInX0());
+    pathInL0.push_back(particle.pathInL0());
+    pathLimitX0.push_back(particle.pathLimitX0());
+    pathLimitL0.push_back(particle.pathLimitL0());
+  }
+  /// Assemble the particle at the given position.
+  Particle operator[](std::size_t i) const {
+    return Particle(particleId[i], pdg[i], charge[i], mass[i])
+        .setProcess(process[i])
+        .setPosition4(position4[i])
+        .setDirection(unitDirection[i])
+        .setAbsMomentum(absMomentum[i])
+        .setMaterialPassed(pathInX0[i], pathInL0[i])
+        .setMaterialLimits(pathLimitX0[i], pathLimitL0[i]);
+  }
+};
+
+}  // namespace ActsFatras
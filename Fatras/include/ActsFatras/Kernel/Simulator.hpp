@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <iterator>
 #include <memory>
 #include <vector>
@@ -24,6 +25,7 @@
 #include "Acts/Propagator/detail/DebugOutputActor.hpp"
 #include "Acts/Propagator/detail/StandardAborters.hpp"
 #include "Acts/Utilities/Logger.hpp"
+#include "Acts/Utilities/ParallelFor.hpp"
 #include "Acts/Utilities/Result.hpp"
 #include "ActsFatras/EventData/Hit.hpp"
 #include "ActsFatras/EventData/Particle.hpp"
@@ -184,8 +186,10 @@ struct Simulator {
   ///
   /// @tparam generator_t is the type of the random number generator
   /// @tparam input_particles_t is a Container for particles
-  /// @tparam output_particles_t is a SequenceContainer for particles
-  /// @tparam hits_t is a SequenceContainer for hits
+  /// @tparam output_particles_t is a container for particles with push_back,
+  ///         e.g. std::vector or ParticleColumns
+  /// @tparam hits_t is a container for hits with push_back, e.g. std::vector
+  ///         or HitColumns
   template <typename generator_t, typename input_particles_t,
             typename output_particles_t, typename hits_t>
   Acts::Result<std::vector<FailedParticle>> simulate(
@@ -198,9 +202,9 @@ struct Simulator {
         (simulatedParticlesInitial.size() == simulatedParticlesFinal.size()) and
         "Inconsistent initial sizes of the simulated particle containers");
 
-    using ParticleSimulatorResult = Acts::Result<InteractorResult>;
-
     std::vector<FailedParticle> failedParticles;
+    // particles waiting for simulation, reused for all primaries
+    std::vector<Particle> queue;
 
     for (const Particle &inputParticle : inputParticles) {
       // only consider simulatable particles
@@ -212,48 +216,12 @@ struct Simulator {
           (inputParticle.particleId().subParticle() != 0u)) {
         return detail::SimulatorError::eInvalidInputParticleId;
       }
-
-      // Do a *depth-first* simulation of the particle and its secondaries,
-      // i.e. we simulate all secondaries, tertiaries, ... before simulating
-      // the next primary particle. Use the end of the output container as
-      // a queue to store particles that should be simulated.
-      //
-      // WARNING the initial particle state output container will be modified
-      //         during iteration. New secondaries are added to and failed
-      //         particles might be removed. to avoid issues, access must always
-      //         occur via indices.
-      auto iinitial = simulatedParticlesInitial.size();
-      simulatedParticlesInitial.push_back(inputParticle);
-      for (; iinitial < simulatedParticlesInitial.size(); ++iinitial) {
-        const auto &initialParticle = simulatedParticlesInitial[iinitial];
-
-        // only simulatable particles are pushed to the container.
-        // they must therefore be either charged or neutral.
-        ParticleSimulatorResult result = ParticleSimulatorResult::success({});
-        if (selectCharged(initialParticle)) {
-          result = charged.simulate(geoCtx, magCtx, generator, initialParticle);
-        } else {
-          result = neutral.simulate(geoCtx, magCtx, generator, initialParticle);
-        }
-
-        if (not result.ok()) {
-          // remove particle from output container since it was not simulated.
-          simulatedParticlesInitial.erase(
-              std::next(simulatedParticlesInitial.begin(), iinitial));
-          // record the particle as failed
-          failedParticles.push_back({initialParticle, result.error()});
-          continue;
-        }
-
-        copyOutputs(result.value(), simulatedParticlesInitial,
-                    simulatedParticlesFinal, hits);
-        // since physics processes are independent, there can be particle id
-        // collisions within the generated secondaries. they can be resolved by
-        // renumbering within each sub-particle generation. this must happen
-        // before the particle is simulated since the particle id is used to
-        // associate generated hits back to the particle.
-        renumberTailParticleIds(simulatedParticlesInitial, iinitial);
-      }
+      // all particles share the same generator
+      simulatePrimary(
+          geoCtx, magCtx,
+          [&](const Particle &) -> generator_t & { return generator; },
+          inputParticle, queue, simulatedParticlesInitial,
+          simulatedParticlesFinal, hits, failedParticles);
     }
 
     // the overall function call succeeded, i.e. no fatal errors occured.
@@ -263,7 +231,262 @@ struct Simulator {
     return failedParticles;
   }
 
+  /// Scratch buffers of the parallel simulation.
+  ///
+  /// The buffers are cleared for every event but keep their capacity, such
+  /// that a state kept by the caller avoids reallocating them.
+  struct ParallelState {
+    /// Outputs of all primaries simulated by one thread
+    struct ThreadOutput {
+      std::vector<Particle> queue;
+      std::vector<Particle> initial;
+      std::vector<Particle> final;
+      std::vector<Hit> hits;
+      std::vector<FailedParticle> failed;
+    };
+    /// Location of the outputs of one primary in the thread outputs
+    struct PrimaryOutput {
+      size_t thread = 0;
+      size_t initialBegin = 0, initialEnd = 0;
+      size_t finalBegin = 0, finalEnd = 0;
+      size_t hitsBegin = 0, hitsEnd = 0;
+      size_t failedBegin = 0, failedEnd = 0;
+    };
+
+    /// Selected primaries in input order
+    std::vector<const Particle *> primaries;
+    /// Outputs of every primary, in input order
+    std::vector<PrimaryOutput> outputs;
+    /// Outputs of every thread, in the order the primaries were processed
+    std::vector<ThreadOutput> threads;
+  };
+
+  /// Simulate multiple particles and generated secondaries in parallel.
+  ///
+  /// @param geoCtx is the geometry context to access surface geometries
+  /// @param magCtx is the magnetic field context to access field values
+  /// @param seed is the event seed from which all random streams are derived
+  /// @param inputParticles contains all particles that should be simulated
+  /// @param simulatedParticlesInitial contains initial particle states
+  /// @param simulatedParticlesFinal contains final particle states
+  /// @param hits contains all generated hits
+  /// @param nThreads is the number of threads, 0 means all hardware threads
+  /// @retval Acts::Result::Error if there is a fundamental issue
+  /// @retval Acts::Result::Success with all particles that failed to simulate
+  ///
+  /// The selected input particles are distributed over the worker threads
+  /// and each one is simulated together with all its secondaries. Every
+  /// simulated particle uses its own generator that is seeded from the event
+  /// seed and its particle id, see `particleSeed`. The outputs are collected
+  /// per input particle and appended in the order of the input particles.
+  /// The outputs are thus identical regardless of the number of threads,
+  /// but differ from the outputs of `simulate` with a shared generator.
+  ///
+  /// @see simulate for the output conventions and the requirements on the
+  ///      input particle ids
+  ///
+  /// @tparam generator_t is the type of the random number generator; it must
+  ///         be constructible from a `uint64_t` seed
+  /// @tparam input_particles_t is a Container for particles
+  /// @tparam output_particles_t is a container for particles with push_back,
+  ///         e.g. std::vector or ParticleColumns
+  /// @tparam hits_t is a container for hits with push_back, e.g. std::vector
+  ///         or HitColumns
+  template <typename generator_t, typename input_particles_t,
+            typename output_particles_t, typename hits_t>
+  Acts::Result<std::vector<FailedParticle>> simulateParallel(
+      const Acts::GeometryContext &geoCtx,
+      const Acts::MagneticFieldContext &magCtx, uint64_t seed,
+      const input_particles_t &inputParticles,
+      output_particles_t &simulatedParticlesInitial,
+      output_particles_t &simulatedParticlesFinal, hits_t &hits,
+      size_t nThreads = 0) const {
+    ParallelState state;
+    return simulateParallel<generator_t>(
+        geoCtx, magCtx, seed, inputParticles, simulatedParticlesInitial,
+        simulatedParticlesFinal, hits, state, nThreads);
+  }
+
+  /// Simulate multiple particles in parallel reusing the scratch buffers.
+  ///
+  /// @param state holds the scratch buffers, it can be reused for all
+  ///        events simulated by the caller
+  ///
+  /// @see simulateParallel above for the other parameters and the outputs
+  ///
+  /// Every thread appends the outputs of its primaries to its own buffers.
+  /// They are moved to the output containers in the order of the primaries
+  /// once all primaries are simulated.
+  template <typename generator_t, typename input_particles_t,
+            typename output_particles_t, typename hits_t>
+  Acts::Result<std::vector<FailedParticle>> simulateParallel(
+      const Acts::GeometryContext &geoCtx,
+      const Acts::MagneticFieldContext &magCtx, uint64_t seed,
+      const input_particles_t &inputParticles,
+      output_particles_t &simulatedParticlesInitial,
+      output_particles_t &simulatedParticlesFinal, hits_t &hits,
+      ParallelState &state, size_t nThreads = 0) const {
+    assert(
+        (simulatedParticlesInitial.size() == simulatedParticlesFinal.size()) and
+        "Inconsistent initial sizes of the simulated particle containers");
+
+    // select the primaries up-front to keep the output order fixed
+    auto &primaries = state.primaries;
+    primaries.clear();
+    for (const Particle &inputParticle : inputParticles) {
+      if (not selectParticle(inputParticle)) {
+        continue;
+      }
+      if ((inputParticle.particleId().generation() != 0u) or
+          (inputParticle.particleId().subParticle() != 0u)) {
+        return detail::SimulatorError::eInvalidInputParticleId;
+      }
+      primaries.push_back(&inputParticle);
+    }
+
+    // the buffers of the previous event are cleared but kept
+    nThreads = Acts::resolveNumberOfThreads(nThreads, primaries.size());
+    if (state.threads.size() < nThreads) {
+      state.threads.resize(nThreads);
+    }
+    for (auto &thread : state.threads) {
+      thread.initial.clear();
+      thread.final.clear();
+      thread.hits.clear();
+      thread.failed.clear();
+    }
+    state.outputs.resize(primaries.size());
+
+    Acts::parallelFor(
+        primaries.size(), nThreads, [&](size_t iprimary, size_t ithread) {
+          auto &thread = state.threads[ithread];
+          auto &output = state.outputs[iprimary];
+          output.thread = ithread;
+          output.initialBegin = thread.initial.size();
+          output.finalBegin = thread.final.size();
+          output.hitsBegin = thread.hits.size();
+          output.failedBegin = thread.failed.size();
+          // the generator is reseeded for every simulated particle
+          generator_t generator(seed);
+          simulatePrimary(
+              geoCtx, magCtx,
+              [&](const Particle &particle) -> generator_t & {
+                generator = generator_t(particleSeed(seed, particle));
+                return generator;
+              },
+              *primaries[iprimary], thread.queue, thread.initial,
+              thread.final, thread.hits, thread.failed);
+          output.initialEnd = thread.initial.size();
+          output.finalEnd = thread.final.size();
+          output.hitsEnd = thread.hits.size();
+          output.failedEnd = thread.failed.size();
+        });
+
+    std::vector<FailedParticle> failedParticles;
+    for (const auto &output : state.outputs) {
+      auto &thread = state.threads[output.thread];
+      moveRange(thread.initial, output.initialBegin, output.initialEnd,
+                simulatedParticlesInitial);
+      moveRange(thread.final, output.finalBegin, output.finalEnd,
+                simulatedParticlesFinal);
+      moveRange(thread.hits, output.hitsBegin, output.hitsEnd, hits);
+      moveRange(thread.failed, output.failedBegin, output.failedEnd,
+                failedParticles);
+    }
+    return failedParticles;
+  }
+
+  /// Derive the random seed of a particle from the event seed.
+  ///
+  /// @param seed is the event seed
+  /// @param particle is the particle that should be simulated
+  ///
+  /// Mixes the seed and the particle id with the splitmix64 finalizer such
+  /// that neighbouring particle ids result in uncorrelated seeds.
+  static uint64_t particleSeed(uint64_t seed, const Particle &particle) {
+    uint64_t z = seed ^ particle.particleId().value();
+    z += 0x9e3779b97f4a7c15u;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9u;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebu;
+    return z ^ (z >> 31);
+  }
+
  private:
+  /// Simulate a primary particle and all its secondaries.
+  ///
+  /// @param geoCtx is the geometry context to access surface geometries
+  /// @param magCtx is the magnetic field context to access field values
+  /// @param generatorFor provides the generator to simulate a given particle
+  /// @param inputParticle is the primary particle
+  /// @param queue is the scratch buffer for particles awaiting simulation
+  /// @param simulatedParticlesInitial contains initial particle states
+  /// @param simulatedParticlesFinal contains final particle states
+  /// @param hits contains all generated hits
+  /// @param failedParticles contains the particles that failed to simulate
+  template <typename generator_provider_t, typename output_particles_t,
+            typename hits_t>
+  void simulatePrimary(const Acts::GeometryContext &geoCtx,
+                       const Acts::MagneticFieldContext &magCtx,
+                       generator_provider_t &&generatorFor,
+                       const Particle &inputParticle,
+                       std::vector<Particle> &queue,
+                       output_particles_t &simulatedParticlesInitial,
+                       output_particles_t &simulatedParticlesFinal,
+                       hits_t &hits,
+                       std::vector<FailedParticle> &failedParticles) const {
+    using ParticleSimulatorResult = Acts::Result<InteractorResult>;
+
+    // Do a *depth-first* simulation of the particle and its secondaries,
+    // i.e. we simulate all secondaries, tertiaries, ... before simulating
+    // the next primary particle. The queue stores the particles that should
+    // be simulated; since it grows during iteration, access must always occur
+    // via indices. Particles are only written to the outputs once they are
+    // simulated, such that the outputs only need to support appending.
+    queue.clear();
+    queue.push_back(inputParticle);
+    for (size_t iqueue = 0; iqueue < queue.size(); ++iqueue) {
+      const auto &initialParticle = queue[iqueue];
+      auto &generator = generatorFor(initialParticle);
+
+      // only simulatable particles are pushed to the queue.
+      // they must therefore be either charged or neutral.
+      ParticleSimulatorResult result = ParticleSimulatorResult::success({});
+      if (selectCharged(initialParticle)) {
+        result = charged.simulate(geoCtx, magCtx, generator, initialParticle);
+      } else {
+        result = neutral.simulate(geoCtx, magCtx, generator, initialParticle);
+      }
+
+      if (not result.ok()) {
+        // record the particle as failed; it does not enter the outputs
+        failedParticles.push_back({initialParticle, result.error()});
+        continue;
+      }
+
+      // the particle id is final once the particle has been simulated
+      simulatedParticlesInitial.push_back(initialParticle);
+      // invalidates the initialParticle reference
+      copyOutputs(result.value(), queue, simulatedParticlesFinal, hits);
+      // since physics processes are independent, there can be particle id
+      // collisions within the generated secondaries. they can be resolved by
+      // renumbering within each sub-particle generation. this must happen
+      // before the particle is simulated since the particle id is used to
+      // associate generated hits back to the particle.
+      renumberTailParticleIds(queue, iqueue);
+    }
+  }
+
+  /// Move a range of a scratch buffer to the end of an output container.
+  ///
+  /// @tparam output_t is a container with push_back
+  template <typename element_t, typename output_t>
+  static void moveRange(std::vector<element_t> &buffer, size_t begin,
+                        size_t end, output_t &output) {
+    for (size_t i = begin; i < end; ++i) {
+      output.push_back(std::move(buffer[i]));
+    }
+  }
+
   /// Select if the particle should be simulated at all.
   ///
   /// This also enforces mutual-exclusivity of the two charge selections. If
@@ -277,23 +500,25 @@ struct Simulator {
     return isValidCharged xor isValidNeutral;
   }
 
-  /// Copy Interactor results to output containers.
+  /// Copy Interactor results to the queue and the output containers.
   ///
-  /// @tparam particles_t is a SequenceContainer for particles
-  /// @tparam hits_t is a SequenceContainer for hits
+  /// @tparam particles_t is a container for particles with push_back
+  /// @tparam hits_t is a container for hits with push_back
   template <typename particles_t, typename hits_t>
   void copyOutputs(const InteractorResult &result,
-                   particles_t &particlesInitial, particles_t &particlesFinal,
+                   std::vector<Particle> &queue, particles_t &particlesFinal,
                    hits_t &hits) const {
     // initial particle state was already pushed to the container before
     // store final particle state at the end of the simulation
     particlesFinal.push_back(result.particle);
-    // move generated secondaries that should be simulated to the output
+    // queue generated secondaries that should be simulated
     std::copy_if(
         result.generatedParticles.begin(), result.generatedParticles.end(),
-        std::back_inserter(particlesInitial),
+        std::back_inserter(queue),
         [this](const Particle &particle) { return selectParticle(particle); });
-    std::copy(result.hits.begin(), result.hits.end(), std::back_inserter(hits));
+    for (const Hit &hit : result.hits) {
+      hits.push_back(hit);
+    }
   }
 
   /// Renumber particle ids in the tail of the container.
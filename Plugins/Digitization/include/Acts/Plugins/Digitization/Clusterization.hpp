@@ -10,6 +10,7 @@
 
 #include <boost/config.hpp>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 #include "Acts/Plugins/Digitization/DigitizationCell.hpp"
 
@@ -34,30 +35,54 @@ std::vector<std::vector<cell_t>> createClusters(
     std::unordered_map<size_t, std::pair<cell_t, bool>>& cellMap, size_t nBins0,
     bool commonCorner = true, double energyCut = 0.);
 
-/// @brief fillCluster
-/// This function is a helper function internally used by Acts::createClusters.
-/// It does connected component labelling using a hash map in order to find out
-/// which cells are neighbours. This function is called recursively by all
-/// neighbours of the current cell. The function is templated on the
-/// digitization cell type to allow users to use their own implementation
-/// inheriting from Acts::DigitizationCell.
+/// @brief create clusters from a contiguous vector of cells
+/// Same as the map based createClusters, but the cell positions are taken
+/// from channel0 and channel1 of the cells. Every cell is expected to appear
+/// once, cells at the same position end up in the same cluster.
+/// The clusters are ordered by their first cell and the cells of a cluster
+/// are ordered by (channel1, channel0), the result is hence independent of
+/// the order of the input cells.
 /// @tparam Cell the digitization cell
-/// @param [in,out] mergedCells the final vector of cells to which cells of one
-/// cluster should be added
-/// @param [in,out] cellMap the hashmap of all present cells + a flag indicating
-/// if they have been added to a cluster already, with the key being the global
-/// grid index
-/// @param [in] index the current global grid index of the cell
-/// @param [in] cellA the current cell
-/// @param [in] nBins0 number of bins in direction 0
+/// @param [in] cells all cells of the module
 /// @param [in] commonCorner flag indicating if also cells sharing a common
 /// corner should be merged into one cluster
 /// @param [in] energyCut possible energy cut to be applied
+/// @return vector (the different clusters) of vector of digitization cells (the
+/// cells which belong to each cluster)
 template <typename cell_t>
-void fillCluster(std::vector<std::vector<cell_t>>& mergedCells,
-                 std::unordered_map<size_t, std::pair<cell_t, bool>>& cellMap,
-                 size_t index, size_t nBins0, bool commonCorner = true,
-                 double energyCut = 0.);
+std::vector<std::vector<cell_t>> createClusters(
+    const std::vector<cell_t>& cells, bool commonCorner = true,
+    double energyCut = 0.);
+
+/// @brief create clusters for many modules in parallel
+/// @tparam Cell the digitization cell
+/// @param [in] moduleCells the cells, one vector per module
+/// @param [in] commonCorner flag indicating if also cells sharing a common
+/// corner should be merged into one cluster
+/// @param [in] energyCut possible energy cut to be applied
+/// @param [in] nThreads the number of threads, 0 means all hardware threads
+/// @return the clusters of each module, in the order of the modules
+template <typename cell_t>
+std::vector<std::vector<std::vector<cell_t>>> createModuleClusters(
+    const std::vector<std::vector<cell_t>>& moduleCells,
+    bool commonCorner = true, double energyCut = 0., size_t nThreads = 0);
+
+namespace detail {
+
+/// @brief connected component labelling of cells on a grid
+/// The cells are sorted by (channel1, channel0) and scanned once, each cell
+/// is united with its neighbours in the same and in the previous row using
+/// a union-find structure. This needs neither hashing nor recursion.
+/// @param [in] positions the (channel0, channel1) position of each cell
+/// @param [in] commonCorner flag indicating if also cells sharing a common
+/// corner should be merged into one cluster
+/// @param [out] clusters the indices of the cells of each cluster, ordered
+/// by the position of their first cell
+void labelClusters(const std::vector<std::pair<size_t, size_t>>& positions,
+                   bool commonCorner,
+                   std::vector<std::vector<size_t>>& clusters);
+
+}  // namespace detail
 }  // namespace Acts
 
 #include "Acts/Plugins/Digitization/detail/Clusterization.ipp"
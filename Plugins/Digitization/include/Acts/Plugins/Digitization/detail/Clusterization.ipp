@@ -11,26 +11,38 @@
 #include <utility>
 #include <vector>
 
+#include "Acts/Utilities/ParallelFor.hpp"
+
 template <typename cell_t>
 std::vector<std::vector<cell_t>> Acts::createClusters(
     std::unordered_map<size_t, std::pair<cell_t, bool>>& cellMap, size_t nBins0,
     bool commonCorner, double energyCut) {
-  // the output
-  std::vector<std::vector<cell_t>> mergedCells;
-  // now go through cells and label
+  // collect the unused cells above threshold, the position is given by the
+  // global grid index
+  std::vector<std::pair<cell_t, bool>*> selected;
+  std::vector<std::pair<size_t, size_t>> positions;
+  selected.reserve(cellMap.size());
+  positions.reserve(cellMap.size());
   for (auto& cell : cellMap) {
-    // check if the cell was already used
     if (!(cell.second.second) &&
         (cell.second.first.depositedEnergy() >= energyCut)) {
-      // create new cluster
-      mergedCells.push_back(std::vector<cell_t>());
-      // add current cell to current cluster
-      mergedCells.back().push_back(cell.second.first);
+      selected.push_back(&cell.second);
+      positions.emplace_back(cell.first % nBins0, cell.first / nBins0);
+    }
+  }
+  std::vector<std::vector<size_t>> clusters;
+  detail::labelClusters(positions, commonCorner, clusters);
+
+  // the output
+  std::vector<std::vector<cell_t>> mergedCells;
+  mergedCells.reserve(clusters.size());
+  for (const auto& cluster : clusters) {
+    mergedCells.emplace_back();
+    mergedCells.back().reserve(cluster.size());
+    for (size_t i : cluster) {
+      mergedCells.back().push_back(selected[i]->first);
       // set cell to be used already
-      cell.second.second = true;
-      // fill all cells belonging to that cluster
-      fillCluster(mergedCells, cellMap, cell.first, nBins0, commonCorner,
-                  energyCut);
+      selected[i]->second = true;
     }
   }
   // return the grouped together cells
@@ -38,63 +50,43 @@ std::vector<std::vector<cell_t>> Acts::createClusters(
 }
 
 template <typename cell_t>
-void Acts::fillCluster(
-    std::vector<std::vector<cell_t>>& mergedCells,
-    std::unordered_map<size_t, std::pair<cell_t, bool>>& cellMap, size_t index,
-    size_t nBins0, bool commonCorner, double energyCut) {
-  // go recursively through all neighbours of this cell, if present
-  // calculate neighbour indices first
-  constexpr int iMin = -1;
-  int jMin = -nBins0;
-  constexpr int iMax = 1;
-  int jMax = nBins0;
-  std::vector<int> neighbourIndices;
-  // the neighbour indices - filled depending on merging case
-  if ((index % nBins0) == 0) {
-    // left edge case
-    if (commonCorner) {
-      neighbourIndices = {jMin, jMin + iMax, iMax, jMax, jMax + iMax};
-    } else {
-      neighbourIndices = {jMin, iMax, jMax};
-    }
-  } else if (((index + 1) % nBins0) == 0) {
-    // right edge case
-    if (commonCorner) {
-      neighbourIndices = {jMin + iMin, jMin, iMin, jMax + iMin, jMax};
-    } else {
-      neighbourIndices = {jMin, iMin, jMax};
+std::vector<std::vector<cell_t>> Acts::createClusters(
+    const std::vector<cell_t>& cells, bool commonCorner, double energyCut) {
+  std::vector<size_t> selected;
+  std::vector<std::pair<size_t, size_t>> positions;
+  selected.reserve(cells.size());
+  positions.reserve(cells.size());
+  for (size_t i = 0; i < cells.size(); ++i) {
+    if (cells[i].depositedEnergy() >= energyCut) {
+      selected.push_back(i);
+      positions.emplace_back(cells[i].channel0, cells[i].channel1);
     }
-  } else {
-    if (commonCorner) {
-      neighbourIndices = {jMin + iMin, jMin,        jMin + iMax, iMin,
-                          iMax,        jMax + iMin, jMax,        jMax + iMax};
-    } else {
-      neighbourIndices = {jMin, iMin, iMax, jMax};
+  }
+  std::vector<std::vector<size_t>> clusters;
+  detail::labelClusters(positions, commonCorner, clusters);
+
+  std::vector<std::vector<cell_t>> mergedCells;
+  mergedCells.reserve(clusters.size());
+  for (const auto& cluster : clusters) {
+    mergedCells.emplace_back();
+    mergedCells.back().reserve(cluster.size());
+    for (size_t i : cluster) {
+      mergedCells.back().push_back(cells[selected[i]]);
     }
   }
-  // go through neighbours and recursively call connected component algorithm
-  for (auto& i : neighbourIndices) {
-    // calculate neighbour index of current cell
-    int neighbourIndex = int(index) + i;
-    // check if neighbour is there
-    ///   auto startSearchMap = std::chrono::system_clock::now();
-    auto search = cellMap.find(neighbourIndex);
-    if ((search != cellMap.end())) {
-      // get the corresponding index and call function again
-      auto newIndex = search->first;
-      auto currentCell = search->second.first;
-      // if cell was not already added to cluster & deposited energy is higher
-      // than the energy threshold, add it to the cluster
-      if (!search->second.second &&
-          currentCell.depositedEnergy() >= energyCut) {
-        // add current cell to current cluster
-        mergedCells.back().push_back(currentCell);
-        // set cell to be used already
-        search->second.second = true;
-        // add all neighbours to cluster
-        fillCluster(mergedCells, cellMap, newIndex, nBins0, commonCorner,
-                    energyCut);
-      }  // check if was used already
-    }    // check if neighbour is there
-  }      // go through neighbour indics
-}
\ No newline at end of file
+  return mergedCells;
+}
+
+template <typename cell_t>
+std::vector<std::vector<std::vector<cell_t>>> Acts::createModuleClusters(
+    const std::vector<std::vector<cell_t>>& moduleCells, bool commonCorner,
+    double energyCut, size_t nThreads) {
+  std::vector<std::vector<std::vector<cell_t>>> moduleClusters(
+      moduleCells.size());
+  parallelFor(moduleCells.size(), nThreads,
+              [&](size_t iModule, size_t /*threadIndex*/) {
+                moduleClusters[iModule] = createClusters(
+                    moduleCells[iModule], commonCorner, energyCut);
+              });
+  return moduleClusters;
+}
@@ -0,0 +1,110 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Acts/Plugins/Digitization/Clusterization.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace {
+
+/// Find the root of a cell, halving the path on the way
+size_t findRoot(std::vector<size_t>& parents, size_t i) {
+  while (parents[i] != i) {
+    parents[i] = parents[parents[i]];
+    i = parents[i];
+  }
+  return i;
+}
+
+/// Unite the sets of two cells, the smaller root always wins such that the
+/// root of a cluster is its first cell in the sorted order
+void unite(std::vector<size_t>& parents, size_t a, size_t b) {
+  a = findRoot(parents, a);
+  b = findRoot(parents, b);
+  if (a < b) {
+    parents[b] = a;
+  } else if (b < a) {
+    parents[a] = b;
+  }
+}
+
+}  // namespace
+
+void Acts::detail::labelClusters(
+    const std::vector<std::pair<size_t, size_t>>& positions, bool commonCorner,
+    std::vector<std::vector<size_t>>& clusters) {
+  clusters.clear();
+  const size_t nCells = positions.size();
+  if (nCells == 0) {
+    return;
+  }
+
+  // sort the cells row by row, i.e. by (channel1, channel0)
+  std::vector<size_t> order(nCells);
+  std::iota(order.begin(), order.end(), 0u);
+  std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+    const auto& a = positions[lhs];
+    const auto& b = positions[rhs];
+    return (a.second != b.second) ? (a.second < b.second)
+                                  : (a.first < b.first);
+  });
+  const auto ch0 = [&](size_t s) { return positions[order[s]].first; };
+  const auto ch1 = [&](size_t s) { return positions[order[s]].second; };
+
+  // the union-find works on the positions in the sorted order
+  std::vector<size_t> parents(nCells);
+  std::iota(parents.begin(), parents.end(), 0u);
+
+  // first cell of the current and of the previous row
+  size_t rowBegin = 0;
+  size_t prevBegin = 0;
+  size_t prevEnd = 0;
+  // scan position in the previous row, moves monotonically
+  size_t prev = 0;
+  for (size_t s = 0; s < nCells; ++s) {
+    const size_t c0 = ch0(s);
+    const size_t c1 = ch1(s);
+    if (s > 0 and ch1(s - 1) != c1) {
+      // a new row starts, the previous row is only adjacent if it is the
+      // directly preceding one
+      if (ch1(s - 1) + 1 == c1) {
+        prevBegin = rowBegin;
+        prevEnd = s;
+      } else {
+        prevBegin = prevEnd = s;
+      }
+      rowBegin = s;
+      prev = prevBegin;
+    }
+    // the left neighbour, or a duplicate at the same position
+    if (s > rowBegin and ch0(s - 1) + 1 >= c0) {
+      unite(parents, s, s - 1);
+    }
+    // the neighbours in the previous row
+    const size_t lower = (commonCorner and c0 > 0) ? c0 - 1 : c0;
+    const size_t upper = commonCorner ? c0 + 1 : c0;
+    while (prev < prevEnd and ch0(prev) < lower) {
+      ++prev;
+    }
+    for (size_t p = prev; p < prevEnd and ch0(p) <= upper; ++p) {
+      unite(parents, s, p);
+    }
+  }
+
+  // collect the clusters, ordered by their root which is their first cell
+  std::vector<size_t> clusterIndex(nCells, nCells);
+  for (size_t s = 0; s < nCells; ++s) {
+    const size_t root = findRoot(parents, s);
+    if (clusterIndex[root] == nCells) {
+      clusterIndex[root] = clusters.size();
+      clusters.emplace_back();
+    }
+    clusters[clusterIndex[root]].push_back(order[s]);
+  }
+}
@@ -0,0 +1,72 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+/// Convert material maps between the json and the binary format
+///
+///     ActsConvertMaterialMap <input> <output>
+///
+/// Files ending in .json are read and written as json, all others use the
+/// binary format of Acts::BinaryMaterialMap.
+
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "Acts/Material/BinaryMaterialMap.hpp"
+#include "Acts/Plugins/Json/JsonGeometryConverter.hpp"
+
+namespace {
+bool isJson(const std::string& path) {
+  const std::string ext = ".json";
+  return path.size() >= ext.size() and
+         path.compare(path.size() - ext.size(), ext.size(), ext) == 0;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc != 3) {
+    std::cerr << "Usage: " << argv[0] << " <input> <output>\n"
+              << "Files ending in .json use the json format, all others the "
+                 "binary format.\n";
+    return 1;
+  }
+  const std::string input = argv[1];
+  const std::string output = argv[2];
+
+  Acts::JsonGeometryConverter::Config cfg("JsonGeometryConverter",
+                                          Acts::Logging::INFO);
+  Acts::JsonGeometryConverter converter(cfg);
+
+  try {
+    Acts::BinaryMaterialMap::DetectorMaterialMaps maps;
+    if (isJson(input)) {
+      std::ifstream ifj(input);
+      nlohmann::json jin;
+      ifj >> jin;
+      maps = converter.jsonToMaterialMaps(jin);
+    } else {
+      maps = Acts::BinaryMaterialMap::Reader(input).read();
+    }
+
+    if (isJson(output)) {
+      std::ofstream ofj(output);
+      ofj << std::setw(4) << converter.materialMapsToJson(maps) << std::endl;
+    } else {
+      Acts::BinaryMaterialMap::write(output, maps);
+    }
+    std::cout << "Converted " << maps.first.size() << " surface and "
+              << maps.second.size() << " volume material maps to " << output
+              << std::endl;
+  } catch (const std::exception& e) {
+    std::cerr << "Conversion failed: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
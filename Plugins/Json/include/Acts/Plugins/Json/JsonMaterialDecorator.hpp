@@ -12,6 +12,7 @@
 #include <map>
 #include <mutex>
 
+#include "Acts/Geometry/GeometryIDMap.hpp"
 #include "Acts/Geometry/TrackingVolume.hpp"
 #include "Acts/Material/IMaterialDecorator.hpp"
 #include "Acts/Material/ISurfaceMaterial.hpp"
@@ -52,8 +53,8 @@ class JsonMaterialDecorator : public IMaterialDecorator {
     ifj >> jin;
 
     auto maps = jmConverter.jsonToMaterialMaps(jin);
-    m_surfaceMaterialMap = maps.first;
-    m_volumeMaterialMap = maps.second;
+    m_surfaceMaterialMap = GeometryIDMap<SurfaceMaterialPtr>(maps.first);
+    m_volumeMaterialMap = GeometryIDMap<VolumeMaterialPtr>(maps.second);
   }
 
   /// Decorate a surface
@@ -66,8 +67,8 @@ class JsonMaterialDecorator : public IMaterialDecorator {
     }
     // Try to find the surface in the map
     auto sMaterial = m_surfaceMaterialMap.find(surface.geoID());
-    if (sMaterial != m_surfaceMaterialMap.end()) {
-      surface.assignSurfaceMaterial(sMaterial->second);
+    if (sMaterial != nullptr) {
+      surface.assignSurfaceMaterial(*sMaterial);
     }
   }
 
@@ -79,12 +80,20 @@ class JsonMaterialDecorator : public IMaterialDecorator {
     if (m_clearVolumeMaterial) {
       volume.assignVolumeMaterial(nullptr);
     }
+    // Try to find the volume in the map
+    auto vMaterial = m_volumeMaterialMap.find(volume.geoID());
+    if (vMaterial != nullptr) {
+      volume.assignVolumeMaterial(*vMaterial);
+    }
   }
 
  private:
   JsonGeometryConverter::Config m_readerConfig;
-  SurfaceMaterialMap m_surfaceMaterialMap;
-  VolumeMaterialMap m_volumeMaterialMap;
+  using SurfaceMaterialPtr = std::shared_ptr<const ISurfaceMaterial>;
+  using VolumeMaterialPtr = std::shared_ptr<const IVolumeMaterial>;
+
+  GeometryIDMap<SurfaceMaterialPtr> m_surfaceMaterialMap;
+  GeometryIDMap<VolumeMaterialPtr> m_volumeMaterialMap;
 
   bool m_clearSurfaceMaterial{true};
   bool m_clearVolumeMaterial{true};
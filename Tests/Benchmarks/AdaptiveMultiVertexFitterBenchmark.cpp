@@ -0,0 +1,186 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/program_options.hpp>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Acts/EventData/TrackParameters.hpp"
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/MagneticField/ConstantBField.hpp"
+#include "Acts/MagneticField/MagneticFieldContext.hpp"
+#include "Acts/Propagator/EigenStepper.hpp"
+#include "Acts/Propagator/Propagator.hpp"
+#include "Acts/Surfaces/PerigeeSurface.hpp"
+#include "Acts/Tests/CommonHelpers/BenchmarkTools.hpp"
+#include "Acts/Utilities/Logger.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include "Acts/Vertexing/AdaptiveMultiVertexFitter.hpp"
+#include "Acts/Vertexing/HelicalTrackLinearizer.hpp"
+#include "Acts/Vertexing/ImpactPoint3dEstimator.hpp"
+#include "Acts/Vertexing/Vertex.hpp"
+
+namespace po = boost::program_options;
+using namespace Acts;
+using namespace Acts::UnitLiterals;
+
+int main(int argc, char* argv[]) {
+  unsigned int nVertices = 200;
+  unsigned int nTracksPerVertex = 10;
+  unsigned int nShared = 2;
+  unsigned int nRuns = 20;
+  unsigned int nThreads = 1;
+  bool cacheLinearizations = false;
+  bool analyticTransport = false;
+  unsigned int lvl = Acts::Logging::INFO;
+
+  try {
+    po::options_description desc("Allowed options");
+    // clang-format off
+  desc.add_options()
+      ("help", "produce help message")
+      ("vertices",po::value<unsigned int>(&nVertices)->default_value(200),"number of vertices")
+      ("tracks",po::value<unsigned int>(&nTracksPerVertex)->default_value(10),"number of tracks per vertex")
+      ("shared",po::value<unsigned int>(&nShared)->default_value(2),"number of neighbouring vertices each track is also attached to")
+      ("runs",po::value<unsigned int>(&nRuns)->default_value(20),"number of benchmark runs")
+      ("threads",po::value<unsigned int>(&nThreads)->default_value(1),"number of fitter threads, 0 for all hardware threads")
+      ("cache",po::bool_switch(&cacheLinearizations),"cache track linearizations")
+      ("analytic",po::bool_switch(&analyticTransport),"use the closed-form helix transport instead of the propagator")
+      ("verbose",po::value<unsigned int>(&lvl)->default_value(Acts::Logging::INFO),"logging level");
+    // clang-format on
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help") != 0u) {
+      std::cout << desc << std::endl;
+      return 0;
+    }
+  } catch (std::exception& e) {
+    std::cerr << "error: " << e.what() << std::endl;
+    return 1;
+  }
+
+  auto myLogger = getDefaultLogger("AMVFitter", Acts::Logging::Level(lvl));
+  ACTS_LOCAL_LOGGER(std::move(myLogger));
+
+  ACTS_INFO("fitting " << nVertices << " vertices with " << nTracksPerVertex
+                       << " tracks each, shared with " << nShared
+                       << " neighbouring vertices");
+  ACTS_INFO("using " << nThreads << " threads, linearization cache "
+                     << (cacheLinearizations ? "on" : "off")
+                     << ", analytic transport "
+                     << (analyticTransport ? "on" : "off"));
+
+  using Propagator = Acts::Propagator<EigenStepper<ConstantBField>>;
+  using Linearizer = HelicalTrackLinearizer<Propagator>;
+  using Fitter = AdaptiveMultiVertexFitter<BoundParameters, Linearizer>;
+  using IPEstimator = ImpactPoint3dEstimator<BoundParameters, Propagator>;
+
+  GeometryContext geoContext = GeometryContext();
+  MagneticFieldContext magFieldContext = MagneticFieldContext();
+
+  ConstantBField bField(Vector3D(0., 0., 2_T));
+  auto propagator =
+      std::make_shared<Propagator>(EigenStepper<ConstantBField>(bField));
+
+  IPEstimator::Config ip3dEstCfg(bField, propagator);
+  ip3dEstCfg.useAnalyticTransport = analyticTransport;
+  Fitter::Config fitterCfg{IPEstimator(ip3dEstCfg)};
+  fitterCfg.annealingTool =
+      AnnealingUtility(AnnealingUtility::Config({8., 4., 2., 1.4, 1.2, 1.}));
+  fitterCfg.nThreads = nThreads;
+  fitterCfg.cacheLinearizations = cacheLinearizations;
+  Linearizer::Config ltConfig(bField, propagator);
+  ltConfig.useAnalyticTransport = analyticTransport;
+  Linearizer linearizer(ltConfig);
+  Fitter fitter(fitterCfg);
+
+  VertexingOptions<BoundParameters> vertexingOptions(geoContext,
+                                                     magFieldContext);
+
+  // vertices along the beam line, close enough to share tracks
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<> d0Dist(-10_um, 10_um);
+  std::uniform_real_distribution<> z0Dist(-50_um, 50_um);
+  std::uniform_real_distribution<> phiDist(-M_PI, M_PI);
+  std::uniform_real_distribution<> thetaDist(1.0, M_PI - 1.0);
+  std::uniform_real_distribution<> qOverPDist(-1 / 1_GeV, 1 / 1_GeV);
+
+  BoundSymMatrix cov = BoundSymMatrix::Zero();
+  cov.diagonal() << 30_um * 30_um, 50_um * 50_um, 1e-6, 1e-6, 1e-4 / 1_GeV,
+      1.;
+
+  std::vector<Vertex<BoundParameters>> seeds;
+  std::vector<BoundParameters> tracks;
+  for (unsigned int iv = 0; iv < nVertices; ++iv) {
+    Vector3D pos(0., 0., (iv - 0.5 * nVertices) * 0.5_mm);
+    Vertex<BoundParameters> vtx(pos);
+    vtx.setFullCovariance(SpacePointSymMatrix::Identity() * 1_mm * 1_mm);
+    seeds.push_back(vtx);
+
+    auto perigee = Surface::makeShared<PerigeeSurface>(pos);
+    for (unsigned int it = 0; it < nTracksPerVertex; ++it) {
+      BoundVector par;
+      par << d0Dist(rng), z0Dist(rng), phiDist(rng), thetaDist(rng),
+          qOverPDist(rng), 0.;
+      tracks.emplace_back(geoContext, cov, par, perigee);
+    }
+  }
+
+  std::vector<Vertex<BoundParameters>> vertices;
+  std::vector<Vertex<BoundParameters>*> verticesPtr;
+  Fitter::State state;
+
+  // fill the state with the tracks at their own and neighbouring vertices
+  auto setup = [&]() {
+    vertices = seeds;
+    verticesPtr.clear();
+    for (auto& vtx : vertices) {
+      verticesPtr.push_back(&vtx);
+    }
+    state = Fitter::State();
+    state.reserve(nVertices, tracks.size(),
+                  tracks.size() * (2 * nShared + 1));
+    for (unsigned int iv = 0; iv < nVertices; ++iv) {
+      auto& info = state.vertexInfo(vertices[iv]);
+      info.constraintVertex = seeds[iv];
+      info.linPoint = seeds[iv].fullPosition();
+      info.oldPosition = info.linPoint;
+      info.seedPosition = info.linPoint;
+
+      for (unsigned int jv = (iv < nShared) ? 0 : iv - nShared;
+           jv <= std::min(iv + nShared, nVertices - 1); ++jv) {
+        for (unsigned int it = 0; it < nTracksPerVertex; ++it) {
+          const auto& trk = tracks[jv * nTracksPerVertex + it];
+          state.addTrackToVertex(vertices[iv],
+                                 TrackAtVertex<BoundParameters>(trk, &trk));
+        }
+      }
+    }
+    for (auto& vtx : vertices) {
+      state.addVertexToTrackLinks(vtx);
+    }
+    return state.activeLinks.size();
+  };
+
+  const auto setupResult = Acts::Test::microBenchmark(setup, 1, nRuns);
+  ACTS_INFO("State setup: " << setupResult);
+
+  const auto fitResult = Acts::Test::microBenchmark(
+      [&] {
+        setup();
+        return fitter.fit(state, verticesPtr, linearizer, vertexingOptions)
+            .ok();
+      },
+      1, nRuns);
+  ACTS_INFO("State setup and fit: " << fitResult);
+
+  return 0;
+}
@@ -0,0 +1,134 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/program_options.hpp>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Acts/Material/Interactions.hpp"
+#include "Acts/Tests/CommonHelpers/BenchmarkTools.hpp"
+#include "Acts/Tests/CommonHelpers/PredefinedMaterials.hpp"
+#include "Acts/Utilities/Logger.hpp"
+#include "Acts/Utilities/PdgParticle.hpp"
+#include "Acts/Utilities/Units.hpp"
+
+namespace po = boost::program_options;
+using namespace Acts;
+using namespace Acts::UnitLiterals;
+
+int main(int argc, char* argv[]) {
+  unsigned int nEntries = 1000000;
+  unsigned int nSlabs = 1000;
+  unsigned int nRuns = 20;
+  unsigned int lvl = Acts::Logging::INFO;
+
+  try {
+    po::options_description desc("Allowed options");
+    // clang-format off
+  desc.add_options()
+      ("help", "produce help message")
+      ("entries",po::value<unsigned int>(&nEntries)->default_value(1000000),"number of particle-slab crossings")
+      ("slabs",po::value<unsigned int>(&nSlabs)->default_value(1000),"number of material slabs")
+      ("runs",po::value<unsigned int>(&nRuns)->default_value(20),"number of benchmark runs")
+      ("verbose",po::value<unsigned int>(&lvl)->default_value(Acts::Logging::INFO),"logging level");
+    // clang-format on
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help") != 0u) {
+      std::cout << desc << std::endl;
+      return 0;
+    }
+  } catch (std::exception& e) {
+    std::cerr << "error: " << e.what() << std::endl;
+    return 1;
+  }
+
+  auto myLogger = getDefaultLogger("Interactions", Acts::Logging::Level(lvl));
+  ACTS_LOCAL_LOGGER(std::move(myLogger));
+
+  ACTS_INFO("computing interactions for " << nEntries << " crossings of "
+                                          << nSlabs << " slabs");
+
+  // silicon and beryllium slabs of different thickness
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> thicknessDist(100_um, 2_mm);
+  std::vector<MaterialProperties> slabs;
+  for (unsigned int is = 0; is < nSlabs; ++is) {
+    auto material =
+        (is % 2 == 0) ? Acts::Test::makeSilicon() : Acts::Test::makeBeryllium();
+    slabs.emplace_back(material, thicknessDist(rng));
+  }
+  InteractionSlabTable table(slabs);
+
+  // muons, pions, and electrons of both charges
+  const std::vector<std::pair<PdgParticle, float>> particles = {
+      {PdgParticle::eMuon, 105.658_MeV},
+      {PdgParticle::ePionPlus, 139.570_MeV},
+      {PdgParticle::eElectron, 0.511_MeV}};
+  std::uniform_int_distribution<unsigned int> slabDist(0, nSlabs - 1);
+  std::uniform_int_distribution<size_t> particleDist(0, particles.size() - 1);
+  std::uniform_real_distribution<float> pDist(500_MeV, 100_GeV);
+  InteractionBatch batch;
+  for (unsigned int ie = 0; ie < nEntries; ++ie) {
+    const auto [pdg, mass] = particles[particleDist(rng)];
+    const float q = (ie % 2 == 0) ? 1_e : -1_e;
+    batch.add(slabDist(rng), pdg, mass, q / pDist(rng), q);
+  }
+
+  std::vector<float> output(nEntries);
+
+  // evaluates a single particle function for all batch entries
+  auto scalarLoop = [&](auto&& function) {
+    return [&, function] {
+      for (size_t i = 0; i < batch.size(); ++i) {
+        output[i] = function(slabs[batch.slab[i]], batch.pdg[i],
+                             batch.mass[i], batch.qOverP[i], batch.charge[i]);
+      }
+      return output.back();
+    };
+  };
+  auto compare = [&](const std::string& name, auto&& scalar, auto&& batched) {
+    const auto scalarResult = Acts::Test::microBenchmark(scalar, 1, nRuns);
+    const auto batchedResult = Acts::Test::microBenchmark(batched, 1, nRuns);
+    ACTS_INFO(name << " scalar:  " << scalarResult);
+    ACTS_INFO(name << " batched: " << batchedResult);
+    ACTS_INFO(name << " speed-up: "
+                   << scalarResult.runTimeMedian() /
+                          batchedResult.runTimeMedian());
+  };
+
+  compare("Bethe energy loss",
+          scalarLoop([](const auto&... args) {
+            return computeEnergyLossBethe(args...);
+          }),
+          [&] {
+            computeEnergyLossBethe(table, batch, output);
+            return output.back();
+          });
+  compare("Landau energy loss",
+          scalarLoop([](const auto&... args) {
+            return computeEnergyLossLandau(args...);
+          }),
+          [&] {
+            computeEnergyLossLandau(table, batch, output);
+            return output.back();
+          });
+  compare("Multiple scattering theta0",
+          scalarLoop([](const auto&... args) {
+            return computeMultipleScatteringTheta0(args...);
+          }),
+          [&] {
+            computeMultipleScatteringTheta0(table, batch, output);
+            return output.back();
+          });
+
+  return 0;
+}
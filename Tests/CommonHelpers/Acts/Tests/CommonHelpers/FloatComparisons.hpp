@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <type_traits>
 
 #include <boost/test/unit_test.hpp>
 
@@ -159,8 +160,13 @@ predicate_result matrixCompare(const Eigen::DenseBase<Derived1>& val,
 // FIXME: The algorithm only supports ordered containers, so the API should
 //        only accept them. Does someone know a clean way to do that in C++?
 //
+// Eigen 3.4 matrices also define const_iterator, they are excluded here and
+// handled by the Eigen frontend below.
+//
 template <typename Container,
-          typename Enable = typename Container::const_iterator>
+          typename Enable = typename Container::const_iterator,
+          typename = std::enable_if_t<not std::is_base_of<
+              Eigen::DenseBase<Container>, Container>::value>>
 predicate_result compare(const Container& val, const Container& ref,
                          ScalarComparison&& compareImpl) {
   // Make sure that the two input containers have the same number of items
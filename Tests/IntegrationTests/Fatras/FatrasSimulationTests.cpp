@@ -19,6 +19,7 @@
 #include "Acts/Propagator/StraightLineStepper.hpp"
 #include "Acts/Tests/CommonHelpers/CylindricalTrackingGeometry.hpp"
 #include "Acts/Utilities/UnitVectors.hpp"
+#include "ActsFatras/EventData/Columns.hpp"
 #include "ActsFatras/Kernel/PhysicsList.hpp"
 #include "ActsFatras/Kernel/Simulator.hpp"
 #include "ActsFatras/Physics/StandardPhysicsLists.hpp"
@@ -237,3 +238,101 @@ BOOST_DATA_TEST_CASE(FatrasSimulation, dataset, pdg, phi, eta, p,
     BOOST_TEST(containsParticleId(simulatedFinal, hit));
   }
 }
+
+BOOST_AUTO_TEST_CASE(FatrasSimulationParallel) {
+  Acts::GeometryContext geoCtx;
+  Acts::MagneticFieldContext magCtx;
+  Acts::Logging::Level logLevel = Acts::Logging::Level::WARNING;
+
+  // construct the example detector
+  Acts::Test::CylindricalTrackingGeometry geoBuilder(geoCtx);
+  auto trackingGeometry = geoBuilder();
+
+  // construct the propagators
+  Navigator navigator(trackingGeometry);
+  ChargedStepper chargedStepper(Acts::ConstantBField(0, 0, 1_T));
+  ChargedPropagator chargedPropagator(std::move(chargedStepper), navigator);
+  NeutralPropagator neutralPropagator(NeutralStepper(), navigator);
+
+  // construct the simulator
+  ChargedSimulator simulatorCharged(std::move(chargedPropagator), logLevel);
+  NeutralSimulator simulatorNeutral(std::move(neutralPropagator), logLevel);
+  Simulator simulator(std::move(simulatorCharged), std::move(simulatorNeutral));
+
+  // input particles in all directions, some of them split into secondaries
+  std::vector<ActsFatras::Particle> input;
+  const std::vector<Acts::PdgParticle> pdgs = {
+      Acts::PdgParticle::eElectron, Acts::PdgParticle::eMuon,
+      Acts::PdgParticle::ePionPlus, Acts::PdgParticle::ePionZero};
+  for (std::size_t i = 0; i < 64; ++i) {
+    const auto pid =
+        ActsFatras::Barcode().setVertexPrimary(1).setParticle(i + 1);
+    const auto phi = -M_PI + (i % 8) * M_PI / 4 + 0.1;
+    const auto eta = -2.0 + (i / 8) * 0.5;
+    input.push_back(
+        ActsFatras::Particle(pid, pdgs[i % pdgs.size()])
+            .setDirection(Acts::makeDirectionUnitFromPhiEta(phi, eta))
+            .setAbsMomentum((i % 3 == 0) ? 12_GeV : 2_GeV));
+  }
+
+  struct Output {
+    std::vector<ActsFatras::Particle> initial;
+    std::vector<ActsFatras::Particle> final;
+    std::vector<ActsFatras::Hit> hits;
+  };
+  auto run = [&](std::size_t nThreads) {
+    Output output;
+    auto result = simulator.simulateParallel<Generator>(
+        geoCtx, magCtx, 1234u, input, output.initial, output.final,
+        output.hits, nThreads);
+    BOOST_TEST(result.ok());
+    BOOST_TEST(result.value().empty());
+    return output;
+  };
+  const auto checkParticles = [](const auto& lhs, const auto& rhs) {
+    BOOST_TEST_REQUIRE(lhs.size() == rhs.size());
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+      BOOST_TEST(lhs[i].particleId() == rhs[i].particleId());
+      BOOST_TEST(lhs[i].position4() == rhs[i].position4());
+      BOOST_TEST(lhs[i].momentum4() == rhs[i].momentum4());
+    }
+  };
+
+  const auto serial = run(1u);
+  BOOST_TEST(input.size() < serial.initial.size());
+  BOOST_TEST(0u < serial.hits.size());
+  for (std::size_t nThreads : {2u, 4u, 7u}) {
+    const auto parallel = run(nThreads);
+    checkParticles(serial.initial, parallel.initial);
+    checkParticles(serial.final, parallel.final);
+    BOOST_TEST_REQUIRE(serial.hits.size() == parallel.hits.size());
+    for (std::size_t i = 0; i < serial.hits.size(); ++i) {
+      BOOST_TEST(serial.hits[i].geometryId() == parallel.hits[i].geometryId());
+      BOOST_TEST(serial.hits[i].particleId() == parallel.hits[i].particleId());
+      BOOST_TEST(serial.hits[i].position4() == parallel.hits[i].position4());
+      BOOST_TEST(serial.hits[i].momentum4Before() ==
+                 parallel.hits[i].momentum4Before());
+      BOOST_TEST(serial.hits[i].momentum4After() ==
+                 parallel.hits[i].momentum4After());
+    }
+  }
+
+  // columnar outputs contain the same content
+  ActsFatras::ParticleColumns initial, final;
+  ActsFatras::HitColumns hits;
+  auto result = simulator.simulateParallel<Generator>(
+      geoCtx, magCtx, 1234u, input, initial, final, hits, 3u);
+  BOOST_TEST(result.ok());
+  BOOST_TEST_REQUIRE(initial.size() == serial.initial.size());
+  BOOST_TEST_REQUIRE(final.size() == serial.final.size());
+  BOOST_TEST_REQUIRE(hits.size() == serial.hits.size());
+  for (std::size_t i = 0; i < initial.size(); ++i) {
+    BOOST_TEST(initial.particleId[i] == serial.initial[i].particleId());
+    BOOST_TEST(final.absMomentum[i] == serial.final[i].absMomentum());
+    BOOST_TEST(final.unitDirection[i] == serial.final[i].unitDirection());
+  }
+  for (std::size_t i = 0; i < hits.size(); ++i) {
+    BOOST_TEST(hits.geometryId[i] == serial.hits[i].geometryId());
+    BOOST_TEST(hits.position4[i] == serial.hits[i].position4());
+  }
+}
@@ -18,6 +18,7 @@
 #include "Acts/Utilities/TypeTraits.hpp"
 
 #include <iostream>
+#include <vector>
 
 using std::cout;
 using std::endl;
@@ -159,6 +160,144 @@ BOOST_AUTO_TEST_CASE(multitrajectory_build) {
   BOOST_CHECK_EQUAL_COLLECTIONS(act.begin(), act.end(), exp.begin(), exp.end());
 }
 
+BOOST_AUTO_TEST_CASE(multitrajectory_reserve_clear) {
+  MultiTrajectory<SourceLink> t;
+  t.reserve(10);
+
+  auto i0 = t.addTrackState(make_rand_trackstate());
+  auto i1 = t.addTrackState(make_rand_trackstate(), i0);
+  BOOST_CHECK_EQUAL(i0, 0u);
+  BOOST_CHECK_EQUAL(i1, 1u);
+
+  // the indices start from zero again after clearing
+  t.clear();
+  auto j0 = t.addTrackState(TrackStatePropMask::All);
+  auto j1 = t.addTrackState(TrackStatePropMask::All, j0);
+  BOOST_CHECK_EQUAL(j0, 0u);
+  BOOST_CHECK_EQUAL(j1, 1u);
+
+  auto ts = t.getTrackState(j1);
+  BOOST_CHECK_EQUAL(ts.previous(), j0);
+  BOOST_CHECK_EQUAL(ts.data().ipredicted, 3u);
+  BOOST_CHECK_EQUAL(ts.data().ifiltered, 4u);
+  BOOST_CHECK_EQUAL(ts.data().ismoothed, 5u);
+  BOOST_CHECK_EQUAL(ts.data().ijacobian, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(multitrajectory_allocation_mask) {
+  namespace PM = TrackStatePropMask;
+  MultiTrajectory<SourceLink> t(PM::Predicted | PM::Filtered | PM::Calibrated);
+  BOOST_CHECK(t.allocationMask() ==
+              (PM::Predicted | PM::Filtered | PM::Calibrated));
+  t.reserve(4);
+
+  // components outside of the allocation mask are never allocated
+  auto i0 = t.addTrackState(PM::All);
+  auto ts0 = t.getTrackState(i0);
+  BOOST_CHECK(ts0.hasPredicted());
+  BOOST_CHECK(ts0.hasFiltered());
+  BOOST_CHECK(!ts0.hasSmoothed());
+  BOOST_CHECK(!ts0.hasJacobian());
+  BOOST_CHECK(!ts0.hasUncalibrated());
+  BOOST_CHECK(ts0.hasCalibrated());
+  BOOST_CHECK(ts0.hasProjector());
+  // parameters columns are only used by predicted and filtered
+  BOOST_CHECK_EQUAL(ts0.data().ipredicted, 0u);
+  BOOST_CHECK_EQUAL(ts0.data().ifiltered, 1u);
+
+  auto i1 = t.addTrackState(PM::Predicted | PM::Smoothed, i0);
+  auto ts1 = t.getTrackState(i1);
+  BOOST_CHECK(ts1.hasPredicted());
+  BOOST_CHECK(!ts1.hasFiltered());
+  BOOST_CHECK(!ts1.hasSmoothed());
+  BOOST_CHECK_EQUAL(ts1.data().ipredicted, 2u);
+
+  // the same holds for track states with full information
+  auto [rts, fm, meas] = make_trackstate();
+  auto i2 = t.addTrackState(rts, i1);
+  auto ts2 = t.getTrackState(i2);
+  BOOST_CHECK(ts2.hasPredicted());
+  BOOST_CHECK(ts2.hasFiltered());
+  BOOST_CHECK(!ts2.hasSmoothed());
+  BOOST_CHECK(!ts2.hasJacobian());
+  BOOST_CHECK(!ts2.hasUncalibrated());
+  BOOST_CHECK(ts2.hasCalibrated());
+  BOOST_CHECK_EQUAL(ts2.predicted(), rts.parameter.predicted->parameters());
+  BOOST_CHECK_EQUAL(ts2.filtered(), rts.parameter.filtered->parameters());
+}
+
+BOOST_AUTO_TEST_CASE(multitrajectory_surface_ownership) {
+  auto plane = Surface::makeShared<PlaneSurface>(Vector3D{0., 0., 0.},
+                                                 Vector3D{0., 0., 1.});
+  const auto useCount = plane.use_count();
+
+  // shared ownership keeps the surface alive
+  MultiTrajectory<SourceLink> owning;
+  BOOST_CHECK(owning.sharesSurfaceOwnership());
+  auto ts = owning.getTrackState(owning.addTrackState());
+  ts.setReferenceSurface(plane);
+  BOOST_CHECK_EQUAL(plane.use_count(), useCount + 1);
+  // surfaces set by pointer are never owned
+  ts.setReferenceSurface(plane.get());
+  BOOST_CHECK_EQUAL(plane.use_count(), useCount);
+
+  // only pointers are stored without shared ownership
+  MultiTrajectory<SourceLink> t(TrackStatePropMask::All, false);
+  BOOST_CHECK(!t.sharesSurfaceOwnership());
+  auto nts = t.getTrackState(t.addTrackState());
+  nts.setReferenceSurface(plane);
+  BOOST_CHECK_EQUAL(plane.use_count(), useCount);
+  BOOST_CHECK_EQUAL(&nts.referenceSurface(), plane.get());
+  BOOST_CHECK_EQUAL(nts.referenceSurface().geoID(), plane->geoID());
+
+  // the parameters still refer to the same surface
+  nts.predicted() << 1, 2, M_PI / 4., M_PI / 2., 5, 0.;
+  nts.predictedCovariance() = CovMat_t::Identity();
+  auto pars = nts.predictedParameters(gctx);
+  BOOST_CHECK_EQUAL(&pars.referenceSurface(), plane.get());
+  BOOST_CHECK_EQUAL(pars.parameters(), nts.predicted());
+  // without taking ownership of the surface
+  BOOST_CHECK_EQUAL(plane.use_count(), useCount);
+}
+
+BOOST_AUTO_TEST_CASE(multitrajectory_event_arena) {
+  namespace PM = TrackStatePropMask;
+  auto plane = Surface::makeShared<PlaneSurface>(Vector3D{0., 0., 0.},
+                                                 Vector3D{0., 0., 1.});
+  // many short tracks stored in a single trajectory, reused between events
+  MultiTrajectory<SourceLink> t(PM::Predicted | PM::Filtered, false);
+  const size_t nTracks = 10000;
+  const size_t nStatesPerTrack = 10;
+
+  for (size_t event = 0; event < 2; ++event) {
+    t.clear();
+    t.reserve(nTracks * nStatesPerTrack);
+
+    std::vector<size_t> tips;
+    for (size_t itrack = 0; itrack < nTracks; ++itrack) {
+      size_t tip = SIZE_MAX;
+      for (size_t istate = 0; istate < nStatesPerTrack; ++istate) {
+        tip = t.addTrackState(PM::All, tip);
+        auto ts = t.getTrackState(tip);
+        ts.setReferenceSurface(plane.get());
+        ts.pathLength() = itrack;
+      }
+      tips.push_back(tip);
+    }
+    // exceeds the range of 16bit indices
+    BOOST_CHECK_EQUAL(t.size(), nTracks * nStatesPerTrack);
+
+    for (size_t itrack : {size_t(0), nTracks / 2, nTracks - 1}) {
+      size_t n = 0;
+      t.visitBackwards(tips[itrack], [&](const auto& ts) {
+        BOOST_CHECK_EQUAL(ts.pathLength(), itrack);
+        n++;
+      });
+      BOOST_CHECK_EQUAL(n, nStatesPerTrack);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_CASE(visit_apply_abort) {
   MultiTrajectory<SourceLink> t;
 
@@ -0,0 +1,320 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <vector>
+
+#include "Acts/EventData/Measurement.hpp"
+#include "Acts/EventData/MeasurementHelpers.hpp"
+#include "Acts/EventData/TrackParameters.hpp"
+#include "Acts/Fitter/CombinatorialKalmanFitter.hpp"
+#include "Acts/Fitter/GainMatrixUpdater.hpp"
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/Geometry/TrackingGeometry.hpp"
+#include "Acts/MagneticField/ConstantBField.hpp"
+#include "Acts/MagneticField/MagneticFieldContext.hpp"
+#include "Acts/Propagator/EigenStepper.hpp"
+#include "Acts/Propagator/Navigator.hpp"
+#include "Acts/Propagator/Propagator.hpp"
+#include "Acts/Propagator/StraightLineStepper.hpp"
+#include "Acts/Propagator/detail/StandardAborters.hpp"
+#include "Acts/Surfaces/Surface.hpp"
+#include "Acts/Tests/CommonHelpers/CubicTrackingGeometry.hpp"
+#include "Acts/Utilities/CalibrationContext.hpp"
+#include "Acts/Utilities/Definitions.hpp"
+
+using namespace Acts::UnitLiterals;
+
+namespace Acts {
+namespace Test {
+
+using SourceLink = MinimalSourceLink;
+using Covariance = BoundSymMatrix;
+
+// Create a test context
+GeometryContext tgContext = GeometryContext();
+MagneticFieldContext mfContext = MagneticFieldContext();
+CalibrationContext calContext = CalibrationContext();
+
+/// @brief Collects the sensitive surfaces and the volume boundaries, and the
+/// local positions of the true track on them
+struct SensitiveHitCollector {
+  struct this_result {
+    std::vector<std::pair<const Surface*, Vector2D>> hits;
+    std::vector<std::pair<const Surface*, Vector2D>> boundaryHits;
+  };
+
+  using result_type = this_result;
+
+  template <typename propagator_state_t, typename stepper_t>
+  void operator()(propagator_state_t& state, const stepper_t& stepper,
+                  result_type& result) const {
+    auto surface = state.navigation.currentSurface;
+    if (surface == nullptr) {
+      return;
+    }
+    Vector2D lPos;
+    surface->globalToLocal(state.geoContext, stepper.position(state.stepping),
+                           stepper.direction(state.stepping), lPos);
+    if (surface->associatedDetectorElement()) {
+      result.hits.emplace_back(surface, lPos);
+    } else if (surface->geoID().boundary() != 0 and
+               (result.boundaryHits.empty() or
+                result.boundaryHits.back().first != surface)) {
+      result.boundaryHits.emplace_back(surface, lPos);
+    }
+  }
+};
+
+struct CombinatorialKalmanFitterFixture {
+  using MeasurementPropagator = Propagator<StraightLineStepper, Navigator>;
+  using RecoStepper = EigenStepper<ConstantBField>;
+  using RecoPropagator = Propagator<RecoStepper, Navigator>;
+  using Updater = GainMatrixUpdater<BoundParameters>;
+  using TrackFinder = CombinatorialKalmanFitter<RecoPropagator, Updater>;
+
+  CombinatorialKalmanFitterFixture()
+      : cGeometry(tgContext),
+        detector(cGeometry()),
+        bField(Vector3D(0., 0., 0.)),
+        ckf(RecoPropagator(RecoStepper(bField), makeNavigator())) {
+    // Collect the true hits of a straight track along the x-axis
+    MeasurementPropagator mPropagator(StraightLineStepper(), makeNavigator());
+    SingleCurvilinearTrackParameters<NeutralPolicy> mStart(
+        std::nullopt, startPos, startMom, 42_ns);
+    PropagatorOptions<ActionList<SensitiveHitCollector>,
+                      AbortList<detail::EndOfWorldReached>>
+        mOptions(tgContext, mfContext);
+    auto collected = mPropagator.propagate(mStart, mOptions)
+                         .value()
+                         .template get<SensitiveHitCollector::result_type>();
+    hits = std::move(collected.hits);
+    boundaryHits = std::move(collected.boundaryHits);
+  }
+
+  Navigator makeNavigator() const {
+    Navigator navigator(detector);
+    navigator.resolvePassive = false;
+    navigator.resolveMaterial = true;
+    navigator.resolveSensitive = true;
+    return navigator;
+  }
+
+  /// Add a measurement on the i-th hit surface with an offset in loc0
+  void addMeasurement(size_t ihit, double offset = 0.) {
+    addMeasurement(hits.at(ihit), offset);
+  }
+
+  /// Add a measurement on a hit surface with an offset in loc0
+  void addMeasurement(const std::pair<const Surface*, Vector2D>& hit,
+                      double offset) {
+    const auto& [surface, lPos] = hit;
+    ActsSymMatrixD<2> cov2D;
+    cov2D << resolution * resolution, 0., 0., resolution * resolution;
+    measurements.push_back(Measurement<SourceLink, eLOC_0, eLOC_1>(
+        surface->getSharedPtr(), {}, cov2D, lPos[eLOC_0] + offset,
+        lPos[eLOC_1]));
+  }
+
+  std::vector<SourceLink> sourceLinks() const {
+    std::vector<SourceLink> sourcelinks;
+    std::transform(measurements.begin(), measurements.end(),
+                   std::back_inserter(sourcelinks),
+                   [](const auto& m) { return SourceLink{&m}; });
+    return sourcelinks;
+  }
+
+  SingleCurvilinearTrackParameters<ChargedPolicy> seed() const {
+    Covariance cov;
+    cov << 1000_um, 0., 0., 0., 0., 0., 0., 1000_um, 0., 0., 0., 0., 0., 0.,
+        0.05, 0., 0., 0., 0., 0., 0., 0.05, 0., 0., 0., 0., 0., 0., 0.01, 0.,
+        0., 0., 0., 0., 0., 1.;
+    return SingleCurvilinearTrackParameters<ChargedPolicy>(cov, startPos,
+                                                           startMom, 1., 42.);
+  }
+
+  Vector3D startPos{-3_m, 0., 0.};
+  Vector3D startMom{1_GeV, 0., 0.};
+  double resolution = 50_um;
+
+  // The geometry builder owns the detector elements
+  CubicTrackingGeometry cGeometry;
+  std::shared_ptr<const TrackingGeometry> detector;
+  ConstantBField bField;
+  TrackFinder ckf;
+  std::vector<std::pair<const Surface*, Vector2D>> hits;
+  std::vector<std::pair<const Surface*, Vector2D>> boundaryHits;
+  // std::list keeps the measurements in place for the source links
+  std::list<FittableMeasurement<SourceLink>> measurements;
+};
+
+BOOST_FIXTURE_TEST_CASE(ckf_single_track, CombinatorialKalmanFitterFixture) {
+  BOOST_CHECK_EQUAL(hits.size(), 6u);
+  for (size_t i = 0; i < hits.size(); ++i) {
+    addMeasurement(i);
+  }
+  // An incompatible measurement after the track is constrained
+  addMeasurement(3, 5_mm);
+
+  CombinatorialKalmanFitterOptions options(tgContext, mfContext, calContext);
+  auto res = ckf.findTracks(sourceLinks(), seed(), options);
+  BOOST_CHECK(res.ok());
+  auto& found = *res;
+  BOOST_CHECK_EQUAL(found.tracks.size(), 1u);
+  BOOST_CHECK_EQUAL(found.tracks[0].measurementStates, 6u);
+  BOOST_CHECK_EQUAL(found.tracks[0].holeStates, 0u);
+
+  size_t nMeasurements = 0;
+  found.fittedStates.visitBackwards(
+      found.tracks[0].trackTip, [&](const auto& state) {
+        if (state.typeFlags().test(TrackStateFlag::MeasurementFlag)) {
+          BOOST_CHECK(state.hasFiltered());
+          BOOST_CHECK_LT(state.chi2(), options.maxChi2);
+          ++nMeasurements;
+        }
+      });
+  BOOST_CHECK_EQUAL(nMeasurements, 6u);
+}
+
+BOOST_FIXTURE_TEST_CASE(ckf_branching, CombinatorialKalmanFitterFixture) {
+  for (size_t i = 0; i < hits.size(); ++i) {
+    addMeasurement(i);
+  }
+  // A second compatible measurement splits the track
+  addMeasurement(3, resolution);
+
+  CombinatorialKalmanFitterOptions options(tgContext, mfContext, calContext);
+  auto res = ckf.findTracks(sourceLinks(), seed(), options);
+  BOOST_CHECK(res.ok());
+  auto& found = *res;
+  BOOST_CHECK_EQUAL(found.tracks.size(), 2u);
+
+  // Both candidates share the track states before the split
+  std::vector<std::vector<size_t>> indices;
+  for (const auto& track : found.tracks) {
+    BOOST_CHECK_EQUAL(track.measurementStates, 6u);
+    std::vector<size_t> trackIndices;
+    found.fittedStates.visitBackwards(track.trackTip, [&](const auto& state) {
+      trackIndices.push_back(state.index());
+    });
+    std::reverse(trackIndices.begin(), trackIndices.end());
+    indices.push_back(std::move(trackIndices));
+  }
+  BOOST_CHECK_EQUAL(indices[0].size(), indices[1].size());
+  size_t nShared = 0;
+  while (nShared < indices[0].size() and
+         indices[0][nShared] == indices[1][nShared]) {
+    ++nShared;
+  }
+  BOOST_CHECK_GT(nShared, 0u);
+  BOOST_CHECK_LT(nShared, indices[0].size());
+
+  // The split states share their predicted parameters
+  auto state0 = found.fittedStates.getTrackState(indices[0][nShared]);
+  auto state1 = found.fittedStates.getTrackState(indices[1][nShared]);
+  BOOST_CHECK_EQUAL(state0.data().ipredicted, state1.data().ipredicted);
+  BOOST_CHECK_NE(state0.data().ifiltered, state1.data().ifiltered);
+
+  // The per-surface budget prevents the split
+  options.maxBranchesPerSurface = 1;
+  res = ckf.findTracks(sourceLinks(), seed(), options);
+  BOOST_CHECK(res.ok());
+  BOOST_CHECK_EQUAL((*res).tracks.size(), 1u);
+
+  // The total budget prevents the split
+  options.maxBranchesPerSurface = 10;
+  options.maxCandidates = 1;
+  res = ckf.findTracks(sourceLinks(), seed(), options);
+  BOOST_CHECK(res.ok());
+  BOOST_CHECK_EQUAL((*res).tracks.size(), 1u);
+}
+
+BOOST_FIXTURE_TEST_CASE(ckf_branching_on_boundary,
+                        CombinatorialKalmanFitterFixture) {
+  // The track crosses the boundary between the two volumes at x = 0
+  auto glued = std::find_if(
+      boundaryHits.begin(), boundaryHits.end(), [](const auto& hit) {
+        return std::abs(hit.first->center(tgContext).x()) < 1_um;
+      });
+  BOOST_REQUIRE(glued != boundaryHits.end());
+  BOOST_CHECK_EQUAL(glued->first->associatedLayer(), nullptr);
+  for (size_t i = 0; i < hits.size(); ++i) {
+    addMeasurement(i);
+  }
+  // Two compatible measurements split the track on the boundary surface,
+  // which has no associated layer
+  addMeasurement(*glued, 0.);
+  addMeasurement(*glued, resolution);
+
+  CombinatorialKalmanFitterOptions options(tgContext, mfContext, calContext);
+  auto res = ckf.findTracks(sourceLinks(), seed(), options);
+  BOOST_CHECK(res.ok());
+  auto& found = *res;
+  // The resumed branch finds the sensitive surfaces behind the boundary
+  BOOST_CHECK_EQUAL(found.tracks.size(), 2u);
+  for (const auto& track : found.tracks) {
+    BOOST_CHECK_EQUAL(track.measurementStates, 7u);
+    BOOST_CHECK_EQUAL(track.holeStates, 0u);
+  }
+  // The resume surface is cleared once the branch moved on
+  BOOST_CHECK_EQUAL(found.resumeSurface, nullptr);
+}
+
+/// Calibrator counting its calls
+struct CountingCalibrator {
+  static size_t nCalls;
+
+  template <typename source_link_t, typename parameters_t>
+  FittableMeasurement<source_link_t> operator()(
+      const source_link_t& sl, const parameters_t& pars) const {
+    ++nCalls;
+    return VoidMeasurementCalibrator()(sl, pars);
+  }
+};
+
+size_t CountingCalibrator::nCalls = 0;
+
+BOOST_FIXTURE_TEST_CASE(ckf_calibrates_once,
+                        CombinatorialKalmanFitterFixture) {
+  for (size_t i = 0; i < hits.size(); ++i) {
+    addMeasurement(i);
+  }
+  addMeasurement(3, 5_mm);
+
+  using CountingTrackFinder =
+      CombinatorialKalmanFitter<RecoPropagator, Updater, CountingCalibrator>;
+  CountingTrackFinder countingCkf(
+      RecoPropagator(RecoStepper(bField), makeNavigator()));
+  CombinatorialKalmanFitterOptions options(tgContext, mfContext, calContext);
+  CountingCalibrator::nCalls = 0;
+  auto res = countingCkf.findTracks(sourceLinks(), seed(), options);
+  BOOST_CHECK(res.ok());
+  BOOST_CHECK_EQUAL((*res).tracks.size(), 1u);
+  // Every measurement is calibrated once, during the selection
+  BOOST_CHECK_EQUAL(CountingCalibrator::nCalls, measurements.size());
+
+  // The compatible measurements are copies, valid after the call
+  for (const auto& candidate : (*res).compatibleMeasurements) {
+    BOOST_CHECK_EQUAL(&candidate.sourceLink.referenceSurface(),
+                      hits.back().first);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(ckf_no_measurements,
+                        CombinatorialKalmanFitterFixture) {
+  CombinatorialKalmanFitterOptions options(tgContext, mfContext, calContext);
+  auto res = ckf.findTracks(sourceLinks(), seed(), options);
+  BOOST_CHECK(!res.ok());
+}
+
+}  // namespace Test
+}  // namespace Acts
@@ -0,0 +1,245 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <list>
+#include <random>
+#include <vector>
+
+#include "Acts/EventData/Measurement.hpp"
+#include "Acts/EventData/MeasurementHelpers.hpp"
+#include "Acts/EventData/TrackParameters.hpp"
+#include "Acts/Fitter/GaussianSumFitter.hpp"
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/Geometry/TrackingGeometry.hpp"
+#include "Acts/MagneticField/ConstantBField.hpp"
+#include "Acts/MagneticField/MagneticFieldContext.hpp"
+#include "Acts/Propagator/MultiEigenStepper.hpp"
+#include "Acts/Propagator/Navigator.hpp"
+#include "Acts/Propagator/Propagator.hpp"
+#include "Acts/Propagator/StraightLineStepper.hpp"
+#include "Acts/Propagator/detail/StandardAborters.hpp"
+#include "Acts/Surfaces/Surface.hpp"
+#include "Acts/Tests/CommonHelpers/CubicTrackingGeometry.hpp"
+#include "Acts/Tests/CommonHelpers/FloatComparisons.hpp"
+#include "Acts/Utilities/CalibrationContext.hpp"
+#include "Acts/Utilities/Definitions.hpp"
+
+using namespace Acts::UnitLiterals;
+
+namespace Acts {
+namespace Test {
+
+using SourceLink = MinimalSourceLink;
+using Covariance = BoundSymMatrix;
+
+// Create a test context
+GeometryContext tgContext = GeometryContext();
+MagneticFieldContext mfContext = MagneticFieldContext();
+CalibrationContext calContext = CalibrationContext();
+
+/// @brief Collects the sensitive surfaces and the local positions of the
+/// true track on them
+struct SensitiveHitCollector {
+  struct this_result {
+    std::vector<std::pair<const Surface*, Vector2D>> hits;
+  };
+
+  using result_type = this_result;
+
+  template <typename propagator_state_t, typename stepper_t>
+  void operator()(propagator_state_t& state, const stepper_t& stepper,
+                  result_type& result) const {
+    auto surface = state.navigation.currentSurface;
+    if (surface and surface->associatedDetectorElement()) {
+      Vector2D lPos;
+      surface->globalToLocal(state.geoContext,
+                             stepper.position(state.stepping),
+                             stepper.direction(state.stepping), lPos);
+      result.hits.emplace_back(surface, lPos);
+    }
+  }
+};
+
+struct GaussianSumFitterFixture {
+  using MeasurementPropagator = Propagator<StraightLineStepper, Navigator>;
+  using RecoStepper = MultiEigenStepper<ConstantBField>;
+  using RecoPropagator = Propagator<RecoStepper, Navigator>;
+  using Fitter = GaussianSumFitter<RecoPropagator>;
+
+  GaussianSumFitterFixture()
+      : cGeometry(tgContext),
+        detector(cGeometry()),
+        bField(Vector3D(0., 0., 0.)),
+        gsf(RecoPropagator(RecoStepper(bField), makeNavigator())) {
+    // Collect the true hits of a straight track along the x-axis
+    MeasurementPropagator mPropagator(StraightLineStepper(), makeNavigator());
+    SingleCurvilinearTrackParameters<NeutralPolicy> mStart(
+        std::nullopt, startPos, startMom, 42_ns);
+    PropagatorOptions<ActionList<SensitiveHitCollector>,
+                      AbortList<detail::EndOfWorldReached>>
+        mOptions(tgContext, mfContext);
+    hits = std::move(mPropagator.propagate(mStart, mOptions)
+                         .value()
+                         .template get<SensitiveHitCollector::result_type>()
+                         .hits);
+    for (const auto& [surface, lPos] : hits) {
+      ActsSymMatrixD<2> cov2D;
+      cov2D << resolution * resolution, 0., 0., resolution * resolution;
+      measurements.push_back(Measurement<SourceLink, eLOC_0, eLOC_1>(
+          surface->getSharedPtr(), {}, cov2D, lPos[eLOC_0], lPos[eLOC_1]));
+    }
+    std::transform(measurements.begin(), measurements.end(),
+                   std::back_inserter(sourcelinks),
+                   [](const auto& m) { return SourceLink{&m}; });
+  }
+
+  Navigator makeNavigator() const {
+    Navigator navigator(detector);
+    navigator.resolvePassive = false;
+    navigator.resolveMaterial = true;
+    navigator.resolveSensitive = true;
+    return navigator;
+  }
+
+  SingleCurvilinearTrackParameters<ChargedPolicy> start() const {
+    Covariance cov;
+    cov << 1000_um, 0., 0., 0., 0., 0., 0., 1000_um, 0., 0., 0., 0., 0., 0.,
+        0.05, 0., 0., 0., 0., 0., 0., 0.05, 0., 0., 0., 0., 0., 0., 0.01, 0.,
+        0., 0., 0., 0., 0., 1.;
+    return SingleCurvilinearTrackParameters<ChargedPolicy>(cov, startPos,
+                                                           startMom, -1., 42.);
+  }
+
+  Vector3D startPos{-3_m, 0., 0.};
+  Vector3D startMom{1_GeV, 0., 0.};
+  double resolution = 50_um;
+
+  // The geometry builder owns the detector elements
+  CubicTrackingGeometry cGeometry;
+  std::shared_ptr<const TrackingGeometry> detector;
+  ConstantBField bField;
+  Fitter gsf;
+  std::vector<std::pair<const Surface*, Vector2D>> hits;
+  // std::list keeps the measurements in place for the source links
+  std::list<FittableMeasurement<SourceLink>> measurements;
+  std::vector<SourceLink> sourcelinks;
+};
+
+BOOST_FIXTURE_TEST_CASE(gsf_electron, GaussianSumFitterFixture) {
+  BOOST_CHECK_EQUAL(hits.size(), 6u);
+
+  GaussianSumFitterOptions options(tgContext, mfContext, calContext, 4);
+  auto res = gsf.fit(sourcelinks, start(), options);
+  BOOST_CHECK(res.ok());
+  auto& fitted = *res;
+  BOOST_CHECK_EQUAL(fitted.measurementStates, 6u);
+  BOOST_CHECK(fitted.missedActiveSurfaces.empty());
+
+  // The bremsstrahlung splits the components, the mixture stays bounded
+  BOOST_CHECK_GT(fitted.fittedComponents.size(), 1u);
+  BOOST_CHECK_LE(fitted.fittedComponents.size(), 4u);
+  double sumWeights = 0.;
+  for (const auto& cmp : fitted.fittedComponents) {
+    sumWeights += cmp.weight;
+  }
+  CHECK_CLOSE_REL(sumWeights, 1., 1e-6);
+
+  // The fitted position is compatible with the last hit
+  const auto& fittedParameters = fitted.fittedParameters.value();
+  BOOST_CHECK_EQUAL(&fittedParameters.referenceSurface(), hits.back().first);
+  CHECK_CLOSE_ABS(fittedParameters.parameters()[eLOC_0],
+                  hits.back().second[eLOC_0], 3 * resolution);
+  CHECK_CLOSE_ABS(fittedParameters.parameters()[eLOC_1],
+                  hits.back().second[eLOC_1], 3 * resolution);
+
+  size_t nMeasurements = 0;
+  fitted.fittedStates.visitBackwards(fitted.trackTip, [&](const auto& state) {
+    if (state.typeFlags().test(TrackStateFlag::MeasurementFlag)) {
+      BOOST_CHECK(state.hasFiltered());
+      ++nMeasurements;
+    }
+  });
+  BOOST_CHECK_EQUAL(nMeasurements, 6u);
+}
+
+BOOST_FIXTURE_TEST_CASE(gsf_single_component, GaussianSumFitterFixture) {
+  // Without energy loss the mixture is a single Gaussian
+  GaussianSumFitterOptions options(tgContext, mfContext, calContext, 4, true,
+                                   false);
+  auto res = gsf.fit(sourcelinks, start(), options);
+  BOOST_CHECK(res.ok());
+  BOOST_CHECK_EQUAL((*res).fittedComponents.size(), 1u);
+  BOOST_CHECK_EQUAL((*res).measurementStates, 6u);
+
+  // No measurements, no fit
+  res = gsf.fit(std::vector<SourceLink>(), start(), options);
+  BOOST_CHECK(!res.ok());
+}
+
+BOOST_AUTO_TEST_CASE(gaussian_mixture_reduction) {
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> uniform(0.1, 1.);
+  std::vector<detail::GaussianComponent> mixture(48);
+  for (auto& cmp : mixture) {
+    cmp.weight = uniform(generator);
+    cmp.parameters << uniform(generator), uniform(generator),
+        uniform(generator), uniform(generator), uniform(generator),
+        uniform(generator);
+    cmp.covariance = BoundSymMatrix::Identity() * uniform(generator);
+  }
+  detail::normalizeWeights(mixture);
+
+  // Reference: rescan all pairs for every merge
+  auto reference = mixture;
+  while (reference.size() > 6) {
+    size_t iMin = 0;
+    size_t jMin = 1;
+    for (size_t i = 0; i < reference.size(); ++i) {
+      for (size_t j = i + 1; j < reference.size(); ++j) {
+        if (detail::qOverPDistance(reference[i], reference[j]) <
+            detail::qOverPDistance(reference[iMin], reference[jMin])) {
+          iMin = i;
+          jMin = j;
+        }
+      }
+    }
+    detail::mergeComponents(reference[iMin], reference[jMin]);
+    reference.erase(reference.begin() + jMin);
+  }
+
+  std::vector<std::pair<size_t, double>> neighbours;
+  detail::reduceMixture(mixture, 6, neighbours);
+  BOOST_CHECK_EQUAL(mixture.size(), reference.size());
+
+  // The same components are merged, regardless of the order
+  auto byQOverP = [](const auto& a, const auto& b) {
+    return a.parameters[eQOP] < b.parameters[eQOP];
+  };
+  std::sort(mixture.begin(), mixture.end(), byQOverP);
+  std::sort(reference.begin(), reference.end(), byQOverP);
+  for (size_t i = 0; i < reference.size(); ++i) {
+    CHECK_CLOSE_REL(mixture[i].weight, reference[i].weight, 1e-9);
+    CHECK_CLOSE_REL(mixture[i].parameters, reference[i].parameters, 1e-9);
+  }
+
+  // The moments of the mixture are preserved
+  BoundVector mean;
+  BoundSymMatrix covariance;
+  BoundVector refMean;
+  BoundSymMatrix refCovariance;
+  detail::combineComponents(mixture, mean, covariance);
+  detail::combineComponents(reference, refMean, refCovariance);
+  CHECK_CLOSE_REL(mean, refMean, 1e-9);
+  CHECK_CLOSE_COVARIANCE(covariance, refCovariance, 1e-9);
+}
+
+}  // namespace Test
+}  // namespace Acts
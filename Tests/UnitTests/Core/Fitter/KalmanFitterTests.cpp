@@ -26,6 +26,7 @@
 #include "Acts/Geometry/TrackingGeometry.hpp"
 #include "Acts/MagneticField/ConstantBField.hpp"
 #include "Acts/MagneticField/MagneticFieldContext.hpp"
+#include "Acts/Propagator/DirectNavigator.hpp"
 #include "Acts/Propagator/EigenStepper.hpp"
 #include "Acts/Propagator/Navigator.hpp"
 #include "Acts/Propagator/Propagator.hpp"
@@ -477,6 +478,76 @@ BOOST_AUTO_TEST_CASE(kalman_fitter_zero_field) {
     }
   });
   BOOST_CHECK_EQUAL(nOutliers, 1u);
+
+  // Fit a batch of tracks, distributed over two threads
+  kfOptions.backwardFiltering = false;
+  std::vector<std::pair<std::vector<SourceLink>,
+                        SingleCurvilinearTrackParameters<ChargedPolicy>>>
+      batch = {{sourcelinks, rStart},
+               {shuffledMeasurements, rStart},
+               {measurementsWithHole, rStart}};
+  auto batchRes = kFitter.fitBatch(batch, kfOptions, 2);
+  BOOST_CHECK_EQUAL(batchRes.size(), batch.size());
+  for (size_t i = 0; i < 2; ++i) {
+    BOOST_CHECK(batchRes[i].ok());
+    auto batchParameters = batchRes[i].value().fittedParameters.value();
+    CHECK_CLOSE_REL(fittedParameters.parameters().template head<5>(),
+                    batchParameters.parameters().template head<5>(), 1e-5);
+    CHECK_CLOSE_ABS(fittedParameters.parameters().template tail<1>(),
+                    batchParameters.parameters().template tail<1>(), 1e-5);
+  }
+  BOOST_CHECK(batchRes[2].ok());
+  BOOST_CHECK_EQUAL(batchRes[2].value().missedActiveSurfaces.size(), 1u);
+
+  // A fit state reuses the propagator state for several fits
+  auto fitState = kFitter.makeFitState<SourceLink>(rStart, kfOptions);
+  const auto& workStates =
+      fitState.result.template get<KalmanFitterResult<SourceLink>>()
+          .fittedStates;
+  auto stateRes = kFitter.fitWithState(sourcelinks, rStart, fitState);
+  BOOST_CHECK(stateRes.ok());
+  const size_t nStates = stateRes.value().fittedStates.size();
+  BOOST_CHECK_GT(nStates, 0u);
+  stateRes = kFitter.fitWithState(shuffledMeasurements, rStart, fitState);
+  BOOST_CHECK(stateRes.ok());
+  BOOST_CHECK_EQUAL(stateRes.value().fittedStates.size(), nStates);
+  // The fitted states are moved into the result, not copied
+  BOOST_CHECK_EQUAL(workStates.size(), 0u);
+  auto stateParameters = stateRes.value().fittedParameters.value();
+  CHECK_CLOSE_REL(fittedParameters.parameters().template head<5>(),
+                  stateParameters.parameters().template head<5>(), 1e-5);
+
+  // Refit along the navigation sequence of the first fit
+  auto sequence = navigationSequence(fittedTrack);
+  BOOST_CHECK_GE(sequence.size(), sourcelinks.size());
+  for (const auto& sl : sourcelinks) {
+    BOOST_CHECK(std::find(sequence.begin(), sequence.end(),
+                          &sl.referenceSurface()) != sequence.end());
+  }
+
+  using DirectPropagator = Propagator<RecoStepper, DirectNavigator>;
+  using DirectKalmanFitter =
+      Acts::KalmanFitter<DirectPropagator, Updater, Smoother,
+                         MinimalOutlierFinder>;
+  DirectPropagator dPropagator(rStepper, DirectNavigator());
+  DirectKalmanFitter dFitter(dPropagator,
+                             getDefaultLogger("KalmanFilter", Logging::INFO));
+  auto refitRes = dFitter.fit(sourcelinks, rStart, kfOptions, sequence);
+  BOOST_CHECK(refitRes.ok());
+  auto refitParameters = refitRes.value().fittedParameters.value();
+  CHECK_CLOSE_REL(fittedParameters.parameters().template head<5>(),
+                  refitParameters.parameters().template head<5>(), 1e-5);
+  CHECK_CLOSE_ABS(fittedParameters.parameters().template tail<1>(),
+                  refitParameters.parameters().template tail<1>(), 1e-5);
+  BOOST_CHECK(navigationSequence(refitRes.value()) == sequence);
+
+  // The sequence is replayed backwards for the backward filtering
+  kfOptions.backwardFiltering = true;
+  refitRes = dFitter.fit(sourcelinks, rStart, kfOptions, sequence);
+  BOOST_CHECK(refitRes.ok());
+  BOOST_CHECK(refitRes.value().forwardFiltered);
+  BOOST_CHECK_EQUAL(refitRes.value().passedAgainSurfaces.size(),
+                    sourcelinks.size());
 }
 
 }  // namespace Test
@@ -0,0 +1,69 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <vector>
+
+#include "Acts/Geometry/GeometryIDMap.hpp"
+
+namespace Acts {
+namespace Test {
+
+BOOST_AUTO_TEST_CASE(GeometryIDMap_empty) {
+  GeometryIDMap<int> map;
+  BOOST_CHECK(map.empty());
+  BOOST_CHECK(map.find(GeometryID().setVolume(3)) == nullptr);
+  BOOST_CHECK(map.find(GeometryID()) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(GeometryIDMap_find) {
+  std::vector<std::pair<GeometryID, int>> elements;
+  std::map<GeometryID, int> reference;
+  // unsorted input spread over several volumes, including the last one
+  for (GeometryID::Value volume : {255u, 1u, 7u, 2u}) {
+    for (GeometryID::Value layer = 1; layer < 5; ++layer) {
+      for (GeometryID::Value sensitive = 0; sensitive < 20; sensitive += 3) {
+        GeometryID id =
+            GeometryID().setVolume(volume).setLayer(2 * layer).setSensitive(
+                sensitive);
+        const int value = volume * 1000 + layer * 100 + sensitive;
+        elements.emplace_back(id, value);
+        reference[id] = value;
+      }
+    }
+  }
+  GeometryIDMap<int> map(elements);
+  GeometryIDMap<int> fromMap(reference);
+  BOOST_CHECK_EQUAL(map.size(), reference.size());
+  BOOST_CHECK(map.ids() == fromMap.ids());
+  BOOST_CHECK(map.values() == fromMap.values());
+
+  for (const auto& [id, value] : reference) {
+    BOOST_REQUIRE(map.find(id) != nullptr);
+    BOOST_CHECK_EQUAL(*map.find(id), value);
+    // odd layers and unknown sensitives are not stored
+    BOOST_CHECK(map.find(GeometryID(id).setLayer(id.layer() + 1)) == nullptr);
+    BOOST_CHECK(map.find(GeometryID(id).setSensitive(id.sensitive() + 1)) ==
+                nullptr);
+  }
+  BOOST_CHECK(map.find(GeometryID().setVolume(3).setLayer(2)) == nullptr);
+  BOOST_CHECK(map.find(GeometryID().setVolume(254).setLayer(2)) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(GeometryIDMap_duplicates) {
+  std::vector<std::pair<GeometryID, int>> elements = {
+      {GeometryID().setVolume(1).setLayer(2), 1},
+      {GeometryID().setVolume(1).setLayer(4), 2},
+      {GeometryID().setVolume(1).setLayer(2), 3}};
+  BOOST_CHECK_THROW(GeometryIDMap<int>{elements}, std::invalid_argument);
+}
+
+}  // namespace Test
+}  // namespace Acts
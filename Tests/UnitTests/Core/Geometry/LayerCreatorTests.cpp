@@ -461,6 +461,53 @@ BOOST_FIXTURE_TEST_CASE(LayerCreator_barrelStagger, LayerCreatorFixture) {
   checkBinning(tgContext, *layer->surfaceArray());
 }
 
+BOOST_FIXTURE_TEST_CASE(LayerCreator_createLayersOnBVH, LayerCreatorFixture) {
+  // the barrel layer has the same dimensions as with the grid lookup
+  auto brl = makeBarrel(30, 7, 2, 1.5);
+  double envR = 0.1, envZ = 0.5;
+  ProtoLayer pl(tgContext, brl);
+  pl.envR = {envR, envR};
+  pl.envZ = {envZ, envZ};
+  std::shared_ptr<CylinderLayer> cLayer =
+      std::dynamic_pointer_cast<CylinderLayer>(
+          p_LC->cylinderLayerOnBVH(tgContext, brl, pl));
+
+  double rMax = 10.6071, rMin = 9.59111;  // empirical
+  CHECK_CLOSE_REL(cLayer->thickness(), (rMax - rMin) + 2 * envR, 1e-3);
+  const CylinderBounds* cBounds = &cLayer->bounds();
+  CHECK_CLOSE_REL(cBounds->get(CylinderBounds::eR), (rMax + rMin) / 2., 1e-3);
+  CHECK_CLOSE_REL(cBounds->get(CylinderBounds::eHalfLengthZ), 14 + envZ,
+                  1e-3);
+  BOOST_CHECK(checkBinning(tgContext, *cLayer->surfaceArray()));
+  BOOST_CHECK(cLayer->surfaceArray()->getAxes().empty());
+  BOOST_CHECK_EQUAL(cLayer->surfaceArray()->surfaces().size(), brl.size());
+  for (const auto& srf : brl) {
+    BOOST_CHECK_EQUAL(srf->associatedLayer(), cLayer.get());
+  }
+
+  // the disc layer
+  std::vector<std::shared_ptr<const Surface>> surfaces;
+  for (double r : {10., 15., 20.}) {
+    auto ring = fullPhiTestSurfacesEC(30, 0, 0, r);
+    surfaces.insert(surfaces.end(), ring.begin(), ring.end());
+  }
+  ProtoLayer pl2(tgContext, surfaces);
+  pl2.minZ = -10;
+  pl2.maxZ = 10;
+  pl2.minR = 5;
+  pl2.maxR = 25;
+  std::shared_ptr<DiscLayer> dLayer = std::dynamic_pointer_cast<DiscLayer>(
+      p_LC->discLayerOnBVH(tgContext, surfaces, pl2));
+  CHECK_CLOSE_REL(dLayer->thickness(), 20, 1e-3);
+  const RadialBounds* dBounds =
+      dynamic_cast<const RadialBounds*>(&dLayer->bounds());
+  CHECK_CLOSE_REL(dBounds->rMin(), 5, 1e-3);
+  CHECK_CLOSE_REL(dBounds->rMax(), 25, 1e-3);
+  BOOST_CHECK(checkBinning(tgContext, *dLayer->surfaceArray()));
+  BOOST_CHECK_EQUAL(dLayer->surfaceArray()->surfaces().size(),
+                    surfaces.size());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace Test
 
@@ -24,6 +24,26 @@ BOOST_AUTO_TEST_CASE(CylindricalTrackingGeometryTest) {
   BOOST_CHECK_NE(tGeometry, nullptr);
 }
 
+BOOST_AUTO_TEST_CASE(CylindricalTrackingGeometryFindSurface) {
+  CylindricalTrackingGeometry cGeometry(tgContext);
+  auto tGeometry = cGeometry();
+
+  size_t nSensitives = 0;
+  tGeometry->visitSurfaces([&](const Surface* surface) {
+    ++nSensitives;
+    BOOST_CHECK_EQUAL(tGeometry->findSurface(surface->geoID()), surface);
+  });
+  BOOST_CHECK_GT(nSensitives, 0u);
+
+  // the boundary surfaces are indexed as well
+  const auto* world = tGeometry->highestTrackingVolume();
+  for (const auto& bSurface : world->boundarySurfaces()) {
+    const Surface& surface = bSurface->surfaceRepresentation();
+    BOOST_CHECK_EQUAL(tGeometry->findSurface(surface.geoID()), &surface);
+  }
+  BOOST_CHECK(tGeometry->findSurface(GeometryID().setVolume(200)) == nullptr);
+}
+
 BOOST_AUTO_TEST_CASE(CubicTrackingGeometryTest) {
   CubicTrackingGeometry cGeometry(tgContext);
   auto tGeometry = cGeometry();
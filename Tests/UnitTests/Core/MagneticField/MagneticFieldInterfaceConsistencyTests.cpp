@@ -17,6 +17,7 @@
 #include "Acts/MagneticField/MagneticFieldContext.hpp"
 #include "Acts/MagneticField/SharedBField.hpp"
 #include "Acts/MagneticField/SolenoidBField.hpp"
+#include "Acts/MagneticField/TabulatedBFieldMap.hpp"
 #include "Acts/Utilities/Definitions.hpp"
 #include "Acts/Utilities/Units.hpp"
 
@@ -97,6 +98,15 @@ BOOST_AUTO_TEST_CASE(TestSharedBFieldInterfaceConsistency) {
       std::make_shared<ConstantBField>(Vector3D(1, 1, 1)));
   testInterfaceConsistency(field);
 }
+
+BOOST_AUTO_TEST_CASE(TestTabulatedBFieldMapInterfaceConsistency) {
+  TabulatedBFieldMapXYZ fieldXYZ({-1, -1, -1}, {1, 1, 1}, {2, 2, 2},
+                                 std::vector<Vector3D>(8, Vector3D(0, 0, 1)));
+  testInterfaceConsistency(fieldXYZ);
+  TabulatedBFieldMapRZ fieldRZ({0, -1}, {1, 1}, {2, 2},
+                               std::vector<Vector2D>(4, Vector2D(0, 1)));
+  testInterfaceConsistency(fieldRZ);
+}
 }  // namespace Test
 
 }  // namespace Acts
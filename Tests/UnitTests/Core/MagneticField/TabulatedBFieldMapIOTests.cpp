@@ -0,0 +1,93 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include "Acts/MagneticField/TabulatedBFieldMap.hpp"
+#include "Acts/MagneticField/TabulatedBFieldMapIO.hpp"
+#include "Acts/Tests/CommonHelpers/FloatComparisons.hpp"
+#include "Acts/Utilities/Definitions.hpp"
+
+namespace Acts {
+namespace Test {
+
+BOOST_AUTO_TEST_CASE(TabulatedBFieldMapIO_xyz) {
+  std::array<size_t, 3> nPoints = {4, 3, 5};
+  std::vector<Vector3D> values;
+  for (size_t i = 0; i < 4 * 3 * 5; ++i) {
+    values.emplace_back(0.1 * i, -0.2 * i, 1. + i);
+  }
+  TabulatedBFieldMapXYZ field({-1., -2., -3.}, {1., 2., 3.}, nPoints, values);
+
+  const std::string path = "bfield_xyz.bin";
+  writeTabulatedBFieldMap(path, field);
+  {
+    auto mapped = mapTabulatedBFieldMap<3>(path);
+    BOOST_CHECK(mapped.getNBins() == field.getNBins());
+    BOOST_CHECK(mapped.getMin() == field.getMin());
+    BOOST_CHECK(mapped.getMax() == field.getMax());
+    BOOST_CHECK_EQUAL(mapped.size(), values.size());
+    for (const auto& pos : {Vector3D(0., 0., 0.), Vector3D(-0.9, 1.7, 2.1),
+                            Vector3D(0.5, -0.5, -2.9)}) {
+      CHECK_CLOSE_REL(mapped.getField(pos), field.getField(pos), 1e-12);
+    }
+    // copies share the mapping
+    auto copy = mapped;
+    BOOST_CHECK_EQUAL(copy.data(), mapped.data());
+    // a map of the wrong dimension is rejected
+    BOOST_CHECK_THROW(mapTabulatedBFieldMap<2>(path), std::runtime_error);
+  }
+
+  // grid sizes whose product overflows to the stored number of values
+  // are rejected
+  {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    const uint64_t overflowPoints[3] = {(uint64_t(1) << 63) + 15, 4, 1};
+    file.seekp(offsetof(TabulatedBFieldMapHeader, nPoints));
+    file.write(reinterpret_cast<const char*>(overflowPoints),
+               sizeof(overflowPoints));
+  }
+  BOOST_CHECK_THROW(mapTabulatedBFieldMap<3>(path), std::runtime_error);
+
+  // a truncated file is rejected
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::app);
+    file << "x";
+  }
+  BOOST_CHECK_THROW(mapTabulatedBFieldMap<3>(path), std::runtime_error);
+  std::remove(path.c_str());
+  BOOST_CHECK_THROW(mapTabulatedBFieldMap<3>(path), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(TabulatedBFieldMapIO_rz) {
+  std::vector<Vector2D> values;
+  for (size_t i = 0; i < 3 * 4; ++i) {
+    values.emplace_back(0.5 * i, 2. - i);
+  }
+  TabulatedBFieldMapRZ field({0., -3.}, {2., 3.}, {3, 4}, values);
+
+  const std::string path = "bfield_rz.bin";
+  writeTabulatedBFieldMap(path, field);
+  auto mapped = mapTabulatedBFieldMap<2>(path);
+  std::remove(path.c_str());
+
+  // the mapping stays valid after the file is removed
+  for (const auto& pos : {Vector3D(0., 0., 0.), Vector3D(1.1, -0.3, 2.5),
+                          Vector3D(-0.2, 0.7, -1.)}) {
+    CHECK_CLOSE_ABS(mapped.getField(pos), field.getField(pos), 1e-12);
+  }
+}
+
+}  // namespace Test
+}  // namespace Acts
@@ -0,0 +1,138 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include "Acts/MagneticField/MagneticFieldContext.hpp"
+#include "Acts/MagneticField/TabulatedBFieldMap.hpp"
+#include "Acts/Tests/CommonHelpers/FloatComparisons.hpp"
+#include "Acts/Utilities/Definitions.hpp"
+
+namespace Acts {
+namespace Test {
+
+// Create a test context
+MagneticFieldContext mfContext = MagneticFieldContext();
+
+BOOST_AUTO_TEST_CASE(TabulatedBFieldMap_xyz) {
+  // trilinear in x, y and z so interpolation should be exact
+  auto value = [](double x, double y, double z) {
+    return Vector3D(x * y * z, 3 * x - y, 2 * y * z + 1);
+  };
+  auto gradient = [](double x, double y, double z) {
+    ActsMatrixD<3, 3> g;
+    g << y * z, x * z, x * y, 3, -1, 0, 0, 2 * z, 2 * y;
+    return g;
+  };
+
+  std::array<double, 3> min = {-4., -2., 0.};
+  std::array<double, 3> max = {4., 2., 10.};
+  std::array<size_t, 3> nPoints = {5, 3, 6};
+  std::vector<Vector3D> values;
+  for (size_t i = 0; i < nPoints[0]; ++i) {
+    for (size_t j = 0; j < nPoints[1]; ++j) {
+      for (size_t k = 0; k < nPoints[2]; ++k) {
+        values.push_back(value(-4. + 2. * i, -2. + 2. * j, 2. * k));
+      }
+    }
+  }
+  TabulatedBFieldMapXYZ field(min, max, nPoints, values);
+  TabulatedBFieldMapXYZ::Cache cache(mfContext);
+
+  BOOST_CHECK_EQUAL(field.getNBins()[2], 6u);
+  BOOST_CHECK(field.isInside({0., 0., 5.}));
+  BOOST_CHECK(not field.isInside({0., 3., 5.}));
+
+  // grid points, cell centers, cell boundaries and arbitrary points
+  std::vector<Vector3D> positions = {
+      {-4., -2., 0.}, {4., 2., 10.}, {1., 1., 1.},    {0., 0., 0.},
+      {-3.3, 1.7, 9.9}, {2.5, -0.1, 4.2}, {2.6, -0.2, 4.3}, {-1., 0.5, 3.}};
+  for (const auto& pos : positions) {
+    const Vector3D expected = value(pos.x(), pos.y(), pos.z());
+    CHECK_CLOSE_ABS(field.getField(pos), expected, 1e-10);
+    CHECK_CLOSE_ABS(field.getField(pos, cache), expected, 1e-10);
+
+    ActsMatrixD<3, 3> derivative;
+    CHECK_CLOSE_ABS(field.getFieldGradient(pos, derivative, cache), expected,
+                    1e-10);
+    // the gradient is only unique within a cell
+    if (pos != Vector3D(1., 1., 1.) and pos != Vector3D(0., 0., 0.) and
+        pos != Vector3D(-1., 0.5, 3.)) {
+      const ActsMatrixD<3, 3> expectedGradient =
+          gradient(pos.x(), pos.y(), pos.z());
+      for (int j = 0; j < 3; ++j) {
+        CHECK_CLOSE_ABS(derivative.col(j), expectedGradient.col(j), 1e-10);
+      }
+    }
+  }
+
+  BOOST_CHECK_THROW(
+      TabulatedBFieldMapXYZ(min, max, nPoints, std::vector<Vector3D>(3)),
+      std::invalid_argument);
+  BOOST_CHECK_THROW(
+      TabulatedBFieldMapXYZ(min, max, {1, 3, 6}, std::vector<Vector3D>(18)),
+      std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(TabulatedBFieldMap_rz) {
+  // bilinear in r and z so interpolation should be exact
+  auto value = [](double r, double z) {
+    return Vector2D(r * (z + 1), 3 * r - 2 * z);
+  };
+
+  std::array<double, 2> min = {0., -5.};
+  std::array<double, 2> max = {4., 5.};
+  std::array<size_t, 2> nPoints = {5, 6};
+  std::vector<Vector2D> values;
+  for (size_t i = 0; i < nPoints[0]; ++i) {
+    for (size_t j = 0; j < nPoints[1]; ++j) {
+      values.push_back(value(i, -5. + 2. * j));
+    }
+  }
+  TabulatedBFieldMapRZ field(min, max, nPoints, values);
+  TabulatedBFieldMapRZ::Cache cache(mfContext);
+
+  BOOST_CHECK(field.isInside({1., 1., 2.}));
+  BOOST_CHECK(not field.isInside({3., 3., 2.}));
+  BOOST_CHECK(not field.isInside({1., 1., 6.}));
+
+  std::vector<Vector3D> positions = {
+      {0., 0., 0.},    {1., 0., 0.},      {0.5, 0.7, -4.9},
+      {-2., 1., 3.3},  {0.3, -2.2, 1.2},  {-0.1, -0.2, -0.3}};
+  for (const auto& pos : positions) {
+    const double r = std::hypot(pos.x(), pos.y());
+    const Vector2D bRZ = value(r, pos.z());
+    const double cosPhi = (r > 0) ? pos.x() / r : 1.;
+    const double sinPhi = (r > 0) ? pos.y() / r : 0.;
+    const Vector3D expected(bRZ[0] * cosPhi, bRZ[0] * sinPhi, bRZ[1]);
+    CHECK_CLOSE_ABS(field.getField(pos), expected, 1e-10);
+    CHECK_CLOSE_ABS(field.getField(pos, cache), expected, 1e-10);
+
+    // compare the gradient to finite differences of the field
+    ActsMatrixD<3, 3> derivative;
+    CHECK_CLOSE_ABS(field.getFieldGradient(pos, derivative, cache), expected,
+                    1e-10);
+    // the test field is not differentiable on the axis
+    if (r == 0.) {
+      continue;
+    }
+    const double h = 1e-6;
+    for (int j = 0; j < 3; ++j) {
+      const Vector3D dx = h * Vector3D::Unit(j);
+      const Vector3D numerical =
+          (field.getField(pos + dx) - field.getField(pos - dx)) / (2 * h);
+      CHECK_CLOSE_ABS(derivative.col(j), numerical, 1e-6);
+    }
+  }
+}
+
+}  // namespace Test
+}  // namespace Acts
@@ -192,5 +192,45 @@ BOOST_AUTO_TEST_CASE(AccumulatedMaterialProperties_totalaverage_test) {
   BOOST_CHECK_EQUAL(averageAA3E.second, 3u);
 }
 
+/// Test that merging is equivalent to a common accumulation
+BOOST_AUTO_TEST_CASE(AccumulatedMaterialProperties_merge_test) {
+  MaterialProperties a(1., 2., 6., 3., 5., 1.);
+  MaterialProperties b(2., 4., 12., 6., 2., 3.);
+  MaterialProperties v(1.);
+
+  AccumulatedMaterialProperties all;
+  AccumulatedMaterialProperties first;
+  AccumulatedMaterialProperties second;
+  for (auto* amp : {&all, &first}) {
+    amp->accumulate(a);
+    amp->trackAverage();
+    amp->accumulate(b, 1.5);
+    amp->trackAverage();
+  }
+  for (auto* amp : {&all, &second}) {
+    amp->accumulate(v);
+    amp->trackAverage();
+    amp->accumulate(a);
+    amp->accumulate(b);
+    amp->trackAverage();
+  }
+  first.merge(second);
+
+  auto averageAll = all.totalAverage();
+  auto averageMerged = first.totalAverage();
+  BOOST_CHECK_EQUAL(averageMerged.second, 4u);
+  BOOST_CHECK_EQUAL(averageMerged.second, averageAll.second);
+  CHECK_CLOSE_REL(averageMerged.first.thicknessInX0(),
+                  averageAll.first.thicknessInX0(), 1e-12);
+  CHECK_CLOSE_REL(averageMerged.first.thicknessInL0(),
+                  averageAll.first.thicknessInL0(), 1e-12);
+  CHECK_CLOSE_REL(averageMerged.first.material().Ar(),
+                  averageAll.first.material().Ar(), 1e-6);
+  CHECK_CLOSE_REL(averageMerged.first.material().Z(),
+                  averageAll.first.material().Z(), 1e-6);
+  CHECK_CLOSE_REL(averageMerged.first.material().massDensity(),
+                  averageAll.first.material().massDensity(), 1e-6);
+}
+
 }  // namespace Test
 }  // namespace Acts
@@ -118,5 +118,36 @@ BOOST_AUTO_TEST_CASE(AccumulatedSurfaceMaterial_fill_convert_1D) {
   BOOST_CHECK_EQUAL(accMatProp11.first.thicknessInX0(), four.thicknessInX0());
 }
 
+/// Test the merging of binned material
+BOOST_AUTO_TEST_CASE(AccumulatedSurfaceMaterial_merge) {
+  MaterialProperties one(1., 1., 1., 1., 1., 1.);
+  MaterialProperties two(1., 1., 1., 1., 1., 2.);
+
+  BinUtility binUtility2D(2, -1., 1., open, binX);
+  binUtility2D += BinUtility(2, -1., 1., open, binY);
+  AccumulatedSurfaceMaterial first{binUtility2D};
+  AccumulatedSurfaceMaterial second{binUtility2D};
+
+  first.accumulate(Vector2D{-0.5, -0.5}, one);
+  first.trackAverage();
+  second.accumulate(Vector2D{-0.5, -0.5}, two);
+  second.trackAverage();
+  second.accumulate(Vector2D{0.5, 0.5}, two);
+  second.trackAverage();
+  first.merge(second);
+
+  auto accMat2D = first.accumulatedMaterial();
+  auto accMatProp00 = accMat2D[0][0].totalAverage();
+  auto accMatProp11 = accMat2D[1][1].totalAverage();
+  BOOST_CHECK_EQUAL(accMatProp00.second, 2u);
+  BOOST_CHECK_EQUAL(accMatProp11.second, 1u);
+  BOOST_CHECK_EQUAL(accMatProp00.first.thicknessInX0(), 1.5);
+  BOOST_CHECK_EQUAL(accMatProp11.first.thicknessInX0(), two.thicknessInX0());
+
+  // different binnings can not be merged
+  AccumulatedSurfaceMaterial homogeneous{};
+  BOOST_CHECK_THROW(first.merge(homogeneous), std::invalid_argument);
+}
+
 }  // namespace Test
 }  // namespace Acts
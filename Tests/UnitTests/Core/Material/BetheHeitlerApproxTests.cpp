@@ -0,0 +1,73 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include "Acts/Material/BetheHeitlerApprox.hpp"
+#include "Acts/Tests/CommonHelpers/FloatComparisons.hpp"
+
+namespace data = boost::unit_test::data;
+
+BOOST_AUTO_TEST_SUITE(bethe_heitler_approx)
+
+// the moments of the mixture reproduce the Bethe-Heitler distribution
+BOOST_DATA_TEST_CASE(mixture_moments,
+                     data::make({0.001, 0.01, 0.05, 0.1, 0.2, 0.5}),
+                     thicknessInX0) {
+  constexpr size_t nComponents = 6;
+  std::vector<Acts::BetheHeitlerApprox::Component> mixture(nComponents);
+  Acts::BetheHeitlerApprox::computeMixture(thicknessInX0, nComponents,
+                                           mixture.data());
+
+  double sumWeights = 0.;
+  double mean = 0.;
+  double secondMoment = 0.;
+  for (const auto& cmp : mixture) {
+    BOOST_TEST(0 < cmp.mean);
+    BOOST_TEST(cmp.mean <= 1);
+    BOOST_TEST(0 <= cmp.variance);
+    sumWeights += cmp.weight;
+    mean += cmp.weight * cmp.mean;
+    secondMoment += cmp.weight * (cmp.variance + cmp.mean * cmp.mean);
+  }
+  // -ln(z) is Gamma distributed with shape c = t / ln(2), which gives
+  // E[z^n] = (n + 1)^(-c)
+  const double c = thicknessInX0 / std::log(2.);
+  CHECK_CLOSE_REL(sumWeights, 1., 1e-6);
+  CHECK_CLOSE_REL(mean, std::pow(2., -c), 1e-3);
+  CHECK_CLOSE_REL(secondMoment, std::pow(3., -c), 1e-3);
+
+  // the components are ordered by decreasing energy fraction
+  for (size_t i = 1; i < nComponents; ++i) {
+    BOOST_TEST(mixture[i].mean <= mixture[i - 1].mean);
+  }
+}
+
+// the table lookup is close to the direct computation
+BOOST_AUTO_TEST_CASE(table_lookup) {
+  Acts::BetheHeitlerApprox approx(6, 0.2, 100);
+  BOOST_TEST(approx.numComponents() == 6u);
+
+  std::vector<Acts::BetheHeitlerApprox::Component> direct(6);
+  std::vector<Acts::BetheHeitlerApprox::Component> lookup;
+  for (float t : {0.f, 0.0123f, 0.05f, 0.1777f, 0.3f}) {
+    Acts::BetheHeitlerApprox::computeMixture(t, 6, direct.data());
+    approx.mixture(t, lookup);
+    BOOST_TEST(lookup.size() == 6u);
+    for (size_t i = 0; i < 6; ++i) {
+      CHECK_CLOSE_ABS(lookup[i].weight, direct[i].weight, 1e-6);
+      CHECK_CLOSE_ABS(lookup[i].mean, direct[i].mean, 1e-3);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,196 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "Acts/Material/BinaryMaterialMap.hpp"
+#include "Acts/Material/BinnedSurfaceMaterial.hpp"
+#include "Acts/Material/HomogeneousSurfaceMaterial.hpp"
+#include "Acts/Material/HomogeneousVolumeMaterial.hpp"
+#include "Acts/Material/ProtoSurfaceMaterial.hpp"
+#include "Acts/Utilities/BinUtility.hpp"
+#include "Acts/Utilities/Definitions.hpp"
+
+namespace Acts {
+namespace Test {
+
+namespace {
+GeometryID makeID(GeometryID::Value volume, GeometryID::Value layer,
+                  GeometryID::Value sensitive = 0) {
+  return GeometryID().setVolume(volume).setLayer(layer).setSensitive(
+      sensitive);
+}
+
+void checkBinUtility(const BinUtility& a, const BinUtility& b) {
+  BOOST_CHECK_EQUAL(a.dimensions(), b.dimensions());
+  for (size_t i = 0; i < a.dimensions(); ++i) {
+    const auto& da = a.binningData()[i];
+    const auto& db = b.binningData()[i];
+    BOOST_CHECK_EQUAL(da.type, db.type);
+    BOOST_CHECK_EQUAL(da.option, db.option);
+    BOOST_CHECK_EQUAL(da.binvalue, db.binvalue);
+    BOOST_CHECK_EQUAL(da.bins(), db.bins());
+    BOOST_CHECK(da.boundaries() == db.boundaries());
+  }
+  BOOST_CHECK_EQUAL(a.transform() == nullptr, b.transform() == nullptr);
+  if (a.transform() and b.transform()) {
+    BOOST_CHECK(a.transform()->isApprox(*b.transform()));
+  }
+}
+
+BinaryMaterialMap::DetectorMaterialMaps makeMaps() {
+  BinaryMaterialMap::DetectorMaterialMaps maps;
+  const MaterialProperties silicon(95.7, 465.2, 28.03, 14., 2.32e-3, 0.3);
+
+  maps.first[makeID(1, 2)] =
+      std::make_shared<HomogeneousSurfaceMaterial>(silicon, 0.25);
+
+  auto transform = std::make_shared<const Transform3D>(
+      Translation3D(1., 2., 3.) * AngleAxis3D(0.5, Vector3D::UnitZ()));
+  BinUtility binned(BinningData(open, binX, 3, -1., 1.), transform);
+  std::vector<float> boundaries = {-5., -1., 2., 5.};
+  binned += BinUtility(BinningData(closed, binPhi, boundaries));
+  MaterialPropertiesMatrix matrix(3, MaterialPropertiesVector(3));
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      matrix[i][j] =
+          MaterialProperties(90. + i, 400. + j, 28., 14., 2e-3, 0.1 * (i + j));
+    }
+  }
+  maps.first[makeID(2, 4, 17)] =
+      std::make_shared<BinnedSurfaceMaterial>(binned, matrix, 0.5);
+
+  maps.first[makeID(2, 6)] = std::make_shared<ProtoSurfaceMaterial>(
+      BinUtility(20, -3., 3., closed, binPhi));
+
+  maps.second[makeID(2, 0)] = std::make_shared<HomogeneousVolumeMaterial>(
+      Material(352.8, 407., 9.012, 4., 1.848e-3));
+  return maps;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(BinaryMaterialMap_roundtrip) {
+  const auto maps = makeMaps();
+  const std::string path = "material_roundtrip.bin";
+  BinaryMaterialMap::write(path, maps);
+
+  BinaryMaterialMap::Reader reader(path);
+  BOOST_CHECK_EQUAL(reader.numSurfaces(), 3u);
+  BOOST_CHECK_EQUAL(reader.numVolumes(), 1u);
+  BOOST_CHECK(reader.surfaceMaterial(makeID(3, 2)) == nullptr);
+  BOOST_CHECK(reader.volumeMaterial(makeID(1, 2)) == nullptr);
+
+  auto hsm = std::dynamic_pointer_cast<const HomogeneousSurfaceMaterial>(
+      reader.surfaceMaterial(makeID(1, 2)));
+  BOOST_REQUIRE(hsm != nullptr);
+  auto hsmRef = std::dynamic_pointer_cast<const HomogeneousSurfaceMaterial>(
+      maps.first.at(makeID(1, 2)));
+  BOOST_CHECK(*hsm == *hsmRef);
+  BOOST_CHECK_EQUAL(hsm->factor(forward, postUpdate), 0.25);
+
+  auto bsm = std::dynamic_pointer_cast<const BinnedSurfaceMaterial>(
+      reader.surfaceMaterial(makeID(2, 4, 17)));
+  BOOST_REQUIRE(bsm != nullptr);
+  auto bsmRef = std::dynamic_pointer_cast<const BinnedSurfaceMaterial>(
+      maps.first.at(makeID(2, 4, 17)));
+  checkBinUtility(bsm->binUtility(), bsmRef->binUtility());
+  BOOST_CHECK(bsm->fullMaterial() == bsmRef->fullMaterial());
+  BOOST_CHECK_EQUAL(bsm->factor(forward, postUpdate), 0.5);
+
+  auto psm = std::dynamic_pointer_cast<const ProtoSurfaceMaterial>(
+      reader.surfaceMaterial(makeID(2, 6)));
+  BOOST_REQUIRE(psm != nullptr);
+  checkBinUtility(psm->binUtility(),
+                  std::dynamic_pointer_cast<const ProtoSurfaceMaterial>(
+                      maps.first.at(makeID(2, 6)))
+                      ->binUtility());
+
+  auto hvm = reader.volumeMaterial(makeID(2, 0));
+  BOOST_REQUIRE(hvm != nullptr);
+  BOOST_CHECK(hvm->material(Vector3D(0., 0., 0.)) ==
+              maps.second.at(makeID(2, 0))->material(Vector3D(0., 0., 0.)));
+
+  // the complete file and single volumes
+  auto all = reader.read();
+  BOOST_CHECK_EQUAL(all.first.size(), 3u);
+  BOOST_CHECK_EQUAL(all.second.size(), 1u);
+  auto volume1 = reader.readVolume(1);
+  BOOST_CHECK_EQUAL(volume1.first.size(), 1u);
+  BOOST_CHECK_EQUAL(volume1.second.size(), 0u);
+  auto volume2 = reader.readVolume(2);
+  BOOST_CHECK_EQUAL(volume2.first.size(), 2u);
+  BOOST_CHECK_EQUAL(volume2.second.size(), 1u);
+  BOOST_CHECK(volume2.first.count(makeID(2, 4, 17)) == 1);
+  auto volume3 = reader.readVolume(3);
+  BOOST_CHECK(volume3.first.empty() and volume3.second.empty());
+
+  std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(BinaryMaterialMap_invalid) {
+  BOOST_CHECK_THROW(BinaryMaterialMap::Reader("does_not_exist.bin"),
+                    std::runtime_error);
+
+  // unsupported material types are rejected when writing
+  class CustomVolumeMaterial : public IVolumeMaterial {
+    const Material& material(const Vector3D&) const final { return m_mat; }
+    Material m_mat;
+  };
+  BinaryMaterialMap::DetectorMaterialMaps custom;
+  custom.second[makeID(1, 0)] = std::make_shared<CustomVolumeMaterial>();
+  BOOST_CHECK_THROW(BinaryMaterialMap::write("custom.bin", custom),
+                    std::invalid_argument);
+
+  const std::string path = "material_invalid.bin";
+  BinaryMaterialMap::write(path, makeMaps());
+  std::vector<char> bytes;
+  {
+    std::ifstream in(path, std::ios::binary);
+    bytes.assign(std::istreambuf_iterator<char>(in),
+                 std::istreambuf_iterator<char>());
+  }
+  const auto writeBytes = [&](const std::vector<char>& content) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(content.data(), content.size());
+  };
+
+  // wrong magic
+  auto corrupt = bytes;
+  corrupt[0] = 'X';
+  writeBytes(corrupt);
+  BOOST_CHECK_THROW(BinaryMaterialMap::Reader{path}, std::runtime_error);
+
+  // truncated index
+  corrupt = bytes;
+  corrupt.resize(bytes.size() - 8);
+  writeBytes(corrupt);
+  BOOST_CHECK_THROW(BinaryMaterialMap::Reader{path}, std::runtime_error);
+
+  // record size exceeding the data of the binned material
+  corrupt = bytes;
+  BinaryMaterialMap::Header header;
+  std::memcpy(&header, bytes.data(), sizeof(header));
+  auto* index = reinterpret_cast<BinaryMaterialMap::IndexEntry*>(
+      corrupt.data() + header.indexOffset);
+  index[1].size = 20;
+  writeBytes(corrupt);
+  BinaryMaterialMap::Reader reader(path);
+  BOOST_CHECK(reader.surfaceMaterial(makeID(1, 2)) != nullptr);
+  BOOST_CHECK_THROW(reader.surfaceMaterial(makeID(2, 4, 17)),
+                    std::runtime_error);
+
+  std::remove(path.c_str());
+}
+
+}  // namespace Test
+}  // namespace Acts
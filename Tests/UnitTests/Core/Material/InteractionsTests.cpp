@@ -105,4 +105,59 @@ BOOST_DATA_TEST_CASE(vacuum, thickness* particle* momentum, x, i, m, q, p) {
   BOOST_TEST(computeMultipleScatteringTheta0(vacuum, i, m, qOverP, q) == 0);
 }
 
+// batched computations agree with the single particle computations
+BOOST_AUTO_TEST_CASE(batch_consistency) {
+  Acts::InteractionSlabTable table;
+  std::vector<Acts::MaterialProperties> slabs;
+  for (auto x : valuesThickness) {
+    slabs.emplace_back(material, x);
+  }
+  slabs.emplace_back(Acts::Material(), 1_mm);
+  for (const auto& slab : slabs) {
+    table.add(slab);
+  }
+  BOOST_TEST(table.size() == slabs.size());
+
+  Acts::InteractionBatch batch;
+  for (size_t s = 0; s < slabs.size(); ++s) {
+    for (size_t j = 0; j < 4; ++j) {
+      for (double p = 100_MeV; p < 10_TeV; p *= 1.3) {
+        batch.add(s, pdg[j], mass[j], charge[j] / p, charge[j]);
+      }
+    }
+  }
+
+  std::vector<float> bethe, betheDer, landau, landauDer, theta0;
+  computeEnergyLossBethe(table, batch, bethe);
+  deriveEnergyLossBetheQOverP(table, batch, betheDer);
+  computeEnergyLossLandau(table, batch, landau);
+  deriveEnergyLossLandauQOverP(table, batch, landauDer);
+  computeMultipleScatteringTheta0(table, batch, theta0);
+  BOOST_TEST(bethe.size() == batch.size());
+  BOOST_TEST(theta0.size() == batch.size());
+
+  // float precision; the derivatives include cancelling terms
+  const auto tolerance = boost::test_tools::tolerance(1e-3f);
+  for (size_t i = 0; i < batch.size(); ++i) {
+    const auto& slab = slabs[batch.slab[i]];
+    const auto j = batch.pdg[i];
+    const auto m = batch.mass[i];
+    const auto qOverP = batch.qOverP[i];
+    const auto q = batch.charge[i];
+    BOOST_TEST(bethe[i] == computeEnergyLossBethe(slab, j, m, qOverP, q),
+               tolerance);
+    BOOST_TEST(betheDer[i] ==
+                   deriveEnergyLossBetheQOverP(slab, j, m, qOverP, q),
+               tolerance);
+    BOOST_TEST(landau[i] == computeEnergyLossLandau(slab, j, m, qOverP, q),
+               tolerance);
+    BOOST_TEST(landauDer[i] ==
+                   deriveEnergyLossLandauQOverP(slab, j, m, qOverP, q),
+               tolerance);
+    BOOST_TEST(theta0[i] ==
+                   computeMultipleScatteringTheta0(slab, j, m, qOverP, q),
+               tolerance);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
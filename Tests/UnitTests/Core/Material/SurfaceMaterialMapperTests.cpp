@@ -22,6 +22,7 @@
 #include "Acts/Material/MaterialProperties.hpp"
 #include "Acts/Material/ProtoSurfaceMaterial.hpp"
 #include "Acts/Material/SurfaceMaterialMapper.hpp"
+#include "Acts/Tests/CommonHelpers/FloatComparisons.hpp"
 
 namespace Acts {
 
@@ -118,6 +119,72 @@ BOOST_AUTO_TEST_CASE(SurfaceMaterialMapper_tests) {
   BOOST_CHECK_EQUAL(mState.accumulatedMaterial.size(), 3u);
 }
 
+/// Test that the threaded mapping agrees with the serial one
+BOOST_AUTO_TEST_CASE(SurfaceMaterialMapper_threads) {
+  Navigator navigator(tGeometry);
+  SurfaceMaterialMapper::StraightLinePropagator propagator(
+      StraightLineStepper(), std::move(navigator));
+  SurfaceMaterialMapper smMapper(SurfaceMaterialMapper::Config(),
+                                 std::move(propagator));
+
+  GeometryContext gCtx;
+  MagneticFieldContext mfCtx;
+
+  // Straight tracks from the origin with one material step per layer
+  std::vector<RecordedMaterialTrack> mTracks;
+  for (size_t it = 0; it < 64; ++it) {
+    const double phi = 0.1 * it;
+    const double cotTheta = -1. + 2. * it / 64.;
+    const Vector3D dir =
+        Vector3D(std::cos(phi), std::sin(phi), cotTheta).normalized();
+    RecordedMaterialTrack mTrack;
+    mTrack.first = {Vector3D(0., 0., 0.), dir};
+    for (double r : {10., 20., 30.}) {
+      MaterialInteraction mInteraction;
+      mInteraction.position = r * dir / dir.head<2>().norm();
+      mInteraction.materialProperties =
+          MaterialProperties(90. + it, 400., 28., 14., 2e-3, 0.1 * r);
+      mTrack.second.materialInteractions.push_back(mInteraction);
+    }
+    mTracks.push_back(std::move(mTrack));
+  }
+  auto mTracksSerial = mTracks;
+
+  auto serialState = smMapper.createState(gCtx, mfCtx, *tGeometry);
+  smMapper.mapMaterialTracks(serialState, mTracksSerial, 1);
+  smMapper.finalizeMaps(serialState);
+
+  auto threadedState = smMapper.createState(gCtx, mfCtx, *tGeometry);
+  smMapper.mapMaterialTracks(threadedState, mTracks, 4);
+  smMapper.finalizeMaps(threadedState);
+
+  BOOST_CHECK_EQUAL(threadedState.surfaceMaterial.size(), 3u);
+  size_t nFilled = 0;
+  for (const auto& [geoID, serialMaterial] : serialState.surfaceMaterial) {
+    const auto& threadedMaterial = threadedState.surfaceMaterial.at(geoID);
+    for (double z = -35.; z < 40.; z += 10.) {
+      const Vector3D pos(0., 20., z);
+      const auto& serialMp = serialMaterial->materialProperties(pos);
+      const auto& threadedMp = threadedMaterial->materialProperties(pos);
+      BOOST_CHECK_EQUAL(bool(serialMp), bool(threadedMp));
+      if (serialMp) {
+        ++nFilled;
+        CHECK_CLOSE_REL(threadedMp.thicknessInX0(), serialMp.thicknessInX0(),
+                        1e-10);
+        CHECK_CLOSE_REL(threadedMp.material().massDensity(),
+                        serialMp.material().massDensity(), 1e-6);
+      }
+    }
+  }
+  BOOST_CHECK_GT(nFilled, 0u);
+  // the surfaces are assigned to the material steps in all threads
+  for (const auto& mTrack : mTracks) {
+    for (const auto& mInteraction : mTrack.second.materialInteractions) {
+      BOOST_CHECK(mInteraction.surface != nullptr);
+    }
+  }
+}
+
 }  // namespace Test
 
 }  // namespace Acts
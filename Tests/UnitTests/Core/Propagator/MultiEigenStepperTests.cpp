@@ -0,0 +1,305 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "Acts/EventData/TrackParameters.hpp"
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/MagneticField/ConstantBField.hpp"
+#include "Acts/MagneticField/MagneticFieldContext.hpp"
+#include "Acts/Propagator/ActionList.hpp"
+#include "Acts/Propagator/EigenStepper.hpp"
+#include "Acts/Propagator/MultiEigenStepper.hpp"
+#include "Acts/Propagator/Navigator.hpp"
+#include "Acts/Propagator/Propagator.hpp"
+#include "Acts/Propagator/StepperConcept.hpp"
+#include "Acts/Propagator/SurfaceCollector.hpp"
+#include "Acts/Tests/CommonHelpers/CylindricalTrackingGeometry.hpp"
+#include "Acts/Tests/CommonHelpers/FloatComparisons.hpp"
+#include "Acts/Utilities/Definitions.hpp"
+#include "Acts/Utilities/Units.hpp"
+
+using namespace Acts::UnitLiterals;
+
+namespace Acts {
+namespace Test {
+
+// Create a test context
+GeometryContext tgContext = GeometryContext();
+MagneticFieldContext mfContext = MagneticFieldContext();
+
+using BFieldType = ConstantBField;
+using MultiStepperType = MultiEigenStepper<BFieldType>;
+using EigenStepperType = EigenStepper<BFieldType>;
+
+static_assert(StepperConcept<MultiStepperType>,
+              "MultiEigenStepper does not fulfill the stepper concept");
+
+const double Bz = 2_T;
+BFieldType bField(0, 0, Bz);
+
+/// A bundle of tracks with different momenta, directions and charges
+std::vector<CurvilinearParameters> makeBundle() {
+  std::vector<CurvilinearParameters> bundle;
+  for (int i = 0; i < 8; ++i) {
+    const double pT = (0.5 + 0.7 * i) * 1_GeV;
+    const double phi = 0.4 * i;
+    const double theta = 0.6 + 0.25 * i;
+    const double q = (i % 2 == 0) ? 1. : -1.;
+    Vector3D pos(0.1_mm * i, -0.2_mm * i, 1_mm * i);
+    Vector3D mom(pT * std::cos(phi), pT * std::sin(phi),
+                 pT / std::tan(theta));
+    bundle.emplace_back(std::nullopt, pos, mom, q, 1_ns * i);
+  }
+  return bundle;
+}
+
+/// A collimated bundle of tracks from the origin, with covariance
+std::vector<CurvilinearParameters> makeCollimatedBundle() {
+  BoundSymMatrix cov = BoundSymMatrix::Zero();
+  cov.diagonal() << 10_um * 10_um, 10_um * 10_um, 1e-6, 1e-6,
+      1e-4 / (1_GeV * 1_GeV), 1_ns * 1_ns;
+  std::vector<CurvilinearParameters> bundle;
+  for (int i = 0; i < 4; ++i) {
+    const double pT = 2_GeV * (1. + 1e-3 * i);
+    const double phi = 0.1 + 1e-5 * i;
+    const double theta = 1.2 - 1e-5 * i;
+    Vector3D mom(pT * std::cos(phi), pT * std::sin(phi),
+                 pT / std::tan(theta));
+    bundle.emplace_back(cov, Vector3D(0., 0., 0.), mom, 1_e, 0.);
+  }
+  return bundle;
+}
+
+/// Collects the surfaces the bundle passes and the largest distance of a
+/// track to them
+struct BundleSurfaceCollector {
+  struct this_result {
+    std::vector<const Surface*> surfaces;
+    double maxDistance = 0.;
+  };
+
+  using result_type = this_result;
+
+  template <typename propagator_state_t, typename stepper_t>
+  void operator()(propagator_state_t& state, const stepper_t& stepper,
+                  result_type& result) const {
+    auto surface = state.navigation.currentSurface;
+    if (surface == nullptr or
+        (not result.surfaces.empty() and result.surfaces.back() == surface)) {
+      return;
+    }
+    result.surfaces.push_back(surface);
+    for (size_t i = 0; i < stepper.size(state.stepping); ++i) {
+      auto sIntersection =
+          surface->intersect(state.geoContext,
+                             stepper.position(state.stepping, i),
+                             stepper.direction(state.stepping, i), false);
+      result.maxDistance =
+          std::max(result.maxDistance,
+                   std::abs(sIntersection.intersection.pathLength));
+    }
+  }
+};
+
+BOOST_AUTO_TEST_CASE(multi_eigen_stepper_state) {
+  MultiStepperType stepper(bField);
+  auto bundle = makeBundle();
+  MultiStepperType::State state(tgContext, mfContext, bundle, backward,
+                                5_cm);
+
+  BOOST_CHECK_EQUAL(stepper.size(state), bundle.size());
+  Vector3D meanPosition(0., 0., 0.);
+  for (size_t i = 0; i < bundle.size(); ++i) {
+    CHECK_CLOSE_ABS(stepper.position(state, i), bundle[i].position(), 1e-12);
+    CHECK_CLOSE_ABS(stepper.direction(state, i),
+                    bundle[i].momentum().normalized(), 1e-12);
+    CHECK_CLOSE_REL(stepper.momentum(state, i), bundle[i].momentum().norm(),
+                    1e-12);
+    BOOST_CHECK_EQUAL(stepper.charge(state, i), bundle[i].charge());
+    BOOST_CHECK_EQUAL(stepper.time(state, i), bundle[i].time());
+    CHECK_CLOSE_REL(stepper.weight(state, i), 1. / bundle.size(), 1e-12);
+    BOOST_CHECK_EQUAL(state.tracks[i].stepSize, -5_cm);
+    meanPosition += bundle[i].position() / bundle.size();
+  }
+  CHECK_CLOSE_ABS(stepper.position(state), meanPosition, 1e-12);
+  BOOST_CHECK_EQUAL(state.stepSize, -5_cm);
+  BOOST_CHECK_EQUAL(state.pathAccumulated, 0.);
+  BOOST_CHECK(not state.covTransport);
+
+  // The state created by the propagator holds a single track
+  MultiStepperType::State single(tgContext, mfContext, bundle[3]);
+  BOOST_CHECK_EQUAL(stepper.size(single), 1u);
+  CHECK_CLOSE_ABS(stepper.position(single), bundle[3].position(), 1e-12);
+  BOOST_CHECK_EQUAL(stepper.charge(single), bundle[3].charge());
+}
+
+BOOST_AUTO_TEST_CASE(multi_eigen_stepper_vs_eigen_stepper) {
+  using MultiPropagatorType = Propagator<MultiStepperType>;
+  MultiPropagatorType propagator(MultiStepperType{bField});
+  PropagatorOptions<> options(tgContext, mfContext);
+  options.pathLimit = 1_m;
+  options.maxStepSize = 1_cm;
+
+  auto bundle = makeBundle();
+  auto state = propagator.makeState(bundle.front(), options);
+  state.stepping = MultiStepperType::State(tgContext, mfContext, bundle,
+                                           forward, options.maxStepSize,
+                                           options.tolerance);
+  MultiPropagatorType::result_type<decltype(options)> result;
+  BOOST_CHECK(propagator.propagateState(state, result).ok());
+  CHECK_CLOSE_ABS(state.stepping.pathAccumulated, options.pathLimit, 1e-6);
+  CHECK_CLOSE_ABS(result.pathLength, options.pathLimit, 1e-6);
+
+  // The single track reference
+  Propagator<EigenStepperType> reference(EigenStepperType{bField});
+  MultiStepperType stepper(bField);
+  for (size_t i = 0; i < bundle.size(); ++i) {
+    CHECK_CLOSE_ABS(state.stepping.tracks[i].pathAccumulated,
+                    options.pathLimit, 1e-6);
+    auto refResult = reference.propagate(bundle[i], options);
+    BOOST_CHECK(refResult.ok());
+    const auto& refParameters = *refResult.value().endParameters;
+    auto [parameters, jacobian, pathLength] =
+        stepper.curvilinearState(state.stepping, i);
+    CHECK_CLOSE_ABS(parameters.position(), refParameters.position(), 1_um);
+    CHECK_CLOSE_REL(parameters.momentum(), refParameters.momentum(), 1e-6);
+    CHECK_CLOSE_REL(parameters.time(), refParameters.time(), 1e-6);
+    BOOST_CHECK_EQUAL(parameters.charge(), refParameters.charge());
+  }
+  // The end parameters are the mean of the bundle
+  CHECK_CLOSE_ABS(result.endParameters->position(),
+                  stepper.position(state.stepping), 1_um);
+}
+
+BOOST_AUTO_TEST_CASE(multi_eigen_stepper_step_adaptation) {
+  using MultiPropagatorType = Propagator<MultiStepperType>;
+  MultiPropagatorType propagator(MultiStepperType{bField});
+  PropagatorOptions<> options(tgContext, mfContext);
+  options.pathLimit = 1_m;
+  // Large steps are rejected for the soft tracks only
+  options.maxStepSize = 1_m;
+
+  auto bundle = makeBundle();
+  auto state = propagator.makeState(bundle.front(), options);
+  state.stepping = MultiStepperType::State(tgContext, mfContext, bundle,
+                                           forward, options.maxStepSize,
+                                           options.tolerance);
+  MultiPropagatorType::result_type<decltype(options)> result;
+  BOOST_CHECK(propagator.propagateState(state, result).ok());
+
+  // Every track adapts its step size like a single track
+  Propagator<EigenStepperType> reference(EigenStepperType{bField});
+  MultiStepperType stepper(bField);
+  for (size_t i = 0; i < bundle.size(); ++i) {
+    auto refResult = reference.propagate(bundle[i], options);
+    BOOST_CHECK(refResult.ok());
+    const auto& refParameters = *refResult.value().endParameters;
+    auto [parameters, jacobian, pathLength] =
+        stepper.curvilinearState(state.stepping, i);
+    CHECK_CLOSE_ABS(parameters.position(), refParameters.position(), 1_um);
+    CHECK_CLOSE_REL(parameters.momentum(), refParameters.momentum(), 1e-6);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(multi_eigen_stepper_covariance) {
+  using MultiPropagatorType = Propagator<MultiStepperType>;
+  MultiPropagatorType propagator(MultiStepperType{bField});
+  PropagatorOptions<> options(tgContext, mfContext);
+  options.pathLimit = 50_cm;
+  options.maxStepSize = 5_cm;
+
+  auto bundle = makeCollimatedBundle();
+  auto state = propagator.makeState(bundle.front(), options);
+  state.stepping = MultiStepperType::State(tgContext, mfContext, bundle,
+                                           forward, options.maxStepSize,
+                                           options.tolerance);
+  BOOST_CHECK(state.stepping.covTransport);
+  MultiPropagatorType::result_type<decltype(options)> result;
+  BOOST_CHECK(propagator.propagateState(state, result).ok());
+  BOOST_CHECK(result.endParameters->covariance());
+  BOOST_CHECK(result.transportJacobian);
+
+  // Every track transports its covariance like a single track
+  Propagator<EigenStepperType> reference(EigenStepperType{bField});
+  MultiStepperType stepper(bField);
+  for (size_t i = 0; i < bundle.size(); ++i) {
+    auto refResult = reference.propagate(bundle[i], options);
+    BOOST_CHECK(refResult.ok());
+    const auto& refParameters = *refResult.value().endParameters;
+    auto [parameters, jacobian, pathLength] =
+        stepper.curvilinearState(state.stepping, i);
+    CHECK_CLOSE_ABS(parameters.position(), refParameters.position(), 1_um);
+    CHECK_CLOSE_COVARIANCE(*parameters.covariance(),
+                           *refParameters.covariance(), 1e-6);
+  }
+
+  // The combined covariance includes the spread of the bundle
+  const auto& combined = *result.endParameters->covariance();
+  for (size_t i = 0; i < bundle.size(); ++i) {
+    auto [parameters, jacobian, pathLength] =
+        stepper.curvilinearState(state.stepping, i);
+    BOOST_CHECK_GE(combined(eQOP, eQOP),
+                   (*parameters.covariance())(eQOP, eQOP) / bundle.size());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(multi_eigen_stepper_navigation) {
+  CylindricalTrackingGeometry cGeometry(tgContext);
+  auto tGeometry = cGeometry();
+
+  PropagatorOptions<ActionList<BundleSurfaceCollector>> options(tgContext,
+                                                                mfContext);
+  options.maxStepSize = 10_cm;
+  options.pathLimit = 1.5_m;
+
+  using MultiPropagatorType = Propagator<MultiStepperType, Navigator>;
+  MultiPropagatorType propagator(MultiStepperType{bField},
+                                 Navigator(tGeometry));
+  auto bundle = makeCollimatedBundle();
+  auto state = propagator.makeState(bundle.front(), options);
+  state.stepping = MultiStepperType::State(tgContext, mfContext, bundle,
+                                           forward, options.maxStepSize,
+                                           options.tolerance);
+  MultiPropagatorType::result_type<decltype(options)> result;
+  BOOST_CHECK(propagator.propagateState(state, result).ok());
+  const auto& collected = result.get<BundleSurfaceCollector::result_type>();
+
+  // Every track is on the surfaces the bundle passes
+  BOOST_CHECK(not collected.surfaces.empty());
+  BOOST_CHECK_LT(collected.maxDistance, 1_um);
+
+  // The bundle passes the sensitive surfaces of its first track
+  using Collector = SurfaceCollector<SurfaceSelector>;
+  Propagator<EigenStepperType, Navigator> reference(EigenStepperType{bField},
+                                                    Navigator(tGeometry));
+  PropagatorOptions<ActionList<Collector>> refOptions(tgContext, mfContext);
+  refOptions.maxStepSize = options.maxStepSize;
+  refOptions.pathLimit = options.pathLimit;
+  auto refResult = reference.propagate(bundle.front(), refOptions);
+  BOOST_CHECK(refResult.ok());
+  std::vector<const Surface*> refSurfaces;
+  for (const auto& hit :
+       refResult.value().get<Collector::result_type>().collected) {
+    refSurfaces.push_back(hit.surface);
+  }
+  std::vector<const Surface*> sensitive;
+  std::copy_if(collected.surfaces.begin(), collected.surfaces.end(),
+               std::back_inserter(sensitive), [](const Surface* surface) {
+                 return surface->associatedDetectorElement() != nullptr;
+               });
+  BOOST_CHECK(not refSurfaces.empty());
+  BOOST_CHECK(sensitive == refSurfaces);
+}
+
+}  // namespace Test
+}  // namespace Acts
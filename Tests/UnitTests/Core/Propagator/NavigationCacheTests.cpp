@@ -0,0 +1,240 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Acts/EventData/TrackParameters.hpp"
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/MagneticField/ConstantBField.hpp"
+#include "Acts/MagneticField/MagneticFieldContext.hpp"
+#include "Acts/Propagator/ActionList.hpp"
+#include "Acts/Propagator/EigenStepper.hpp"
+#include "Acts/Propagator/NavigationCache.hpp"
+#include "Acts/Propagator/Navigator.hpp"
+#include "Acts/Propagator/Propagator.hpp"
+#include "Acts/Propagator/SurfaceCollector.hpp"
+#include "Acts/Surfaces/CylinderSurface.hpp"
+#include "Acts/Tests/CommonHelpers/CylindricalTrackingGeometry.hpp"
+#include "Acts/Utilities/Definitions.hpp"
+#include "Acts/Utilities/Units.hpp"
+
+using namespace Acts::UnitLiterals;
+
+namespace Acts {
+namespace Test {
+
+// Create a test context
+GeometryContext tgContext = GeometryContext();
+MagneticFieldContext mfContext = MagneticFieldContext();
+
+CylindricalTrackingGeometry cGeometry(tgContext);
+auto tGeometry = cGeometry();
+
+using BFieldType = ConstantBField;
+using EigenStepperType = EigenStepper<BFieldType>;
+using EigenPropagatorType = Propagator<EigenStepperType, Navigator>;
+using Collector = SurfaceCollector<SurfaceSelector>;
+
+/// Propagate the tracks and return the collected surfaces for each.
+std::vector<std::vector<const Surface*>> collectSurfaces(
+    const std::vector<CurvilinearParameters>& tracks,
+    std::shared_ptr<NavigationCache> cache) {
+  Navigator navigator(tGeometry);
+  navigator.navigationCache = std::move(cache);
+  EigenPropagatorType propagator(EigenStepperType(BFieldType(0, 0, 2_T)),
+                                 std::move(navigator));
+
+  PropagatorOptions<ActionList<Collector>> options(tgContext, mfContext);
+  options.maxStepSize = 10_cm;
+  options.pathLimit = 1.5_m;
+
+  std::vector<std::vector<const Surface*>> collected;
+  for (const auto& start : tracks) {
+    const auto& result = propagator.propagate(start, options).value();
+    std::vector<const Surface*> surfaces;
+    for (const auto& hit : result.get<Collector::result_type>().collected) {
+      surfaces.push_back(hit.surface);
+    }
+    collected.push_back(std::move(surfaces));
+  }
+  return collected;
+}
+
+/// Tracks from the origin within a narrow cone, or spread over the full
+/// azimuth and most of the barrel and endcaps.
+std::vector<CurvilinearParameters> makeTracks(size_t n, bool spread = false) {
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<> pTDist(spread ? 0.5_GeV : 5_GeV, 10_GeV);
+  std::uniform_real_distribution<> phiDist(spread ? -M_PI : 0.1,
+                                           spread ? M_PI : 0.102);
+  std::uniform_real_distribution<> thetaDist(spread ? 0.3 : 1.2,
+                                             spread ? M_PI - 0.3 : 1.202);
+
+  std::vector<CurvilinearParameters> tracks;
+  for (size_t i = 0; i < n; ++i) {
+    double pT = pTDist(rng);
+    double phi = phiDist(rng);
+    double theta = thetaDist(rng);
+    Vector3D mom(pT * std::cos(phi), pT * std::sin(phi), pT / std::tan(theta));
+    tracks.emplace_back(std::nullopt, Vector3D(0., 0., 0.), mom, 1_e, 0.);
+  }
+  return tracks;
+}
+
+BOOST_AUTO_TEST_SUITE(NavigationCacheTests)
+
+BOOST_AUTO_TEST_CASE(NavigationCacheKey) {
+  NavigationCache cache;
+  int object = 0;
+  Vector3D pos(10_cm, 20_cm, 30_cm);
+  Vector3D dir = Vector3D(1., 1., 1.).normalized();
+
+  auto key = cache.key(&object, pos, dir, forward);
+  // small changes remain in the same bin
+  BOOST_CHECK(key == cache.key(&object, pos + Vector3D(1_um, 0., 0.),
+                               (dir + Vector3D(0., 1e-6, 0.)).normalized(),
+                               forward));
+  // different object, position, or direction
+  BOOST_CHECK(not(key == cache.key(&cache, pos, dir, forward)));
+  BOOST_CHECK(not(key == cache.key(&object, pos + Vector3D(0., 0., 1_m), dir,
+                                   forward)));
+  BOOST_CHECK(not(key == cache.key(&object, pos, -dir, forward)));
+  // the navigation direction is included
+  BOOST_CHECK(not(key == cache.key(&object, pos, dir, backward)));
+  // the signed direction is binned
+  auto backwardKey = cache.key(&object, pos, -dir, backward);
+  BOOST_CHECK_EQUAL(backwardKey.phi, key.phi);
+  BOOST_CHECK_EQUAL(backwardKey.theta, key.theta);
+}
+
+BOOST_AUTO_TEST_CASE(NavigationCacheStatistics) {
+  NavigationCache cache;
+  int object = 0;
+  auto key = cache.key(&object, Vector3D(0., 0., 0.), Vector3D(1., 0., 0.),
+                       forward);
+
+  BOOST_CHECK(not cache.find<Layer>(key));
+  cache.insert<Layer>(key, {nullptr});
+  BOOST_CHECK_EQUAL(cache.size(), 1u);
+  // candidates are stored per object type
+  BOOST_CHECK(not cache.find<BoundarySurface>(key));
+  auto candidates = cache.find<Layer>(key);
+  BOOST_CHECK(candidates);
+  BOOST_CHECK_EQUAL(candidates->size(), 1u);
+  cache.reject();
+
+  auto stats = cache.statistics();
+  BOOST_CHECK_EQUAL(stats.hits, 1u);
+  BOOST_CHECK_EQUAL(stats.misses, 2u);
+  BOOST_CHECK_EQUAL(stats.rejected, 1u);
+  BOOST_CHECK_EQUAL(stats.hitRate(), 0.);
+
+  cache.clear();
+  BOOST_CHECK_EQUAL(cache.size(), 0u);
+  BOOST_CHECK_EQUAL(cache.statistics().misses, 0u);
+}
+
+// cached navigation finds the same surfaces for collimated tracks
+BOOST_AUTO_TEST_CASE(NavigationCachePropagation) {
+  auto tracks = makeTracks(200);
+  auto cache = std::make_shared<NavigationCache>();
+
+  auto reference = collectSurfaces(tracks, nullptr);
+  auto cached = collectSurfaces(tracks, cache);
+
+  BOOST_CHECK_EQUAL(cached.size(), reference.size());
+  for (size_t i = 0; i < reference.size(); ++i) {
+    BOOST_CHECK(not reference[i].empty());
+    BOOST_CHECK(cached[i] == reference[i]);
+  }
+
+  auto stats = cache->statistics();
+  BOOST_TEST_MESSAGE("hits " << stats.hits << " misses " << stats.misses
+                             << " rejected " << stats.rejected);
+  BOOST_CHECK(0 < stats.misses);
+  BOOST_CHECK(0.5 < stats.hitRate());
+}
+
+// the entries are dropped when the cache is full
+BOOST_AUTO_TEST_CASE(NavigationCacheCapacity) {
+  NavigationCache::Config cfg;
+  cfg.maxEntries = 2;
+  NavigationCache cache(cfg);
+  int object = 0;
+  for (int i = 0; i < 5; ++i) {
+    auto key = cache.key(&object, Vector3D(i * 1_m, 0., 0.),
+                         Vector3D(1., 0., 0.), forward);
+    cache.insert<Layer>(key, {nullptr});
+    cache.insert<BoundarySurface>(key, {nullptr});
+    BOOST_CHECK_LE(cache.size(), 2 * cfg.maxEntries);
+  }
+  // the last key is still found
+  auto key = cache.key(&object, Vector3D(4_m, 0., 0.), Vector3D(1., 0., 0.),
+                       forward);
+  BOOST_CHECK(cache.find<Layer>(key));
+  BOOST_CHECK(cache.find<BoundarySurface>(key));
+  BOOST_CHECK_EQUAL(cache.statistics().dropped, 8u);
+}
+
+// cached navigation finds exactly the same surfaces for spread tracks,
+// also when the entries are dropped in between
+BOOST_AUTO_TEST_CASE(NavigationCacheExact) {
+  auto tracks = makeTracks(2000, true);
+  auto reference = collectSurfaces(tracks, nullptr);
+
+  NavigationCache::Config smallCfg;
+  smallCfg.maxEntries = 100;
+  for (auto cfg : {NavigationCache::Config(), smallCfg}) {
+    auto cache = std::make_shared<NavigationCache>(cfg);
+    auto cached = collectSurfaces(tracks, cache);
+
+    BOOST_CHECK_EQUAL(cached.size(), reference.size());
+    for (size_t i = 0; i < reference.size(); ++i) {
+      BOOST_CHECK(cached[i] == reference[i]);
+    }
+    auto stats = cache->statistics();
+    BOOST_TEST_MESSAGE("hits " << stats.hits << " misses " << stats.misses
+                               << " rejected " << stats.rejected
+                               << " dropped " << stats.dropped);
+    BOOST_CHECK(0 < stats.hits);
+    BOOST_CHECK_LE(cache->size(), 2 * cfg.maxEntries);
+  }
+}
+
+// targeted propagation bypasses the cache
+BOOST_AUTO_TEST_CASE(NavigationCacheTargetSurface) {
+  auto cache = std::make_shared<NavigationCache>();
+  Navigator navigator(tGeometry);
+  navigator.navigationCache = cache;
+  EigenPropagatorType propagator(EigenStepperType(BFieldType(0, 0, 2_T)),
+                                 std::move(navigator));
+
+  auto target = Surface::makeShared<CylinderSurface>(nullptr, 150_mm, 1_m);
+  PropagatorOptions<> options(tgContext, mfContext);
+  options.maxStepSize = 10_cm;
+
+  for (const auto& start : makeTracks(10)) {
+    auto result = propagator.propagate(start, *target, options);
+    BOOST_CHECK(result.ok());
+    BOOST_CHECK(result.value().endParameters);
+  }
+  // neither layers nor boundaries were looked up in the cache
+  auto stats = cache->statistics();
+  BOOST_CHECK_EQUAL(cache->size(), 0u);
+  BOOST_CHECK_EQUAL(stats.hits, 0u);
+  BOOST_CHECK_EQUAL(stats.misses, 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace Test
+}  // namespace Acts
@@ -32,15 +32,12 @@ class ATLASCuts : public IExperimentCuts<SpacePoint> {
                      const InternalSpacePoint<SpacePoint>&,
                      const InternalSpacePoint<SpacePoint>&) const;
 
-  /// @param seeds contains pairs of weight and seed created for one middle
-  /// space
-  /// point
-  /// @return vector of seeds that pass the cut
-  std::vector<std::pair<float, std::unique_ptr<const InternalSeed<SpacePoint>>>>
-  cutPerMiddleSP(
-      std::vector<
-          std::pair<float, std::unique_ptr<const InternalSeed<SpacePoint>>>>
-          seeds) const;
+  using IExperimentCuts<SpacePoint>::cutPerMiddleSP;
+
+  /// @param [in,out] seeds contains pairs of weight and seed created for one
+  /// middle space point. Seeds that do not pass the cut are removed.
+  void cutPerMiddleSP(
+      std::vector<std::pair<float, InternalSeed<SpacePoint>>>& seeds) const;
 };
 
 template <typename SpacePoint>
@@ -67,24 +64,18 @@ bool ATLASCuts<SpacePoint>::singleSeedCut(
 }
 
 template <typename SpacePoint>
-std::vector<std::pair<float, std::unique_ptr<const InternalSeed<SpacePoint>>>>
-ATLASCuts<SpacePoint>::cutPerMiddleSP(
-    std::vector<
-        std::pair<float, std::unique_ptr<const InternalSeed<SpacePoint>>>>
-        seeds) const {
-  std::vector<std::pair<float, std::unique_ptr<const InternalSeed<SpacePoint>>>>
-      newSeedsVector;
+void ATLASCuts<SpacePoint>::cutPerMiddleSP(
+    std::vector<std::pair<float, InternalSeed<SpacePoint>>>& seeds) const {
   if (seeds.size() > 1) {
-    newSeedsVector.push_back(std::move(seeds[0]));
     size_t itLength = std::min(seeds.size(), size_t(5));
     // don't cut first element
+    size_t nKept = 1;
     for (size_t i = 1; i < itLength; i++) {
-      if (seeds[i].first > 200. || seeds[i].second->sp[0]->radius() > 43.) {
-        newSeedsVector.push_back(std::move(seeds[i]));
+      if (seeds[i].first > 200. || seeds[i].second.sp[0]->radius() > 43.) {
+        seeds[nKept++] = seeds[i];
       }
     }
-    return newSeedsVector;
+    seeds.erase(seeds.begin() + nKept, seeds.end());
   }
-  return seeds;
 }
 }  // namespace Acts
@@ -18,6 +18,7 @@
 #include "Acts/Seeding/BinnedSPGroup.hpp"
 #include "Acts/Seeding/InternalSeed.hpp"
 #include "Acts/Seeding/InternalSpacePoint.hpp"
+#include "Acts/Seeding/ParallelSeeding.hpp"
 #include "Acts/Seeding/Seed.hpp"
 #include "Acts/Seeding/SeedFilter.hpp"
 #include "Acts/Seeding/Seedfinder.hpp"
@@ -70,9 +71,12 @@ int main(int argc, char** argv) {
   std::string file{"sp.txt"};
   bool help(false);
   bool quiet(false);
+  bool vectorized(false);
+  bool sortBins(false);
+  size_t nThreads(1);
 
   int opt;
-  while ((opt = getopt(argc, argv, "hf:q")) != -1) {
+  while ((opt = getopt(argc, argv, "hf:qst:v")) != -1) {
     switch (opt) {
       case 'f':
         file = optarg;
@@ -80,11 +84,20 @@ int main(int argc, char** argv) {
       case 'q':
         quiet = true;
         break;
+      case 's':
+        sortBins = true;
+        break;
+      case 't':
+        nThreads = std::stoul(optarg);
+        break;
+      case 'v':
+        vectorized = true;
+        break;
       case 'h':
         help = true;
         [[fallthrough]];
       default: /* '?' */
-        std::cerr << "Usage: " << argv[0] << " [-hq] [-f FILENAME]\n";
+        std::cerr << "Usage: " << argv[0] << " [-hqsv] [-f FILENAME] [-t THREADS]\n";
         if (help) {
           std::cout << "      -h : this help" << std::endl;
           std::cout
@@ -92,6 +105,14 @@ int main(int argc, char** argv) {
               << file << "\"" << std::endl;
           std::cout << "      -q : don't print out all found seeds"
                     << std::endl;
+          std::cout << "      -s : sort the bins in r and search the duplets "
+                       "by r window"
+                    << std::endl;
+          std::cout << "      -t THREADS : number of seeding threads, 0 uses "
+                       "all hardware threads. Default is 1"
+                    << std::endl;
+          std::cout << "      -v : use the vectorized seeding kernels"
+                    << std::endl;
         }
 
         exit(EXIT_FAILURE);
@@ -131,6 +152,8 @@ int main(int argc, char** argv) {
 
   config.beamPos = {-.5, -.5};
   config.impactMax = 10.;
+  config.useVectorizedKernels = vectorized;
+  config.sortBinsInR = sortBins;
 
   auto bottomBinFinder = std::make_shared<Acts::BinFinder<SpacePoint>>(
       Acts::BinFinder<SpacePoint>());
@@ -165,11 +188,15 @@ int main(int argc, char** argv) {
 
   std::vector<std::vector<Acts::Seed<SpacePoint>>> seedVector;
   auto start = std::chrono::system_clock::now();
-  auto groupIt = spGroup.begin();
-  auto endOfGroups = spGroup.end();
-  for (; !(groupIt == endOfGroups); ++groupIt) {
-    seedVector.push_back(a.createSeedsForGroup(
-        groupIt.bottom(), groupIt.middle(), groupIt.top()));
+  if (nThreads == 1) {
+    auto groupIt = spGroup.begin();
+    auto endOfGroups = spGroup.end();
+    for (; !(groupIt == endOfGroups); ++groupIt) {
+      seedVector.push_back(a.createSeedsForGroup(
+          groupIt.bottom(), groupIt.middle(), groupIt.top()));
+    }
+  } else {
+    seedVector = Acts::createSeedsParallel(a, spGroup, nThreads);
   }
   auto end = std::chrono::system_clock::now();
   std::chrono::duration<double> elapsed_seconds = end - start;
@@ -184,13 +211,13 @@ int main(int argc, char** argv) {
     for (auto& regionVec : seedVector) {
       for (size_t i = 0; i < regionVec.size(); i++) {
         const Acts::Seed<SpacePoint>* seed = &regionVec[i];
-        const SpacePoint* sp = seed->sp()[0];
+        const SpacePoint* sp = seed->spacePoints()[0];
         std::cout << " (" << sp->x() << ", " << sp->y() << ", " << sp->z()
                   << ") ";
-        sp = seed->sp()[1];
+        sp = seed->spacePoints()[1];
         std::cout << sp->surface << " (" << sp->x() << ", " << sp->y() << ", "
                   << sp->z() << ") ";
-        sp = seed->sp()[2];
+        sp = seed->spacePoints()[2];
         std::cout << sp->surface << " (" << sp->x() << ", " << sp->y() << ", "
                   << sp->z() << ") ";
         std::cout << std::endl;
@@ -0,0 +1,469 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "Acts/Seeding/BinFinder.hpp"
+#include "Acts/Seeding/BinnedSPGroup.hpp"
+#include "Acts/Seeding/ParallelSeeding.hpp"
+#include "Acts/Seeding/Seed.hpp"
+#include "Acts/Seeding/SeedFilter.hpp"
+#include "Acts/Seeding/Seedfinder.hpp"
+#include "Acts/Seeding/SpacePointGrid.hpp"
+
+#include "ATLASCuts.hpp"
+#include "SpacePoint.hpp"
+
+// Count the heap allocations of the test module
+static std::atomic<size_t> s_allocations{0};
+
+void* operator new(std::size_t size) {
+  ++s_allocations;
+  if (void* ptr = std::malloc(size > 0 ? size : 1)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+namespace Acts {
+namespace Test {
+
+/// Create space points of helical tracks from the beam line crossing six
+/// barrel layers, plus uniformly distributed noise hits
+std::vector<SpacePoint> createSpacePoints(size_t nTracks, size_t nNoise) {
+  std::mt19937 gen(2718);
+  std::uniform_real_distribution<float> phiDist(-M_PI, M_PI);
+  std::uniform_real_distribution<float> etaDist(-2., 2.);
+  std::uniform_real_distribution<float> z0Dist(-100., 100.);
+  std::uniform_real_distribution<float> pTDist(500., 5000.);
+  std::uniform_real_distribution<float> qDist(-1., 1.);
+  std::normal_distribution<float> smear(0., 0.02);
+
+  const std::vector<float> layerR = {35., 50., 70., 90., 120., 150.};
+  // 2T field, the helix radius in mm is pT / (0.3 * B)
+  const float pTPerHelixRadius = 0.6;
+
+  std::vector<SpacePoint> spacePoints;
+  for (size_t iTrack = 0; iTrack < nTracks; ++iTrack) {
+    float phi0 = phiDist(gen);
+    float cotTheta = std::sinh(etaDist(gen));
+    float z0 = z0Dist(gen);
+    float radius = pTDist(gen) / pTPerHelixRadius;
+    float q = qDist(gen) < 0 ? -1. : 1.;
+    int layer = 0;
+    for (float r : layerR) {
+      float halfAngle = std::asin(r / (2 * radius));
+      float phi = phi0 - q * halfAngle;
+      float x = r * std::cos(phi) + smear(gen);
+      float y = r * std::sin(phi) + smear(gen);
+      float z = z0 + cotTheta * 2 * radius * halfAngle + smear(gen);
+      spacePoints.push_back(SpacePoint{x, y, z, std::hypot(x, y), layer++,
+                                       0.0004, 0.0004});
+    }
+  }
+  std::uniform_real_distribution<float> noiseZDist(-1000., 1000.);
+  std::uniform_int_distribution<size_t> layerDist(0, layerR.size() - 1);
+  for (size_t iNoise = 0; iNoise < nNoise; ++iNoise) {
+    int layer = layerDist(gen);
+    float phi = phiDist(gen);
+    float x = layerR[layer] * std::cos(phi);
+    float y = layerR[layer] * std::sin(phi);
+    spacePoints.push_back(SpacePoint{x, y, noiseZDist(gen), layerR[layer],
+                                     layer, 0.0004, 0.0004});
+  }
+  return spacePoints;
+}
+
+std::vector<const SpacePoint*> pointers(
+    const std::vector<SpacePoint>& spacePoints) {
+  std::vector<const SpacePoint*> spVec;
+  for (const auto& sp : spacePoints) {
+    spVec.push_back(&sp);
+  }
+  return spVec;
+}
+
+SeedfinderConfig<SpacePoint> createConfig() {
+  static ATLASCuts<SpacePoint> atlasCuts;
+
+  SeedfinderConfig<SpacePoint> config;
+  config.rMax = 160.;
+  config.deltaRMin = 5.;
+  config.deltaRMax = 160.;
+  config.collisionRegionMin = -250.;
+  config.collisionRegionMax = 250.;
+  config.zMin = -2800.;
+  config.zMax = 2800.;
+  config.maxSeedsPerSpM = 5;
+  config.cotThetaMax = 7.40627;
+  config.sigmaScattering = 1.;
+  config.minPt = 500.;
+  config.bFieldInZ = 0.00199724;
+  config.beamPos = {-.5, -.5};
+  config.impactMax = 10.;
+  config.seedFilter =
+      std::make_shared<SeedFilter<SpacePoint>>(SeedFilterConfig(), &atlasCuts);
+  return config;
+}
+
+BinnedSPGroup<SpacePoint> createGroup(
+    const std::vector<const SpacePoint*>& spVec,
+    SeedfinderConfig<SpacePoint> config) {
+  auto ct = [](const SpacePoint& sp, float, float, float) -> Vector2D {
+    return {sp.varianceR, sp.varianceZ};
+  };
+  SpacePointGridConfig gridConf;
+  gridConf.bFieldInZ = config.bFieldInZ;
+  gridConf.minPt = config.minPt;
+  gridConf.rMax = config.rMax;
+  gridConf.zMax = config.zMax;
+  gridConf.zMin = config.zMin;
+  gridConf.deltaRMax = config.deltaRMax;
+  gridConf.cotThetaMax = config.cotThetaMax;
+  auto binFinder = std::make_shared<BinFinder<SpacePoint>>();
+  return BinnedSPGroup<SpacePoint>(
+      spVec.begin(), spVec.end(), ct, binFinder, binFinder,
+      SpacePointGridCreator::createGrid<SpacePoint>(gridConf), config);
+}
+
+/// Data pointer and capacity of every scratch buffer of the state
+std::vector<std::pair<const void*, size_t>> buffers(
+    const SeedfinderState<SpacePoint>& state,
+    const std::vector<Seed<SpacePoint>>& outputVec) {
+  std::vector<std::pair<const void*, size_t>> result;
+  auto add = [&](const auto& vec) {
+    result.emplace_back(vec.data(), vec.capacity());
+  };
+  add(state.compatBottomSP);
+  add(state.compatTopSP);
+  add(state.linCircleBottom);
+  add(state.linCircleTop);
+  add(state.topSpVec);
+  add(state.curvatures);
+  add(state.impactParameters);
+  add(state.seedsPerSpM);
+  add(state.filterState.compatibleSeedR);
+  for (const auto* columns : {&state.bottomColumns, &state.topColumns}) {
+    add(columns->r);
+    add(columns->z);
+    add(columns->sp);
+    add(columns->runEnds);
+  }
+  const auto& lc = state.linCircleTopColumns;
+  for (const auto* column :
+       {&lc.Zo, &lc.cotTheta, &lc.iDeltaR, &lc.Er, &lc.U, &lc.V}) {
+    add(*column);
+  }
+  add(state.accept);
+  add(outputVec);
+  return result;
+}
+
+BOOST_AUTO_TEST_CASE(seedfinder_state_reuse) {
+  auto spacePoints = createSpacePoints(200, 200);
+  auto spVec = pointers(spacePoints);
+
+  for (int mode = 0; mode < 3; ++mode) {
+    auto config = createConfig();
+    config.useVectorizedKernels = (mode == 1);
+    config.sortBinsInR = (mode == 2);
+    auto spGroup = createGroup(spVec, config);
+    Seedfinder<SpacePoint> seedfinder(config);
+
+    // the neighborhoods refer to the bin indices of the iterators
+    std::vector<BinnedSPGroupIterator<SpacePoint>> groups;
+    auto groupIt = spGroup.begin();
+    auto endOfGroups = spGroup.end();
+    for (; !(groupIt == endOfGroups); ++groupIt) {
+      groups.push_back(groupIt);
+    }
+
+    Seedfinder<SpacePoint>::State state;
+    std::vector<Seed<SpacePoint>> outputVec;
+    auto findAll = [&]() {
+      size_t nSeeds = 0;
+      for (const auto& group : groups) {
+        outputVec.clear();
+        seedfinder.createSeedsForGroup(state, outputVec, group.bottom(),
+                                       group.middle(), group.top());
+        nSeeds += outputVec.size();
+      }
+      return nSeeds;
+    };
+
+    // the first pass grows the buffers to the size of the largest group
+    size_t nSeeds = findAll();
+    BOOST_CHECK_GT(nSeeds, 0u);
+    auto grown = buffers(state, outputVec);
+
+    // the second pass must neither grow nor reallocate any buffer
+    BOOST_CHECK_EQUAL(findAll(), nSeeds);
+    auto reused = buffers(state, outputVec);
+    BOOST_REQUIRE_EQUAL(reused.size(), grown.size());
+    for (size_t i = 0; i < grown.size(); ++i) {
+      BOOST_TEST_CONTEXT("mode " << mode << ", buffer " << i) {
+        BOOST_CHECK_EQUAL(reused[i].first, grown[i].first);
+        BOOST_CHECK_EQUAL(reused[i].second, grown[i].second);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(seedfinder_allocation_free) {
+  auto spacePoints = createSpacePoints(200, 200);
+  auto spVec = pointers(spacePoints);
+
+  for (int mode = 0; mode < 3; ++mode) {
+    auto config = createConfig();
+    config.useVectorizedKernels = (mode == 1);
+    config.sortBinsInR = (mode == 2);
+    auto spGroup = createGroup(spVec, config);
+    Seedfinder<SpacePoint> seedfinder(config);
+
+    Seedfinder<SpacePoint>::State state;
+    std::vector<Seed<SpacePoint>> outputVec;
+    auto groupIt = spGroup.begin();
+    const auto firstGroup = groupIt;
+    auto endOfGroups = spGroup.end();
+    auto findAll = [&]() {
+      size_t nSeeds = 0;
+      for (; !(groupIt == endOfGroups); ++groupIt) {
+        outputVec.clear();
+        seedfinder.createSeedsForGroup(state, outputVec, groupIt.bottom(),
+                                       groupIt.middle(), groupIt.top());
+        for (const auto& seed : outputVec) {
+          nSeeds += (seed.sp().size() == 3);
+        }
+      }
+      return nSeeds;
+    };
+
+    // the first pass grows the buffers of the state, the output and the
+    // bin indices of the iterator
+    s_allocations = 0;
+    size_t nSeeds = findAll();
+    BOOST_CHECK_GT(nSeeds, 0u);
+    BOOST_CHECK_GT(s_allocations, 0u);
+
+    // the second pass, restarted by assignment into the grown iterator,
+    // does not allocate at all
+    s_allocations = 0;
+    groupIt = firstGroup;
+    size_t nSeedsAgain = findAll();
+    size_t nAllocations = s_allocations;
+    BOOST_TEST_CONTEXT("mode " << mode) {
+      BOOST_CHECK_EQUAL(nSeedsAgain, nSeeds);
+      BOOST_CHECK_EQUAL(nAllocations, 0u);
+    }
+  }
+}
+
+using GroupSeeds = std::vector<std::vector<Seed<SpacePoint>>>;
+
+/// Create the seeds of all groups serially with one reused state
+GroupSeeds createSeeds(const SeedfinderConfig<SpacePoint>& config,
+                       BinnedSPGroup<SpacePoint>& spGroup) {
+  Seedfinder<SpacePoint> seedfinder(config);
+  Seedfinder<SpacePoint>::State state;
+  GroupSeeds seeds;
+  auto groupIt = spGroup.begin();
+  auto endOfGroups = spGroup.end();
+  for (; !(groupIt == endOfGroups); ++groupIt) {
+    seeds.push_back(seedfinder.createSeedsForGroup(
+        state, groupIt.bottom(), groupIt.middle(), groupIt.top()));
+  }
+  return seeds;
+}
+
+/// Check that two seed collections are identical, including the order of
+/// the seeds and the bit pattern of the vertex position
+void checkIdentical(const GroupSeeds& seeds, const GroupSeeds& reference) {
+  BOOST_REQUIRE_EQUAL(seeds.size(), reference.size());
+  size_t nSeeds = 0;
+  for (size_t g = 0; g < seeds.size(); ++g) {
+    BOOST_TEST_CONTEXT("group " << g) {
+      BOOST_REQUIRE_EQUAL(seeds[g].size(), reference[g].size());
+      for (size_t i = 0; i < seeds[g].size(); ++i) {
+        BOOST_CHECK(seeds[g][i].spacePoints() ==
+                    reference[g][i].spacePoints());
+        BOOST_CHECK_EQUAL(seeds[g][i].z(), reference[g][i].z());
+      }
+    }
+    nSeeds += seeds[g].size();
+  }
+  BOOST_CHECK_GT(nSeeds, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(seedfinder_vectorized_kernels) {
+  auto spacePoints = createSpacePoints(500, 500);
+  auto spVec = pointers(spacePoints);
+
+  auto config = createConfig();
+  auto spGroup = createGroup(spVec, config);
+  auto scalarSeeds = createSeeds(config, spGroup);
+
+  // the structure-of-arrays kernels find exactly the same seeds
+  config.useVectorizedKernels = true;
+  checkIdentical(createSeeds(config, spGroup), scalarSeeds);
+}
+
+BOOST_AUTO_TEST_CASE(seedfinder_sorted_bins) {
+  auto spacePoints = createSpacePoints(500, 500);
+  auto spVec = pointers(spacePoints);
+
+  auto config = createConfig();
+  auto windowConfig = createConfig();
+  windowConfig.sortBinsInR = true;
+
+  // on the same bins, the r-window search finds the same seeds as the full
+  // scan, both for r-sorted bins and for bins only ordered to within 1 mm
+  auto sortedGroup = createGroup(spVec, windowConfig);
+  checkIdentical(createSeeds(windowConfig, sortedGroup),
+                 createSeeds(config, sortedGroup));
+  auto unsortedGroup = createGroup(spVec, config);
+  checkIdentical(createSeeds(windowConfig, unsortedGroup),
+                 createSeeds(config, unsortedGroup));
+
+  // with the input ordered in r, sorting the bins changes nothing and the
+  // sorted path reproduces the default unsorted one
+  std::vector<std::pair<float, const SpacePoint*>> radii;
+  for (const SpacePoint* sp : spVec) {
+    InternalSpacePoint<SpacePoint> isp(*sp, Vector3D(sp->x(), sp->y(), sp->z()),
+                                       config.beamPos, Vector2D(0., 0.));
+    radii.emplace_back(isp.radius(), sp);
+  }
+  std::stable_sort(
+      radii.begin(), radii.end(),
+      [](const auto& a, const auto& b) { return a.first < b.first; });
+  std::vector<const SpacePoint*> spVecInR;
+  for (const auto& radius : radii) {
+    spVecInR.push_back(radius.second);
+  }
+  auto groupInR = createGroup(spVecInR, config);
+  auto sortedGroupInR = createGroup(spVecInR, windowConfig);
+  checkIdentical(createSeeds(windowConfig, sortedGroupInR),
+                 createSeeds(config, groupInR));
+}
+
+BOOST_AUTO_TEST_CASE(seedfinder_parallel) {
+  auto spacePoints = createSpacePoints(500, 500);
+  auto spVec = pointers(spacePoints);
+
+  auto config = createConfig();
+  auto spGroup = createGroup(spVec, config);
+  Seedfinder<SpacePoint> seedfinder(config);
+  // the groups keep their bin indices while they are processed in parallel
+  checkIdentical(createSeedsParallel(seedfinder, spGroup, 4),
+                 createSeeds(config, spGroup));
+}
+
+/// Experiment cuts without any weight modification or single seed cut
+class NoSeedCuts : public IExperimentCuts<SpacePoint> {
+ public:
+  float seedWeight(const InternalSpacePoint<SpacePoint>&,
+                   const InternalSpacePoint<SpacePoint>&,
+                   const InternalSpacePoint<SpacePoint>&) const override {
+    return 0.;
+  }
+  bool singleSeedCut(float, const InternalSpacePoint<SpacePoint>&,
+                     const InternalSpacePoint<SpacePoint>&,
+                     const InternalSpacePoint<SpacePoint>&) const override {
+    return true;
+  }
+};
+
+/// Experiment cuts keeping the seed with the highest weight per middle space
+/// point, implementing the in-place interface
+class BestSeedCuts : public NoSeedCuts {
+ public:
+  using NoSeedCuts::cutPerMiddleSP;
+
+  void cutPerMiddleSP(std::vector<std::pair<float, InternalSeed<SpacePoint>>>&
+                          seeds) const override {
+    if (seeds.size() > 1) {
+      seeds.erase(seeds.begin() + 1, seeds.end());
+    }
+  }
+};
+
+/// The same cuts implementing only the deprecated interface
+class LegacyBestSeedCuts : public NoSeedCuts {
+ public:
+  using SeedPtrs = std::vector<
+      std::pair<float, std::unique_ptr<const InternalSeed<SpacePoint>>>>;
+  using NoSeedCuts::cutPerMiddleSP;
+
+  SeedPtrs cutPerMiddleSP(SeedPtrs seeds) const override {
+    if (seeds.size() > 1) {
+      seeds.erase(seeds.begin() + 1, seeds.end());
+    }
+    return seeds;
+  }
+};
+
+BOOST_AUTO_TEST_CASE(seedfilter_legacy_experiment_cuts) {
+  auto spacePoints = createSpacePoints(200, 200);
+  auto spVec = pointers(spacePoints);
+
+  NoSeedCuts noCuts;
+  BestSeedCuts cuts;
+  LegacyBestSeedCuts legacyCuts;
+  auto createSeedfinder = [](IExperimentCuts<SpacePoint>* expCuts) {
+    auto config = createConfig();
+    config.seedFilter =
+        std::make_shared<SeedFilter<SpacePoint>>(SeedFilterConfig(), expCuts);
+    return std::make_unique<Seedfinder<SpacePoint>>(config);
+  };
+  auto uncutSeedfinder = createSeedfinder(&noCuts);
+  auto seedfinder = createSeedfinder(&cuts);
+  auto legacySeedfinder = createSeedfinder(&legacyCuts);
+
+  auto spGroup = createGroup(spVec, createConfig());
+  size_t nSeeds = 0;
+  size_t nUncutSeeds = 0;
+  auto groupIt = spGroup.begin();
+  auto endOfGroups = spGroup.end();
+  for (; !(groupIt == endOfGroups); ++groupIt) {
+    nUncutSeeds += uncutSeedfinder
+                       ->createSeedsForGroup(groupIt.bottom(),
+                                             groupIt.middle(), groupIt.top())
+                       .size();
+    auto seeds = seedfinder->createSeedsForGroup(
+        groupIt.bottom(), groupIt.middle(), groupIt.top());
+    auto legacySeeds = legacySeedfinder->createSeedsForGroup(
+        groupIt.bottom(), groupIt.middle(), groupIt.top());
+    BOOST_REQUIRE_EQUAL(legacySeeds.size(), seeds.size());
+    for (size_t i = 0; i < seeds.size(); ++i) {
+      BOOST_CHECK(legacySeeds[i].spacePoints() == seeds[i].spacePoints());
+    }
+    nSeeds += seeds.size();
+  }
+  // the cuts of the deprecated interface are applied
+  BOOST_CHECK_GT(nSeeds, 0u);
+  BOOST_CHECK_LT(nSeeds, nUncutSeeds);
+}
+
+}  // namespace Test
+}  // namespace Acts
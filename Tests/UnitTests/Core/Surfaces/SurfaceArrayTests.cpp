@@ -25,6 +25,7 @@
 #include "Acts/Utilities/detail/Grid.hpp"
 
 #include <fstream>
+#include <set>
 
 using Acts::VectorHelpers::perp;
 using Acts::VectorHelpers::phi;
@@ -223,6 +224,11 @@ BOOST_FIXTURE_TEST_CASE(SurfaceArray_create, SurfaceArrayFixture) {
       sa.neighbors(itransform(Vector2D(0, 0)));
   BOOST_CHECK_EQUAL(neighbors.size(), 9u);
 
+  // grid lookups do not depend on the direction
+  BOOST_CHECK(not sa.isDirectionDependent());
+  BOOST_CHECK(sa.candidates(itransform(Vector2D(0, 0)), Vector3D(1, 0, 0)) ==
+              neighbors);
+
   auto sl2 = std::make_unique<
       SurfaceArray::SurfaceGridLookup<decltype(phiAxis), decltype(zAxis)>>(
       transform, itransform,
@@ -240,6 +246,52 @@ BOOST_FIXTURE_TEST_CASE(SurfaceArray_create, SurfaceArrayFixture) {
   }
 }
 
+BOOST_FIXTURE_TEST_CASE(SurfaceArray_BVH, SurfaceArrayFixture) {
+  GeometryContext tgContext = GeometryContext();
+
+  // tilted barrel modules and endcap modules aligned with z
+  SrfVec brl = makeBarrel(30, 7, 2, 1);
+  SrfVec ec = fullPhiTestSurfacesEC(30, 0, 20, 10);
+
+  for (const auto& srfs : {brl, ec}) {
+    std::vector<const Surface*> srfsRaw = unpack_shared_vector(srfs);
+    auto sl = std::make_unique<SurfaceArray::SurfaceBVHLookup>(0.1);
+    sl->fill(tgContext, srfsRaw);
+    SurfaceArray sa(std::move(sl), srfs);
+
+    // lookups without a direction return all surfaces
+    BOOST_CHECK(sa.isDirectionDependent());
+    BOOST_CHECK_EQUAL(sa.size(), 1u);
+    BOOST_CHECK_EQUAL(sa.neighbors(Vector3D(10, 0, 0)).size(), srfs.size());
+    BOOST_CHECK_EQUAL(
+        sa.candidates(Vector3D(10, 0, 0), Vector3D(0, 0, 0)).size(),
+        srfs.size());
+
+    // every surface crossed by a straight line is a candidate
+    Vector3D origin(0, 0, 0);
+    size_t nCandidates = 0;
+    size_t nLines = 0;
+    for (double ph = -M_PI; ph < M_PI; ph += 0.05) {
+      for (double t = -1.5; t <= 1.5; t += 0.25) {
+        Vector3D dir(std::cos(ph), std::sin(ph), t);
+        std::vector<const Surface*> candidates = sa.candidates(origin, dir);
+        std::set<const Surface*> candidateSet(candidates.begin(),
+                                              candidates.end());
+        for (const auto& srf : srfs) {
+          auto sfi = srf->intersect(tgContext, origin, dir.normalized(), true);
+          if (sfi && sfi.intersection.pathLength > 0) {
+            BOOST_CHECK(candidateSet.count(srf.get()) == 1u);
+          }
+        }
+        nCandidates += candidates.size();
+        ++nLines;
+      }
+    }
+    // only a small fraction of the surfaces is tested on average
+    BOOST_CHECK_LT(nCandidates, nLines * srfs.size() / 5);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(SurfaceArray_singleElement) {
   double w = 3, h = 4;
   auto bounds = std::make_shared<const RectangleBounds>(w, h);
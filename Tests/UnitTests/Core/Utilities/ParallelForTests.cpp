@@ -0,0 +1,59 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2019 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/test/unit_test.hpp>
+
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "Acts/Utilities/ParallelFor.hpp"
+
+namespace Acts {
+namespace Test {
+
+BOOST_AUTO_TEST_SUITE(Utilities)
+
+BOOST_AUTO_TEST_CASE(parallel_for_number_of_threads) {
+  BOOST_CHECK_EQUAL(resolveNumberOfThreads(4, 100), 4u);
+  BOOST_CHECK_EQUAL(resolveNumberOfThreads(4, 2), 2u);
+  BOOST_CHECK_EQUAL(resolveNumberOfThreads(4, 0), 1u);
+  BOOST_CHECK_GE(resolveNumberOfThreads(0, 100), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_for_all_tasks) {
+  for (size_t nThreads : {1u, 2u, 4u, 7u}) {
+    std::vector<size_t> result(1000, 0);
+    std::vector<size_t> perThread(nThreads, 0);
+    parallelFor(result.size(), nThreads, [&](size_t i, size_t t) {
+      result[i] += i * i;
+      perThread.at(t) += 1;
+    });
+    for (size_t i = 0; i < result.size(); ++i) {
+      BOOST_CHECK_EQUAL(result[i], i * i);
+    }
+    BOOST_CHECK_EQUAL(
+        std::accumulate(perThread.begin(), perThread.end(), size_t(0)),
+        result.size());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(parallel_for_exception) {
+  auto throwing = [](size_t i, size_t) {
+    if (i == 17) {
+      throw std::runtime_error("task failed");
+    }
+  };
+  BOOST_CHECK_THROW(parallelFor(100, 1, throwing), std::runtime_error);
+  BOOST_CHECK_THROW(parallelFor(100, 4, throwing), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace Test
+}  // namespace Acts
@@ -182,31 +182,26 @@ BOOST_AUTO_TEST_CASE(adaptive_multi_vertex_fitter_test) {
        iTrack++) {
     // Index of current vertex
     int vtxIdx = (int)(iTrack / nTracksPerVtx);
-    state.vtxInfoMap[&(vtxList[vtxIdx])].trackLinks.push_back(
-        &(allTracks[iTrack]));
-    state.tracksAtVerticesMap.insert(
-        std::make_pair(std::make_pair(&(allTracks[iTrack]), &(vtxList[vtxIdx])),
-                       TrackAtVertex<BoundParameters>(1., allTracks[iTrack],
-                                                      &(allTracks[iTrack]))));
+    state.addTrackToVertex(
+        vtxList[vtxIdx], TrackAtVertex<BoundParameters>(
+                             1., allTracks[iTrack], &(allTracks[iTrack])));
 
     // Use first track also for second vertex to let vtx1 and vtx2
     // share this track
     if (iTrack == 0) {
-      state.vtxInfoMap[&(vtxList.at(1))].trackLinks.push_back(
-          &(allTracks[iTrack]));
-      state.tracksAtVerticesMap.insert(
-          std::make_pair(std::make_pair(&(allTracks[iTrack]), &(vtxList.at(1))),
-                         TrackAtVertex<BoundParameters>(1., allTracks[iTrack],
-                                                        &(allTracks[iTrack]))));
+      state.addTrackToVertex(
+          vtxList.at(1), TrackAtVertex<BoundParameters>(
+                             1., allTracks[iTrack], &(allTracks[iTrack])));
     }
   }
 
   for (auto& vtx : vtxPtrList) {
-    state.addVertexToMultiMap(*vtx);
+    state.addVertexToTrackLinks(*vtx);
     if (debugMode) {
       std::cout << "Vertex, with ptr: " << vtx << std::endl;
-      for (auto& trk : state.vtxInfoMap[vtx].trackLinks) {
-        std::cout << "\t track ptr: " << trk << std::endl;
+      for (auto& trk : state.vertexInfo(*vtx).trackLinks) {
+        std::cout << "\t track ptr: "
+                  << state.tracksAtVertices[trk].originalParams << std::endl;
       }
     }
   }
@@ -214,11 +209,14 @@ BOOST_AUTO_TEST_CASE(adaptive_multi_vertex_fitter_test) {
   if (debugMode) {
     std::cout << "Checking all vertices linked to a single track: "
               << std::endl;
+    state.updateTrackVertexLinks();
     for (auto& trk : allTracks) {
       std::cout << "Track with ptr: " << &trk << std::endl;
-      auto range = state.trackToVerticesMultiMap.equal_range(&trk);
-      for (auto vtxIter = range.first; vtxIter != range.second; ++vtxIter) {
-        std::cout << "\t used by vertex: " << vtxIter->second << std::endl;
+      auto [begin, end] = state.trackVertexRange(state.trackIndex(&trk));
+      for (size_t i = begin; i < end; ++i) {
+        const size_t ivtx = state.links[state.trackVertexLinks[i]].second;
+        std::cout << "\t used by vertex: " << state.vertices[ivtx]
+                  << std::endl;
       }
     }
   }
@@ -235,8 +233,9 @@ BOOST_AUTO_TEST_CASE(adaptive_multi_vertex_fitter_test) {
     for (auto& vtx : vtxPtrList) {
       c++;
       std::cout << c << ". vertex, with ptr: " << vtx << std::endl;
-      for (auto& trk : state.vtxInfoMap[vtx].trackLinks) {
-        std::cout << "\t track ptr: " << trk << std::endl;
+      for (auto& trk : state.vertexInfo(*vtx).trackLinks) {
+        std::cout << "\t track ptr: "
+                  << state.tracksAtVertices[trk].originalParams << std::endl;
       }
     }
   }
@@ -246,9 +245,11 @@ BOOST_AUTO_TEST_CASE(adaptive_multi_vertex_fitter_test) {
               << std::endl;
     for (auto& trk : allTracks) {
       std::cout << "Track with ptr: " << &trk << std::endl;
-      auto range = state.trackToVerticesMultiMap.equal_range(&trk);
-      for (auto vtxIter = range.first; vtxIter != range.second; ++vtxIter) {
-        std::cout << "\t used by vertex: " << vtxIter->second << std::endl;
+      auto [begin, end] = state.trackVertexRange(state.trackIndex(&trk));
+      for (size_t i = begin; i < end; ++i) {
+        const size_t ivtx = state.links[state.trackVertexLinks[i]].second;
+        std::cout << "\t used by vertex: " << state.vertices[ivtx]
+                  << std::endl;
       }
     }
   }
@@ -442,11 +443,10 @@ BOOST_AUTO_TEST_CASE(adaptive_multi_vertex_fitter_test_athena) {
   vtxInfo1.oldPosition = vtxInfo1.linPoint;
   vtxInfo1.seedPosition = vtxInfo1.linPoint;
 
+  state.vertexInfo(vtx1) = std::move(vtxInfo1);
   for (const auto& trk : params1) {
-    vtxInfo1.trackLinks.push_back(&trk);
-    state.tracksAtVerticesMap.insert(
-        std::make_pair(std::make_pair(&trk, &vtx1),
-                       TrackAtVertex<BoundParameters>(1.5, trk, &trk)));
+    state.addTrackToVertex(vtx1,
+                           TrackAtVertex<BoundParameters>(1.5, trk, &trk));
   }
 
   // Prepare second vertex
@@ -469,18 +469,14 @@ BOOST_AUTO_TEST_CASE(adaptive_multi_vertex_fitter_test_athena) {
   vtxInfo2.oldPosition = vtxInfo2.linPoint;
   vtxInfo2.seedPosition = vtxInfo2.linPoint;
 
+  state.vertexInfo(vtx2) = std::move(vtxInfo2);
   for (const auto& trk : params2) {
-    vtxInfo2.trackLinks.push_back(&trk);
-    state.tracksAtVerticesMap.insert(
-        std::make_pair(std::make_pair(&trk, &vtx2),
-                       TrackAtVertex<BoundParameters>(1.5, trk, &trk)));
+    state.addTrackToVertex(vtx2,
+                           TrackAtVertex<BoundParameters>(1.5, trk, &trk));
   }
 
-  state.vtxInfoMap[&vtx1] = std::move(vtxInfo1);
-  state.vtxInfoMap[&vtx2] = std::move(vtxInfo2);
-
-  state.addVertexToMultiMap(vtx1);
-  state.addVertexToMultiMap(vtx2);
+  state.addVertexToTrackLinks(vtx1);
+  state.addVertexToTrackLinks(vtx2);
 
   // Fit vertices
   fitter.fit(state, vtxList, linearizer, vertexingOptions);
@@ -558,5 +554,168 @@ BOOST_AUTO_TEST_CASE(adaptive_multi_vertex_fitter_test_athena) {
   CHECK_CLOSE_ABS(vtx2FQ.second, expVtx2ndf, 0.001);
 }
 
+// Test the track and vertex bookkeeping of the fitter state
+BOOST_AUTO_TEST_CASE(adaptive_multi_vertex_fitter_state) {
+  using State = AdaptiveMultiVertexFitter<BoundParameters, Linearizer>::State;
+  using TrackAtVertex = TrackAtVertex<BoundParameters>;
+
+  std::vector<BoundParameters> tracks;
+  for (int i = 0; i < 3; ++i) {
+    Vector3D pos(0., 0., i * 1_mm);
+    tracks.emplace_back(geoContext, Covariance::Identity(), pos,
+                        Vector3D(1_GeV, 0., 0.), 1, 0,
+                        Surface::makeShared<PerigeeSurface>(pos));
+  }
+  Vertex<BoundParameters> vtx1, vtx2;
+
+  State state;
+  // tracks 0 and 1 at vtx1, tracks 1 and 2 at vtx2
+  BOOST_CHECK_EQUAL(state.addTrackToVertex(
+                        vtx1, TrackAtVertex(1., tracks[0], &tracks[0])),
+                    0u);
+  BOOST_CHECK_EQUAL(state.addTrackToVertex(
+                        vtx1, TrackAtVertex(2., tracks[1], &tracks[1])),
+                    1u);
+  BOOST_CHECK_EQUAL(state.addTrackToVertex(
+                        vtx2, TrackAtVertex(3., tracks[1], &tracks[1])),
+                    2u);
+  BOOST_CHECK_EQUAL(state.addTrackToVertex(
+                        vtx2, TrackAtVertex(4., tracks[2], &tracks[2])),
+                    3u);
+  BOOST_CHECK_EQUAL(state.vertices.size(), 2u);
+  BOOST_CHECK_EQUAL(state.tracks.size(), 3u);
+  BOOST_CHECK_EQUAL(state.vertexIndex(vtx2), 1u);
+  BOOST_CHECK_EQUAL(state.trackIndex(&tracks[2]), 2u);
+
+  // an existing track at vertex is kept for the same (track, vertex) pair
+  state.vertexInfo(vtx1) = VertexInfo<BoundParameters>();
+  BOOST_CHECK_EQUAL(state.addTrackToVertex(
+                        vtx1, TrackAtVertex(5., tracks[0], &tracks[0])),
+                    0u);
+  BOOST_CHECK_EQUAL(state.addTrackToVertex(
+                        vtx1, TrackAtVertex(6., tracks[1], &tracks[1])),
+                    1u);
+  BOOST_CHECK_EQUAL(state.tracksAtVertices.size(), 4u);
+  BOOST_CHECK_EQUAL(state.tracksAtVertices[0].chi2Track, 1.);
+
+  // only vertices added to the track links are used by the tracks
+  state.addVertexToTrackLinks(vtx2);
+  state.updateTrackVertexLinks();
+  BOOST_CHECK(state.trackVertexRange(0) == std::make_pair(0ul, 0ul));
+  BOOST_CHECK(state.trackVertexRange(1) == std::make_pair(0ul, 1ul));
+  state.addVertexToTrackLinks(vtx1);
+  state.updateTrackVertexLinks();
+  // the links of each track are in the order the vertices were added
+  auto [begin, end] = state.trackVertexRange(1);
+  BOOST_CHECK_EQUAL(end - begin, 2u);
+  BOOST_CHECK_EQUAL(state.trackVertexLinks[begin], 2u);
+  BOOST_CHECK_EQUAL(state.trackVertexLinks[begin + 1], 1u);
+  BOOST_CHECK(state.trackVertexRange(2) == std::make_pair(3ul, 4ul));
+
+  state.removeVertexFromTrackLinks(vtx2);
+  state.updateTrackVertexLinks();
+  BOOST_CHECK_EQUAL(state.activeLinks.size(), 2u);
+  BOOST_CHECK(state.trackVertexRange(1) == std::make_pair(1ul, 2ul));
+  BOOST_CHECK_EQUAL(state.trackVertexLinks[1], 1u);
+  BOOST_CHECK(state.trackVertexRange(2) == std::make_pair(2ul, 2ul));
+}
+
+// Test that the fit does not depend on the number of threads and that
+// cached linearizations give compatible results
+BOOST_AUTO_TEST_CASE(adaptive_multi_vertex_fitter_threads) {
+  using Fitter = AdaptiveMultiVertexFitter<BoundParameters, Linearizer>;
+  using IPEstimator = ImpactPoint3dEstimator<BoundParameters, Propagator>;
+
+  // Set up RNG
+  std::mt19937 gen(31415);
+
+  ConstantBField bField(Vector3D(0., 0., 2_T));
+  auto propagator =
+      std::make_shared<Propagator>(EigenStepper<ConstantBField>(bField));
+  IPEstimator::Config ip3dEstCfg(bField, propagator);
+  Linearizer linearizer(Linearizer::Config(bField, propagator));
+
+  VertexingOptions<BoundParameters> vertexingOptions(geoContext,
+                                                     magFieldContext);
+
+  // Vertices close enough in z to share all their tracks
+  std::vector<Vector3D> vtxPosVec{Vector3D(0.1_mm, -0.1_mm, -1_mm),
+                                  Vector3D(-0.1_mm, 0.05_mm, 0_mm),
+                                  Vector3D(0.05_mm, 0.1_mm, 1.5_mm)};
+
+  Covariance covMat = Covariance::Zero();
+  covMat.diagonal() << 50_um * 50_um, 50_um * 50_um, 1e-4, 1e-4,
+      1e-4 / (1_GeV * 1_GeV), 1.;
+
+  std::vector<BoundParameters> allTracks;
+  for (const auto& vtxPos : vtxPosVec) {
+    for (int iTrack = 0; iTrack < 5; ++iTrack) {
+      double q = qDist(gen) < 0 ? -1. : 1.;
+      BoundParameters::ParVector_t paramVec;
+      paramVec << d0Dist(gen), z0Dist(gen), phiDist(gen), thetaDist(gen),
+          q / pTDist(gen), 0.;
+      allTracks.emplace_back(geoContext, covMat, paramVec,
+                             Surface::makeShared<PerigeeSurface>(vtxPos));
+    }
+  }
+
+  // Seeds away from the true vertex positions require relinearization
+  const Vector3D seedShift(0.1_mm, 0._mm, 0.6_mm);
+
+  // Fit all vertices and return them together with all track weights
+  auto fitVertices = [&](unsigned int nThreads, bool cacheLinearizations) {
+    Fitter::Config fitterCfg(IPEstimator{ip3dEstCfg});
+    fitterCfg.nThreads = nThreads;
+    fitterCfg.cacheLinearizations = cacheLinearizations;
+    Fitter fitter(fitterCfg);
+
+    std::vector<Vertex<BoundParameters>> vtxList;
+    for (const auto& vtxPos : vtxPosVec) {
+      vtxList.emplace_back(Vector3D(vtxPos + seedShift));
+      vtxList.back().setFullCovariance(SpacePointSymMatrix::Identity());
+    }
+
+    Fitter::State state;
+    std::vector<Vertex<BoundParameters>*> vtxPtrList;
+    for (auto& vtx : vtxList) {
+      auto& vtxInfo = state.vertexInfo(vtx);
+      vtxInfo.linPoint = vtx.fullPosition();
+      vtxInfo.oldPosition = vtxInfo.linPoint;
+      vtxInfo.seedPosition = vtxInfo.linPoint;
+      for (const auto& trk : allTracks) {
+        state.addTrackToVertex(vtx, TrackAtVertex<BoundParameters>(trk, &trk));
+      }
+      state.addVertexToTrackLinks(vtx);
+      vtxPtrList.push_back(&vtx);
+    }
+
+    BOOST_CHECK(
+        fitter.fit(state, vtxPtrList, linearizer, vertexingOptions).ok());
+
+    std::vector<double> weights;
+    for (const auto& trkAtVtx : state.tracksAtVertices) {
+      weights.push_back(trkAtVtx.trackWeight);
+    }
+    return std::make_pair(std::move(vtxList), std::move(weights));
+  };
+
+  auto [serialVertices, serialWeights] = fitVertices(1, false);
+  auto [parallelVertices, parallelWeights] = fitVertices(4, false);
+  auto [cachedVertices, cachedWeights] = fitVertices(4, true);
+
+  BOOST_CHECK(serialWeights == parallelWeights);
+  for (size_t i = 0; i < vtxPosVec.size(); ++i) {
+    BOOST_CHECK(serialVertices[i].fullPosition() ==
+                parallelVertices[i].fullPosition());
+    BOOST_CHECK(serialVertices[i].fullCovariance() ==
+                parallelVertices[i].fullCovariance());
+    BOOST_CHECK(serialVertices[i].fitQuality() ==
+                parallelVertices[i].fitQuality());
+
+    CHECK_CLOSE_ABS(cachedVertices[i].position(),
+                    serialVertices[i].position(), 1_um);
+  }
+}
+
 }  // namespace Test
 }  // namespace Acts
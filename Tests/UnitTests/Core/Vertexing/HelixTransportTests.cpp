@@ -0,0 +1,223 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+
+#include "Acts/EventData/TrackParameters.hpp"
+#include "Acts/MagneticField/ConstantBField.hpp"
+#include "Acts/Propagator/EigenStepper.hpp"
+#include "Acts/Propagator/Propagator.hpp"
+#include "Acts/Surfaces/PerigeeSurface.hpp"
+#include "Acts/Surfaces/PlaneSurface.hpp"
+#include "Acts/Tests/CommonHelpers/FloatComparisons.hpp"
+#include "Acts/Utilities/Definitions.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include "Acts/Vertexing/detail/HelixTransport.hpp"
+
+using namespace Acts::UnitLiterals;
+
+namespace Acts {
+namespace Test {
+
+using Propagator = Acts::Propagator<EigenStepper<ConstantBField>>;
+
+// Create a test context
+GeometryContext geoContext = GeometryContext();
+MagneticFieldContext magFieldContext = MagneticFieldContext();
+
+// Track d0 distribution
+std::uniform_real_distribution<> d0Dist(-0.1_mm, 0.1_mm);
+// Track z0 distribution
+std::uniform_real_distribution<> z0Dist(-5_mm, 5_mm);
+// Track pT distribution
+std::uniform_real_distribution<> pTDist(0.4_GeV, 10_GeV);
+// Track phi distribution
+std::uniform_real_distribution<> phiDist(-M_PI, M_PI);
+// Track theta distribution
+std::uniform_real_distribution<> thetaDist(0.5, M_PI - 0.5);
+// Track charge helper distribution
+std::uniform_real_distribution<> qDist(-1, 1);
+
+/// @brief Creates random track parameters on the given perigee surface
+BoundVector makeParameters(std::mt19937& gen) {
+  double q = qDist(gen) < 0 ? -1. : 1.;
+  BoundVector paramVec;
+  paramVec << d0Dist(gen), z0Dist(gen), phiDist(gen), thetaDist(gen),
+      q / pTDist(gen), 1_ns;
+  return paramVec;
+}
+
+/// @brief Jacobian of the transported parameters from central differences
+template <typename transport_t>
+BoundMatrix numericalJacobian(const BoundVector& paramVec,
+                              const transport_t& transport) {
+  BoundMatrix jacobian;
+  for (unsigned int i = 0; i < eBoundParametersSize; ++i) {
+    const double h = 1e-6;
+    BoundVector up = paramVec;
+    BoundVector down = paramVec;
+    up[i] += h;
+    down[i] -= h;
+    BoundVector diff = transport(up) - transport(down);
+    diff[ParID_t::ePHI] = std::remainder(diff[ParID_t::ePHI], 2 * M_PI);
+    jacobian.col(i) = diff / (2 * h);
+  }
+  return jacobian;
+}
+
+///
+/// @brief Unit test for the helix transport to a perigee surface
+///
+BOOST_AUTO_TEST_CASE(helix_transport_perigee_test) {
+  std::mt19937 gen(31415);
+
+  ConstantBField bField(0., 0., 2_T);
+  auto propagator =
+      std::make_shared<Propagator>(EigenStepper<ConstantBField>(bField));
+  PropagatorOptions<> pOptions(geoContext, magFieldContext);
+  pOptions.direction = backward;
+
+  auto startSurface =
+      Surface::makeShared<PerigeeSurface>(Vector3D(0.2_mm, -0.1_mm, 1_mm));
+  auto targetSurface =
+      Surface::makeShared<PerigeeSurface>(Vector3D(1_mm, -2_mm, 3_mm));
+  const double bZ = bField.getField(startSurface->center(geoContext))[eZ];
+
+  auto transport = [&](const BoundVector& paramVec) {
+    BoundParameters params(geoContext, std::nullopt, paramVec, startSurface);
+    return detail::transportHelixToPerigee(geoContext, params, bZ,
+                                           pOptions.mass, targetSurface)
+        .value()
+        .parameters();
+  };
+
+  for (unsigned int iTrack = 0; iTrack < 100; ++iTrack) {
+    BoundVector paramVec = makeParameters(gen);
+    BoundParameters params(geoContext, BoundSymMatrix::Identity(), paramVec,
+                           startSurface);
+
+    auto result = detail::transportHelixToPerigee(
+        geoContext, params, bZ, pOptions.mass, targetSurface);
+    BOOST_CHECK(result.ok());
+    const BoundParameters& transported = *result;
+
+    // Compare to the propagation
+    auto propResult =
+        propagator->propagate(params, *targetSurface, pOptions).value();
+    const BoundVector& propParams = propResult.endParameters->parameters();
+    for (unsigned int i = 0; i < eBoundParametersSize; ++i) {
+      CHECK_CLOSE_ABS(transported.parameters()[i], propParams[i], 1_um);
+    }
+
+    // The transported covariance is J * J^T for a unit covariance
+    BoundMatrix jacobian = numericalJacobian(paramVec, transport);
+    BoundSymMatrix expectedCov = jacobian * jacobian.transpose();
+    BOOST_CHECK(transported.covariance()->isApprox(expectedCov, 1e-5));
+  }
+}
+
+///
+/// @brief Unit test for the helix transport to a plane surface
+///
+BOOST_AUTO_TEST_CASE(helix_transport_plane_test) {
+  std::mt19937 gen(27182);
+
+  ConstantBField bField(0., 0., 2_T);
+  auto propagator =
+      std::make_shared<Propagator>(EigenStepper<ConstantBField>(bField));
+  PropagatorOptions<> pOptions(geoContext, magFieldContext);
+  pOptions.direction = backward;
+
+  auto startSurface =
+      Surface::makeShared<PerigeeSurface>(Vector3D(0.2_mm, -0.1_mm, 1_mm));
+  const double bZ = bField.getField(startSurface->center(geoContext))[eZ];
+
+  for (unsigned int iTrack = 0; iTrack < 100; ++iTrack) {
+    BoundVector paramVec = makeParameters(gen);
+    BoundParameters params(geoContext, BoundSymMatrix::Identity(), paramVec,
+                           startSurface);
+
+    // Plane orthogonal to the track direction a few mm along the track
+    Vector3D direction = params.momentum().normalized();
+    Transform3D transform = Transform3D::Identity();
+    transform.linear() =
+        Eigen::Quaterniond::FromTwoVectors(Vector3D::UnitZ(), direction)
+            .toRotationMatrix();
+    transform.translation() = params.position() - 3_mm * direction;
+    auto targetSurface = Surface::makeShared<PlaneSurface>(
+        std::make_shared<Transform3D>(transform));
+
+    auto transport = [&](const BoundVector& vec) {
+      BoundParameters trk(geoContext, std::nullopt, vec, startSurface);
+      return detail::transportHelixToPlane(geoContext, trk, bZ, pOptions.mass,
+                                           targetSurface, 0.)
+          .value()
+          .parameters();
+    };
+
+    auto result = detail::transportHelixToPlane(
+        geoContext, params, bZ, pOptions.mass, targetSurface, 0.);
+    BOOST_CHECK(result.ok());
+    const BoundParameters& transported = *result;
+
+    // Compare to the propagation
+    auto propResult =
+        propagator->propagate(params, *targetSurface, pOptions).value();
+    const BoundVector& propParams = propResult.endParameters->parameters();
+    for (unsigned int i = 0; i < eBoundParametersSize; ++i) {
+      CHECK_CLOSE_ABS(transported.parameters()[i], propParams[i], 1_um);
+    }
+    BOOST_CHECK(transported.covariance()->isApprox(
+        *propResult.endParameters->covariance(), 1e-4));
+
+    BoundMatrix jacobian = numericalJacobian(paramVec, transport);
+    BoundSymMatrix expectedCov = jacobian * jacobian.transpose();
+    BOOST_CHECK(transported.covariance()->isApprox(expectedCov, 1e-5));
+  }
+}
+
+///
+/// @brief Unit test for the conditions of the helix transport
+///
+BOOST_AUTO_TEST_CASE(helix_transport_applicable_test) {
+  std::mt19937 gen(31415);
+
+  auto perigeeSurface =
+      Surface::makeShared<PerigeeSurface>(Vector3D(0., 0., 0.));
+  BoundParameters params(geoContext, std::nullopt, makeParameters(gen),
+                         perigeeSurface);
+
+  const double tolerance = 1e-4;
+  Vector3D field(0., 0., 2_T);
+  BOOST_CHECK(detail::isHelixTransportApplicable(geoContext, params, field,
+                                                 field, tolerance));
+
+  // Field not along z
+  Vector3D tiltedField(0.01_T, 0., 2_T);
+  BOOST_CHECK(!detail::isHelixTransportApplicable(
+      geoContext, params, tiltedField, tiltedField, tolerance));
+  // Field not uniform
+  BOOST_CHECK(!detail::isHelixTransportApplicable(
+      geoContext, params, field, Vector3D(0., 0., 1.9_T), tolerance));
+  // No field
+  BOOST_CHECK(!detail::isHelixTransportApplicable(
+      geoContext, params, Vector3D::Zero(), Vector3D::Zero(), tolerance));
+
+  // Parameters not bound to a perigee surface
+  auto planeSurface = Surface::makeShared<PlaneSurface>(
+      Vector3D(0., 0., 0.), Vector3D(1., 0., 0.));
+  BoundParameters planeParams(geoContext, std::nullopt, makeParameters(gen),
+                              planeSurface);
+  BOOST_CHECK(!detail::isHelixTransportApplicable(
+      geoContext, planeParams, field, field, tolerance));
+}
+
+}  // namespace Test
+}  // namespace Acts
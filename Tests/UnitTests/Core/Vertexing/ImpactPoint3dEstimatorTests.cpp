@@ -296,6 +296,84 @@ BOOST_AUTO_TEST_CASE(impactpoint_3d_estimator_compatibility_test) {
   }
 }
 
+/// @brief Unit test for ImpactPoint3dEstimator with the closed-form
+/// helix transport, compared to the propagation
+BOOST_AUTO_TEST_CASE(impactpoint_3d_estimator_analytic_test) {
+  // Number of tests
+  unsigned int nTests = 10;
+
+  // Set up RNG
+  int mySeed = 31415;
+  std::mt19937 gen(mySeed);
+
+  // Set up constant B-Field
+  ConstantBField bField(Vector3D(0., 0., 2._T));
+
+  // Set up Eigenstepper
+  EigenStepper<ConstantBField> stepper(bField);
+
+  // Set up propagator with void navigator
+  auto propagator = std::make_shared<Propagator>(stepper);
+
+  // Set up the ImpactPoint3dEstimators
+  ImpactPoint3dEstimator<BoundParameters, Propagator>::Config ipEstCfg(
+      bField, propagator);
+  ImpactPoint3dEstimator<BoundParameters, Propagator> ipEstimator(ipEstCfg);
+
+  ipEstCfg.useAnalyticTransport = true;
+  ImpactPoint3dEstimator<BoundParameters, Propagator> analyticIpEstimator(
+      ipEstCfg);
+
+  // Vertex position
+  Vector3D vtxPos(0.1_mm, -0.05_mm, 0.3_mm);
+
+  for (unsigned int i = 0; i < nTests; i++) {
+    // Resolutions
+    double resD0 = resIPDist(gen);
+    double resZ0 = resIPDist(gen);
+    double resPh = resAngDist(gen);
+    double resTh = resAngDist(gen);
+    double resQp = resQoPDist(gen);
+
+    // Covariance matrix
+    Covariance covMat;
+    covMat << resD0 * resD0, 0., 0., 0., 0., 0., 0., resZ0 * resZ0, 0., 0., 0.,
+        0., 0., 0., resPh * resPh, 0., 0., 0., 0., 0., 0., resTh * resTh, 0.,
+        0., 0., 0., 0., 0., resQp * resQp, 0., 0., 0., 0., 0., 0., 1.;
+
+    // The charge
+    double q = qDist(gen) < 0 ? -1. : 1.;
+
+    // The track parameters
+    BoundParameters::ParVector_t paramVec;
+    paramVec << d0Dist(gen), z0Dist(gen), phiDist(gen), thetaDist(gen),
+        q / pTDist(gen), 0.;
+
+    std::shared_ptr<PerigeeSurface> perigeeSurface =
+        Surface::makeShared<PerigeeSurface>(Vector3D(0., 0., 0.));
+
+    BoundParameters myTrack(geoContext, std::move(covMat), paramVec,
+                            perigeeSurface);
+
+    auto res = ipEstimator.getParamsAtClosestApproach(
+        geoContext, magFieldContext, myTrack, vtxPos);
+    BOOST_CHECK(res.ok());
+    auto analyticRes = analyticIpEstimator.getParamsAtClosestApproach(
+        geoContext, magFieldContext, myTrack, vtxPos);
+    BOOST_CHECK(analyticRes.ok());
+
+    const BoundParameters& propParams = **res;
+    const BoundParameters& analyticParams = **analyticRes;
+
+    for (unsigned int iPar = 0; iPar < eBoundParametersSize; ++iPar) {
+      CHECK_CLOSE_ABS(analyticParams.parameters()[iPar],
+                      propParams.parameters()[iPar], 1_um);
+    }
+    BOOST_CHECK(analyticParams.covariance()->isApprox(
+        *propParams.covariance(), 1e-4));
+  }
+}
+
 /// @brief Unit test for ImpactPoint 3d estimator, using same
 /// configuration and test values as in Athena unit test algorithm
 /// Tracking/TrkVertexFitter/TrkVertexFitterUtils/test/ImpactPoint3dEstimator_test
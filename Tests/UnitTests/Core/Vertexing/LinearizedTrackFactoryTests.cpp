@@ -240,5 +240,131 @@ BOOST_AUTO_TEST_CASE(linearized_track_factory_straightline_test) {
   }
 }
 
+///
+/// @brief Unit test for HelicalTrackLinearizer using the closed-form helix
+/// transport, compared to the linearization using the propagator
+///
+BOOST_AUTO_TEST_CASE(linearized_track_factory_analytic_test) {
+  // Number of tracks
+  unsigned int nTracks = 100;
+
+  // Set up RNG
+  int mySeed = 31415;
+  std::mt19937 gen(mySeed);
+
+  // Set up constant B-Field
+  ConstantBField bField(0.0, 0.0, 2_T);
+
+  // Set up Eigenstepper
+  EigenStepper<ConstantBField> stepper(bField);
+
+  // Set up propagator with void navigator
+  auto propagator =
+      std::make_shared<Propagator<EigenStepper<ConstantBField>>>(stepper);
+
+  // Create perigee surface
+  std::shared_ptr<PerigeeSurface> perigeeSurface =
+      Surface::makeShared<PerigeeSurface>(Vector3D(0., 0., 0.));
+
+  // Create position of vertex and perigee surface
+  double x = vXYDist(gen);
+  double y = vXYDist(gen);
+  double z = vZDist(gen);
+
+  // Calculate d0 and z0 corresponding to vertex position
+  double d0v = sqrt(x * x + y * y);
+  double z0v = z;
+
+  // Start constructing nTracks tracks in the following
+  std::vector<BoundParameters> tracks;
+
+  // Construct random track emerging from vicinity of vertex position
+  for (unsigned int iTrack = 0; iTrack < nTracks; iTrack++) {
+    // Construct positive or negative charge randomly
+    double q = qDist(gen) < 0 ? -1. : 1.;
+
+    // Construct random track parameters
+    BoundVector paramVec;
+    paramVec << d0v + d0Dist(gen), z0v + z0Dist(gen), phiDist(gen),
+        thetaDist(gen), q / pTDist(gen), 0.;
+
+    // Resolutions
+    double resD0 = resIPDist(gen);
+    double resZ0 = resIPDist(gen);
+    double resPh = resAngDist(gen);
+    double resTh = resAngDist(gen);
+    double resQp = resQoPDist(gen);
+
+    // Fill vector of track objects with simple covariance matrix
+    Covariance covMat;
+
+    covMat << resD0 * resD0, 0., 0., 0., 0., 0., 0., resZ0 * resZ0, 0., 0., 0.,
+        0., 0., 0., resPh * resPh, 0., 0., 0., 0., 0., 0., resTh * resTh, 0.,
+        0., 0., 0., 0., 0., resQp * resQp, 0., 0., 0., 0., 0., 0., 1.;
+    tracks.push_back(BoundParameters(geoContext, std::move(covMat), paramVec,
+                                     perigeeSurface));
+  }
+
+  Linearizer::Config ltConfig(bField, propagator);
+  Linearizer linFactory(ltConfig);
+  ltConfig.useAnalyticTransport = true;
+  Linearizer analyticLinFactory(ltConfig);
+
+  // Linearization point away from the track perigee
+  SpacePointVector linPoint(x + 1_mm, y - 2_mm, z + 3_mm, 0.);
+
+  for (const BoundParameters& parameters : tracks) {
+    LinearizedTrack linTrack =
+        linFactory
+            .linearizeTrack(parameters, linPoint, geoContext, magFieldContext)
+            .value();
+    LinearizedTrack analyticLinTrack =
+        analyticLinFactory
+            .linearizeTrack(parameters, linPoint, geoContext, magFieldContext)
+            .value();
+
+    // Agreement is limited by the precision of the propagation, and the
+    // covariance transport of the propagator to the perigee is approximate
+    BOOST_CHECK(analyticLinTrack.parametersAtPCA.isApprox(
+        linTrack.parametersAtPCA, 1e-4));
+    BOOST_CHECK(analyticLinTrack.covarianceAtPCA.isApprox(
+        linTrack.covarianceAtPCA, 1e-2));
+    BOOST_CHECK(analyticLinTrack.positionAtPCA.isApprox(
+        linTrack.positionAtPCA, 1e-4));
+    BOOST_CHECK(analyticLinTrack.positionJacobian.isApprox(
+        linTrack.positionJacobian, 1e-4));
+    BOOST_CHECK(analyticLinTrack.momentumJacobian.isApprox(
+        linTrack.momentumJacobian, 1e-4));
+    BOOST_CHECK(
+        analyticLinTrack.constantTerm.isApprox(linTrack.constantTerm, 1e-4));
+  }
+
+  // A field that is not uniform along z falls back to the propagation
+  ConstantBField tiltedField(0.1_T, 0.0, 2_T);
+  auto tiltedPropagator = std::make_shared<
+      Propagator<EigenStepper<ConstantBField>>>(
+      EigenStepper<ConstantBField>(tiltedField));
+  Linearizer::Config tiltedConfig(tiltedField, tiltedPropagator);
+  Linearizer tiltedLinFactory(tiltedConfig);
+  tiltedConfig.useAnalyticTransport = true;
+  Linearizer tiltedAnalyticLinFactory(tiltedConfig);
+
+  for (const BoundParameters& parameters : tracks) {
+    LinearizedTrack linTrack =
+        tiltedLinFactory
+            .linearizeTrack(parameters, linPoint, geoContext, magFieldContext)
+            .value();
+    LinearizedTrack analyticLinTrack =
+        tiltedAnalyticLinFactory
+            .linearizeTrack(parameters, linPoint, geoContext, magFieldContext)
+            .value();
+
+    BOOST_CHECK_EQUAL(analyticLinTrack.parametersAtPCA,
+                      linTrack.parametersAtPCA);
+    BOOST_CHECK_EQUAL(analyticLinTrack.covarianceAtPCA,
+                      linTrack.covarianceAtPCA);
+  }
+}
+
 }  // namespace Test
 }  // namespace Acts
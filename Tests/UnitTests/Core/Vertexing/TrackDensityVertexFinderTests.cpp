@@ -233,6 +233,104 @@ BOOST_AUTO_TEST_CASE(track_density_finder_random_test) {
   }
 }
 
+///
+/// @brief Unit test for TrackDensityVertexFinder reusing its state while
+/// tracks are removed, as done during iterative vertex finding
+///
+BOOST_AUTO_TEST_CASE(track_density_finder_state_test) {
+  Covariance covMat = Covariance::Identity();
+
+  // Perigee surface for track parameters
+  Vector3D pos0{0, 0, 0};
+  std::shared_ptr<PerigeeSurface> perigeeSurface =
+      Surface::makeShared<PerigeeSurface>(pos0);
+
+  VertexingOptions<BoundParameters> vertexingOptions(geoContext,
+                                                     magFieldContext);
+
+  using Finder =
+      TrackDensityVertexFinder<DummyVertexFitter<>, GaussianTrackDensity>;
+  Finder finder;
+
+  int mySeed = 27182;
+  std::mt19937 gen(mySeed);
+  unsigned int nTracks = 200;
+
+  std::vector<BoundParameters> trackVec;
+  trackVec.reserve(nTracks);
+
+  // Create nTracks tracks for test case
+  for (unsigned int i = 0; i < nTracks; i++) {
+    // The position of the particle
+    Vector3D pos(xdist(gen), ydist(gen), 0);
+    if ((i % 4) == 0) {
+      pos[eZ] = z2dist(gen);
+    } else {
+      pos[eZ] = z1dist(gen);
+    }
+
+    // Create momentum and charge of track
+    double pt = pTDist(gen);
+    double phi = phiDist(gen);
+    double eta = etaDist(gen);
+    Vector3D mom(pt * std::cos(phi), pt * std::sin(phi), pt * std::sinh(eta));
+    double charge = etaDist(gen) > 0 ? 1 : -1;
+
+    trackVec.push_back(BoundParameters(geoContext, covMat, pos, mom, charge, 0,
+                                       perigeeSurface));
+  }
+
+  std::vector<const BoundParameters*> trackPtrVec;
+  for (const auto& trk : trackVec) {
+    trackPtrVec.push_back(&trk);
+  }
+
+  // Remove the tracks close to the found seed after each call, the seeds
+  // found with the reused state need to match the ones found from scratch
+  Finder::State state;
+  for (unsigned int iteration = 0; iteration < 5; iteration++) {
+    auto res = finder.find(trackPtrVec, vertexingOptions, state);
+    auto resFresh = finder.find(trackPtrVec, vertexingOptions);
+    BOOST_CHECK(res.ok());
+    BOOST_CHECK(resFresh.ok());
+    if (!res.ok() || !resFresh.ok()) {
+      break;
+    }
+    BOOST_CHECK_EQUAL(state.tracks.size(), trackPtrVec.size());
+    Vector3D result = (*res).back().position();
+    Vector3D resultFresh = (*resFresh).back().position();
+    BOOST_CHECK_EQUAL(result[eZ], resultFresh[eZ]);
+
+    auto nearSeed = [&](const BoundParameters* trk) {
+      return std::abs(trk->parameters()[ParID_t::eLOC_Z0] - result[eZ]) <
+             0.5_mm;
+    };
+    trackPtrVec.erase(
+        std::remove_if(trackPtrVec.begin(), trackPtrVec.end(), nearSeed),
+        trackPtrVec.end());
+  }
+
+  // Tracks sharing the same z0 are removed one at a time, the remaining
+  // ones still contribute to the density
+  BOOST_REQUIRE(!trackPtrVec.empty());
+  std::vector<BoundParameters> duplicates(20, *trackPtrVec.front());
+  for (const auto& trk : duplicates) {
+    trackPtrVec.push_back(&trk);
+  }
+  for (unsigned int i = 0; i < duplicates.size(); i++) {
+    auto res = finder.find(trackPtrVec, vertexingOptions, state);
+    auto resFresh = finder.find(trackPtrVec, vertexingOptions);
+    BOOST_CHECK(res.ok());
+    BOOST_CHECK(resFresh.ok());
+    if (!res.ok() || !resFresh.ok()) {
+      break;
+    }
+    BOOST_CHECK_EQUAL((*res).back().position()[eZ],
+                      (*resFresh).back().position()[eZ]);
+    trackPtrVec.pop_back();
+  }
+}
+
 // Dummy user-defined InputTrack type
 struct InputTrack {
   InputTrack(const BoundParameters& params) : m_parameters(params) {}
@@ -0,0 +1,85 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/test/unit_test.hpp>
+
+#include "ActsFatras/EventData/Columns.hpp"
+
+using namespace ActsFatras;
+
+namespace {
+const auto pid = Barcode().setVertexPrimary(12).setParticle(23);
+const auto gid = Acts::GeometryID().setVolume(1).setLayer(2).setSensitive(3);
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(FatrasColumns)
+
+BOOST_AUTO_TEST_CASE(Hits) {
+  HitColumns hits;
+  BOOST_TEST(hits.empty());
+
+  for (int i = 0; i < 10; ++i) {
+    hits.push_back(Hit(gid, pid, Hit::Vector4(1, 2, 3, i),
+                       Hit::Vector4(1, 1, 1, 4), Hit::Vector4(1, 1, 0.5, 3.5),
+                       i));
+  }
+  BOOST_TEST(hits.size() == 10u);
+  BOOST_TEST(hits.position4.size() == 10u);
+  for (int i = 0; i < 10; ++i) {
+    const Hit h = hits[i];
+    BOOST_TEST(h.geometryId() == gid);
+    BOOST_TEST(h.particleId() == pid);
+    BOOST_TEST(h.index() == i);
+    BOOST_TEST(h.position4() == Hit::Vector4(1, 2, 3, i));
+    BOOST_TEST(h.momentum4Before() == Hit::Vector4(1, 1, 1, 4));
+    BOOST_TEST(h.momentum4After() == Hit::Vector4(1, 1, 0.5, 3.5));
+    BOOST_TEST(hits.position4[i][3] == i);
+  }
+
+  // clearing keeps the memory for the next event
+  const auto capacity = hits.position4.capacity();
+  hits.clear();
+  BOOST_TEST(hits.empty());
+  BOOST_TEST(hits.position4.capacity() == capacity);
+}
+
+BOOST_AUTO_TEST_CASE(Particles) {
+  ParticleColumns particles;
+  particles.reserve(8);
+  BOOST_TEST(particles.empty());
+  BOOST_TEST(particles.absMomentum.capacity() >= 8u);
+
+  const auto particle = Particle(pid, Acts::PdgParticle::eProton, 1, 0.938)
+                            .setProcess(ProcessType::eUndefined)
+                            .setPosition4(1, 2, 3, 4)
+                            .setDirection(0, 1, 1)
+                            .setAbsMomentum(10)
+                            .setMaterialPassed(0.5, 0.25)
+                            .setMaterialLimits(2, 1);
+  particles.push_back(particle);
+  BOOST_TEST(particles.size() == 1u);
+
+  const Particle p = particles[0];
+  BOOST_TEST(p.particleId() == particle.particleId());
+  BOOST_TEST(p.process() == particle.process());
+  BOOST_TEST(p.pdg() == particle.pdg());
+  BOOST_TEST(p.charge() == particle.charge());
+  BOOST_TEST(p.mass() == particle.mass());
+  BOOST_TEST(p.position4() == particle.position4());
+  BOOST_TEST(p.unitDirection().isApprox(particle.unitDirection()));
+  BOOST_TEST(p.absMomentum() == particle.absMomentum());
+  BOOST_TEST(p.pathInX0() == particle.pathInX0());
+  BOOST_TEST(p.pathInL0() == particle.pathInL0());
+  BOOST_TEST(p.pathLimitX0() == particle.pathLimitX0());
+  BOOST_TEST(p.pathLimitL0() == particle.pathLimitL0());
+
+  particles.clear();
+  BOOST_TEST(particles.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,124 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/MagneticField/MagneticFieldContext.hpp"
+#include "Acts/Propagator/PropagatorError.hpp"
+#include "ActsFatras/EventData/Particle.hpp"
+#include "ActsFatras/Kernel/Simulator.hpp"
+#include "ActsFatras/Selectors/ChargeSelectors.hpp"
+
+using namespace ActsFatras;
+
+namespace {
+
+/// Mock-up single particle simulator that fails for one particle number and
+/// lets every primary generate a single secondary.
+struct MockParticleSimulator {
+  Barcode::Value failedParticle = 0u;
+
+  template <typename generator_t>
+  Acts::Result<InteractorResult> simulate(const Acts::GeometryContext &,
+                                          const Acts::MagneticFieldContext &,
+                                          generator_t &,
+                                          const Particle &particle) const {
+    if (particle.particleId().particle() == failedParticle) {
+      return Acts::PropagatorError::Failure;
+    }
+    InteractorResult result;
+    result.particle = particle;
+    if (particle.particleId().generation() == 0u) {
+      result.generatedParticles.push_back(
+          particle.withParticleId(particle.particleId().makeDescendant()));
+    }
+    return result;
+  }
+};
+
+using TestSimulator =
+    ActsFatras::Simulator<ChargedSelector, MockParticleSimulator,
+                          NeutralSelector, MockParticleSimulator>;
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(FatrasSimulator)
+
+BOOST_AUTO_TEST_CASE(FailedPrimary) {
+  Acts::GeometryContext geoCtx;
+  Acts::MagneticFieldContext magCtx;
+  const Barcode::Value failed = 3u;
+  TestSimulator simulator(MockParticleSimulator{failed},
+                          MockParticleSimulator{failed});
+
+  // the failing primary is in the middle of the input
+  std::vector<Particle> input;
+  for (Barcode::Value i = 1u; i <= 5u; ++i) {
+    const auto pid = Barcode().setVertexPrimary(1).setParticle(i);
+    input.emplace_back(pid, (i % 2 == 0) ? Acts::PdgParticle::ePionZero
+                                         : Acts::PdgParticle::eMuon);
+  }
+
+  auto check = [&](auto &result, const std::vector<Particle> &initial,
+                   const std::vector<Particle> &final) {
+    BOOST_TEST_REQUIRE(result.ok());
+    // the failed primary is reported exactly once
+    const auto &failedParticles = result.value();
+    BOOST_TEST_REQUIRE(failedParticles.size() == 1u);
+    BOOST_TEST(failedParticles.front().particle.particleId() ==
+               input[failed - 1].particleId());
+    BOOST_CHECK(failedParticles.front().error ==
+                Acts::PropagatorError::Failure);
+    // every other primary and its secondary are simulated
+    BOOST_TEST(initial.size() == 2 * (input.size() - 1));
+    BOOST_TEST(final.size() == initial.size());
+    for (const auto &particle : input) {
+      auto n = std::count_if(
+          initial.begin(), initial.end(), [&](const Particle &simulated) {
+            return simulated.particleId().particle() ==
+                   particle.particleId().particle();
+          });
+      BOOST_TEST(n == ((particle.particleId().particle() == failed) ? 0 : 2));
+    }
+  };
+
+  std::ranlux48 generator;
+  std::vector<Particle> initial, final;
+  std::vector<Hit> hits;
+  auto result = simulator.simulate(geoCtx, magCtx, generator, input, initial,
+                                   final, hits);
+  check(result, initial, final);
+
+  // the scratch buffers are reused between events
+  TestSimulator::ParallelState state;
+  for (std::size_t nThreads : {1u, 2u}) {
+    initial.clear();
+    final.clear();
+    result = simulator.simulateParallel<std::ranlux48>(
+        geoCtx, magCtx, 1234u, input, initial, final, hits, nThreads);
+    check(result, initial, final);
+    for (int event = 0; event < 2; ++event) {
+      initial.clear();
+      final.clear();
+      result = simulator.simulateParallel<std::ranlux48>(
+          geoCtx, magCtx, 1234u, input, initial, final, hits, state,
+          nThreads);
+      check(result, initial, final);
+    }
+  }
+  BOOST_TEST(state.primaries.size() == input.size());
+  BOOST_TEST(state.threads.size() == 2u);
+  BOOST_TEST(hits.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -12,6 +12,8 @@
 #include <algorithm>
 #include <chrono>
 #include <ctime>
+#include <map>
+#include <queue>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -520,5 +522,163 @@ BOOST_AUTO_TEST_CASE(create_Clusters2) {
   }
   CHECK_CLOSE_REL(data9, (nClustersNoTouch * 2) * 2, 1e-5);
 }
+
+/// Reference clusterization with a breadth-first search over the channels,
+/// independent of the algorithm under test. Returns the clusters as sorted
+/// lists of global indices, in sorted order.
+std::vector<std::vector<size_t>> referenceClusters(
+    const std::vector<DigitizationCell>& cells, size_t nBins0,
+    bool commonCorner, double energyCut) {
+  std::map<std::pair<long, long>, bool> unused;
+  for (const auto& cell : cells) {
+    if (cell.depositedEnergy() >= energyCut) {
+      unused[{cell.channel0, cell.channel1}] = true;
+    }
+  }
+  std::vector<std::vector<size_t>> clusters;
+  for (auto& seed : unused) {
+    if (not seed.second) {
+      continue;
+    }
+    seed.second = false;
+    std::vector<size_t> cluster;
+    std::queue<std::pair<long, long>> open;
+    open.push(seed.first);
+    while (not open.empty()) {
+      auto [a, b] = open.front();
+      open.pop();
+      cluster.push_back(a + nBins0 * b);
+      for (long da = -1; da <= 1; ++da) {
+        for (long db = -1; db <= 1; ++db) {
+          if ((da == 0 and db == 0) or
+              (not commonCorner and da != 0 and db != 0)) {
+            continue;
+          }
+          auto neighbour = unused.find({a + da, b + db});
+          if (neighbour != unused.end() and neighbour->second) {
+            neighbour->second = false;
+            open.push(neighbour->first);
+          }
+        }
+      }
+    }
+    std::sort(cluster.begin(), cluster.end());
+    clusters.push_back(std::move(cluster));
+  }
+  std::sort(clusters.begin(), clusters.end());
+  return clusters;
+}
+
+/// This test checks that the vector based and the map based clusterization
+/// find the same clusters as a reference breadth-first search, also when
+/// many modules are processed in parallel
+BOOST_AUTO_TEST_CASE(create_Clusters_vector) {
+  size_t nBins0 = 40;
+  auto globalIndex = [&nBins0](const size_t& a, const size_t& b) {
+    return (a + nBins0 * b);
+  };
+
+  // pseudo-random occupancy of about one third, in reverse order
+  std::vector<Acts::DigitizationCell> cells;
+  for (size_t b = 40; b-- > 0;) {
+    for (size_t a = nBins0; a-- > 0;) {
+      size_t hash = (a * 7919 + b * 104729 + a * b * 31) % 97;
+      if (hash < 33) {
+        cells.emplace_back(a, b, 1. + (hash % 3));
+      }
+    }
+  }
+
+  // the clusters as sorted lists of global indices, for comparison
+  auto toIndices = [&](const std::vector<std::vector<DigitizationCell>>& cls) {
+    std::vector<std::vector<size_t>> indices;
+    for (const auto& cluster : cls) {
+      indices.emplace_back();
+      for (const auto& cell : cluster) {
+        indices.back().push_back(globalIndex(cell.channel0, cell.channel1));
+      }
+      std::sort(indices.back().begin(), indices.back().end());
+    }
+    std::sort(indices.begin(), indices.end());
+    return indices;
+  };
+
+  for (bool commonCorner : {true, false}) {
+    for (double energyCut : {0., 1.5}) {
+      std::unordered_map<size_t, std::pair<Acts::DigitizationCell, bool>>
+          cellMap;
+      for (const auto& cell : cells) {
+        cellMap.insert(
+            {globalIndex(cell.channel0, cell.channel1), {cell, false}});
+      }
+      auto mapClusters = toIndices(Acts::createClusters<DigitizationCell>(
+          cellMap, nBins0, commonCorner, energyCut));
+      auto vectorClusters = toIndices(Acts::createClusters<DigitizationCell>(
+          cells, commonCorner, energyCut));
+      auto reference =
+          referenceClusters(cells, nBins0, commonCorner, energyCut);
+      // the cells form isolated cells as well as larger clusters
+      BOOST_CHECK_LT(reference.size(), cells.size());
+      BOOST_CHECK(std::any_of(reference.begin(), reference.end(),
+                              [](const auto& c) { return c.size() == 1u; }));
+      BOOST_CHECK(mapClusters == reference);
+      BOOST_CHECK(vectorClusters == reference);
+      // all cells above threshold are flagged as used
+      for (const auto& cell : cellMap) {
+        BOOST_CHECK_EQUAL(cell.second.second,
+                          cell.second.first.depositedEnergy() >= energyCut);
+      }
+    }
+  }
+
+  // the cells of a cluster are sorted by (channel1, channel0)
+  auto clusters = Acts::createClusters<DigitizationCell>(cells, true, 0.);
+  for (const auto& cluster : clusters) {
+    for (size_t i = 1; i < cluster.size(); ++i) {
+      BOOST_CHECK(std::make_pair(cluster[i - 1].channel1,
+                                 cluster[i - 1].channel0) <
+                  std::make_pair(cluster[i].channel1, cluster[i].channel0));
+    }
+  }
+
+  // many modules in parallel give the same result as one after the other
+  std::vector<std::vector<Acts::DigitizationCell>> modules;
+  for (size_t m = 0; m < 50; ++m) {
+    modules.emplace_back(cells.begin() + m, cells.end() - m);
+  }
+  auto moduleClusters =
+      Acts::createModuleClusters<DigitizationCell>(modules, true, 0., 4);
+  BOOST_CHECK_EQUAL(moduleClusters.size(), modules.size());
+  for (size_t m = 0; m < modules.size(); ++m) {
+    auto serial = Acts::createClusters<DigitizationCell>(modules[m], true, 0.);
+    BOOST_CHECK(toIndices(moduleClusters[m]) == toIndices(serial));
+  }
+}
+
+/// This test checks that a single cluster covering a large module does not
+/// exhaust the stack
+BOOST_AUTO_TEST_CASE(create_Clusters_large) {
+  size_t nBins = 1000;
+  std::vector<Acts::DigitizationCell> cells;
+  cells.reserve(nBins * nBins);
+  for (size_t b = 0; b < nBins; ++b) {
+    for (size_t a = 0; a < nBins; ++a) {
+      cells.emplace_back(a, b, 1.);
+    }
+  }
+  auto clusters = Acts::createClusters<DigitizationCell>(cells, false, 0.);
+  BOOST_CHECK_EQUAL(clusters.size(), 1u);
+  BOOST_CHECK_EQUAL(clusters.front().size(), nBins * nBins);
+
+  // a diagonal line is only connected with common corners
+  cells.clear();
+  for (size_t a = 0; a < nBins; ++a) {
+    cells.emplace_back(a, a, 1.);
+  }
+  BOOST_CHECK_EQUAL(
+      (Acts::createClusters<DigitizationCell>(cells, true, 0.).size()), 1u);
+  BOOST_CHECK_EQUAL(
+      (Acts::createClusters<DigitizationCell>(cells, false, 0.).size()), nBins);
+}
 }  // namespace Test
 }  // namespace Acts